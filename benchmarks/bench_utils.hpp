@@ -0,0 +1,36 @@
+#ifndef YADQ_BENCH_UTILS_HPP
+#define YADQ_BENCH_UTILS_HPP
+
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+
+namespace yadq_bench{
+
+    /**
+     * Number of elements used by the "array" variants of the benchmarks
+     */
+    constexpr int64_t array_size = 1 << 16;
+
+    /**
+     * \brief Deterministic random quaternions with components in [-1, 1]
+     * \param n number of quaternions
+     * \param seed seed of the generator
+     */
+    template<typename Q>
+    std::vector<Q> random_quaternions(std::size_t n, unsigned seed = 42){
+        using T = typename Q::value_type;
+
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-1, 1);
+
+        std::vector<Q> v;
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+        }
+        return v;
+    }
+}
+
+#endif
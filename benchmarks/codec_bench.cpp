@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/codec.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::random_quaternions;
+
+    constexpr std::size_t stream_size = 1 << 20;
+
+    template<typename T, typename Codec>
+    void BM_EncodeScalar(benchmark::State& state){
+        const auto q = random_quaternions<yadq::quaternionU<T>>(stream_size);
+        std::vector<typename Codec::storage_type> s(q.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < q.size(); ++i){
+                s[i] = Codec::encode(q[i]);
+            }
+            benchmark::DoNotOptimize(s.data());
+        }
+        state.SetItemsProcessed(state.iterations() * stream_size);
+    }
+
+    template<typename T, typename Codec>
+    void BM_EncodeBatch(benchmark::State& state){
+        const auto q = random_quaternions<yadq::quaternionU<T>>(stream_size);
+        const yadq::quaternion_batch<T> batch(q.begin(), q.end());
+        std::vector<typename Codec::storage_type> s(q.size());
+        for (auto _ : state){
+            yadq::encode<Codec>(batch, s.data());
+            benchmark::DoNotOptimize(s.data());
+        }
+        state.SetItemsProcessed(state.iterations() * stream_size);
+        state.SetBytesProcessed(state.iterations() * stream_size * sizeof(typename Codec::storage_type));
+    }
+
+    template<typename T, typename Codec>
+    void BM_DecodeScalar(benchmark::State& state){
+        const auto q = random_quaternions<yadq::quaternionU<T>>(stream_size);
+        const yadq::compressed_trajectory<T, Codec> traj(q.begin(), q.end());
+        std::vector<yadq::quaternionU<T>> res(q.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < traj.size(); ++i){
+                res[i] = traj[i];
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * stream_size);
+    }
+
+    template<typename T, typename Codec>
+    void BM_DecodeBatch(benchmark::State& state){
+        const auto q = random_quaternions<yadq::quaternionU<T>>(stream_size);
+        const yadq::quaternion_batch<T> batch(q.begin(), q.end());
+        const auto s = yadq::encode<Codec>(batch);
+        yadq::quaternion_batch<T> res(q.size());
+        for (auto _ : state){
+            yadq::decode<Codec>(s.data(), s.size(), res);
+            benchmark::DoNotOptimize(res.w());
+        }
+        state.SetItemsProcessed(state.iterations() * stream_size);
+        state.SetBytesProcessed(state.iterations() * stream_size * sizeof(typename Codec::storage_type));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_EncodeScalar, float, yadq::smallest_three_32);
+BENCHMARK_TEMPLATE(BM_EncodeScalar, double, yadq::smallest_three_48);
+BENCHMARK_TEMPLATE(BM_EncodeScalar, float, yadq::half_64);
+BENCHMARK_TEMPLATE(BM_EncodeBatch, float, yadq::smallest_three_32);
+BENCHMARK_TEMPLATE(BM_EncodeBatch, float, yadq::smallest_three_48);
+BENCHMARK_TEMPLATE(BM_EncodeBatch, double, yadq::smallest_three_48);
+BENCHMARK_TEMPLATE(BM_EncodeBatch, double, yadq::smallest_three_64);
+BENCHMARK_TEMPLATE(BM_EncodeBatch, float, yadq::half_64);
+BENCHMARK_TEMPLATE(BM_EncodeBatch, double, yadq::half_64);
+BENCHMARK_TEMPLATE(BM_DecodeScalar, float, yadq::smallest_three_32);
+BENCHMARK_TEMPLATE(BM_DecodeScalar, double, yadq::smallest_three_48);
+BENCHMARK_TEMPLATE(BM_DecodeScalar, float, yadq::half_64);
+BENCHMARK_TEMPLATE(BM_DecodeBatch, float, yadq::smallest_three_32);
+BENCHMARK_TEMPLATE(BM_DecodeBatch, float, yadq::smallest_three_48);
+BENCHMARK_TEMPLATE(BM_DecodeBatch, double, yadq::smallest_three_48);
+BENCHMARK_TEMPLATE(BM_DecodeBatch, double, yadq::smallest_three_64);
+BENCHMARK_TEMPLATE(BM_DecodeBatch, float, yadq::half_64);
+BENCHMARK_TEMPLATE(BM_DecodeBatch, double, yadq::half_64);
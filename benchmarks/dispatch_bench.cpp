@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/rotation_batch.hpp>
+#include <yadq/dispatch.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq::dispatch::isa;
+
+    // Selects the instruction set of the benchmark argument, skipping the ones this machine lacks
+    bool select_isa(benchmark::State& state){
+        const auto target = static_cast<isa>(state.range(1));
+        if (!yadq::dispatch::select(target)){
+            state.SkipWithError("instruction set not supported");
+            return false;
+        }
+        state.SetLabel(yadq::dispatch::name(target));
+        return true;
+    }
+
+    template<typename T>
+    void BM_DispatchMultiply(benchmark::State& state){
+        if (!select_isa(state)){
+            return;
+        }
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const auto v = yadq_bench::random_quaternions<yadq::quaternion<T>>(n);
+        const yadq::quaternion_batch<T> qb(v.begin(), v.end());
+        yadq::quaternion_batch<T> res(n);
+
+        for (auto _ : state){
+            yadq::dispatch::multiply(qb, qb, res);
+            benchmark::DoNotOptimize(res.w());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template<typename T>
+    void BM_DispatchQuatToRotation(benchmark::State& state){
+        if (!select_isa(state)){
+            return;
+        }
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const auto v = yadq_bench::random_quaternions<yadq::quaternionU<T>>(n);
+        const yadq::quaternion_batch<T> qb(v.begin(), v.end());
+        std::vector<T> matrices(9 * n);
+
+        for (auto _ : state){
+            yadq::dispatch::quatToRotation(qb, matrices.data());
+            benchmark::DoNotOptimize(matrices.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void isa_args(benchmark::internal::Benchmark* b){
+        for (const isa target : {isa::scalar, isa::sse2, isa::sse42, isa::avx2, isa::avx512}){
+            b->Args({1 << 12, static_cast<long>(target)});
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_DispatchMultiply, double)->Apply(isa_args);
+BENCHMARK_TEMPLATE(BM_DispatchMultiply, float)->Apply(isa_args);
+BENCHMARK_TEMPLATE(BM_DispatchQuatToRotation, double)->Apply(isa_args);
+BENCHMARK_TEMPLATE(BM_DispatchQuatToRotation, float)->Apply(isa_args);
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/point_cloud.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::array_size;
+    using yadq_bench::random_quaternions;
+
+    template<typename T>
+    std::vector<yadq::dualquaternion<T>> random_dualquaternions(std::size_t n, unsigned seed){
+        const auto r = random_quaternions<yadq::quaternionU<T>>(n, seed);
+        const auto t = random_quaternions<yadq::quaternion<T>>(n, seed + 1);
+
+        std::vector<yadq::dualquaternion<T>> v;
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(r[i], std::array<T, 3>{t[i].x(), t[i].y(), t[i].z()});
+        }
+        return v;
+    }
+
+    template<typename T>
+    void BM_DualConstruction(benchmark::State& state){
+        const auto r = random_quaternions<yadq::quaternionU<T>>(1);
+        std::array<T, 3> t{0.1, 0.2, 0.3};
+        for (auto _ : state){
+            benchmark::DoNotOptimize(t);
+            yadq::dualquaternion<T> dq(r[0], t);
+            benchmark::DoNotOptimize(dq);
+        }
+    }
+
+    template<typename T>
+    void BM_DualProduct(benchmark::State& state){
+        auto v = random_dualquaternions<T>(2, 1);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(v.data());
+            auto dq = v[0] * v[1];
+            benchmark::DoNotOptimize(dq);
+        }
+    }
+
+    template<typename T>
+    void BM_DualProductArray(benchmark::State& state){
+        const auto v1 = random_dualquaternions<T>(array_size, 1);
+        const auto v2 = random_dualquaternions<T>(array_size, 3);
+        std::vector<yadq::dualquaternion<T>> res(v1.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < v1.size(); ++i){
+                res[i] = v1[i] * v2[i];
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_DualConjugate(benchmark::State& state){
+        auto v = random_dualquaternions<T>(1, 1);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(v.data());
+            auto dq = conjugate(v[0]);
+            benchmark::DoNotOptimize(dq);
+        }
+    }
+
+    template<typename T>
+    void BM_DualTransformTripleProduct(benchmark::State& state){
+        const auto v = random_dualquaternions<T>(1, 1);
+        const auto p = random_quaternions<yadq::quaternion<T>>(array_size, 5);
+        std::vector<T> out(3 * array_size);
+        const auto dq_conj = combined_conjugate(v[0]);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < array_size; ++i){
+                yadq::dualquaternion<T> dq_p(yadq::quaternionU<T>(1, 0, 0, 0), yadq::quaternion<T>(0, p[i].x(), p[i].y(), p[i].z()));
+                auto dq = v[0] * dq_p * dq_conj;
+                out[3 * i] = dq.qd_.x();
+                out[3 * i + 1] = dq.qd_.y();
+                out[3 * i + 2] = dq.qd_.z();
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_DualTransformScalar(benchmark::State& state){
+        const auto v = random_dualquaternions<T>(1, 1);
+        const auto p = random_quaternions<yadq::quaternion<T>>(array_size, 5);
+        std::vector<T> out(3 * array_size);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < array_size; ++i){
+                auto r = v[0] * std::array<T, 3>{p[i].x(), p[i].y(), p[i].z()};
+                out[3 * i] = r[0];
+                out[3 * i + 1] = r[1];
+                out[3 * i + 2] = r[2];
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_DualTransformBatch(benchmark::State& state){
+        const auto v = random_dualquaternions<T>(1, 1);
+        const auto p = random_quaternions<yadq::quaternion<T>>(array_size, 5);
+        std::vector<T> in(3 * array_size), out(3 * array_size);
+        for (std::size_t i = 0; i < array_size; ++i){
+            in[3 * i] = p[i].x();
+            in[3 * i + 1] = p[i].y();
+            in[3 * i + 2] = p[i].z();
+        }
+        for (auto _ : state){
+            transform(v[0], in.data(), out.data(), array_size);
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_DualConstruction, float);
+BENCHMARK_TEMPLATE(BM_DualConstruction, double);
+BENCHMARK_TEMPLATE(BM_DualProduct, float);
+BENCHMARK_TEMPLATE(BM_DualProduct, double);
+BENCHMARK_TEMPLATE(BM_DualProductArray, float);
+BENCHMARK_TEMPLATE(BM_DualProductArray, double);
+BENCHMARK_TEMPLATE(BM_DualConjugate, float);
+BENCHMARK_TEMPLATE(BM_DualConjugate, double);
+BENCHMARK_TEMPLATE(BM_DualTransformTripleProduct, float);
+BENCHMARK_TEMPLATE(BM_DualTransformTripleProduct, double);
+BENCHMARK_TEMPLATE(BM_DualTransformScalar, float);
+BENCHMARK_TEMPLATE(BM_DualTransformScalar, double);
+BENCHMARK_TEMPLATE(BM_DualTransformBatch, float);
+BENCHMARK_TEMPLATE(BM_DualTransformBatch, double);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/expression.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::random_quaternions;
+
+    // r = a b c* + d over arrays: two products, a conjugate and a sum. Eager quaternionU operands normalise
+    // three times (93 arithmetic operations and 3 square roots per element), the expression once (71 and 1).
+    template<typename Q, bool Fused>
+    void BM_Chain(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const auto a = random_quaternions<Q>(n, 1);
+        const auto b = random_quaternions<Q>(n, 2);
+        const auto c = random_quaternions<Q>(n, 3);
+        const auto d = random_quaternions<Q>(n, 4);
+        std::vector<Q> r(n);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < n; ++i){
+                if constexpr (Fused){
+                    r[i] = yadq::expr(a[i]) * b[i] * conjugate(c[i]) + d[i];
+                }else{
+                    r[i] = a[i] * b[i] * conjugate(c[i]) + d[i];
+                }
+            }
+            benchmark::DoNotOptimize(r.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    // Composition of four rotations, a b c d: three normalisations become one
+    template<typename Q, bool Fused>
+    void BM_Product4(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const auto a = random_quaternions<Q>(n, 1);
+        const auto b = random_quaternions<Q>(n, 2);
+        const auto c = random_quaternions<Q>(n, 3);
+        const auto d = random_quaternions<Q>(n, 4);
+        std::vector<Q> r(n);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < n; ++i){
+                if constexpr (Fused){
+                    r[i] = yadq::expr(a[i]) * b[i] * c[i] * d[i];
+                }else{
+                    r[i] = a[i] * b[i] * c[i] * d[i];
+                }
+            }
+            benchmark::DoNotOptimize(r.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Chain, yadq::quaternionU<double>, false)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Chain, yadq::quaternionU<double>, true)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Chain, yadq::quaternionU<float>, false)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Chain, yadq::quaternionU<float>, true)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Chain, yadq::quaternion<double>, false)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Chain, yadq::quaternion<double>, true)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Product4, yadq::quaternionU<double>, false)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Product4, yadq::quaternionU<double>, true)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Product4, yadq::quaternionU<float>, false)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_Product4, yadq::quaternionU<float>, true)->Arg(yadq_bench::array_size);
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/frame_graph.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using dq = yadq::dualquaternion<double>;
+
+    // Chain of `depth` frames under the root
+    void build_chain(yadq::frame_graph<double>& g, std::size_t depth){
+        const auto rotations = yadq_bench::random_quaternions<yadq::quaternionU<double>>(depth, 1);
+        std::size_t last = g.root;
+        for (std::size_t i = 0; i < depth; ++i){
+            last = g.add_frame(last, dq(rotations[i], std::array<double, 3>{0.1, 0.2, 0.3}));
+        }
+    }
+
+    // Baseline: recompose the root-to-leaf path with operator* at every lookup
+    void BM_RecomposePath(benchmark::State& state){
+        const std::size_t depth = static_cast<std::size_t>(state.range(0));
+        yadq::frame_graph<double> g;
+        build_chain(g, depth);
+
+        std::vector<dq> edges;
+        for (std::size_t k = 1; k <= depth; ++k){
+            edges.push_back(g.transform(k));
+        }
+
+        for (auto _ : state){
+            dq result;
+            for (const auto& e : edges){
+                result = result * e;
+            }
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    // Cached lookup of the leaf, edges unchanged
+    void BM_CachedLookup(benchmark::State& state){
+        const std::size_t depth = static_cast<std::size_t>(state.range(0));
+        yadq::frame_graph<double> g;
+        build_chain(g, depth);
+        g.refresh();
+
+        for (auto _ : state){
+            benchmark::DoNotOptimize(g.lookup(depth / 2, depth));
+        }
+    }
+
+    // An edge halfway down changes before every lookup: only the lower half of the path is recomposed
+    void BM_LookupAfterUpdate(benchmark::State& state){
+        const std::size_t depth = static_cast<std::size_t>(state.range(0));
+        yadq::frame_graph<double> g;
+        build_chain(g, depth);
+        const dq edge = g.transform(depth / 2);
+
+        for (auto _ : state){
+            g.set_transform(depth / 2, edge);
+            benchmark::DoNotOptimize(g.world(depth));
+        }
+    }
+}
+
+BENCHMARK(BM_RecomposePath)->Arg(8)->Arg(32);
+BENCHMARK(BM_CachedLookup)->Arg(8)->Arg(32);
+BENCHMARK(BM_LookupAfterUpdate)->Arg(8)->Arg(32);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/gyro_integration.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::random_quaternions;
+    using yadq::integration_scheme;
+
+    // Rates of a few rad/s sampled at 1 kHz
+    template<typename T>
+    std::array<std::vector<T>, 3> random_rates(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-5, 5);
+        std::array<std::vector<T>, 3> rates;
+        for (auto& r : rates){
+            r.resize(n);
+            for (auto& v : r){
+                v = dist(gen);
+            }
+        }
+        return rates;
+    }
+
+    template<typename T>
+    constexpr T dt = T(1e-3);
+
+    // The usual hand-written step: axis and angle of the mean rate, then a product with quaternionU(axis, angle)
+    template<typename T>
+    void BM_GyroAxisAngle(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        auto q = random_quaternions<yadq::quaternionU<T>>(n);
+        const auto w0 = random_rates<T>(n, 1);
+        const auto w1 = random_rates<T>(n, 2);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < n; ++i){
+                const T x = (w0[0][i] + w1[0][i]) / 2, y = (w0[1][i] + w1[1][i]) / 2, z = (w0[2][i] + w1[2][i]) / 2;
+                const T norm = std::sqrt(x * x + y * y + z * z);
+                q[i] *= yadq::quaternionU<T>(std::array<T, 3>{x / norm, y / norm, z / norm}, norm * dt<T>);
+            }
+            benchmark::DoNotOptimize(q.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    template<typename T, integration_scheme S>
+    void BM_GyroScalar(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        auto q = random_quaternions<yadq::quaternionU<T>>(n);
+        const auto w0 = random_rates<T>(n, 1);
+        const auto w1 = random_rates<T>(n, 2);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < n; ++i){
+                q[i] = yadq::integrate(q[i], {w0[0][i], w0[1][i], w0[2][i]}, {w1[0][i], w1[1][i], w1[2][i]}, dt<T>, S);
+            }
+            benchmark::DoNotOptimize(q.data());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    template<typename T, integration_scheme S>
+    void BM_GyroBatch(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const auto v = random_quaternions<yadq::quaternionU<T>>(n);
+        yadq::quaternion_batch<T> q(v.begin(), v.end());
+        const auto w0 = random_rates<T>(n, 1);
+        const auto w1 = random_rates<T>(n, 2);
+        for (auto _ : state){
+            yadq::integrate(q, {w0[0].data(), w0[1].data(), w0[2].data()}, {w1[0].data(), w1[1].data(), w1[2].data()}, dt<T>, S);
+            benchmark::DoNotOptimize(q.w());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+}
+
+// Hundreds of sensors, and a large batch
+BENCHMARK_TEMPLATE(BM_GyroAxisAngle, float)->Arg(256)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_GyroAxisAngle, double)->Arg(256)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_GyroScalar, double, integration_scheme::magnus)->Arg(256);
+BENCHMARK_TEMPLATE(BM_GyroBatch, float, integration_scheme::exponential)->Arg(256)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_GyroBatch, float, integration_scheme::magnus)->Arg(256)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_GyroBatch, float, integration_scheme::rk4)->Arg(256)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_GyroBatch, double, integration_scheme::exponential)->Arg(256)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_GyroBatch, double, integration_scheme::magnus)->Arg(256)->Arg(yadq_bench::array_size);
+BENCHMARK_TEMPLATE(BM_GyroBatch, double, integration_scheme::rk4)->Arg(256)->Arg(yadq_bench::array_size);
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/mean.hpp>
+
+namespace {
+
+    // Orientation estimates scattered by about 0.1 rad around a common rotation, with random signs
+    template<typename T>
+    yadq::quaternion_batch<T> clustered(std::size_t n){
+        std::mt19937 gen(7);
+        std::normal_distribution<T> noise(0, T(0.05));
+        std::bernoulli_distribution flip(0.5);
+
+        yadq::quaternion_batch<T> q(n);
+        for (std::size_t i = 0; i < n; ++i){
+            const T s = flip(gen) ? T(-1) : T(1);
+            q.set(i, yadq::quaternionU<T>(s * (T(0.8) + noise(gen)), s * (T(0.4) + noise(gen)), s * (T(-0.2) + noise(gen)), s * (T(0.4) + noise(gen))));
+        }
+        return q;
+    }
+
+    // The usual hand-written version: pull every sample out of the batch, accumulate the full 4x4 matrix,
+    // then an eigen-decomposition
+    template<typename T>
+    void BM_MeanNaive(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const auto q = clustered<T>(n);
+        for (auto _ : state){
+            double m[4][4] = {};
+            for (std::size_t i = 0; i < n; ++i){
+                const auto s = q.get(i);
+                const double v[4] = {s.w(), s.x(), s.y(), s.z()};
+                for (int r = 0; r < 4; ++r){
+                    for (int c = 0; c < 4; ++c){
+                        m[r][c] += v[r] * v[c];
+                    }
+                }
+            }
+            const auto e = yadq::detail::dominant_eigenvector({m[0][0], m[0][1], m[0][2], m[0][3], m[1][1], m[1][2], m[1][3], m[2][2], m[2][3], m[3][3]});
+            benchmark::DoNotOptimize(e);
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    template<typename T>
+    void BM_MeanStreaming(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const auto q = clustered<T>(n);
+        std::vector<yadq::quaternionU<T>> v;
+        for (std::size_t i = 0; i < n; ++i){
+            v.push_back(q.get(i));
+        }
+        for (auto _ : state){
+            benchmark::DoNotOptimize(yadq::mean(v.begin(), v.end()));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    template<typename T>
+    void BM_MeanBatch(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const auto q = clustered<T>(n);
+        const unsigned threads = static_cast<unsigned>(state.range(1));
+        for (auto _ : state){
+            benchmark::DoNotOptimize(yadq::mean(q, {threads}));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    template<typename T, yadq::mean_metric M>
+    void BM_IterativeMean(benchmark::State& state){
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        const auto q = clustered<T>(n);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(yadq::iterative_mean(q, nullptr, {M}));
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_MeanNaive, float)->Arg(1000)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_MeanNaive, double)->Arg(1000)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_MeanStreaming, double)->Arg(1000)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_MeanBatch, float)->Args({1000, 1})->Args({1000000, 1})->Args({1000000, 0});
+BENCHMARK_TEMPLATE(BM_MeanBatch, double)->Args({1000, 1})->Args({1000000, 1})->Args({1000000, 0});
+BENCHMARK_TEMPLATE(BM_IterativeMean, float, yadq::mean_metric::chordal)->Arg(1000)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_IterativeMean, double, yadq::mean_metric::chordal)->Arg(1000)->Arg(1000000);
+BENCHMARK_TEMPLATE(BM_IterativeMean, double, yadq::mean_metric::geodesic)->Arg(1000)->Arg(1000000);
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/mixed_precision.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    // 10^7 compositions of the same 1000 float rotations
+    constexpr std::size_t chain_length = 10000000;
+
+    using quaternionl = std::array<long double, 4>;
+
+    const std::vector<yadq::quaternionU<float>>& steps(){
+        static const auto v = yadq_bench::random_quaternions<yadq::quaternionU<float>>(1000);
+        return v;
+    }
+
+    quaternionl hamilton(const quaternionl& l, const quaternionl& r){
+        return {    l[0] * r[0] - l[1] * r[1] - l[2] * r[2] - l[3] * r[3],
+                    l[0] * r[1] + l[1] * r[0] + l[2] * r[3] - l[3] * r[2],
+                    l[0] * r[2] - l[1] * r[3] + l[2] * r[0] + l[3] * r[1],
+                    l[0] * r[3] + l[1] * r[2] - l[2] * r[1] + l[3] * r[0]};
+    }
+
+    // Exact product of the chain, in long double, computed once
+    const quaternionl& reference(){
+        static const quaternionl ref = []{
+            quaternionl q{1, 0, 0, 0};
+            for (std::size_t i = 0; i < chain_length; ++i){
+                const auto& s = steps()[i % steps().size()];
+                q = hamilton(q, {s.w(), s.x(), s.y(), s.z()});
+                if (i % 4096 == 0){
+                    const long double d = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+                    for (auto& c : q){
+                        c /= d;
+                    }
+                }
+            }
+            return q;
+        }();
+        return ref;
+    }
+
+    // Angle between q and the reference rotation, in radians
+    template<typename Q>
+    double angle_error(const Q& q){
+        const quaternionl& ref = reference();
+        const quaternionl d = hamilton({q.w(), -q.x(), -q.y(), -q.z()}, ref);
+        return static_cast<double>(2 * std::atan2(std::sqrt(d[1] * d[1] + d[2] * d[2] + d[3] * d[3]), std::fabs(d[0])));
+    }
+
+    template<typename Chain>
+    yadq::quaternionU<float> rounded(const Chain& chain){
+        if constexpr (yadq::is_quaternionU_v<Chain>){
+            return yadq::quaternionU<float>(chain);
+        }else{
+            return chain.value();
+        }
+    }
+
+    // Throughput of a 10^7-step chain, with the angle_error of its result (rounded to float) as a counter
+    template<typename Chain, typename Step>
+    void BM_MixedChain(benchmark::State& state){
+        std::vector<Step> v;
+        for (const auto& s : steps()){
+            v.emplace_back(s);
+        }
+        reference();
+
+        double error = 0;
+        for (auto _ : state){
+            Chain chain;
+            for (std::size_t i = 0; i < chain_length; i += v.size()){
+                for (const auto& s : v){
+                    chain *= s;
+                }
+            }
+            benchmark::DoNotOptimize(chain);
+            error = angle_error(rounded(chain));
+        }
+        state.SetItemsProcessed(state.iterations() * chain_length);
+        state.counters["angle_error"] = error;
+    }
+
+    using float_chain = yadq::quaternionU<float>;
+    using double_chain = yadq::quaternionU<double>;
+    using wide_chain = yadq::composition_chain<float, yadq::accumulation::wide>;
+    using compensated_chain = yadq::composition_chain<float, yadq::accumulation::compensated>;
+}
+
+BENCHMARK_TEMPLATE(BM_MixedChain, float_chain, yadq::quaternionU<float>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MixedChain, double_chain, yadq::quaternionU<double>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MixedChain, wide_chain, yadq::quaternionU<float>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MixedChain, compensated_chain, yadq::quaternionU<float>)->Unit(benchmark::kMillisecond);
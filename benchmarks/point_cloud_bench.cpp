@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/point_cloud.hpp>
+
+namespace {
+
+    constexpr std::size_t cloud_size = 1 << 20;
+
+    template<typename T>
+    std::vector<T> make_cloud(std::size_t n){
+        std::vector<T> v(3 * n);
+        for (std::size_t i = 0; i < v.size(); ++i){
+            v[i] = static_cast<T>(i % 97) * T(0.1);
+        }
+        return v;
+    }
+
+    template<typename T>
+    void BM_RotateDoubleProduct(benchmark::State& state){
+        const yadq::quaternionU<T> q({0.2, 0.3, 0.9}, 0.7);
+        const auto cloud = make_cloud<T>(cloud_size);
+        std::vector<T> out(cloud.size());
+
+        for (auto _ : state){
+            for (std::size_t i = 0; i < cloud_size; ++i){
+                yadq::quaternionU<T> p(0, cloud[3 * i], cloud[3 * i + 1], cloud[3 * i + 2]);
+                auto r = q * p * conjugate(q);
+                out[3 * i] = r.x();
+                out[3 * i + 1] = r.y();
+                out[3 * i + 2] = r.z();
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * cloud_size);
+    }
+
+    template<typename T>
+    void BM_RotateScalar(benchmark::State& state){
+        const yadq::quaternionU<T> q({0.2, 0.3, 0.9}, 0.7);
+        const auto cloud = make_cloud<T>(cloud_size);
+        std::vector<T> out(cloud.size());
+
+        for (auto _ : state){
+            for (std::size_t i = 0; i < cloud_size; ++i){
+                auto r = rotate(q, {cloud[3 * i], cloud[3 * i + 1], cloud[3 * i + 2]});
+                out[3 * i] = r[0];
+                out[3 * i + 1] = r[1];
+                out[3 * i + 2] = r[2];
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * cloud_size);
+    }
+
+    template<typename T>
+    void BM_RotateInterleaved(benchmark::State& state){
+        const yadq::quaternionU<T> q({0.2, 0.3, 0.9}, 0.7);
+        const auto cloud = make_cloud<T>(cloud_size);
+        std::vector<T> out(cloud.size());
+        const yadq::parallel_config config{static_cast<unsigned>(state.range(0))};
+
+        for (auto _ : state){
+            rotate(q, cloud.data(), out.data(), cloud_size, config);
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * cloud_size);
+        state.SetLabel(yadq::simd::isa_name());
+    }
+
+    template<typename T>
+    void BM_RotateSoA(benchmark::State& state){
+        const yadq::quaternionU<T> q({0.2, 0.3, 0.9}, 0.7);
+        auto x = make_cloud<T>(cloud_size / 3 + 1), y = x, z = x;
+        std::vector<T> x_out(cloud_size), y_out(cloud_size), z_out(cloud_size);
+        x.resize(cloud_size); y.resize(cloud_size); z.resize(cloud_size);
+        const yadq::parallel_config config{static_cast<unsigned>(state.range(0))};
+
+        for (auto _ : state){
+            rotate(q, yadq::point_lanes<const T>{x.data(), y.data(), z.data()}, yadq::point_lanes<T>{x_out.data(), y_out.data(), z_out.data()}, cloud_size, config);
+            benchmark::DoNotOptimize(x_out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * cloud_size);
+        state.SetLabel(yadq::simd::isa_name());
+    }
+
+    const int64_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+BENCHMARK_TEMPLATE(BM_RotateDoubleProduct, float);
+BENCHMARK_TEMPLATE(BM_RotateDoubleProduct, double);
+BENCHMARK_TEMPLATE(BM_RotateScalar, float);
+BENCHMARK_TEMPLATE(BM_RotateScalar, double);
+BENCHMARK_TEMPLATE(BM_RotateInterleaved, float)->Arg(1)->Arg(max_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RotateInterleaved, double)->Arg(1)->Arg(max_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RotateSoA, float)->Arg(1)->Arg(max_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RotateSoA, double)->Arg(1)->Arg(max_threads)->UseRealTime();
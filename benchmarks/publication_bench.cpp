@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/publication.hpp>
+
+namespace {
+
+    using dq = yadq::dualquaternion<double>;
+
+    // Runs f in a loop on `threads` background threads while in scope, the contention of the measured thread
+    template<typename F>
+    class background{
+        public:
+            background(int threads, F f){
+                for (int i = 0; i < threads; ++i){
+                    threads_.emplace_back([this, f]{
+                        while (!stop_.load(std::memory_order_relaxed)){
+                            f();
+                        }
+                    });
+                }
+            }
+            ~background(){
+                stop_ = true;
+                for (auto& t : threads_){
+                    t.join();
+                }
+            }
+
+        private:
+            std::atomic<bool> stop_{false};
+            std::vector<std::thread> threads_;
+    };
+
+    // Baseline: the latest pose behind a mutex
+    class locked_pose{
+        public:
+            void store(const dq& v){
+                const std::lock_guard<std::mutex> lock(mutex_);
+                value_ = v;
+            }
+            dq load() const{
+                const std::lock_guard<std::mutex> lock(mutex_);
+                return value_;
+            }
+
+        private:
+            mutable std::mutex mutex_;
+            dq value_;
+    };
+
+    // Reader latency while one writer stores continuously
+    template<typename P>
+    void BM_ReadWhileWriting(benchmark::State& state){
+        P pose;
+        const dq v(yadq::quaternionU<double>(1, 2, 3, 4), std::array<double, 3>{1, 2, 3});
+        background writer(1, [&]{ pose.store(v); });
+
+        for (auto _ : state){
+            benchmark::DoNotOptimize(pose.load());
+        }
+    }
+
+    // Writer latency while `range(0)` readers load continuously
+    template<typename P>
+    void BM_WriteWhileReading(benchmark::State& state){
+        P pose;
+        const dq v(yadq::quaternionU<double>(1, 2, 3, 4), std::array<double, 3>{1, 2, 3});
+        background readers(static_cast<int>(state.range(0)), [&]{ benchmark::DoNotOptimize(pose.load()); });
+
+        for (auto _ : state){
+            pose.store(v);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    // Interpolated lookup in a full history of 1024 poses
+    void BM_HistoryAt(benchmark::State& state){
+        yadq::pose_history<dq> history(1024);
+        for (int i = 0; i < 4096; ++i){
+            history.push(i, dq(yadq::quaternionU<double>(1, 0.001 * i, 0, 0), std::array<double, 3>{0.01 * i, 0, 0}));
+        }
+
+        double t = 3072.5;
+        for (auto _ : state){
+            benchmark::DoNotOptimize(history.at(t));
+            t = t < 4094 ? t + 1 : 3072.5;
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ReadWhileWriting, yadq::seqlock<dq>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReadWhileWriting, locked_pose)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_WriteWhileReading, yadq::seqlock<dq>)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_WriteWhileReading, locked_pose)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_HistoryAt);
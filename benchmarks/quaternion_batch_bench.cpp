@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+
+namespace {
+
+    template<typename Q>
+    std::vector<Q> make_rotations(std::size_t n){
+        std::vector<Q> v;
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(1.0, 0.001 * i, 0.002, 0.003);
+        }
+        return v;
+    }
+
+    template<typename Q>
+    void BM_AoSMultiply(benchmark::State& state){
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const auto v1 = make_rotations<Q>(n);
+        const auto v2 = make_rotations<Q>(n);
+        std::vector<Q> res(n);
+
+        for (auto _ : state){
+            for (std::size_t i = 0; i < n; ++i){
+                res[i] = hamilton_prod(v1[i], v2[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template<typename T>
+    void BM_BatchMultiply(benchmark::State& state){
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const auto v = make_rotations<yadq::quaternion<T>>(n);
+        const yadq::quaternion_batch<T> qb1(v.begin(), v.end());
+        const yadq::quaternion_batch<T> qb2(v.begin(), v.end());
+        yadq::quaternion_batch<T> res(n);
+
+        for (auto _ : state){
+            multiply(qb1, qb2, res);
+            benchmark::DoNotOptimize(res.w());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetLabel(yadq::simd::isa_name());
+    }
+
+    template<typename T>
+    void BM_BatchNormalise(benchmark::State& state){
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const auto v = make_rotations<yadq::quaternion<T>>(n);
+        const yadq::quaternion_batch<T> qb(v.begin(), v.end());
+        yadq::quaternion_batch<T> res(n);
+
+        for (auto _ : state){
+            normalise(qb, res);
+            benchmark::DoNotOptimize(res.w());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetLabel(yadq::simd::isa_name());
+    }
+
+    // Product of unitary batches followed by their renormalisation
+    template<typename T, yadq::norm_strategy S>
+    void BM_BatchMultiplyRenormalise(benchmark::State& state){
+        const auto n = static_cast<std::size_t>(state.range(0));
+        const auto v = make_rotations<yadq::quaternionU<T>>(n);
+        const yadq::quaternion_batch<T> qb1(v.begin(), v.end());
+        const yadq::quaternion_batch<T> qb2(v.begin(), v.end());
+        yadq::quaternion_batch<T> res(n);
+
+        for (auto _ : state){
+            multiply(qb1, qb2, res);
+            yadq::renormalise<S>(res, res);
+            benchmark::DoNotOptimize(res.w());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetLabel(yadq::simd::isa_name());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_AoSMultiply, yadq::quaternionU<double>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_AoSMultiply, yadq::quaternion<double>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BatchMultiply, double)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BatchMultiply, float)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BatchNormalise, double)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BatchNormalise, float)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_BatchMultiplyRenormalise, double, yadq::norm_strategy::exact)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_BatchMultiplyRenormalise, double, yadq::norm_strategy::newton)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_BatchMultiplyRenormalise, double, yadq::norm_strategy::pade)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_BatchMultiplyRenormalise, float, yadq::norm_strategy::exact)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_BatchMultiplyRenormalise, float, yadq::norm_strategy::newton)->Arg(1 << 12);
+BENCHMARK_TEMPLATE(BM_BatchMultiplyRenormalise, float, yadq::norm_strategy::pade)->Arg(1 << 12);
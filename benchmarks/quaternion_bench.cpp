@@ -0,0 +1,260 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include "bench_utils.hpp"
+
+/*
+    Coverage of the public quaternion API, for float and double. Every operation has a single-call variant and
+    an array variant processing yadq_bench::array_size elements per iteration.
+*/
+
+namespace {
+
+    using yadq_bench::array_size;
+    using yadq_bench::random_quaternions;
+
+    template<typename T>
+    void BM_Construction(benchmark::State& state){
+        T w = 0.5, x = 0.1, y = 0.2, z = 0.3;
+        for (auto _ : state){
+            benchmark::DoNotOptimize(w);
+            yadq::quaternion<T> q(w, x, y, z);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename T>
+    void BM_ConstructionU(benchmark::State& state){
+        T w = 0.5, x = 0.1, y = 0.2, z = 0.3;
+        for (auto _ : state){
+            benchmark::DoNotOptimize(w);
+            yadq::quaternionU<T> q(w, x, y, z);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename T>
+    void BM_ConstructionAxisAngle(benchmark::State& state){
+        std::array<T, 3> axis{0.2, 0.3, 0.9};
+        T angle = 0.7;
+        for (auto _ : state){
+            benchmark::DoNotOptimize(angle);
+            yadq::quaternionU<T> q(axis, angle);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename Q>
+    void BM_HamiltonProd(benchmark::State& state){
+        auto v = random_quaternions<Q>(2);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(v.data());
+            auto q = hamilton_prod(v[0], v[1]);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename Q>
+    void BM_HamiltonProdArray(benchmark::State& state){
+        const auto v1 = random_quaternions<Q>(array_size, 1);
+        const auto v2 = random_quaternions<Q>(array_size, 2);
+        std::vector<Q> res(v1.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < v1.size(); ++i){
+                res[i] = hamilton_prod(v1[i], v2[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_Normalise(benchmark::State& state){
+        auto v = random_quaternions<yadq::quaternion<T>>(1);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(v.data());
+            auto q = normalise(v[0]);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename T>
+    void BM_NormaliseArray(benchmark::State& state){
+        const auto v = random_quaternions<yadq::quaternion<T>>(array_size);
+        std::vector<yadq::quaternion<T>> res(v.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < v.size(); ++i){
+                res[i] = normalise(v[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_Inverse(benchmark::State& state){
+        auto v = random_quaternions<yadq::quaternionU<T>>(1);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(v.data());
+            auto q = inverse(v[0]);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename T>
+    void BM_InverseArray(benchmark::State& state){
+        const auto v = random_quaternions<yadq::quaternionU<T>>(array_size);
+        std::vector<yadq::quaternionU<T>> res(v.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < v.size(); ++i){
+                res[i] = inverse(v[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T, yadq::InterpType I>
+    void BM_Interpolation(benchmark::State& state){
+        auto v = random_quaternions<yadq::quaternionU<T>>(2);
+        double t = 0.3;
+        for (auto _ : state){
+            benchmark::DoNotOptimize(t);
+            auto q = interpolation(v[0], v[1], t, I);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename T, yadq::InterpType I>
+    void BM_InterpolationArray(benchmark::State& state){
+        const auto v1 = random_quaternions<yadq::quaternionU<T>>(array_size, 1);
+        const auto v2 = random_quaternions<yadq::quaternionU<T>>(array_size, 2);
+        std::vector<yadq::quaternionU<T>> res(v1.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < v1.size(); ++i){
+                res[i] = interpolation(v1[i], v2[i], 0.3, I);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_QuatToRotation(benchmark::State& state){
+        auto v = random_quaternions<yadq::quaternionU<T>>(1);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(v.data());
+            auto R = quatToRotation(v[0]);
+            benchmark::DoNotOptimize(R);
+        }
+    }
+
+    template<typename T>
+    void BM_QuatToRotationArray(benchmark::State& state){
+        const auto v = random_quaternions<yadq::quaternionU<T>>(array_size);
+        std::vector<std::array<T, 9>> res(v.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < v.size(); ++i){
+                res[i] = quatToRotation(v[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_Exp(benchmark::State& state){
+        auto v = random_quaternions<yadq::quaternionU<T>>(1);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(v.data());
+            auto q = exp(v[0]);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename T>
+    void BM_ExpArray(benchmark::State& state){
+        const auto v = random_quaternions<yadq::quaternionU<T>>(array_size);
+        std::vector<yadq::quaternionU<T>> res(v.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < v.size(); ++i){
+                res[i] = exp(v[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_Log(benchmark::State& state){
+        auto v = random_quaternions<yadq::quaternionU<T>>(1);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(v.data());
+            auto q = log(v[0]);
+            benchmark::DoNotOptimize(q);
+        }
+    }
+
+    template<typename T>
+    void BM_LogArray(benchmark::State& state){
+        const auto v = random_quaternions<yadq::quaternionU<T>>(array_size);
+        std::vector<yadq::quaternionU<T>> res(v.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < v.size(); ++i){
+                res[i] = log(v[i]).value();
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Construction, float);
+BENCHMARK_TEMPLATE(BM_Construction, double);
+BENCHMARK_TEMPLATE(BM_ConstructionU, float);
+BENCHMARK_TEMPLATE(BM_ConstructionU, double);
+BENCHMARK_TEMPLATE(BM_ConstructionAxisAngle, float);
+BENCHMARK_TEMPLATE(BM_ConstructionAxisAngle, double);
+
+BENCHMARK_TEMPLATE(BM_HamiltonProd, yadq::quaternion<float>);
+BENCHMARK_TEMPLATE(BM_HamiltonProd, yadq::quaternion<double>);
+BENCHMARK_TEMPLATE(BM_HamiltonProd, yadq::quaternionU<float>);
+BENCHMARK_TEMPLATE(BM_HamiltonProd, yadq::quaternionU<double>);
+BENCHMARK_TEMPLATE(BM_HamiltonProdArray, yadq::quaternion<float>);
+BENCHMARK_TEMPLATE(BM_HamiltonProdArray, yadq::quaternion<double>);
+BENCHMARK_TEMPLATE(BM_HamiltonProdArray, yadq::quaternionU<float>);
+BENCHMARK_TEMPLATE(BM_HamiltonProdArray, yadq::quaternionU<double>);
+
+BENCHMARK_TEMPLATE(BM_Normalise, float);
+BENCHMARK_TEMPLATE(BM_Normalise, double);
+BENCHMARK_TEMPLATE(BM_NormaliseArray, float);
+BENCHMARK_TEMPLATE(BM_NormaliseArray, double);
+
+BENCHMARK_TEMPLATE(BM_Inverse, float);
+BENCHMARK_TEMPLATE(BM_Inverse, double);
+BENCHMARK_TEMPLATE(BM_InverseArray, float);
+BENCHMARK_TEMPLATE(BM_InverseArray, double);
+
+BENCHMARK_TEMPLATE(BM_Interpolation, float, yadq::InterpType::LERP);
+BENCHMARK_TEMPLATE(BM_Interpolation, double, yadq::InterpType::LERP);
+BENCHMARK_TEMPLATE(BM_Interpolation, float, yadq::InterpType::SLERP);
+BENCHMARK_TEMPLATE(BM_Interpolation, double, yadq::InterpType::SLERP);
+BENCHMARK_TEMPLATE(BM_InterpolationArray, float, yadq::InterpType::LERP);
+BENCHMARK_TEMPLATE(BM_InterpolationArray, double, yadq::InterpType::LERP);
+BENCHMARK_TEMPLATE(BM_InterpolationArray, float, yadq::InterpType::SLERP);
+BENCHMARK_TEMPLATE(BM_InterpolationArray, double, yadq::InterpType::SLERP);
+
+BENCHMARK_TEMPLATE(BM_QuatToRotation, float);
+BENCHMARK_TEMPLATE(BM_QuatToRotation, double);
+BENCHMARK_TEMPLATE(BM_QuatToRotationArray, float);
+BENCHMARK_TEMPLATE(BM_QuatToRotationArray, double);
+
+BENCHMARK_TEMPLATE(BM_Exp, float);
+BENCHMARK_TEMPLATE(BM_Exp, double);
+BENCHMARK_TEMPLATE(BM_ExpArray, float);
+BENCHMARK_TEMPLATE(BM_ExpArray, double);
+
+BENCHMARK_TEMPLATE(BM_Log, float);
+BENCHMARK_TEMPLATE(BM_Log, double);
+BENCHMARK_TEMPLATE(BM_LogArray, float);
+BENCHMARK_TEMPLATE(BM_LogArray, double);
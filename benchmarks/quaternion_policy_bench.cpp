@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+
+namespace {
+
+    template<typename Q>
+    void BM_CompositionChain(benchmark::State& state){
+        const Q q_step({0.2, 0.3, 0.9}, 0.001);
+        for (auto _ : state){
+            Q q_chain;
+            for (int64_t i = 0; i < state.range(0); ++i){
+                q_chain *= q_step;
+            }
+            benchmark::DoNotOptimize(q_chain.w());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template<typename Q>
+    void BM_PassByValue(benchmark::State& state){
+        const std::vector<Q> v(static_cast<std::size_t>(state.range(0)), Q({0.2, 0.3, 0.9}, 0.5));
+        for (auto _ : state){
+            std::vector<Q> dst;
+            dst.reserve(v.size());
+            for (const auto q : v){
+                dst.push_back(q);
+            }
+            benchmark::DoNotOptimize(dst.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    using eager_t = yadq::quaternionU<double, yadq::normalise_eager>;
+    using lazy_t = yadq::quaternionU<double, yadq::normalise_lazy>;
+    using periodic_t = yadq::quaternionU<double, yadq::normalise_periodic<16>>;
+    using newton_t = yadq::quaternionU<double, yadq::normalise_fast<yadq::norm_strategy::newton>>;
+    using pade_t = yadq::quaternionU<double, yadq::normalise_fast<yadq::norm_strategy::pade>>;
+    using eager_float_t = yadq::quaternionU<float, yadq::normalise_eager>;
+    using newton_float_t = yadq::quaternionU<float, yadq::normalise_fast<yadq::norm_strategy::newton>>;
+    using pade_float_t = yadq::quaternionU<float, yadq::normalise_fast<yadq::norm_strategy::pade>>;
+}
+
+BENCHMARK_TEMPLATE(BM_CompositionChain, eager_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_CompositionChain, lazy_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_CompositionChain, periodic_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_CompositionChain, newton_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_CompositionChain, pade_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_CompositionChain, eager_float_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_CompositionChain, newton_float_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_CompositionChain, pade_float_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_PassByValue, eager_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_PassByValue, lazy_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_PassByValue, periodic_t)->Arg(1 << 16);
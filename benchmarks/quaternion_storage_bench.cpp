@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstring>
+#include <vector>
+#include <yadq/quaternion.hpp>
+
+namespace {
+
+    /**
+    * \class legacy_quaternion
+    * \brief Replica of the former quaternion storage (array plus reference members and a user-written copy
+    * constructor), kept only as the baseline the current layout is measured against.
+    */
+    template<typename _T>
+    class legacy_quaternion{
+        protected:
+            std::array<_T, 4> data_;
+            _T& w_{data_[0]};
+            _T& x_{data_[1]};
+            _T& y_{data_[2]};
+            _T& z_{data_[3]};
+        public:
+            legacy_quaternion(): data_{1, 0, 0, 0} {}
+            legacy_quaternion(_T w, _T x, _T y, _T z): data_{w, x, y, z} {}
+            legacy_quaternion(const legacy_quaternion& q_in): data_(q_in.data_) {}
+            legacy_quaternion& operator=(const legacy_quaternion& q_in){
+                data_ = q_in.data_;
+                return (*this);
+            }
+            inline auto w() const noexcept{ return w_; }
+            inline auto x() const noexcept{ return x_; }
+            inline auto y() const noexcept{ return y_; }
+            inline auto z() const noexcept{ return z_; }
+    };
+
+    template<typename Q>
+    std::vector<Q> make_quaternions(std::size_t n){
+        std::vector<Q> v;
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(1.0, 0.001 * i, 0.002 * i, 0.003 * i);
+        }
+        return v;
+    }
+
+    template<typename Q>
+    void BM_VectorGrowth(benchmark::State& state){
+        const auto n = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state){
+            std::vector<Q> v;
+            for (std::size_t i = 0; i < n; ++i){
+                v.emplace_back(1.0, 0.0, 0.0, 0.0);
+            }
+            benchmark::DoNotOptimize(v.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["bytes_per_element"] = sizeof(Q);
+    }
+
+    template<typename Q>
+    void BM_VectorCopy(benchmark::State& state){
+        const auto src = make_quaternions<Q>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state){
+            std::vector<Q> dst(src);
+            benchmark::DoNotOptimize(dst.data());
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(Q));
+    }
+
+    void BM_Memcpy(benchmark::State& state){
+        const auto src = make_quaternions<yadq::quaterniond>(static_cast<std::size_t>(state.range(0)));
+        std::vector<yadq::quaterniond> dst(src.size());
+        for (auto _ : state){
+            std::memcpy(dst.data(), src.data(), src.size() * sizeof(yadq::quaterniond));
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(yadq::quaterniond));
+    }
+
+    template<typename Q>
+    void BM_StreamingReduce(benchmark::State& state){
+        const auto v = make_quaternions<Q>(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state){
+            double acc = 0;
+            for (const auto& q : v){
+                acc += q.w() + q.x() + q.y() + q.z();
+            }
+            benchmark::DoNotOptimize(acc);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.counters["footprint_bytes"] = static_cast<double>(v.size() * sizeof(Q));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_VectorGrowth, legacy_quaternion<double>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_VectorGrowth, yadq::quaterniond)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_VectorCopy, legacy_quaternion<double>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_VectorCopy, yadq::quaterniond)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Memcpy)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_StreamingReduce, legacy_quaternion<double>)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(BM_StreamingReduce, yadq::quaterniond)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/rotation_batch.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::array_size;
+    using yadq_bench::random_quaternions;
+
+    template<typename T>
+    void BM_QuatToRotationScalar(benchmark::State& state){
+        const auto q = random_quaternions<yadq::quaternionU<T>>(array_size);
+        std::vector<T> m(9 * array_size);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < q.size(); ++i){
+                const auto R = quatToRotation(q[i]);
+                std::copy(R.begin(), R.end(), m.begin() + 9 * i);
+            }
+            benchmark::DoNotOptimize(m.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T, yadq::matrix_shape S, yadq::matrix_order O>
+    void BM_QuatToRotationBatch(benchmark::State& state){
+        const auto q = random_quaternions<yadq::quaternionU<T>>(array_size);
+        const yadq::quaternion_batch<T> batch(q.begin(), q.end());
+        std::vector<T> m(16 * array_size);
+        for (auto _ : state){
+            quatToRotation(batch, m.data(), S, O);
+            benchmark::DoNotOptimize(m.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+        state.SetLabel(yadq::simd::isa_name());
+    }
+
+    template<typename T>
+    void BM_RotationToQuatScalar(benchmark::State& state){
+        const auto q = random_quaternions<yadq::quaternionU<T>>(array_size);
+        std::vector<std::array<T, 9>> m;
+        for (const auto& qi : q){
+            m.push_back(quatToRotation(qi));
+        }
+        std::vector<yadq::quaternionU<T>> res(array_size);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < m.size(); ++i){
+                res[i] = yadq::rotationToQuat(m[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T, yadq::matrix_shape S, yadq::matrix_order O>
+    void BM_RotationToQuatBatch(benchmark::State& state){
+        const auto q = random_quaternions<yadq::quaternionU<T>>(array_size);
+        const yadq::quaternion_batch<T> batch(q.begin(), q.end());
+        std::vector<T> m(16 * array_size);
+        quatToRotation(batch, m.data(), S, O);
+        yadq::quaternion_batch<T> res(array_size);
+        for (auto _ : state){
+            rotationToQuat(m.data(), res, S, O);
+            benchmark::DoNotOptimize(res.w());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+        state.SetLabel(yadq::simd::isa_name());
+    }
+}
+
+using yadq::matrix_shape;
+using yadq::matrix_order;
+
+BENCHMARK_TEMPLATE(BM_QuatToRotationScalar, float);
+BENCHMARK_TEMPLATE(BM_QuatToRotationScalar, double);
+BENCHMARK_TEMPLATE(BM_QuatToRotationBatch, float, matrix_shape::mat3x3, matrix_order::row_major);
+BENCHMARK_TEMPLATE(BM_QuatToRotationBatch, double, matrix_shape::mat3x3, matrix_order::row_major);
+BENCHMARK_TEMPLATE(BM_QuatToRotationBatch, float, matrix_shape::mat4x4, matrix_order::column_major);
+BENCHMARK_TEMPLATE(BM_QuatToRotationBatch, double, matrix_shape::mat4x4, matrix_order::column_major);
+BENCHMARK_TEMPLATE(BM_RotationToQuatScalar, float);
+BENCHMARK_TEMPLATE(BM_RotationToQuatScalar, double);
+BENCHMARK_TEMPLATE(BM_RotationToQuatBatch, float, matrix_shape::mat3x3, matrix_order::row_major);
+BENCHMARK_TEMPLATE(BM_RotationToQuatBatch, double, matrix_shape::mat3x3, matrix_order::row_major);
+BENCHMARK_TEMPLATE(BM_RotationToQuatBatch, float, matrix_shape::mat4x4, matrix_order::column_major);
+BENCHMARK_TEMPLATE(BM_RotationToQuatBatch, double, matrix_shape::mat4x4, matrix_order::column_major);
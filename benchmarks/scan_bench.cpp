@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/scan.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::random_quaternions;
+
+    constexpr std::size_t chain_size = 1 << 20;
+
+    const int max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    template<typename Q>
+    void BM_ScanSerialLoop(benchmark::State& state){
+        const auto q = random_quaternions<Q>(chain_size);
+        std::vector<Q> res(q.size());
+        for (auto _ : state){
+            Q acc;
+            for (std::size_t i = 0; i < q.size(); ++i){
+                acc *= q[i];
+                res[i] = acc;
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * chain_size);
+    }
+
+    // Scaling from 1 to N threads, state.range(0) being the thread count
+    template<typename Q>
+    void BM_ScanInclusive(benchmark::State& state){
+        const auto q = random_quaternions<Q>(chain_size);
+        std::vector<Q> res(q.size());
+        const yadq::scan_config config{{static_cast<unsigned>(state.range(0))}, 0};
+        for (auto _ : state){
+            yadq::inclusive_product_scan(q.data(), res.data(), q.size(), config);
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * chain_size);
+    }
+
+    template<typename T>
+    void BM_ScanDualQuaternion(benchmark::State& state){
+        const auto r = random_quaternions<yadq::quaternionU<T>>(chain_size);
+        std::vector<yadq::dualquaternion<T>> dq;
+        dq.reserve(chain_size);
+        for (const auto& ri : r){
+            dq.emplace_back(ri, std::array<T, 3>{ri.x(), ri.y(), ri.z()});
+        }
+        std::vector<yadq::dualquaternion<T>> res(dq.size());
+        const yadq::scan_config config{{static_cast<unsigned>(state.range(0))}, 1024};
+        for (auto _ : state){
+            yadq::inclusive_product_scan(dq.data(), res.data(), dq.size(), config);
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * chain_size);
+    }
+
+    void thread_counts(benchmark::internal::Benchmark* b){
+        for (int t = 1; t < max_threads; t *= 2){
+            b->Arg(t);
+        }
+        b->Arg(max_threads);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ScanSerialLoop, yadq::quaternionU<float>);
+BENCHMARK_TEMPLATE(BM_ScanSerialLoop, yadq::quaternionU<double>);
+BENCHMARK_TEMPLATE(BM_ScanInclusive, yadq::quaternionU<float>)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ScanInclusive, yadq::quaternionU<double>)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ScanInclusive, yadq::quaternionU<double, yadq::normalise_periodic<16>>)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ScanDualQuaternion, float)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ScanDualQuaternion, double)->Apply(thread_counts)->UseRealTime();
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/slerp.hpp>
+#include <yadq/sclerp.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::array_size;
+
+    template<typename T>
+    struct segment{
+        yadq::dualquaternion<T> start{yadq::quaternionU<T>(T(0.3), T(-0.2), T(0.9), T(0.4)), std::array<T, 3>{T(1.5), -2, T(0.25)}};
+        yadq::dualquaternion<T> end{yadq::quaternionU<T>(T(0.25), T(-0.1), T(0.95), T(0.45)), std::array<T, 3>{T(1.7), T(-1.8), T(0.3)}};
+        std::vector<T> t;
+
+        segment(): t(array_size){
+            for (std::size_t i = 0; i < t.size(); ++i){
+                t[i] = static_cast<T>(i) / static_cast<T>(t.size() - 1);
+            }
+        }
+    };
+
+    // Rotation and translation interpolated separately and recombined: not a screw path
+    template<typename T>
+    void BM_SegmentSplit(benchmark::State& state){
+        const segment<T> s;
+        const yadq::slerp_plan<T> rotation(s.start.qr_, s.end.qr_);
+        const auto p0 = s.start.translation();
+        const auto p1 = s.end.translation();
+        std::vector<yadq::dualquaternion<T>> out(s.t.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < s.t.size(); ++i){
+                const T u = s.t[i];
+                out[i] = yadq::dualquaternion<T>(rotation(u), std::array<T, 3>{ p0[0] + u * (p1[0] - p0[0]),
+                                                                                p0[1] + u * (p1[1] - p0[1]),
+                                                                                p0[2] + u * (p1[2] - p0[2])});
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    // sclerp() from scratch at every sample: log, scaled twist, exp
+    template<typename T>
+    void BM_SegmentSclerp(benchmark::State& state){
+        const segment<T> s;
+        std::vector<yadq::dualquaternion<T>> out(s.t.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < s.t.size(); ++i){
+                out[i] = yadq::sclerp(s.start, s.end, s.t[i]);
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    // Screw decomposed once, batch evaluation
+    template<typename T, yadq::sclerp_mode M>
+    void BM_SegmentPlan(benchmark::State& state){
+        const segment<T> s;
+        const yadq::sclerp_plan<T> plan(s.start, s.end, M);
+        std::vector<yadq::dualquaternion<T>> out(s.t.size());
+        for (auto _ : state){
+            plan.evaluate(s.t.data(), out.data(), s.t.size());
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_SegmentSplit, float);
+BENCHMARK_TEMPLATE(BM_SegmentSplit, double);
+BENCHMARK_TEMPLATE(BM_SegmentSclerp, float);
+BENCHMARK_TEMPLATE(BM_SegmentSclerp, double);
+BENCHMARK_TEMPLATE(BM_SegmentPlan, float, yadq::sclerp_mode::exact);
+BENCHMARK_TEMPLATE(BM_SegmentPlan, double, yadq::sclerp_mode::exact);
+BENCHMARK_TEMPLATE(BM_SegmentPlan, float, yadq::sclerp_mode::dlb);
+BENCHMARK_TEMPLATE(BM_SegmentPlan, double, yadq::sclerp_mode::dlb);
@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/skinning.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::random_quaternions;
+
+    constexpr std::size_t mesh_size = 1 << 20;
+    constexpr std::size_t palette_size = 64;
+
+    const int max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    template<typename T, std::size_t K>
+    struct mesh{
+        std::vector<yadq::dualquaternion<T>> palette;
+        std::vector<std::uint32_t> bones;
+        std::vector<T> weights;
+        std::vector<T> x, y, z, nx, ny, nz;
+
+        mesh(): bones(K * mesh_size), weights(K * mesh_size, T(1) / K),
+                x(mesh_size), y(mesh_size), z(mesh_size), nx(mesh_size), ny(mesh_size), nz(mesh_size){
+
+            const auto r = random_quaternions<yadq::quaternionU<T>>(palette_size, 1);
+            for (const auto& ri : r){
+                palette.emplace_back(ri, std::array<T, 3>{ri.x(), ri.y(), ri.z()});
+            }
+
+            std::mt19937 gen(3);
+            std::uniform_int_distribution<std::uint32_t> bdist(0, palette_size - 1);
+            for (auto& b : bones){
+                b = bdist(gen);
+            }
+
+            const auto p = random_quaternions<yadq::quaternion<T>>(mesh_size, 5);
+            for (std::size_t i = 0; i < mesh_size; ++i){
+                x[i] = nx[i] = p[i].x();
+                y[i] = ny[i] = p[i].y();
+                z[i] = nz[i] = p[i].z();
+            }
+        }
+    };
+
+    // Per-vertex blend with the dual quaternion operators, as a baseline
+    template<typename T>
+    void BM_SkinScalar(benchmark::State& state){
+        const mesh<T, 4> m;
+        std::vector<T> ox(mesh_size), oy(mesh_size), oz(mesh_size);
+        for (auto _ : state){
+            for (std::size_t i = 0; i < mesh_size; ++i){
+                const auto& pivot = m.palette[m.bones[4 * i]];
+                yadq::dualquaternion<T> b(pivot.qr_ * m.weights[4 * i], pivot.qd_ * m.weights[4 * i]);
+                for (std::size_t k = 1; k < 4; ++k){
+                    const auto& dq = m.palette[m.bones[4 * i + k]];
+                    const T d = pivot.qr_.w() * dq.qr_.w() + pivot.qr_.x() * dq.qr_.x() + pivot.qr_.y() * dq.qr_.y() + pivot.qr_.z() * dq.qr_.z();
+                    const T w = (d < 0 ? -1 : 1) * m.weights[4 * i + k];
+                    b = b + yadq::dualquaternion<T>(dq.qr_ * w, dq.qd_ * w);
+                }
+                const auto p = yadq::transform(normalise(b), std::array<T, 3>{m.x[i], m.y[i], m.z[i]});
+                ox[i] = p[0];
+                oy[i] = p[1];
+                oz[i] = p[2];
+            }
+            benchmark::DoNotOptimize(ox.data());
+        }
+        state.SetItemsProcessed(state.iterations() * mesh_size);
+    }
+
+    // Scaling from 1 to N threads, state.range(0) being the thread count
+    template<typename T, std::size_t K>
+    void BM_Skin(benchmark::State& state){
+        const mesh<T, K> m;
+        std::vector<T> ox(mesh_size), oy(mesh_size), oz(mesh_size);
+        const yadq::parallel_config config{static_cast<unsigned>(state.range(0))};
+        for (auto _ : state){
+            yadq::skin(m.palette.data(), yadq::bone_influences<T, K>{m.bones.data(), m.weights.data()},
+                       {m.x.data(), m.y.data(), m.z.data()}, {ox.data(), oy.data(), oz.data()}, mesh_size, config);
+            benchmark::DoNotOptimize(ox.data());
+        }
+        state.SetItemsProcessed(state.iterations() * mesh_size);
+    }
+
+    template<typename T>
+    void BM_SkinNormals(benchmark::State& state){
+        const mesh<T, 4> m;
+        std::vector<T> ox(mesh_size), oy(mesh_size), oz(mesh_size), onx(mesh_size), ony(mesh_size), onz(mesh_size);
+        const yadq::parallel_config config{static_cast<unsigned>(state.range(0))};
+        for (auto _ : state){
+            yadq::skin(m.palette.data(), yadq::bone_influences<T, 4>{m.bones.data(), m.weights.data()},
+                       {m.x.data(), m.y.data(), m.z.data()}, {m.nx.data(), m.ny.data(), m.nz.data()},
+                       {ox.data(), oy.data(), oz.data()}, {onx.data(), ony.data(), onz.data()}, mesh_size, config);
+            benchmark::DoNotOptimize(ox.data());
+            benchmark::DoNotOptimize(onx.data());
+        }
+        state.SetItemsProcessed(state.iterations() * mesh_size);
+    }
+
+    void thread_counts(benchmark::internal::Benchmark* b){
+        for (int t = 1; t < max_threads; t *= 2){
+            b->Arg(t);
+        }
+        b->Arg(max_threads);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_SkinScalar, float);
+BENCHMARK_TEMPLATE(BM_SkinScalar, double);
+BENCHMARK_TEMPLATE(BM_Skin, float, 4)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Skin, double, 4)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Skin, float, 8)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SkinNormals, float)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SkinNormals, double)->Apply(thread_counts)->UseRealTime();
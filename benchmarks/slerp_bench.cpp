@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/slerp.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::array_size;
+    using yadq_bench::random_quaternions;
+
+    template<typename T>
+    std::vector<T> sample_times(std::size_t n){
+        std::vector<T> t(n);
+        for (std::size_t i = 0; i < n; ++i){
+            t[i] = static_cast<T>(i) / static_cast<T>(n - 1);
+        }
+        return t;
+    }
+
+    // Resampling one segment with interpolation(), the angle is recomputed at every sample
+    template<typename T>
+    void BM_SlerpInterpolation(benchmark::State& state){
+        const auto v = random_quaternions<yadq::quaternionU<T>>(2);
+        const auto t = sample_times<T>(array_size);
+        std::vector<yadq::quaternionU<T>> res(t.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < t.size(); ++i){
+                res[i] = interpolation(v[0], v[1], t[i], yadq::InterpType::SLERP);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T, yadq::slerp_mode M>
+    void BM_SlerpPlan(benchmark::State& state){
+        const auto v = random_quaternions<yadq::quaternionU<T>>(2);
+        const auto t = sample_times<T>(array_size);
+        std::vector<yadq::quaternionU<T>> res(t.size());
+        for (auto _ : state){
+            yadq::slerp_plan<T> plan(v[0], v[1], M);
+            plan.evaluate(t.data(), res.data(), t.size());
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename T>
+    void BM_SlerpPlanSetup(benchmark::State& state){
+        const auto v = random_quaternions<yadq::quaternionU<T>>(2);
+        for (auto _ : state){
+            yadq::slerp_plan<T> plan(v[0], v[1]);
+            benchmark::DoNotOptimize(plan);
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_SlerpInterpolation, float);
+BENCHMARK_TEMPLATE(BM_SlerpInterpolation, double);
+BENCHMARK_TEMPLATE(BM_SlerpPlan, float, yadq::slerp_mode::exact);
+BENCHMARK_TEMPLATE(BM_SlerpPlan, double, yadq::slerp_mode::exact);
+BENCHMARK_TEMPLATE(BM_SlerpPlan, float, yadq::slerp_mode::fast);
+BENCHMARK_TEMPLATE(BM_SlerpPlan, double, yadq::slerp_mode::fast);
+BENCHMARK_TEMPLATE(BM_SlerpPlanSetup, float);
+BENCHMARK_TEMPLATE(BM_SlerpPlanSetup, double);
@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/trajectory.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::array_size;
+    using yadq_bench::random_quaternions;
+
+    constexpr std::size_t keyframes = 4096;
+
+    enum class pattern {sequential, random};
+
+    std::vector<double> keyframe_times(){
+        std::vector<double> t(keyframes);
+        for (std::size_t i = 0; i < keyframes; ++i){
+            t[i] = 0.01 * static_cast<double>(i);
+        }
+        return t;
+    }
+
+    // array_size query times over the whole trajectory, sorted (playback, resampling) or shuffled
+    std::vector<double> query_times(pattern p){
+        std::mt19937 gen(1);
+        std::uniform_real_distribution<double> dist(0, 0.01 * (keyframes - 1));
+
+        std::vector<double> t(array_size);
+        for (auto& ti : t){
+            ti = dist(gen);
+        }
+        if (p == pattern::sequential){
+            std::sort(t.begin(), t.end());
+        }
+        return t;
+    }
+
+    template<typename Q>
+    std::vector<Q> keyframe_values();
+
+    template<>
+    std::vector<yadq::quaternionU<float>> keyframe_values(){
+        return random_quaternions<yadq::quaternionU<float>>(keyframes);
+    }
+
+    template<>
+    std::vector<yadq::quaternionU<double>> keyframe_values(){
+        return random_quaternions<yadq::quaternionU<double>>(keyframes);
+    }
+
+    template<>
+    std::vector<yadq::dualquaternion<double>> keyframe_values(){
+        const auto r = random_quaternions<yadq::quaternionU<double>>(keyframes);
+        std::vector<yadq::dualquaternion<double>> dq;
+        for (std::size_t i = 0; i < keyframes; ++i){
+            dq.emplace_back(r[i], std::array<double, 3>{r[i].y(), r[i].z(), r[i].w()});
+        }
+        return dq;
+    }
+
+    // Binary search from scratch and interpolation() at every query, nothing cached
+    template<typename T, pattern P>
+    void BM_TrajectoryBaseline(benchmark::State& state){
+        const auto t = keyframe_times();
+        const auto q = keyframe_values<yadq::quaternionU<T>>();
+        const auto queries = query_times(P);
+        std::vector<yadq::quaternionU<T>> res(queries.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < queries.size(); ++i){
+                const auto it = std::upper_bound(t.begin(), t.end(), queries[i]);
+                const std::size_t k = std::min<std::size_t>(std::max<std::ptrdiff_t>(it - t.begin(), 1), keyframes - 1) - 1;
+                const double u = (queries[i] - t[k]) / (t[k + 1] - t[k]);
+                res[i] = interpolation(q[k], q[k + 1], u, yadq::InterpType::SLERP);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    // Isolated queries: binary search, cached segment constants
+    template<typename Q, pattern P, yadq::trajectory_interp M>
+    void BM_TrajectoryQuery(benchmark::State& state){
+        const yadq::trajectory<Q> tr(keyframe_times(), keyframe_values<Q>(), M);
+        const auto queries = query_times(P);
+        std::vector<Q> res(queries.size());
+        for (auto _ : state){
+            for (std::size_t i = 0; i < queries.size(); ++i){
+                res[i] = tr(queries[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    // Hint cursor, amortised O(1) search for sorted queries
+    template<typename Q, pattern P, yadq::trajectory_interp M>
+    void BM_TrajectoryCursor(benchmark::State& state){
+        const yadq::trajectory<Q> tr(keyframe_times(), keyframe_values<Q>(), M);
+        const auto queries = query_times(P);
+        std::vector<Q> res(queries.size());
+        for (auto _ : state){
+            auto cursor = tr.make_cursor();
+            for (std::size_t i = 0; i < queries.size(); ++i){
+                res[i] = cursor(queries[i]);
+            }
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename Q, yadq::trajectory_interp M>
+    void BM_TrajectoryBatch(benchmark::State& state){
+        const yadq::trajectory<Q> tr(keyframe_times(), keyframe_values<Q>(), M);
+        const auto queries = query_times(pattern::sequential);
+        std::vector<Q> res(queries.size());
+        for (auto _ : state){
+            tr.evaluate(queries.data(), res.data(), queries.size());
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    // Sorted resampling split across range(0) threads
+    template<typename Q, yadq::trajectory_interp M>
+    void BM_TrajectoryBatchParallel(benchmark::State& state){
+        const yadq::trajectory<Q> tr(keyframe_times(), keyframe_values<Q>(), M);
+        const auto queries = query_times(pattern::sequential);
+        const yadq::parallel_config config{static_cast<unsigned>(state.range(0)), 1 << 12};
+        std::vector<Q> res(queries.size());
+        for (auto _ : state){
+            tr.evaluate(queries.data(), res.data(), queries.size(), config);
+            benchmark::DoNotOptimize(res.data());
+        }
+        state.SetItemsProcessed(state.iterations() * array_size);
+    }
+
+    template<typename Q, yadq::trajectory_interp M>
+    void BM_TrajectoryBuild(benchmark::State& state){
+        const auto t = keyframe_times();
+        const auto v = keyframe_values<Q>();
+        for (auto _ : state){
+            yadq::trajectory<Q> tr(t, v, M);
+            benchmark::DoNotOptimize(tr.values().data());
+        }
+        state.SetItemsProcessed(state.iterations() * keyframes);
+    }
+
+    using yadq::trajectory_interp;
+    using quaternionf = yadq::quaternionU<float>;
+    using quaterniond = yadq::quaternionU<double>;
+    using dualquaterniond = yadq::dualquaternion<double>;
+}
+
+BENCHMARK_TEMPLATE(BM_TrajectoryBaseline, float, pattern::sequential);
+BENCHMARK_TEMPLATE(BM_TrajectoryBaseline, float, pattern::random);
+BENCHMARK_TEMPLATE(BM_TrajectoryBaseline, double, pattern::sequential);
+BENCHMARK_TEMPLATE(BM_TrajectoryBaseline, double, pattern::random);
+
+BENCHMARK_TEMPLATE(BM_TrajectoryQuery, quaternionf, pattern::sequential, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryQuery, quaternionf, pattern::random, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryQuery, quaterniond, pattern::sequential, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryQuery, quaterniond, pattern::random, trajectory_interp::linear);
+
+BENCHMARK_TEMPLATE(BM_TrajectoryCursor, quaternionf, pattern::sequential, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryCursor, quaternionf, pattern::random, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryCursor, quaterniond, pattern::sequential, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryCursor, quaterniond, pattern::random, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryCursor, quaterniond, pattern::sequential, trajectory_interp::smooth);
+BENCHMARK_TEMPLATE(BM_TrajectoryCursor, dualquaterniond, pattern::sequential, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryCursor, dualquaterniond, pattern::random, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryCursor, dualquaterniond, pattern::sequential, trajectory_interp::smooth);
+
+BENCHMARK_TEMPLATE(BM_TrajectoryBatch, quaternionf, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryBatch, quaterniond, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryBatch, dualquaterniond, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryBatchParallel, dualquaterniond, trajectory_interp::linear)->Arg(1)->Arg(4)->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_TrajectoryBuild, quaterniond, trajectory_interp::linear);
+BENCHMARK_TEMPLATE(BM_TrajectoryBuild, quaterniond, trajectory_interp::smooth);
+BENCHMARK_TEMPLATE(BM_TrajectoryBuild, dualquaterniond, trajectory_interp::linear);
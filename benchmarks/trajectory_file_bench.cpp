@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/trajectory_file.hpp>
+#include "bench_utils.hpp"
+
+namespace {
+
+    using yadq_bench::random_quaternions;
+
+    using pose = yadq::dualquaternion<double>;
+
+    constexpr std::size_t log_size = 1 << 20;
+
+    const std::string log_path = "yadq_bench_log.traj";
+
+    // Written once, shared by the read benchmarks, and removed at exit
+    struct bench_log{
+        std::vector<yadq::trajectory_record<pose>> records;
+
+        bench_log(){
+            const auto r = random_quaternions<yadq::quaternionU<double>>(log_size, 1);
+            records.reserve(log_size);
+
+            yadq::trajectory_appender<pose> out(log_path);
+            for (std::size_t i = 0; i < log_size; ++i){
+                records.push_back({1e-3 * i, pose(r[i], std::array<double, 3>{r[i].x(), r[i].y(), r[i].z()})});
+                out.append(records.back().timestamp, records.back().value);
+            }
+        }
+
+        ~bench_log(){
+            std::remove(log_path.c_str());
+        }
+    };
+
+    const std::vector<yadq::trajectory_record<pose>>& make_log(){
+        static const bench_log log;
+        return log.records;
+    }
+
+    // Sum of the record fields a pose consumer typically touches
+    template<typename It>
+    double touch(It first, It last){
+        double acc = 0;
+        for (; first != last; ++first){
+            acc += first->timestamp + first->value.qr_.w() + first->value.qd_.z();
+        }
+        return acc;
+    }
+
+    void BM_TrajectoryOpen(benchmark::State& state){
+        make_log();
+        for (auto _ : state){
+            yadq::trajectory_reader<pose> in(log_path);
+            benchmark::DoNotOptimize(in.data());
+        }
+    }
+
+    void BM_TrajectoryIterateVector(benchmark::State& state){
+        const auto& v = make_log();
+        for (auto _ : state){
+            benchmark::DoNotOptimize(touch(v.begin(), v.end()));
+        }
+        state.SetItemsProcessed(state.iterations() * log_size);
+        state.SetBytesProcessed(state.iterations() * log_size * sizeof(yadq::trajectory_record<pose>));
+    }
+
+    void BM_TrajectoryIterateMapped(benchmark::State& state){
+        make_log();
+        const yadq::trajectory_reader<pose> in(log_path, yadq::access_pattern::sequential);
+        for (auto _ : state){
+            benchmark::DoNotOptimize(touch(in.begin(), in.end()));
+        }
+        state.SetItemsProcessed(state.iterations() * log_size);
+        state.SetBytesProcessed(state.iterations() * log_size * sizeof(yadq::trajectory_record<pose>));
+    }
+
+    void BM_TrajectoryAppend(benchmark::State& state){
+        const auto& v = make_log();
+        const std::string path = "yadq_bench_append.traj";
+        for (auto _ : state){
+            yadq::trajectory_appender<pose> out(path);
+            for (const auto& r : v){
+                out.append(r.timestamp, r.value);
+            }
+        }
+        std::remove(path.c_str());
+        state.SetItemsProcessed(state.iterations() * log_size);
+        state.SetBytesProcessed(state.iterations() * log_size * sizeof(yadq::trajectory_record<pose>));
+    }
+}
+
+BENCHMARK(BM_TrajectoryOpen);
+BENCHMARK(BM_TrajectoryIterateVector);
+BENCHMARK(BM_TrajectoryIterateMapped);
+BENCHMARK(BM_TrajectoryAppend)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,266 @@
+#ifndef ALIGNMENT_HPP
+#define ALIGNMENT_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/point_cloud.hpp>
+#include <yadq/parallel.hpp>
+#include <yadq/mean.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Alignment ------------------------------
+
+        Least-squares registration of two sets of paired points, target_i ~ s R source_i + t (Horn 1987, Umeyama
+        1991). R is the dominant eigenvector of Horn's symmetric 4x4 matrix, built from the centred
+        cross-covariance sum_i (source_i - mean_s) (target_i - mean_t)^T; the optional scale s and the translation t
+        follow in closed form.
+
+        The cross-covariance is accumulated in one streaming pass, in double whatever T. Every chunk of the input
+        is summed relative to its own first pair and turned into centred moments, and chunks are merged with the
+        pairwise update of Chan et al.: no point is copied, and large coordinate offsets (e.g. UTM positions) do not
+        cancel out the spread of the points.
+
+        Pose sets are aligned on their positions. Errors after alignment are reported as the absolute trajectory
+        error (ATE, distances between the aligned source and the target) and the relative pose error (RPE,
+        difference of the motions over a fixed number of poses). A rigid alignment leaves the motions unchanged;
+        a similarity scales their translations, so the RPE of a similarity-aligned source takes the alignment.
+
+        Empty inputs and degenerate similarity problems throw std::invalid_argument.
+    */
+
+    /**
+    * \brief Transformations estimated by align
+    * rigid: rotation and translation, s = 1
+    * similarity: rotation, translation and uniform scale, e.g. for monocular trajectories
+    */
+    enum class alignment_model {rigid, similarity};
+
+    /**
+    * \struct alignment_result
+    * \brief Transformation mapping the source onto the target, target ~ scale * rotation(source) + translation
+    */
+    template<typename _T>
+    struct alignment_result{
+        quaternionU<_T> rotation;
+        std::array<_T, 3> translation{0, 0, 0};
+        _T scale = 1;
+        /**
+         * Root mean square distance between the aligned source and the target, from the moments: free, but only
+         * accurate to about sqrt(epsilon) times the spread of the points. absolute_trajectory_error is exact.
+         */
+        double rmse = 0;
+
+        /**
+         * \brief Map a source point onto the target frame
+         */
+        std::array<_T, 3> apply(const std::array<_T, 3>& p) const noexcept;
+        /**
+         * \brief Rigid part of the transformation, ignoring the scale
+         */
+        dualquaternion<_T> pose() const noexcept{
+            return dualquaternion<_T>(rotation, translation);
+        }
+    };
+
+    /**
+    * \struct error_stats
+    * \brief Statistics of a set of non-negative errors
+    */
+    struct error_stats{
+        double rmse = 0;
+        double mean = 0;
+        double max = 0;
+        std::size_t count = 0;
+    };
+
+    /**
+    * \struct relative_error
+    * \brief Relative pose error: norms of the translation errors and angles (radians) of the rotation errors
+    */
+    struct relative_error{
+        error_stats translation;
+        error_stats rotation;
+    };
+
+    namespace detail {
+
+        /**
+        * \struct centred_moments
+        * \brief Count, means, centred cross-covariance (row-major, cross[3 j + k] = sum_i s'_ij t'_ik) and
+        * centred sums of squares of a set of pairs
+        */
+        struct centred_moments{
+            double n = 0;
+            std::array<double, 3> mean_s{};
+            std::array<double, 3> mean_t{};
+            std::array<double, 9> cross{};
+            double var_s = 0;
+            double var_t = 0;
+
+            /**
+             * \brief Moments of the union of both sets
+             */
+            void merge(const centred_moments& other) noexcept;
+        };
+    }
+
+    /**
+    * \class alignment_accumulator
+    * \brief Streaming accumulator of the moments of a set of paired points. Pairs are never stored, and
+    * accumulators of disjoint sets merge.
+    */
+    template<typename _T>
+    class alignment_accumulator{
+        static_assert(std::is_same_v<_T, float> || std::is_same_v<_T, double>, "This class only supports floating point types");
+        public:
+            using value_type = _T;
+
+            /**
+             * \brief Add a pair
+             * \param source point to move
+             * \param target matching point
+             */
+            void add(const std::array<_T, 3>& source, const std::array<_T, 3>& target) noexcept;
+            /**
+             * \brief Add n pairs stored as separate coordinate arrays, with SIMD
+             * \param source source points
+             * \param target target points
+             * \param n number of pairs
+             * \param config threading settings
+             */
+            void add(point_lanes<const _T> source, point_lanes<const _T> target, std::size_t n, const parallel_config& config = {});
+            /**
+             * \brief Add the positions of n pairs of poses
+             * \param source poses to move
+             * \param target matching poses
+             * \param n number of pairs
+             * \param config threading settings
+             */
+            void add(const dualquaternion<_T>* source, const dualquaternion<_T>* target, std::size_t n, const parallel_config& config = {});
+            /**
+             * \brief Add the pairs of another accumulator
+             */
+            alignment_accumulator& merge(const alignment_accumulator& other) noexcept;
+
+            alignment_accumulator& operator+=(const alignment_accumulator& other) noexcept{
+                return merge(other);
+            }
+            /**
+             * \brief Remove every pair
+             */
+            void clear() noexcept{
+                *this = alignment_accumulator();
+            }
+            /**
+             * \brief Number of pairs added
+             */
+            inline std::size_t count() const noexcept{
+                return count_;
+            }
+            /**
+             * \brief Centred moments of the pairs added so far
+             */
+            inline const detail::centred_moments& moments() const noexcept{
+                return moments_;
+            }
+            /**
+             * \brief Optimal transformation of the pairs added so far
+             * \param model whether to estimate a scale
+             */
+            alignment_result<_T> solve(alignment_model model = alignment_model::rigid) const;
+
+        private:
+            detail::centred_moments moments_;
+            std::size_t count_{0};
+    };
+
+    /**
+     * \brief Align n source points on n target points, stored as separate coordinate arrays
+     * \param source points to move
+     * \param target matching points
+     * \param n number of pairs
+     * \param model whether to estimate a scale
+     * \param config threading settings
+     */
+    template<typename T>
+    alignment_result<T> align(  detail::non_deduced_t<point_lanes<const T>> source, detail::non_deduced_t<point_lanes<const T>> target, std::size_t n,
+                                alignment_model model = alignment_model::rigid, const parallel_config& config = {});
+
+    /**
+     * \brief Align the positions of n source poses on n target poses, e.g. an estimated trajectory on the ground
+     * truth sampled at the same times
+     * \param source poses to move
+     * \param target matching poses
+     * \param n number of pairs
+     * \param model whether to estimate a scale
+     * \param config threading settings
+     */
+    template<typename T>
+    alignment_result<T> align(  const dualquaternion<T>* source, const dualquaternion<T>* target, std::size_t n,
+                                alignment_model model = alignment_model::rigid, const parallel_config& config = {});
+
+    /**
+     * \brief Absolute trajectory error: distances between the aligned source points and the target points
+     * \param alignment transformation applied to the source
+     * \param source source points
+     * \param target matching points
+     * \param n number of pairs
+     * \param config threading settings
+     */
+    template<typename T>
+    error_stats absolute_trajectory_error(  const alignment_result<T>& alignment,
+                                            detail::non_deduced_t<point_lanes<const T>> source, detail::non_deduced_t<point_lanes<const T>> target, std::size_t n,
+                                            const parallel_config& config = {});
+
+    /**
+     * \brief Absolute trajectory error: distances between the aligned source positions and the target positions
+     * \param alignment transformation applied to the source
+     * \param source source poses
+     * \param target matching poses
+     * \param n number of pairs
+     * \param config threading settings
+     */
+    template<typename T>
+    error_stats absolute_trajectory_error(  const alignment_result<T>& alignment,
+                                            const detail::non_deduced_t<dualquaternion<T>>* source, const detail::non_deduced_t<dualquaternion<T>>* target, std::size_t n,
+                                            const parallel_config& config = {});
+
+    /**
+     * \brief Relative pose error over delta poses: for every i, the difference between the target motion
+     * target_i^-1 target_i+delta and the source motion source_i^-1 source_i+delta. Throws std::invalid_argument
+     * if delta is zero or not smaller than n.
+     * \param source source poses
+     * \param target matching poses
+     * \param n number of pairs
+     * \param delta distance, in poses, between the ends of each motion
+     * \param config threading settings
+     */
+    template<typename T>
+    relative_error relative_pose_error( const dualquaternion<T>* source, const dualquaternion<T>* target, std::size_t n,
+                                        std::size_t delta = 1, const parallel_config& config = {});
+
+    /**
+     * \brief Relative pose error of a source aligned by alignment: the translations of the source motions are
+     * multiplied by alignment.scale before the comparison, the rotation and translation of the alignment cancel
+     * out. Throws std::invalid_argument if delta is zero or not smaller than n.
+     * \param alignment transformation applied to the source
+     * \param source source poses
+     * \param target matching poses
+     * \param n number of pairs
+     * \param delta distance, in poses, between the ends of each motion
+     * \param config threading settings
+     */
+    template<typename T>
+    relative_error relative_pose_error( const alignment_result<T>& alignment,
+                                        const detail::non_deduced_t<dualquaternion<T>>* source, const detail::non_deduced_t<dualquaternion<T>>* target, std::size_t n,
+                                        std::size_t delta = 1, const parallel_config& config = {});
+}
+
+#include <yadq/impl/alignment.tpp>
+
+#endif
@@ -0,0 +1,284 @@
+#ifndef CODEC_HPP
+#define CODEC_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/simd.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Codecs ------------------------------
+
+        Compact encodings of unitary quaternions. q and -q describe the same rotation, so encodings only preserve
+        the rotation: decode(encode(q)) may be -q. Error bounds are worst-case rotation angles between the input
+        and the decoded quaternion, for unit inputs, on top of the rounding of T (relevant for float inputs of
+        smallest_three_64 only).
+    */
+
+    /**
+    * \struct smallest_three
+    * \brief Smallest-three encoding: the component with the largest magnitude is dropped (its index takes 2 bits)
+    * and made non-negative by flipping the sign of q, the other three lie in [-1/sqrt(2), 1/sqrt(2)] and are
+    * quantised uniformly on _Bits bits each, with an even number of steps so that 0 is exact. The dropped
+    * component is rebuilt as sqrt(1 - a^2 - b^2 - c^2). Bits are packed as [index | a | b | c], c in the least
+    * significant bits.
+    */
+    template<unsigned _Bits, typename _Storage>
+    struct smallest_three{
+        static_assert(3 * _Bits + 2 <= 8 * sizeof(_Storage), "The storage type is too small");
+
+        using storage_type = _Storage;
+
+        /**
+         * Bits per stored component
+         */
+        static constexpr unsigned component_bits = _Bits;
+        /**
+         * Number of quantisation steps over [-1/sqrt(2), 1/sqrt(2)]
+         */
+        static constexpr std::uint64_t levels = (std::uint64_t(1) << _Bits) - 2;
+        /**
+         * Worst-case rotation angle error in radians, 2 sqrt(6) / levels: each component is off by at most half a
+         * step 1 / (sqrt(2) levels), the rebuilt one by at most sqrt(3) times their norm since it is >= 1/2.
+         */
+        static constexpr double max_angle_error = 4.898979485566356 / double(levels);
+
+        /**
+         * \brief Encode a unitary quaternion
+         */
+        template<typename T, typename P>
+        static storage_type encode(const quaternionU<T, P>& q_in) noexcept;
+        /**
+         * \brief Decode into a unitary quaternion
+         */
+        template<typename T>
+        static quaternionU<T> decode(const storage_type& s_in) noexcept;
+    };
+
+    /**
+     * 32 bits: 3 x 10 bits, max error 4.8e-3 rad (0.27 deg)
+     */
+    using smallest_three_32 = smallest_three<10, std::uint32_t>;
+    /**
+     * 48 bits: 3 x 15 bits, max error 1.5e-4 rad (0.0086 deg)
+     */
+    using smallest_three_48 = smallest_three<15, std::array<std::uint16_t, 3>>;
+    /**
+     * 64 bits: 3 x 20 bits, max error 4.7e-6 rad (2.7e-4 deg)
+     */
+    using smallest_three_64 = smallest_three<20, std::uint64_t>;
+
+    /**
+    * \struct half_64
+    * \brief The four components stored as IEEE 754 binary16 (round to nearest even), [w, x, y, z]. Decoding
+    * renormalises. Each component is off by at most 2^-12, the rotation by at most 2^-10 rad (0.056 deg).
+    */
+    struct half_64{
+        using storage_type = std::array<std::uint16_t, 4>;
+
+        static constexpr double max_angle_error = 9.765625e-4;
+
+        /**
+         * \brief Encode a unitary quaternion
+         */
+        template<typename T, typename P>
+        static storage_type encode(const quaternionU<T, P>& q_in) noexcept;
+        /**
+         * \brief Decode into a unitary quaternion
+         */
+        template<typename T>
+        static quaternionU<T> decode(const storage_type& s_in) noexcept;
+    };
+
+    /**
+     * \brief Encode a batch of unitary quaternions
+     * \param q_in unitary quaternions
+     * \param s_out q_in.size() encoded values
+     */
+    template<typename Codec, typename T>
+    void encode(const quaternion_batch<T>& q_in, typename Codec::storage_type* s_out) noexcept;
+
+    template<typename Codec, typename T>
+    std::vector<typename Codec::storage_type> encode(const quaternion_batch<T>& q_in);
+
+    /**
+     * \brief Decode n values into a batch, resized to n
+     * \param s_in encoded values
+     * \param n number of values
+     * \param q_out decoded unitary quaternions
+     */
+    template<typename Codec, typename T>
+    void decode(const typename Codec::storage_type* s_in, std::size_t n, quaternion_batch<T>& q_out);
+
+    /**
+    * \class compressed_trajectory
+    * \brief Sequence of orientations kept encoded with _Codec. Elements are decoded on access, one at a time by
+    * operator[] and iterators, or by ranges through the batch decoder.
+    */
+    template<typename _T, typename _Codec = smallest_three_48>
+    class compressed_trajectory{
+        public:
+            using value_type = quaternionU<_T>;
+            using codec_type = _Codec;
+            using storage_type = typename _Codec::storage_type;
+
+            /**
+            * \class const_iterator
+            * \brief Random access iterator decoding the element it points to on dereference
+            */
+            class const_iterator{
+                public:
+                    using iterator_category = std::random_access_iterator_tag;
+                    using value_type = quaternionU<_T>;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = void;
+                    using reference = value_type;
+
+                    const_iterator() = default;
+                    explicit const_iterator(const storage_type* p): p_(p) {}
+
+                    reference operator*() const noexcept{ return _Codec::template decode<_T>(*p_); }
+                    reference operator[](difference_type i) const noexcept{ return _Codec::template decode<_T>(p_[i]); }
+
+                    const_iterator& operator++() noexcept{ ++p_; return *this; }
+                    const_iterator operator++(int) noexcept{ auto it = *this; ++p_; return it; }
+                    const_iterator& operator--() noexcept{ --p_; return *this; }
+                    const_iterator operator--(int) noexcept{ auto it = *this; --p_; return it; }
+                    const_iterator& operator+=(difference_type i) noexcept{ p_ += i; return *this; }
+                    const_iterator& operator-=(difference_type i) noexcept{ p_ -= i; return *this; }
+
+                    friend const_iterator operator+(const_iterator it, difference_type i) noexcept{ return it += i; }
+                    friend const_iterator operator+(difference_type i, const_iterator it) noexcept{ return it += i; }
+                    friend const_iterator operator-(const_iterator it, difference_type i) noexcept{ return it -= i; }
+                    friend difference_type operator-(const_iterator a, const_iterator b) noexcept{ return a.p_ - b.p_; }
+
+                    friend bool operator==(const_iterator a, const_iterator b) noexcept{ return a.p_ == b.p_; }
+                    friend bool operator!=(const_iterator a, const_iterator b) noexcept{ return a.p_ != b.p_; }
+                    friend bool operator<(const_iterator a, const_iterator b) noexcept{ return a.p_ < b.p_; }
+                    friend bool operator>(const_iterator a, const_iterator b) noexcept{ return a.p_ > b.p_; }
+                    friend bool operator<=(const_iterator a, const_iterator b) noexcept{ return a.p_ <= b.p_; }
+                    friend bool operator>=(const_iterator a, const_iterator b) noexcept{ return a.p_ >= b.p_; }
+
+                private:
+                    const storage_type* p_{nullptr};
+            };
+
+            /**
+             * \brief Empty constructor
+             */
+            compressed_trajectory() = default;
+            /**
+             * \brief Constructor encoding a whole batch
+             * \param q_in unitary quaternions
+             */
+            explicit compressed_trajectory(const quaternion_batch<_T>& q_in): data_(q_in.size()){
+                yadq::encode<_Codec>(q_in, data_.data());
+            }
+            /**
+             * \brief Constructor from a range of quaternionU objects
+             * \param first iterator to the first quaternion
+             * \param last iterator past the last quaternion
+             */
+            template<   typename It,
+                        typename = std::enable_if_t<is_base_of_quaternion_v<typename std::iterator_traits<It>::value_type>>>
+            compressed_trajectory(It first, It last){
+                for (; first != last; ++first){
+                    push_back(*first);
+                }
+            }
+            /**
+             * \brief Number of orientations stored
+             */
+            inline std::size_t size() const noexcept{
+                return data_.size();
+            }
+            /**
+             * \brief Check if the trajectory is empty
+             */
+            inline bool empty() const noexcept{
+                return data_.empty();
+            }
+            /**
+             * \brief Size of the encoded data in bytes
+             */
+            inline std::size_t bytes() const noexcept{
+                return data_.size() * sizeof(storage_type);
+            }
+            /**
+             * \brief Encoded data, size() values
+             */
+            inline const storage_type* data() const noexcept{
+                return data_.data();
+            }
+            /**
+             * \brief Reserve storage for n orientations
+             */
+            void reserve(std::size_t n){
+                data_.reserve(n);
+            }
+            /**
+             * \brief Remove every orientation
+             */
+            void clear() noexcept{
+                data_.clear();
+            }
+            /**
+             * \brief Encode and append an orientation
+             * \param q_in unitary quaternion
+             */
+            template<typename P>
+            void push_back(const quaternionU<_T, P>& q_in){
+                data_.push_back(_Codec::encode(q_in));
+            }
+            /**
+             * \brief Decode the i-th orientation
+             */
+            inline value_type operator[](std::size_t i) const noexcept{
+                return _Codec::template decode<_T>(data_[i]);
+            }
+            /**
+             * \brief Decode the i-th orientation, with bounds checking
+             */
+            value_type at(std::size_t i) const{
+                if (i >= data_.size()){
+                    throw std::out_of_range("compressed_trajectory index out of range");
+                }
+                return (*this)[i];
+            }
+            /**
+             * \brief Decode count orientations starting at first into a batch, resized to count
+             */
+            void decode(std::size_t first, std::size_t count, quaternion_batch<_T>& q_out) const{
+                if (first > data_.size() || count > data_.size() - first){
+                    throw std::out_of_range("compressed_trajectory range out of range");
+                }
+                yadq::decode<_Codec>(data_.data() + first, count, q_out);
+            }
+            /**
+             * \brief Decode the whole trajectory into a batch
+             */
+            quaternion_batch<_T> decode() const{
+                quaternion_batch<_T> q_out;
+                decode(0, data_.size(), q_out);
+                return q_out;
+            }
+
+            const_iterator begin() const noexcept{ return const_iterator(data_.data()); }
+            const_iterator end() const noexcept{ return const_iterator(data_.data() + data_.size()); }
+
+        private:
+            std::vector<storage_type> data_;
+    };
+}
+
+#include <yadq/impl/codec.tpp>
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef CONSTEXPR_MATH_HPP
+#define CONSTEXPR_MATH_HPP
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+/*
+    YADQ_IS_CONSTANT_EVALUATED() is true while a constant expression is being evaluated. It maps to
+    std::is_constant_evaluated() in C++20 and to the compiler builtin in C++17 (GCC >= 9, Clang >= 9,
+    MSVC >= 19.25). Without either, YADQ_HAS_CONSTEXPR_MATH is 0 and the math functions always call <cmath>.
+*/
+#if defined(__cpp_lib_is_constant_evaluated)
+    #define YADQ_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+    #define YADQ_HAS_CONSTEXPR_MATH 1
+#elif defined(__has_builtin)
+    #if __has_builtin(__builtin_is_constant_evaluated)
+        #define YADQ_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+        #define YADQ_HAS_CONSTEXPR_MATH 1
+    #endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+    #define YADQ_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+    #define YADQ_HAS_CONSTEXPR_MATH 1
+#endif
+
+#ifndef YADQ_HAS_CONSTEXPR_MATH
+    #define YADQ_IS_CONSTANT_EVALUATED() false
+    #define YADQ_HAS_CONSTEXPR_MATH 0
+#endif
+
+namespace yadq{
+
+    /*
+        Math functions usable in constant expressions. At run time they forward to <cmath>; during constant
+        evaluation they switch to the iterative implementations in detail, computed in double with an absolute error
+        of a few 1e-16 on the ranges used by the library (sin/cos reduce the argument with a double precision
+        2 pi, so the error grows with |x| beyond a few turns).
+    */
+    namespace math{
+
+        namespace detail {
+
+            constexpr double pi = 3.14159265358979323846;
+
+            constexpr double sqrt(double x) noexcept{
+
+                if (x != x || x < 0){
+                    return std::numeric_limits<double>::quiet_NaN();
+                }
+
+                if (x == 0 || x == std::numeric_limits<double>::infinity()){
+                    return x;
+                }
+
+                // Newton from above decreases monotonically, stop as soon as it does not improve
+                double r = x >= 1 ? x : 1;
+
+                while (true){
+                    const double next = 0.5 * (r + x / r);
+
+                    if (next >= r){
+                        return r;
+                    }
+                    r = next;
+                }
+            }
+
+            /**
+             * \brief Reduce x to [-pi, pi]
+             */
+            constexpr double reduce_angle(double x) noexcept{
+
+                const double turns = x / (2 * pi);
+                const double k = static_cast<double>(static_cast<long long>(turns + (turns < 0 ? -0.5 : 0.5)));
+
+                return x - k * (2 * pi);
+            }
+
+            /**
+             * \brief Taylor series of sin on [-pi/2, pi/2], summed until the terms vanish
+             */
+            constexpr double sin_series(double x) noexcept{
+
+                const double x2 = x * x;
+                double term = x;
+                double sum = x;
+
+                for (int n = 1; n < 20; ++n){
+                    term *= -x2 / ((2 * n) * (2 * n + 1));
+                    sum += term;
+                }
+
+                return sum;
+            }
+
+            constexpr double sin(double x) noexcept{
+
+                if (x != x || x == std::numeric_limits<double>::infinity() || x == -std::numeric_limits<double>::infinity()){
+                    return std::numeric_limits<double>::quiet_NaN();
+                }
+
+                x = reduce_angle(x);
+
+                // sin(x) = sin(pi - x) folds [pi/2, pi] onto [0, pi/2]
+                if (x > pi / 2){
+                    x = pi - x;
+                }else if (x < -pi / 2){
+                    x = -pi - x;
+                }
+
+                return sin_series(x);
+            }
+
+            constexpr double cos(double x) noexcept{
+                return sin(x + pi / 2);
+            }
+        }
+
+        /**
+         * \brief Square root, evaluable at compile time
+         */
+        template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+        constexpr T sqrt(T x) noexcept{
+            if (YADQ_IS_CONSTANT_EVALUATED()){
+                return static_cast<T>(detail::sqrt(x));
+            }
+            return std::sqrt(x);
+        }
+
+        /**
+         * \brief Sine, evaluable at compile time
+         */
+        template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+        constexpr T sin(T x) noexcept{
+            if (YADQ_IS_CONSTANT_EVALUATED()){
+                return static_cast<T>(detail::sin(x));
+            }
+            return std::sin(x);
+        }
+
+        /**
+         * \brief Cosine, evaluable at compile time
+         */
+        template<typename T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+        constexpr T cos(T x) noexcept{
+            if (YADQ_IS_CONSTANT_EVALUATED()){
+                return static_cast<T>(detail::cos(x));
+            }
+            return std::cos(x);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef DISPATCH_HPP
+#define DISPATCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/rotation_batch.hpp>
+#include <yadq/point_cloud.hpp>
+#include <yadq/parallel.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Runtime dispatch ------------------------------
+
+        The header-only batch functions use the instruction set of the including translation unit, usually
+        baseline SSE2. The yadq_kernels library compiles the same kernels once per instruction set (scalar, SSE2,
+        SSE4.2, AVX2+FMA, AVX-512) and picks the best one the CPU runs on first use. The functions of this
+        namespace mirror the header-only ones and go through that table; they need yadq_kernels to be linked.
+
+        The environment variable YADQ_ISA (scalar, sse2, sse42, avx2 or avx512) overrides the detected instruction
+        set, e.g. to test the scalar path on an AVX-512 machine. It is ignored if the name is unknown or the
+        instruction set is not available.
+
+        Results match the header-only functions, except that the AVX2+FMA and AVX-512 kernels may fuse
+        multiply-adds: they then differ by a few ULP.
+    */
+
+    namespace dispatch{
+
+        /**
+         * \brief Instruction sets of the kernels, in increasing order
+         */
+        enum class isa {scalar, sse2, sse42, avx2, avx512};
+
+        /**
+         * \brief Name of an instruction set, as accepted by parse and YADQ_ISA
+         */
+        const char* name(isa target) noexcept;
+        /**
+         * \brief Instruction set of a name, none if the name is unknown
+         */
+        std::optional<isa> parse(std::string_view name) noexcept;
+        /**
+         * \brief Whether the kernels of target were built and the CPU runs them
+         */
+        bool supported(isa target) noexcept;
+        /**
+         * \brief Supported instruction sets, in increasing order. scalar is always the first one.
+         */
+        std::vector<isa> available();
+        /**
+         * \brief Best supported instruction set, regardless of YADQ_ISA
+         */
+        isa detected() noexcept;
+        /**
+         * \brief Instruction set the dispatched functions currently use
+         */
+        isa active() noexcept;
+        /**
+         * \brief Switch every dispatched function to target. Returns false, leaving the selection unchanged, if
+         * target is not supported. Calls running concurrently finish with the previous kernels.
+         */
+        bool select(isa target) noexcept;
+
+        namespace detail {
+
+            /**
+            * \struct kernels
+            * \brief Entry points of the batch kernels for one scalar type, as built for one instruction set
+            */
+            template<typename T>
+            struct kernels{
+                void (*multiply)(quaternion_lanes<const T>, quaternion_lanes<const T>, quaternion_lanes<T>, std::size_t) noexcept;
+                void (*normalise)(quaternion_lanes<const T>, quaternion_lanes<T>, std::size_t) noexcept;
+                void (*transform_points)(const std::array<T, 4>&, const std::array<T, 3>&, point_lanes<const T>, point_lanes<T>, std::size_t) noexcept;
+                void (*transform_points_interleaved)(const std::array<T, 4>&, const std::array<T, 3>&, const T*, T*, std::size_t) noexcept;
+                void (*quat_to_matrix)(quaternion_lanes<const T>, T*, std::size_t, const matrix_layout&) noexcept;
+                void (*matrix_to_quat)(const T*, quaternion_lanes<T>, std::size_t, const matrix_layout&) noexcept;
+            };
+
+            /**
+            * \struct kernel_table
+            * \brief Every kernel built for one instruction set
+            */
+            struct kernel_table{
+                isa target;
+                kernels<float> f32;
+                kernels<double> f64;
+            };
+
+            /**
+             * \brief Table of the active instruction set, selected on the first call
+             */
+            const kernel_table& active_table() noexcept;
+
+            template<typename T>
+            const kernels<T>& active_kernels() noexcept{
+                static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "dispatched kernels are built for float and double");
+                if constexpr (std::is_same_v<T, float>){
+                    return active_table().f32;
+                }else{
+                    return active_table().f64;
+                }
+            }
+
+            template<typename T>
+            void transform_points(const std::array<T, 4>& q, const std::array<T, 3>& t, const T* points_in, T* points_out, std::size_t n, const parallel_config& config){
+
+                const auto kernel = active_kernels<T>().transform_points_interleaved;
+
+                yadq::detail::parallel_for(n, config, [&](std::size_t begin, std::size_t end){
+                    kernel(q, t, points_in + 3 * begin, points_out + 3 * begin, end - begin);
+                });
+            }
+
+            template<typename T>
+            void transform_points(const std::array<T, 4>& q, const std::array<T, 3>& t, point_lanes<const T> points_in, point_lanes<T> points_out, std::size_t n, const parallel_config& config){
+
+                const auto kernel = active_kernels<T>().transform_points;
+
+                yadq::detail::parallel_for(n, config, [&](std::size_t begin, std::size_t end){
+                    kernel( q, t,
+                            point_lanes<const T>{points_in.x + begin, points_in.y + begin, points_in.z + begin},
+                            point_lanes<T>{points_out.x + begin, points_out.y + begin, points_out.z + begin},
+                            end - begin);
+                });
+            }
+        }
+
+        /**
+         * \brief Element-wise Hamilton product, as yadq::multiply. res may be one of the inputs.
+         */
+        template<typename T>
+        void multiply(const quaternion_batch<T>& lhv, const quaternion_batch<T>& rhv, quaternion_batch<T>& res){
+
+            yadq::detail::check_same_size(lhv, rhv);
+            res.resize(lhv.size());
+
+            detail::active_kernels<T>().multiply(lhv.lanes(), rhv.lanes(), res.lanes(), lhv.padded_size());
+        }
+
+        /**
+         * \brief Element-wise normalisation, as yadq::normalise. res may be the input.
+         */
+        template<typename T>
+        void normalise(const quaternion_batch<T>& q_in, quaternion_batch<T>& res){
+
+            res.resize(q_in.size());
+
+            detail::active_kernels<T>().normalise(q_in.lanes(), res.lanes(), q_in.padded_size());
+        }
+
+        /**
+         * \brief Rotate n interleaved points, as yadq::rotate. points_out may be points_in.
+         */
+        template<typename T, typename P>
+        void rotate(const quaternionU<T, P>& q_in, const yadq::detail::non_deduced_t<T>* points_in, yadq::detail::non_deduced_t<T>* points_out, std::size_t n, const parallel_config& config = {}){
+
+            detail::transform_points<T>({q_in.w(), q_in.x(), q_in.y(), q_in.z()}, {0, 0, 0}, points_in, points_out, n, config);
+        }
+
+        /**
+         * \brief Rotate n points stored as separate coordinate arrays, as yadq::rotate
+         */
+        template<typename T, typename P>
+        void rotate(const quaternionU<T, P>& q_in, yadq::detail::non_deduced_t<point_lanes<const T>> points_in, yadq::detail::non_deduced_t<point_lanes<T>> points_out, std::size_t n, const parallel_config& config = {}){
+
+            detail::transform_points<T>({q_in.w(), q_in.x(), q_in.y(), q_in.z()}, {0, 0, 0}, points_in, points_out, n, config);
+        }
+
+        /**
+         * \brief Apply a rigid transformation to n interleaved points, as yadq::transform
+         */
+        template<typename T>
+        void transform(const dualquaternion<T>& dq_in, const yadq::detail::non_deduced_t<T>* points_in, yadq::detail::non_deduced_t<T>* points_out, std::size_t n, const parallel_config& config = {}){
+
+            const auto& qr = dq_in.qr_;
+
+            detail::transform_points<T>({qr.w(), qr.x(), qr.y(), qr.z()}, dq_in.translation(), points_in, points_out, n, config);
+        }
+
+        /**
+         * \brief Rotation matrices of a batch of unitary quaternions, as yadq::quatToRotation
+         */
+        template<typename T>
+        void quatToRotation(const quaternion_batch<T>& q_in, T* matrices, matrix_shape shape = matrix_shape::mat3x3, matrix_order order = matrix_order::row_major) noexcept{
+
+            detail::active_kernels<T>().quat_to_matrix(q_in.lanes(), matrices, q_in.size(), matrix_layout::make(shape, order));
+        }
+
+        /**
+         * \brief Unitary quaternions of a buffer of rotation matrices, as yadq::rotationToQuat
+         */
+        template<typename T>
+        void rotationToQuat(const T* matrices, quaternion_batch<T>& q_out, matrix_shape shape = matrix_shape::mat3x3, matrix_order order = matrix_order::row_major) noexcept{
+
+            detail::active_kernels<T>().matrix_to_quat(matrices, q_out.lanes(), q_out.size(), matrix_layout::make(shape, order));
+        }
+    }
+}
+
+#endif
@@ -35,30 +35,31 @@ namespace yadq{
             quaternion<_T> qd_;
 
             /**
-             * \brief Empty constructor
+             * \brief Empty constructor, the identity transformation
              */
-            dualquaternion() = default;
+            constexpr dualquaternion(): qr_(1, 0, 0, 0), qd_(0, 0, 0, 0) {}
             /**
              * \brief Constructor from single components
              * \param qr unitary quaternion component for the rotation
              * \param qd quaternion component for the translation
              */
-            dualquaternion(const quaternionU<_T>& qr, const quaternion<_T>& qd){
-                qr_ = qr;
-                qd_ = qd;
-            }
+            constexpr dualquaternion(const quaternionU<_T>& qr, const quaternion<_T>& qd): qr_(qr), qd_(qd) {}
+            /**
+             * \brief Conversion from a dual quaternion of the other value_type
+             * \param dq_in dual quaternion to convert
+             */
+            template<   typename _U,
+                        typename = std::enable_if_t<!std::is_same_v<_U, _T>>>
+            explicit constexpr dualquaternion(const dualquaternion<_U>& dq_in): qr_(dq_in.qr_), qd_(dq_in.qd_) {}
            /**
              * \brief Constructor from rotation and translation
              * \param qr unitary quaternion representing the rotation of the dual quaternion
              * \param t vector representing the translation of the dual quaternion
              */
-            dualquaternion(const quaternionU<_T>& r, const std::array<_T, 3> t){
-                qr_ = r;
-                quaternion<_T> q_t(0, t[0], t[1], t[2]);
-                qd_ = 0.5 * q_t * r;
-            }
+            constexpr dualquaternion(const quaternionU<_T>& r, const std::array<_T, 3> t): qr_(r), qd_(0.5 * quaternion<_T>(0, t[0], t[1], t[2]) * r) {}
            /**
-             * \brief Rotate the dual quaternion given a rotation as input
+             * \brief Rotate the dual quaternion given a rotation as input, i.e. the product with the pure rotation
+             * (q_rhv, 0)
              * \param q_rhv rotation represented as quaternion
              */
             template< typename T>
@@ -66,64 +67,48 @@ namespace yadq{
                 return dqT( qr_ * q_rhv,
                             qd_ * q_rhv);
             }
-    };
-
-    template<typename T>
-    std::ostream& operator<<(std::ostream &os, const dualquaternion<T>& dq_in) noexcept{ 
-        return os <<    "q [w: " << dq_in.qr_.w() << " x: " << dq_in.qr_.x() << " y: " << dq_in.qr_.y() << " z: " << dq_in.qr_.z() << "]" << std::endl <<
-                        "t [w: " << dq_in.qd_.w() << " x: " << dq_in.qd_.x() << " y: " << dq_in.qd_.y() << " z: " << dq_in.qd_.z() << "]" ;
-    }
-
-
-    template< typename T>
-    constexpr dualquaternion<T> operator*(quaternionU<T> lhv, dualquaternion<T> dq_rhv){
-        return dq_rhv * lhv;
-    }
-
-    template<typename T>
-    constexpr dualquaternion<T> operator*(dualquaternion<T> dq_lhv, const dualquaternion<T>& dq_rhv){
-        
-        dq_lhv.qr_ *= dq_rhv.qr_;
-        dq_lhv.qd_ *= dq_rhv.qd_;
-
-        return dq_lhv;
-    }
-
-    // TODO: [#1] Validate functions
-    template<typename T>
-    constexpr std::array<T, 3> operator*(const dualquaternion<T>& dq_lhv, const std::array<T, 3>& p_rhv){
-        
-        std::array<T, 3> p_new;
-        dualquaternion<T> dq_t (quaternionU<T>(1, 0, 0, 0), p_rhv);
-
-        dualquaternion<T> dq = dq_lhv * dq_t * conjugate(dq_lhv);
-
-        return p_new;
-    }
-
-    template<typename T>
-    constexpr dualquaternion<T> operator+(dualquaternion<T> dq_lhv, const dualquaternion<T>& dq_rhv){
-        
-        dq_lhv.qr_ += dq_rhv.qr_;
-        dq_lhv.qd_ += dq_rhv.qd_;
+            /**
+             * \brief Compose with another dual quaternion
+             * \param dq_in dual quaternion to multiply
+             */
+            constexpr dqT& operator*=(const dqT& dq_in) noexcept{
+                YADQ_TIMED(dual_product, [&](){
+                    qd_ = qr_ * dq_in.qd_ + qd_ * dq_in.qr_;
+                    qr_ *= dq_in.qr_;
+                });
 
-        return dq_lhv;
-    }
-    
-    template<typename T>
-    constexpr dualquaternion<T> conjugate(dualquaternion<T> dq_lhv){
-        
-        dq_lhv.qr_.conjugate();
-        dq_lhv.qd_.conjugate();
-        
-        return dq_lhv;
-    } 
+                return (*this);
+            }
+            /**
+             * \brief Translation encoded by the dual quaternion, t = 2 qd qr*
+             */
+            constexpr std::array<_T, 3> translation() const noexcept{
+                const _T rw = qr_.w(), rx = qr_.x(), ry = qr_.y(), rz = qr_.z();
+                const _T dw = qd_.w(), dx = qd_.x(), dy = qd_.y(), dz = qd_.z();
+
+                // Vector part of qd qr*: rw d_v - dw r_v + r_v x d_v
+                return {    2 * (rw * dx - dw * rx + (ry * dz - rz * dy)),
+                            2 * (rw * dy - dw * ry + (rz * dx - rx * dz)),
+                            2 * (rw * dz - dw * rz + (rx * dy - ry * dx))};
+            }
+            /**
+             * \brief Normalise the dual quaternion: unit real part and dual part orthogonal to it
+             */
+            constexpr void normalise() noexcept{
+                // qr_ is kept unitary by quaternionU, only the dual part has to be projected
+                const _T k = qr_.w() * qd_.w() + qr_.x() * qd_.x() + qr_.y() * qd_.y() + qr_.z() * qd_.z();
+
+                qd_ = quaternion<_T>(   qd_.w() - k * qr_.w(),
+                                        qd_.x() - k * qr_.x(),
+                                        qd_.y() - k * qr_.y(),
+                                        qd_.z() - k * qr_.z());
+            }
+    };
 
-    template<typename T>
-    constexpr dualquaternion<T> norm(const dualquaternion<T>& dq_lhv){
-        
-        return dq_lhv * conjugate(dq_lhv);
-    } 
+    using dualquaternionf = dualquaternion<float>;
+    using dualquaterniond = dualquaternion<double>;
 }
 
+#include <yadq/impl/dual_quaterion.tpp>
+
 #endif
@@ -0,0 +1,212 @@
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include <array>
+#include <type_traits>
+#include <yadq/quaternion.hpp>
+#include <yadq/yadq_type_traits.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Expression templates ------------------------------
+
+        Opt-in lazy evaluation of quaternion expressions. expr(q) wraps a quaternion or quaternionU; the operators
+        +, -, * and conjugate() applied to a wrapped operand build an expression tree instead of a temporary per
+        step, the other operand being a quaternion or another expression. The tree is evaluated in one pass when
+        it is converted to its result type (or by evaluate()):
+
+            const quaternionU<double> r = expr(q1) * q2 * conjugate(q3) + q4;
+
+        Result types follow the eager operators: a product of mixed quaternion / quaternionU is a quaternion,
+        sums and differences take the type of their left operand, products by a scalar are quaternions. A
+        quaternionU result is normalised once, at the end, according to its policy. Intermediate products of
+        unitary operands are not renormalised since normalisation commutes with them; an intermediate unitary
+        sum is still normalised when it is the operand of another sum, difference, scalar product or mixed
+        product, as the eager operators would. Results only differ from the eager chain by rounding.
+
+        Nodes hold their operands by value, so an expression may outlive the quaternions it was built from.
+    */
+
+    /**
+    * \class quaternion_expression
+    * \brief CRTP base of the expression nodes. E provides:
+    * - result_type, the quaternion type the eager operators would return
+    * - exact, true when raw() is the value of the eager result, false when it is only a positive multiple of it
+    *   (unitary results before their normalisation)
+    * - raw(), the [w, x, y, z] components before the final normalisation
+    */
+    template<typename E>
+    class quaternion_expression{
+        public:
+            /**
+             * \brief The derived node
+             */
+            constexpr const E& derived() const noexcept{
+                return static_cast<const E&>(*this);
+            }
+            /**
+             * \brief Evaluate the tree, the only normalisation of a unitary result happening here
+             */
+            constexpr auto eval() const noexcept;
+            /**
+             * \brief Implicit evaluation into the result type
+             */
+            template<typename Q, typename D = E, typename = std::enable_if_t<std::is_same_v<Q, typename D::result_type>>>
+            constexpr operator Q() const noexcept{
+                return eval();
+            }
+    };
+
+    namespace detail {
+
+        /**
+         * \brief Leaf of an expression, a copy of the observed components of a quaternion or quaternionU
+         */
+        template<typename Q>
+        class expr_leaf : public quaternion_expression<expr_leaf<Q>>{
+            public:
+                using result_type = Q;
+                using value_type = typename Q::value_type;
+                static constexpr bool exact = true;
+
+                constexpr explicit expr_leaf(const Q& q_in) noexcept: data_{q_in.w(), q_in.x(), q_in.y(), q_in.z()} {}
+
+                constexpr std::array<value_type, 4> raw() const noexcept{
+                    return data_;
+                }
+
+            private:
+                std::array<value_type, 4> data_;
+        };
+
+        /**
+         * \brief Hamilton product of two expressions
+         */
+        template<typename L, typename R>
+        class expr_product : public quaternion_expression<expr_product<L, R>>{
+            public:
+                using result_type = std::conditional_t< std::is_same_v<typename L::result_type, typename R::result_type>,
+                                                        typename L::result_type, quaternion<typename L::value_type>>;
+                using value_type = typename L::value_type;
+                // A product of unitary quaternions stays a positive multiple of its eager value, other products
+                // take exact operands
+                static constexpr bool exact = !is_quaternionU_v<result_type> || (L::exact && R::exact);
+
+                // Operands are either nodes or quaternions, the latter becoming leaves
+                template<typename A, typename B>
+                constexpr expr_product(const A& lhv, const B& rhv) noexcept: lhv_(lhv), rhv_(rhv) {}
+
+                constexpr std::array<value_type, 4> raw() const noexcept;
+
+            private:
+                L lhv_;
+                R rhv_;
+        };
+
+        /**
+         * \brief Component-wise sum (Sign = 1) or difference (Sign = -1) of two expressions
+         */
+        template<typename L, typename R, int Sign>
+        class expr_sum : public quaternion_expression<expr_sum<L, R, Sign>>{
+            public:
+                using result_type = typename L::result_type;
+                using value_type = typename L::value_type;
+                static constexpr bool exact = !is_quaternionU_v<result_type>;
+
+                // Operands are either nodes or quaternions, the latter becoming leaves
+                template<typename A, typename B>
+                constexpr expr_sum(const A& lhv, const B& rhv) noexcept: lhv_(lhv), rhv_(rhv) {}
+
+                constexpr std::array<value_type, 4> raw() const noexcept;
+
+            private:
+                L lhv_;
+                R rhv_;
+        };
+
+        /**
+         * \brief Conjugate of an expression
+         */
+        template<typename E>
+        class expr_conjugate : public quaternion_expression<expr_conjugate<E>>{
+            public:
+                using result_type = typename E::result_type;
+                using value_type = typename E::value_type;
+                static constexpr bool exact = E::exact;
+
+                constexpr explicit expr_conjugate(const E& e) noexcept: e_(e) {}
+
+                constexpr std::array<value_type, 4> raw() const noexcept{
+                    const auto r = e_.raw();
+                    return {r[0], -r[1], -r[2], -r[3]};
+                }
+
+            private:
+                E e_;
+        };
+
+        /**
+         * \brief Product of an expression by a scalar
+         */
+        template<typename E>
+        class expr_scale : public quaternion_expression<expr_scale<E>>{
+            public:
+                using result_type = quaternion<typename E::value_type>;
+                using value_type = typename E::value_type;
+                static constexpr bool exact = true;
+
+                constexpr expr_scale(const E& e, double s) noexcept: e_(e), s_(s) {}
+
+                constexpr std::array<value_type, 4> raw() const noexcept;
+
+            private:
+                E e_;
+                double s_;
+        };
+    }
+
+    /*
+        ------------------------------ Building expressions ------------------------------
+    */
+
+    /**
+     * \brief Start an expression from a quaternion or quaternionU
+     * \param q_in operand, copied
+     */
+    template<   typename Q,
+                typename = std::enable_if_t<is_quaternion_v<Q> || is_quaternionU_v<Q>>>
+    constexpr auto expr(const Q& q_in) noexcept{
+        return detail::expr_leaf<Q>(q_in);
+    }
+
+    /**
+     * \brief Evaluate an expression
+     */
+    template<typename E>
+    constexpr auto evaluate(const quaternion_expression<E>& e) noexcept{
+        return e.eval();
+    }
+
+    template<typename L, typename R, std::enable_if_t<is_quaternion_expression_operands_v<L, R>, int> = 0>
+    constexpr auto operator*(const L& lhv, const R& rhv) noexcept;
+
+    template<typename L, typename R, std::enable_if_t<is_quaternion_expression_operands_v<L, R>, int> = 0>
+    constexpr auto operator+(const L& lhv, const R& rhv) noexcept;
+
+    template<typename L, typename R, std::enable_if_t<is_quaternion_expression_operands_v<L, R>, int> = 0>
+    constexpr auto operator-(const L& lhv, const R& rhv) noexcept;
+
+    template<typename E>
+    constexpr auto operator*(const quaternion_expression<E>& e, double s) noexcept;
+
+    template<typename E>
+    constexpr auto operator*(double s, const quaternion_expression<E>& e) noexcept;
+
+    template<typename E>
+    constexpr auto conjugate(const quaternion_expression<E>& e) noexcept;
+}
+
+#include <yadq/impl/expression.tpp>
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef FRAME_GRAPH_HPP
+#define FRAME_GRAPH_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <yadq/dual_quaternion.hpp>
+
+namespace yadq{
+
+    /**
+    * \class frame_graph
+    * \brief Tree of coordinate frames (world -> robot -> links -> sensors). Each frame but the root holds the
+    * transform of its parent edge, parent_T_frame, mapping coordinates in the frame to coordinates in its parent.
+    *
+    * The root-to-frame transforms root_T_frame are cached. Changing an edge only marks the subtree below it as
+    * stale; a lookup recomposes the stale part of the path to the root, O(depth) in the worst case and O(1) when
+    * the cache is fresh. The relative transform of two frames costs two cached lookups and one product.
+    *
+    * Lookups and edge updates may be called concurrently from any thread: lookups share a reader lock, updates
+    * take it exclusively, and a lookup meeting a stale frame upgrades to the exclusive lock to refresh it.
+    */
+    template<typename T>
+    class frame_graph{
+        public:
+            using value_type = dualquaternion<T>;
+            using frame_id = std::size_t;
+
+            /**
+             * Id of the root frame
+             */
+            static constexpr frame_id root = 0;
+
+            /**
+             * \brief Constructor, with the root frame only
+             * \param root_name name of the root frame
+             */
+            explicit frame_graph(std::string root_name = "world");
+
+            frame_graph(const frame_graph&) = delete;
+            frame_graph& operator=(const frame_graph&) = delete;
+
+            /**
+             * \brief Add a frame under parent. Throws std::out_of_range if parent is not a frame, and
+             * std::invalid_argument if the name is already used.
+             * \param parent parent frame
+             * \param parent_T_frame transform of the new edge, from the new frame to its parent
+             * \param name optional name, unique among the frames; empty names are not registered
+             * \return id of the new frame, greater than the one of its parent
+             */
+            frame_id add_frame(frame_id parent, const value_type& parent_T_frame, std::string name = "");
+            /**
+             * \brief Change the transform of the edge above frame and mark its subtree as stale. Throws
+             * std::out_of_range if frame is not a frame, std::invalid_argument if it is the root.
+             */
+            void set_transform(frame_id frame, const value_type& parent_T_frame);
+            /**
+             * \brief Change n edges at once, under a single lock
+             * \param frames n frames, the root excluded
+             * \param parent_T_frames n new edge transforms
+             * \param n number of edges
+             */
+            void set_transforms(const frame_id* frames, const value_type* parent_T_frames, std::size_t n);
+            /**
+             * \brief Number of frames, the root included
+             */
+            std::size_t size() const;
+            /**
+             * \brief Parent of frame, the root being its own parent
+             */
+            frame_id parent(frame_id frame) const;
+            /**
+             * \brief Depth of frame, 0 for the root
+             */
+            std::size_t depth(frame_id frame) const;
+            /**
+             * \brief Name of frame, empty if it has none
+             */
+            std::string name(frame_id frame) const;
+            /**
+             * \brief Frame with the given name, if any
+             */
+            std::optional<frame_id> find(const std::string& name) const;
+            /**
+             * \brief Transform of the edge above frame, parent_T_frame; the identity for the root
+             */
+            value_type transform(frame_id frame) const;
+            /**
+             * \brief Transform from frame to the root, root_T_frame
+             */
+            value_type world(frame_id frame) const;
+            /**
+             * \brief Transform from frame b to frame a, a_T_b = (root_T_a)^-1 root_T_b: it maps coordinates in b to
+             * coordinates in a, i.e. it is the pose of b expressed in a
+             */
+            value_type lookup(frame_id a, frame_id b) const;
+            /**
+             * \brief Transforms from n frames to frame a, out[i] = lookup(a, frames[i]), under a single lock
+             * \param a target frame
+             * \param frames n source frames
+             * \param out n output transforms
+             * \param n number of lookups
+             */
+            void lookup(frame_id a, const frame_id* frames, value_type* out, std::size_t n) const;
+            /**
+             * \brief Transforms from every frame of frames to frame a
+             */
+            std::vector<value_type> lookup(frame_id a, const std::vector<frame_id>& frames) const;
+            /**
+             * \brief Recompose every stale cached transform
+             */
+            void refresh();
+
+        private:
+            void check_frame(frame_id frame) const;
+            /**
+             * \brief Mark frame and its subtree as stale. A stale frame only has stale descendants, so the walk
+             * stops at subtrees already stale.
+             */
+            void invalidate(frame_id frame);
+            /**
+             * \brief Recompose the stale frames of the path from frame to the root, exclusive lock held
+             */
+            void refresh_path(frame_id frame) const;
+            /**
+             * \brief Call f() with the cached transforms of a and of the n frames fresh, and the graph locked
+             */
+            template<typename F>
+            auto with_fresh(frame_id a, const frame_id* frames, std::size_t n, F&& f) const;
+            value_type relative(frame_id a, frame_id b) const noexcept;
+
+            mutable std::shared_mutex mutex_;
+            std::vector<frame_id> parents_;
+            std::vector<std::vector<frame_id>> children_;
+            std::vector<std::size_t> depths_;
+            std::vector<value_type> edges_;
+            std::vector<std::string> names_;
+            std::unordered_map<std::string, frame_id> ids_;
+            // Cache of root_T_frame, valid where stale_ is 0
+            mutable std::vector<value_type> worlds_;
+            mutable std::vector<char> stale_;
+            // Work list of invalidate() and refresh_path(), used with the exclusive lock held
+            mutable std::vector<frame_id> scratch_;
+    };
+
+    using frame_graphf = frame_graph<float>;
+    using frame_graphd = frame_graph<double>;
+}
+
+#include <yadq/impl/frame_graph.tpp>
+
+#endif
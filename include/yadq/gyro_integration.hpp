@@ -0,0 +1,138 @@
+#ifndef GYRO_INTEGRATION_HPP
+#define GYRO_INTEGRATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/rotation_map.hpp>
+#include <yadq/point_cloud.hpp>
+#include <yadq/parallel.hpp>
+#include <yadq/simd.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Gyroscope integration ------------------------------
+
+        Orientation q (body to world) driven by the body angular velocity omega, dq/dt = q (0, omega) / 2. One
+        step covers the interval between two rate samples omega0 and omega1, dt apart; the rate is taken linear
+        in between. Every step ends with an exact renormalisation.
+    */
+
+    /**
+    * \brief Integration scheme of one step
+    * exponential: q exp_map(dt (omega0 + omega1) / 2), exact for a rotation about a fixed axis, second order
+    * when the axis moves.
+    * magnus: exponential with the second Magnus term, the coning correction dt^2 / 12 (omega0 x omega1). Exact
+    * for a fixed axis too, and fourth order for a rate linear between samples.
+    * rk4: classic Runge-Kutta on the quaternion, the midpoint rate being (omega0 + omega1) / 2. Fourth order as
+    * well and without exponential, but not exact for a fixed axis: its error grows quickly with the rotation
+    * angle per step.
+    */
+    enum class integration_scheme {exponential, magnus, rk4};
+
+    /**
+     * \brief Integrate one step
+     * \param q_in orientation at the first sample
+     * \param omega0 body angular velocity at the first sample, rad/s
+     * \param omega1 body angular velocity at the second sample
+     * \param dt time between the samples
+     * \param scheme integration scheme
+     */
+    template<typename T, typename P>
+    quaternionU<T, P> integrate(const quaternionU<T, P>& q_in, const std::array<T, 3>& omega0, const std::array<T, 3>& omega1, T dt,
+                                integration_scheme scheme = integration_scheme::magnus) noexcept;
+
+    /**
+     * \brief Integrate a constant angular velocity over dt, q exp_map(omega dt)
+     */
+    template<typename T, typename P>
+    quaternionU<T, P> integrate(const quaternionU<T, P>& q_in, const std::array<T, 3>& omega, T dt) noexcept{
+        return integrate(q_in, omega, omega, dt, integration_scheme::exponential);
+    }
+
+    /**
+     * \brief Integrate one step for every quaternion of a batch, in place. Rates are stored as separate x, y, z
+     * arrays of q.size() values. Results match the scalar integrate() up to rounding.
+     * \param q orientations at the first sample, updated
+     * \param omega0 angular velocities at the first sample
+     * \param omega1 angular velocities at the second sample
+     * \param dt time between the samples
+     * \param scheme integration scheme
+     * \param config threading settings
+     */
+    template<typename T>
+    void integrate( quaternion_batch<T>& q, detail::non_deduced_t<point_lanes<const T>> omega0, detail::non_deduced_t<point_lanes<const T>> omega1,
+                    detail::non_deduced_t<T> dt, integration_scheme scheme = integration_scheme::magnus, const parallel_config& config = {});
+
+    /**
+    * \class gyro_integrator
+    * \brief Orientations of a set of sensors integrated from streams of gyroscope samples, all sensors sampled at
+    * the same instants. The last rates are kept, so each update only takes the new samples. The first update
+    * has no previous sample and assumes a constant rate over its step.
+    */
+    template<typename _T>
+    class gyro_integrator{
+        public:
+            using value_type = _T;
+
+            /**
+             * \brief Constructor of sensors starting at the identity
+             * \param sensors number of sensors
+             * \param scheme integration scheme
+             */
+            explicit gyro_integrator(std::size_t sensors, integration_scheme scheme = integration_scheme::magnus);
+            /**
+             * \brief Constructor from initial orientations
+             * \param orientations unitary quaternions, one per sensor
+             * \param scheme integration scheme
+             */
+            explicit gyro_integrator(quaternion_batch<_T> orientations, integration_scheme scheme = integration_scheme::magnus);
+            /**
+             * \brief Integrate up to a new sample of every sensor
+             * \param omega body angular velocities, size() values per coordinate
+             * \param dt time since the previous sample
+             * \param config threading settings
+             */
+            void update(point_lanes<const _T> omega, _T dt, const parallel_config& config = {});
+            /**
+             * \brief Number of sensors
+             */
+            inline std::size_t size() const noexcept{
+                return orientations_.size();
+            }
+            /**
+             * \brief Integration scheme
+             */
+            inline integration_scheme scheme() const noexcept{
+                return scheme_;
+            }
+            /**
+             * \brief Current orientations
+             */
+            inline const quaternion_batch<_T>& orientations() const noexcept{
+                return orientations_;
+            }
+            /**
+             * \brief Current orientations, to be reset or corrected by the caller
+             */
+            inline quaternion_batch<_T>& orientations() noexcept{
+                return orientations_;
+            }
+
+        private:
+            quaternion_batch<_T> orientations_;
+            std::array<std::vector<_T>, 3> rates_;
+            integration_scheme scheme_;
+            bool primed_{false};
+    };
+
+    using gyro_integratorf = gyro_integrator<float>;
+    using gyro_integratord = gyro_integrator<double>;
+}
+
+#include <yadq/impl/gyro_integration.tpp>
+
+#endif
@@ -0,0 +1,459 @@
+#include <yadq/alignment.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace yadq{
+
+    namespace detail {
+
+        inline void centred_moments::merge(const centred_moments& other) noexcept{
+
+            if (other.n == 0){
+                return;
+            }
+            if (n == 0){
+                *this = other;
+                return;
+            }
+
+            const double total = n + other.n;
+            const double f = n * other.n / total;
+            const double ds[3] = {other.mean_s[0] - mean_s[0], other.mean_s[1] - mean_s[1], other.mean_s[2] - mean_s[2]};
+            const double dt[3] = {other.mean_t[0] - mean_t[0], other.mean_t[1] - mean_t[1], other.mean_t[2] - mean_t[2]};
+
+            for (std::size_t j = 0; j < 3; ++j){
+                for (std::size_t k = 0; k < 3; ++k){
+                    cross[3 * j + k] += other.cross[3 * j + k] + f * ds[j] * dt[k];
+                }
+            }
+
+            var_s += other.var_s + f * (ds[0] * ds[0] + ds[1] * ds[1] + ds[2] * ds[2]);
+            var_t += other.var_t + f * (dt[0] * dt[0] + dt[1] * dt[1] + dt[2] * dt[2]);
+
+            const double k = other.n / total;
+            for (std::size_t j = 0; j < 3; ++j){
+                mean_s[j] += k * ds[j];
+                mean_t[j] += k * dt[j];
+            }
+
+            n = total;
+        }
+
+        /**
+         * \brief Centred moments of n pairs from their sums relative to (s0, t0): sums of s - s0 (0..2), of
+         * t - t0 (3..5), of their products (6..14, row-major) and of their squared norms (15, 16)
+         */
+        inline centred_moments moments_from_shifted(double n, const std::array<double, 3>& s0, const std::array<double, 3>& t0, const std::array<double, 17>& sums) noexcept{
+
+            centred_moments m;
+            m.n = n;
+
+            for (std::size_t j = 0; j < 3; ++j){
+                m.mean_s[j] = s0[j] + sums[j] / n;
+                m.mean_t[j] = t0[j] + sums[3 + j] / n;
+
+                for (std::size_t k = 0; k < 3; ++k){
+                    m.cross[3 * j + k] = sums[6 + 3 * j + k] - sums[j] * sums[3 + k] / n;
+                }
+            }
+
+            m.var_s = sums[15] - (sums[0] * sums[0] + sums[1] * sums[1] + sums[2] * sums[2]) / n;
+            m.var_t = sums[16] - (sums[3] * sums[3] + sums[4] * sums[4] + sums[5] * sums[5]) / n;
+            return m;
+        }
+
+        /**
+         * \brief Run f(begin, end) -> centred_moments on the chunks of [0, n), one chunk per thread, and merge the
+         * results in chunk order
+         */
+        template<typename F>
+        centred_moments parallel_moments(std::size_t n, const parallel_config& config, F&& f){
+
+            const unsigned chunks = thread_count(n, config);
+            std::vector<centred_moments> partials(chunks);
+
+            parallel_chunks(n, chunks, [&](unsigned k, std::size_t begin, std::size_t end){
+                if (begin < end){
+                    partials[k] = f(begin, end);
+                }
+            });
+
+            centred_moments total;
+            for (const auto& p : partials){
+                total.merge(p);
+            }
+            return total;
+        }
+
+        /**
+        * \struct error_sums
+        * \brief Running sums of a set of errors, mergeable
+        */
+        struct error_sums{
+            double squares = 0;
+            double sum = 0;
+            double max = 0;
+
+            void add(double e) noexcept{
+                squares += e * e;
+                sum += e;
+                max = std::max(max, e);
+            }
+
+            void merge(const error_sums& other) noexcept{
+                squares += other.squares;
+                sum += other.sum;
+                max = std::max(max, other.max);
+            }
+
+            error_stats stats(std::size_t count) const noexcept{
+                if (count == 0){
+                    return {};
+                }
+                return {std::sqrt(squares / count), sum / count, max, count};
+            }
+        };
+
+        /**
+         * \brief Run f(begin, end, partial) on the chunks of [0, n), one array of K error_sums per thread, and merge
+         * the partials in chunk order
+         */
+        template<std::size_t K, typename F>
+        std::array<error_sums, K> parallel_errors(std::size_t n, const parallel_config& config, F&& f){
+
+            const unsigned chunks = thread_count(n, config);
+            std::vector<std::array<error_sums, K>> partials(chunks);
+
+            parallel_chunks(n, chunks, [&](unsigned k, std::size_t begin, std::size_t end){
+                f(begin, end, partials[k]);
+            });
+
+            std::array<error_sums, K> total{};
+            for (const auto& p : partials){
+                for (std::size_t k = 0; k < K; ++k){
+                    total[k].merge(p[k]);
+                }
+            }
+            return total;
+        }
+
+        /**
+         * \brief Row-major rotation matrix of a unitary quaternion, in double
+         */
+        template<typename T, typename P>
+        std::array<double, 9> rotation_matrix(const quaternionU<T, P>& q) noexcept{
+
+            const double w = q.w(), x = q.x(), y = q.y(), z = q.z();
+
+            return {1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y),
+                    2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x),
+                    2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)};
+        }
+
+        inline void check_alignment_input(std::size_t count){
+            if (count == 0){
+                throw std::invalid_argument("alignment: no point pairs");
+            }
+        }
+    }
+
+    namespace simd{
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /**
+             * \brief Sums of the pairs [begin, end) relative to (s0, t0), in the order of detail::moments_from_shifted
+             */
+            template<typename T>
+            void shifted_moments(   point_lanes<const T> s, point_lanes<const T> t, const std::array<T, 3>& s0, const std::array<T, 3>& t0,
+                                    std::size_t begin, std::size_t end, std::array<double, 17>& sums){
+
+                block_sums<T>(begin, end, sums, [&](auto& acc, std::size_t i){
+                    using Pk = typename std::decay_t<decltype(acc)>::value_type;
+
+                    const Pk sx = Pk::load_unaligned(s.x + i) - Pk::broadcast(s0[0]);
+                    const Pk sy = Pk::load_unaligned(s.y + i) - Pk::broadcast(s0[1]);
+                    const Pk sz = Pk::load_unaligned(s.z + i) - Pk::broadcast(s0[2]);
+                    const Pk tx = Pk::load_unaligned(t.x + i) - Pk::broadcast(t0[0]);
+                    const Pk ty = Pk::load_unaligned(t.y + i) - Pk::broadcast(t0[1]);
+                    const Pk tz = Pk::load_unaligned(t.z + i) - Pk::broadcast(t0[2]);
+
+                    acc[0] = acc[0] + sx;
+                    acc[1] = acc[1] + sy;
+                    acc[2] = acc[2] + sz;
+                    acc[3] = acc[3] + tx;
+                    acc[4] = acc[4] + ty;
+                    acc[5] = acc[5] + tz;
+                    acc[6] = acc[6] + sx * tx;
+                    acc[7] = acc[7] + sx * ty;
+                    acc[8] = acc[8] + sx * tz;
+                    acc[9] = acc[9] + sy * tx;
+                    acc[10] = acc[10] + sy * ty;
+                    acc[11] = acc[11] + sy * tz;
+                    acc[12] = acc[12] + sz * tx;
+                    acc[13] = acc[13] + sz * ty;
+                    acc[14] = acc[14] + sz * tz;
+                    acc[15] = acc[15] + sx * sx + sy * sy + sz * sz;
+                    acc[16] = acc[16] + tx * tx + ty * ty + tz * tz;
+                });
+            }
+        }
+    }
+
+    /*
+        ------------------------------ alignment_result ------------------------------
+    */
+
+    template<typename _T>
+    std::array<_T, 3> alignment_result<_T>::apply(const std::array<_T, 3>& p) const noexcept{
+
+        const auto v = rotate(rotation, p);
+        return {scale * v[0] + translation[0], scale * v[1] + translation[1], scale * v[2] + translation[2]};
+    }
+
+    /*
+        ------------------------------ alignment_accumulator ------------------------------
+    */
+
+    template<typename _T>
+    void alignment_accumulator<_T>::add(const std::array<_T, 3>& source, const std::array<_T, 3>& target) noexcept{
+
+        detail::centred_moments m;
+        m.n = 1;
+        m.mean_s = {source[0], source[1], source[2]};
+        m.mean_t = {target[0], target[1], target[2]};
+
+        moments_.merge(m);
+        ++count_;
+    }
+
+    template<typename _T>
+    void alignment_accumulator<_T>::add(point_lanes<const _T> source, point_lanes<const _T> target, std::size_t n, const parallel_config& config){
+
+        const auto m = detail::parallel_moments(n, config, [&](std::size_t begin, std::size_t end){
+            // Relative to the first pair of the chunk: the sums in T only see the spread of the points
+            const std::array<_T, 3> s0 = {source.x[begin], source.y[begin], source.z[begin]};
+            const std::array<_T, 3> t0 = {target.x[begin], target.y[begin], target.z[begin]};
+
+            std::array<double, 17> sums{};
+            simd::shifted_moments(source, target, s0, t0, begin, end, sums);
+
+            return detail::moments_from_shifted(double(end - begin), {s0[0], s0[1], s0[2]}, {t0[0], t0[1], t0[2]}, sums);
+        });
+
+        moments_.merge(m);
+        count_ += n;
+    }
+
+    template<typename _T>
+    void alignment_accumulator<_T>::add(const dualquaternion<_T>* source, const dualquaternion<_T>* target, std::size_t n, const parallel_config& config){
+
+        const auto m = detail::parallel_moments(n, config, [&](std::size_t begin, std::size_t end){
+            const auto s_begin = source[begin].translation();
+            const auto t_begin = target[begin].translation();
+            const std::array<double, 3> s0 = {s_begin[0], s_begin[1], s_begin[2]};
+            const std::array<double, 3> t0 = {t_begin[0], t_begin[1], t_begin[2]};
+
+            std::array<double, 17> sums{};
+            for (std::size_t i = begin; i < end; ++i){
+                const auto ps = source[i].translation();
+                const auto pt = target[i].translation();
+                const double s[3] = {ps[0] - s0[0], ps[1] - s0[1], ps[2] - s0[2]};
+                const double t[3] = {pt[0] - t0[0], pt[1] - t0[1], pt[2] - t0[2]};
+
+                for (std::size_t j = 0; j < 3; ++j){
+                    sums[j] += s[j];
+                    sums[3 + j] += t[j];
+                    for (std::size_t k = 0; k < 3; ++k){
+                        sums[6 + 3 * j + k] += s[j] * t[k];
+                    }
+                }
+                sums[15] += s[0] * s[0] + s[1] * s[1] + s[2] * s[2];
+                sums[16] += t[0] * t[0] + t[1] * t[1] + t[2] * t[2];
+            }
+
+            return detail::moments_from_shifted(double(end - begin), s0, t0, sums);
+        });
+
+        moments_.merge(m);
+        count_ += n;
+    }
+
+    template<typename _T>
+    alignment_accumulator<_T>& alignment_accumulator<_T>::merge(const alignment_accumulator& other) noexcept{
+
+        moments_.merge(other.moments_);
+        count_ += other.count_;
+        return *this;
+    }
+
+    template<typename _T>
+    alignment_result<_T> alignment_accumulator<_T>::solve(alignment_model model) const{
+
+        detail::check_alignment_input(count_);
+
+        const auto& S = moments_.cross;
+        const double sxx = S[0], sxy = S[1], sxz = S[2];
+        const double syx = S[3], syy = S[4], syz = S[5];
+        const double szx = S[6], szy = S[7], szz = S[8];
+
+        // Horn's matrix: q^T N q = sum_i t'_i . R(q) s'_i for unit q
+        const std::array<double, 10> N = {  sxx + syy + szz, syz - szy, szx - sxz, sxy - syx,
+                                            sxx - syy - szz, sxy + syx, szx + sxz,
+                                            -sxx + syy - szz, syz + szy,
+                                            -sxx - syy + szz};
+
+        const auto q = detail::dominant_eigenvector(N);
+        const quaternionU<double> r(q[0], q[1], q[2], q[3]);
+        const auto R = detail::rotation_matrix(r);
+
+        double correlation = 0;
+        for (std::size_t j = 0; j < 3; ++j){
+            for (std::size_t k = 0; k < 3; ++k){
+                correlation += R[3 * k + j] * S[3 * j + k];
+            }
+        }
+
+        double scale = 1;
+        if (model == alignment_model::similarity){
+            if (!(moments_.var_s > 0)){
+                throw std::invalid_argument("alignment: the source points are all equal, the scale is undefined");
+            }
+            scale = correlation / moments_.var_s;
+        }
+
+        const auto& ms = moments_.mean_s;
+        const auto& mt = moments_.mean_t;
+
+        alignment_result<_T> res;
+        res.rotation = quaternionU<_T>(_T(q[0]), _T(q[1]), _T(q[2]), _T(q[3]));
+        res.scale = _T(scale);
+        for (std::size_t j = 0; j < 3; ++j){
+            res.translation[j] = _T(mt[j] - scale * (R[3 * j] * ms[0] + R[3 * j + 1] * ms[1] + R[3 * j + 2] * ms[2]));
+        }
+
+        // sum_i |s R s'_i - t'_i|^2, expanded on the moments
+        const double residual = scale * scale * moments_.var_s - 2 * scale * correlation + moments_.var_t;
+        res.rmse = std::sqrt(std::max(0.0, residual) / moments_.n);
+
+        return res;
+    }
+
+    /*
+        ------------------------------ Free functions ------------------------------
+    */
+
+    template<typename T>
+    alignment_result<T> align(  detail::non_deduced_t<point_lanes<const T>> source, detail::non_deduced_t<point_lanes<const T>> target, std::size_t n,
+                                alignment_model model, const parallel_config& config){
+
+        alignment_accumulator<T> acc;
+        acc.add(source, target, n, config);
+        return acc.solve(model);
+    }
+
+    template<typename T>
+    alignment_result<T> align(  const dualquaternion<T>* source, const dualquaternion<T>* target, std::size_t n,
+                                alignment_model model, const parallel_config& config){
+
+        alignment_accumulator<T> acc;
+        acc.add(source, target, n, config);
+        return acc.solve(model);
+    }
+
+    template<typename T>
+    error_stats absolute_trajectory_error(  const alignment_result<T>& alignment,
+                                            detail::non_deduced_t<point_lanes<const T>> source, detail::non_deduced_t<point_lanes<const T>> target, std::size_t n,
+                                            const parallel_config& config){
+
+        const auto R = detail::rotation_matrix(alignment.rotation);
+        const double s = alignment.scale;
+        const double t[3] = {alignment.translation[0], alignment.translation[1], alignment.translation[2]};
+
+        const auto e = detail::parallel_errors<1>(n, config, [&](std::size_t begin, std::size_t end, std::array<detail::error_sums, 1>& partial){
+            for (std::size_t i = begin; i < end; ++i){
+                const double p[3] = {source.x[i], source.y[i], source.z[i]};
+                const double dx = s * (R[0] * p[0] + R[1] * p[1] + R[2] * p[2]) + t[0] - target.x[i];
+                const double dy = s * (R[3] * p[0] + R[4] * p[1] + R[5] * p[2]) + t[1] - target.y[i];
+                const double dz = s * (R[6] * p[0] + R[7] * p[1] + R[8] * p[2]) + t[2] - target.z[i];
+                partial[0].add(std::sqrt(dx * dx + dy * dy + dz * dz));
+            }
+        });
+
+        return e[0].stats(n);
+    }
+
+    template<typename T>
+    error_stats absolute_trajectory_error(  const alignment_result<T>& alignment,
+                                            const detail::non_deduced_t<dualquaternion<T>>* source, const detail::non_deduced_t<dualquaternion<T>>* target, std::size_t n,
+                                            const parallel_config& config){
+
+        const auto e = detail::parallel_errors<1>(n, config, [&](std::size_t begin, std::size_t end, std::array<detail::error_sums, 1>& partial){
+            for (std::size_t i = begin; i < end; ++i){
+                const auto p = alignment.apply(source[i].translation());
+                const auto q = target[i].translation();
+                const double dx = double(p[0]) - q[0], dy = double(p[1]) - q[1], dz = double(p[2]) - q[2];
+                partial[0].add(std::sqrt(dx * dx + dy * dy + dz * dz));
+            }
+        });
+
+        return e[0].stats(n);
+    }
+
+    namespace detail {
+
+        /**
+         * \brief Relative pose error with the source motion translations multiplied by scale
+         */
+        template<typename T>
+        relative_error relative_pose_error( const dualquaternion<T>* source, const dualquaternion<T>* target, std::size_t n,
+                                            std::size_t delta, double scale, const parallel_config& config){
+
+            if (delta == 0 || delta >= n){
+                throw std::invalid_argument("relative_pose_error: delta must be in [1, n)");
+            }
+
+            const std::size_t count = n - delta;
+
+            const auto e = parallel_errors<2>(count, config, [&](std::size_t begin, std::size_t end, std::array<error_sums, 2>& partial){
+                for (std::size_t i = begin; i < end; ++i){
+                    // The conjugate of a unit dual quaternion is its inverse
+                    auto motion_s = conjugate(source[i]) * source[i + delta];
+                    const auto motion_t = conjugate(target[i]) * target[i + delta];
+
+                    if (scale != 1){
+                        const auto t = motion_s.translation();
+                        motion_s = dualquaternion<T>(motion_s.qr_, std::array<T, 3>{   static_cast<T>(scale * t[0]),
+                                                                                        static_cast<T>(scale * t[1]),
+                                                                                        static_cast<T>(scale * t[2])});
+                    }
+
+                    const auto err = conjugate(motion_t) * motion_s;
+
+                    const auto t = err.translation();
+                    const auto r = log_map(err.qr_);
+                    partial[0].add(std::sqrt(double(t[0]) * t[0] + double(t[1]) * t[1] + double(t[2]) * t[2]));
+                    partial[1].add(std::sqrt(double(r[0]) * r[0] + double(r[1]) * r[1] + double(r[2]) * r[2]));
+                }
+            });
+
+            return {e[0].stats(count), e[1].stats(count)};
+        }
+    }
+
+    template<typename T>
+    relative_error relative_pose_error( const dualquaternion<T>* source, const dualquaternion<T>* target, std::size_t n,
+                                        std::size_t delta, const parallel_config& config){
+        return detail::relative_pose_error(source, target, n, delta, 1.0, config);
+    }
+
+    template<typename T>
+    relative_error relative_pose_error( const alignment_result<T>& alignment,
+                                        const detail::non_deduced_t<dualquaternion<T>>* source, const detail::non_deduced_t<dualquaternion<T>>* target, std::size_t n,
+                                        std::size_t delta, const parallel_config& config){
+        return detail::relative_pose_error(source, target, n, delta, double(alignment.scale), config);
+    }
+}
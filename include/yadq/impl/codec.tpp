@@ -0,0 +1,439 @@
+#include <yadq/codec.hpp>
+
+#include <cstring>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief Unsigned word holding the packed bits of a smallest-three encoding before they are stored
+         */
+        template<unsigned Bits>
+        using smallest_three_word = std::conditional_t<3 * Bits + 2 <= 32, std::uint32_t, std::uint64_t>;
+
+        /*
+            Storage of the packed word: integer storages hold it as is, arrays of 16-bit words hold it least
+            significant word first.
+        */
+
+        template<typename W, typename S>
+        inline S to_storage(W bits) noexcept{
+            if constexpr (std::is_integral_v<S>){
+                return static_cast<S>(bits);
+            } else {
+                S s;
+                for (std::size_t k = 0; k < s.size(); ++k){
+                    s[k] = static_cast<std::uint16_t>(bits >> (16 * k));
+                }
+                return s;
+            }
+        }
+
+        template<typename W, typename S>
+        inline W from_storage(const S& s) noexcept{
+            if constexpr (std::is_integral_v<S>){
+                return static_cast<W>(s);
+            } else {
+                W bits = 0;
+                for (std::size_t k = 0; k < s.size(); ++k){
+                    bits |= W(s[k]) << (16 * k);
+                }
+                return bits;
+            }
+        }
+
+        /**
+         * \brief IEEE binary16 of a float, round to nearest even, overflow to infinity. Every case is computed and
+         * selected, so that loops over it are vectorised.
+         */
+        inline std::uint16_t float_to_half(float f_in) noexcept{
+
+            constexpr std::uint32_t magic_bits = 126u << 23;
+
+            std::uint32_t f;
+            std::memcpy(&f, &f_in, sizeof(f));
+
+            const std::uint32_t sign = f & 0x80000000u;
+            f ^= sign;
+
+            // Subnormal half or zero: the float adder does the rounding
+            float m, r;
+            std::memcpy(&m, &magic_bits, sizeof(m));
+            std::memcpy(&r, &f, sizeof(r));
+            r += m;
+            std::uint32_t subnormal;
+            std::memcpy(&subnormal, &r, sizeof(subnormal));
+            subnormal -= magic_bits;
+
+            // Normal half: rebias the exponent and round the mantissa to nearest even
+            const std::uint32_t normal = (f + 0xc8000fffu + ((f >> 13) & 1u)) >> 13;
+
+            // Too large for a half: infinity, or a quiet NaN
+            const std::uint32_t special = f > (255u << 23) ? 0x7e00u : 0x7c00u;
+
+            const std::uint32_t h = f >= (143u << 23) ? special : (f < (113u << 23) ? subnormal : normal);
+
+            return static_cast<std::uint16_t>(h | (sign >> 16));
+        }
+
+        /**
+         * \brief Float of an IEEE binary16, exact. Branch-free as float_to_half.
+         */
+        inline float half_to_float(std::uint16_t h_in) noexcept{
+
+            constexpr std::uint32_t shifted_exp = 0x7c00u << 13;
+            constexpr std::uint32_t magic_bits = 113u << 23;
+
+            const std::uint32_t o = ((std::uint32_t(h_in) & 0x7fffu) << 13) + ((127u - 15u) << 23);
+            const std::uint32_t exp = (std::uint32_t(h_in) << 13) & shifted_exp;
+
+            // Subnormal or zero: renormalise through the float unit
+            const std::uint32_t s_bits = o + (1u << 23);
+            float subnormal, m;
+            std::memcpy(&subnormal, &s_bits, sizeof(subnormal));
+            std::memcpy(&m, &magic_bits, sizeof(m));
+            subnormal -= m;
+            std::uint32_t s_out;
+            std::memcpy(&s_out, &subnormal, sizeof(s_out));
+
+            // Infinity or NaN keep an all-ones exponent
+            const std::uint32_t bits = exp == shifted_exp ? o + ((128u - 16u) << 23) : (exp == 0 ? s_out : o);
+            const std::uint32_t res = bits | ((std::uint32_t(h_in) & 0x8000u) << 16);
+
+            float f;
+            std::memcpy(&f, &res, sizeof(f));
+            return f;
+        }
+    }
+
+    namespace simd{
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /*
+                ------------------------------ Kernels ------------------------------
+
+                Each kernel handles M quaternions starting at i, M being a multiple of Pk::width. Kernels are written
+                once for pack<T> and for the one-lane scalar_pack<T>, which also implements the scalar codecs. The
+                floating point part runs on packs; integer levels and half floats are staged in an aligned block,
+                converted by fixed-length loops. Batches stage codec_block quaternions at a time, so that the packs
+                are not loaded right after the narrow stores that filled the block.
+            */
+
+            constexpr std::size_t codec_block = 64;
+
+            template<typename Pk, std::size_t M, unsigned B, typename S, typename T>
+            inline void smallest_three_encode(quaternion_lanes<const T> q, S* out, std::size_t i) noexcept{
+
+                using word = detail::smallest_three_word<B>;
+
+                constexpr T range = T(0.70710678118654752440);
+                constexpr T max_level = T((std::uint64_t(1) << B) - 2);
+
+                const Pk zero = Pk::broadcast(T(0)), one = Pk::broadcast(T(1));
+                const Pk offset = Pk::broadcast(range), scale = Pk::broadcast(max_level / (2 * range));
+                const Pk half = Pk::broadcast(T(0.5)), top = Pk::broadcast(max_level);
+
+                auto quantise = [&](Pk v) noexcept{
+                    const Pk u = (v + offset) * scale + half;
+                    return select_gt(zero, u, zero, select_gt(u, top, top, u));
+                };
+
+                alignas(alignment) T block[4][M];
+
+                for (std::size_t k = 0; k < M; k += Pk::width){
+                    const Pk w = Pk::load(q.w + i + k), x = Pk::load(q.x + i + k), y = Pk::load(q.y + i + k), z = Pk::load(q.z + i + k);
+
+                    // Largest magnitude, the lowest index wins ties; the index is carried as a float
+                    Pk m = select_gt(zero, w, -w, w), d = w, idx = zero;
+
+                    const Pk ax = select_gt(zero, x, -x, x);
+                    idx = select_gt(ax, m, one, idx);
+                    d = select_gt(ax, m, x, d);
+                    m = select_gt(ax, m, ax, m);
+
+                    const Pk ay = select_gt(zero, y, -y, y);
+                    idx = select_gt(ay, m, Pk::broadcast(T(2)), idx);
+                    d = select_gt(ay, m, y, d);
+                    m = select_gt(ay, m, ay, m);
+
+                    const Pk az = select_gt(zero, z, -z, z);
+                    idx = select_gt(az, m, Pk::broadcast(T(3)), idx);
+                    d = select_gt(az, m, z, d);
+
+                    // q and -q are the same rotation: the dropped component is made non-negative
+                    const Pk s = select_gt(zero, d, -one, one);
+
+                    idx.store(block[0] + k);
+                    quantise(s * select_gt(half, idx, x, w)).store(block[1] + k);
+                    quantise(s * select_gt(Pk::broadcast(T(1.5)), idx, y, x)).store(block[2] + k);
+                    quantise(s * select_gt(Pk::broadcast(T(2.5)), idx, z, y)).store(block[3] + k);
+                }
+
+                // Levels fit 20 bits, the conversions go through int32
+                for (std::size_t j = 0; j < M; ++j){
+                    const word bits =   (word(std::int32_t(block[0][j])) << (3 * B)) | (word(std::int32_t(block[1][j])) << (2 * B)) |
+                                        (word(std::int32_t(block[2][j])) << B) | word(std::int32_t(block[3][j]));
+
+                    out[i + j] = detail::to_storage<word, S>(bits);
+                }
+            }
+
+            template<typename Pk, std::size_t M, unsigned B, typename S, typename T>
+            inline void smallest_three_decode(const S* in, quaternion_lanes<T> q, std::size_t i) noexcept{
+
+                using word = detail::smallest_three_word<B>;
+
+                constexpr T range = T(0.70710678118654752440);
+                constexpr word mask = (word(1) << B) - 1;
+
+                alignas(alignment) T block[4][M];
+
+                for (std::size_t j = 0; j < M; ++j){
+                    const word bits = detail::from_storage<word>(in[i + j]);
+
+                    block[0][j] = T(std::int32_t((bits >> (3 * B)) & 3));
+                    block[1][j] = T(std::int32_t((bits >> (2 * B)) & mask));
+                    block[2][j] = T(std::int32_t((bits >> B) & mask));
+                    block[3][j] = T(std::int32_t(bits & mask));
+                }
+
+                const Pk zero = Pk::broadcast(T(0)), one = Pk::broadcast(T(1));
+                const Pk step = Pk::broadcast(2 * range / T(mask - 1)), offset = Pk::broadcast(range);
+                const Pk t0 = Pk::broadcast(T(0.5)), t1 = Pk::broadcast(T(1.5)), t2 = Pk::broadcast(T(2.5));
+
+                for (std::size_t k = 0; k < M; k += Pk::width){
+                    const Pk idx = Pk::load(block[0] + k);
+                    const Pk a = Pk::load(block[1] + k) * step - offset;
+                    const Pk b = Pk::load(block[2] + k) * step - offset;
+                    const Pk c = Pk::load(block[3] + k) * step - offset;
+
+                    const Pk r = one - (a * a + b * b + c * c);
+                    const Pk d = sqrt(select_gt(r, zero, r, zero));
+
+                    select_gt(t0, idx, d, a).store(q.w + i + k);
+                    select_gt(t0, idx, a, select_gt(t1, idx, d, b)).store(q.x + i + k);
+                    select_gt(t1, idx, b, select_gt(t2, idx, d, c)).store(q.y + i + k);
+                    select_gt(t2, idx, c, d).store(q.z + i + k);
+                }
+            }
+
+            /*
+                Conversions of N floats to and from IEEE binary16, through F16C when the target has it
+            */
+
+#if defined(__F16C__) && !defined(YADQ_DISABLE_SIMD)
+            constexpr bool has_f16c = true;
+#else
+            constexpr bool has_f16c = false;
+#endif
+
+            template<std::size_t N>
+            inline void float_to_half(const float* in, std::uint16_t* out) noexcept{
+
+                constexpr std::size_t vectorised = has_f16c ? N / 8 * 8 : 0;
+
+#if defined(__F16C__) && !defined(YADQ_DISABLE_SIMD)
+                for (std::size_t i = 0; i < vectorised; i += 8){
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+                }
+#endif
+                for (std::size_t i = vectorised; i < N; ++i){
+                    out[i] = detail::float_to_half(in[i]);
+                }
+            }
+
+            template<std::size_t N>
+            inline void half_to_float(const std::uint16_t* in, float* out) noexcept{
+
+                constexpr std::size_t vectorised = has_f16c ? N / 8 * 8 : 0;
+
+#if defined(__F16C__) && !defined(YADQ_DISABLE_SIMD)
+                for (std::size_t i = 0; i < vectorised; i += 8){
+                    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+                }
+#endif
+                for (std::size_t i = vectorised; i < N; ++i){
+                    out[i] = detail::half_to_float(in[i]);
+                }
+            }
+
+            template<typename Pk, std::size_t M, typename T>
+            inline void half_encode(quaternion_lanes<const T> q, half_64::storage_type* out, std::size_t i) noexcept{
+
+                alignas(alignment) float block[4 * M];
+
+                for (std::size_t j = 0; j < M; ++j){
+                    block[4 * j] = static_cast<float>(q.w[i + j]);
+                    block[4 * j + 1] = static_cast<float>(q.x[i + j]);
+                    block[4 * j + 2] = static_cast<float>(q.y[i + j]);
+                    block[4 * j + 3] = static_cast<float>(q.z[i + j]);
+                }
+
+                // Converted into one local run, then copied element by element: the M outputs are separate arrays
+                alignas(alignment) std::uint16_t halves[4 * M];
+                float_to_half<4 * M>(block, halves);
+
+                for (std::size_t j = 0; j < M; ++j){
+                    for (std::size_t c = 0; c < 4; ++c){
+                        out[i + j][c] = halves[4 * j + c];
+                    }
+                }
+            }
+
+            template<typename Pk, std::size_t M, typename T>
+            inline void half_decode(const half_64::storage_type* in, quaternion_lanes<T> q, std::size_t i) noexcept{
+
+                alignas(alignment) std::uint16_t halves[4 * M];
+                alignas(alignment) float aos[4 * M];
+                alignas(alignment) T block[4][M];
+
+                for (std::size_t j = 0; j < M; ++j){
+                    for (std::size_t c = 0; c < 4; ++c){
+                        halves[4 * j + c] = in[i + j][c];
+                    }
+                }
+
+                half_to_float<4 * M>(halves, aos);
+
+                for (std::size_t j = 0; j < M; ++j){
+                    for (std::size_t c = 0; c < 4; ++c){
+                        block[c][j] = aos[4 * j + c];
+                    }
+                }
+
+                const Pk one = Pk::broadcast(T(1));
+
+                for (std::size_t k = 0; k < M; k += Pk::width){
+                    const Pk w = Pk::load(block[0] + k), x = Pk::load(block[1] + k), y = Pk::load(block[2] + k), z = Pk::load(block[3] + k);
+                    const Pk inv = one / sqrt(w * w + x * x + y * y + z * z);
+
+                    (w * inv).store(q.w + i + k);
+                    (x * inv).store(q.x + i + k);
+                    (y * inv).store(q.y + i + k);
+                    (z * inv).store(q.z + i + k);
+                }
+            }
+
+            /**
+             * \brief Run f(pack, M, i) over n quaternions: whole staging blocks and whole packs on the aligned lanes,
+             * then the remainder one at a time so that the identity padding of the lanes is never written
+             */
+            template<typename T, typename F>
+            inline void codec_loop(std::size_t n, F&& f) noexcept{
+
+                using P = pack<T>;
+
+                std::size_t i = 0;
+
+                for (; i + codec_block <= n; i += codec_block){
+                    f(P{}, std::integral_constant<std::size_t, codec_block>{}, i);
+                }
+
+                for (; i + P::width <= n; i += P::width){
+                    f(P{}, std::integral_constant<std::size_t, P::width>{}, i);
+                }
+
+                for (; i < n; ++i){
+                    f(scalar_pack<T>{}, std::integral_constant<std::size_t, 1>{}, i);
+                }
+            }
+
+            template<unsigned B, typename S, typename T>
+            void encode(smallest_three<B, S>, quaternion_lanes<const T> q, S* out, std::size_t n) noexcept{
+                codec_loop<T>(n, [&](auto p, auto m, std::size_t i){
+                    smallest_three_encode<decltype(p), decltype(m)::value, B>(q, out, i);
+                });
+            }
+
+            template<unsigned B, typename S, typename T>
+            void decode(smallest_three<B, S>, const S* in, quaternion_lanes<T> q, std::size_t n) noexcept{
+                codec_loop<T>(n, [&](auto p, auto m, std::size_t i){
+                    smallest_three_decode<decltype(p), decltype(m)::value, B>(in, q, i);
+                });
+            }
+
+            template<typename T>
+            void encode(half_64, quaternion_lanes<const T> q, half_64::storage_type* out, std::size_t n) noexcept{
+                codec_loop<T>(n, [&](auto p, auto m, std::size_t i){
+                    half_encode<decltype(p), decltype(m)::value>(q, out, i);
+                });
+            }
+
+            template<typename T>
+            void decode(half_64, const half_64::storage_type* in, quaternion_lanes<T> q, std::size_t n) noexcept{
+                codec_loop<T>(n, [&](auto p, auto m, std::size_t i){
+                    half_decode<decltype(p), decltype(m)::value>(in, q, i);
+                });
+            }
+        }
+    }
+
+    /*
+        ------------------------------ Fcn definition ------------------------------
+
+        The scalar codecs run the batch kernels on one lane, so scalar and batch encoders produce the same bits.
+        Scalar decoders return a quaternionU, whose constructor normalises once more: they may differ from the
+        batch decoders by a few ULP.
+    */
+
+    template<unsigned _Bits, typename _Storage>
+    template<typename T, typename P>
+    typename smallest_three<_Bits, _Storage>::storage_type smallest_three<_Bits, _Storage>::encode(const quaternionU<T, P>& q_in) noexcept{
+
+        const T c[4] = {q_in.w(), q_in.x(), q_in.y(), q_in.z()};
+
+        storage_type s_out;
+        simd::smallest_three_encode<simd::scalar_pack<T>, 1, _Bits>(quaternion_lanes<const T>{c, c + 1, c + 2, c + 3}, &s_out, 0);
+        return s_out;
+    }
+
+    template<unsigned _Bits, typename _Storage>
+    template<typename T>
+    quaternionU<T> smallest_three<_Bits, _Storage>::decode(const storage_type& s_in) noexcept{
+
+        T c[4];
+        simd::smallest_three_decode<simd::scalar_pack<T>, 1, _Bits>(&s_in, quaternion_lanes<T>{c, c + 1, c + 2, c + 3}, 0);
+        return quaternionU<T>(c[0], c[1], c[2], c[3]);
+    }
+
+    template<typename T, typename P>
+    half_64::storage_type half_64::encode(const quaternionU<T, P>& q_in) noexcept{
+
+        const T c[4] = {q_in.w(), q_in.x(), q_in.y(), q_in.z()};
+
+        storage_type s_out;
+        simd::half_encode<simd::scalar_pack<T>, 1>(quaternion_lanes<const T>{c, c + 1, c + 2, c + 3}, &s_out, 0);
+        return s_out;
+    }
+
+    template<typename T>
+    quaternionU<T> half_64::decode(const storage_type& s_in) noexcept{
+
+        T c[4];
+        simd::half_decode<simd::scalar_pack<T>, 1>(&s_in, quaternion_lanes<T>{c, c + 1, c + 2, c + 3}, 0);
+        return quaternionU<T>(c[0], c[1], c[2], c[3]);
+    }
+
+    template<typename Codec, typename T>
+    void encode(const quaternion_batch<T>& q_in, typename Codec::storage_type* s_out) noexcept{
+        simd::encode(Codec{}, q_in.lanes(), s_out, q_in.size());
+    }
+
+    template<typename Codec, typename T>
+    std::vector<typename Codec::storage_type> encode(const quaternion_batch<T>& q_in){
+
+        std::vector<typename Codec::storage_type> s_out(q_in.size());
+        encode<Codec>(q_in, s_out.data());
+        return s_out;
+    }
+
+    template<typename Codec, typename T>
+    void decode(const typename Codec::storage_type* s_in, std::size_t n, quaternion_batch<T>& q_out){
+
+        q_out.resize(n);
+
+        simd::decode(Codec{}, s_in, q_out.lanes(), n);
+    }
+}
@@ -0,0 +1,154 @@
+#include <yadq/dual_quaternion.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Operators definition ------------------------------
+    */
+
+    template<typename T>
+    std::ostream& operator<<(std::ostream &os, const dualquaternion<T>& dq_in) noexcept{ 
+        return os <<    "q [w: " << dq_in.qr_.w() << " x: " << dq_in.qr_.x() << " y: " << dq_in.qr_.y() << " z: " << dq_in.qr_.z() << "]" << std::endl <<
+                        "t [w: " << dq_in.qd_.w() << " x: " << dq_in.qd_.x() << " y: " << dq_in.qd_.y() << " z: " << dq_in.qd_.z() << "]" ;
+    }
+
+    /**
+     * \brief Product of a pure rotation (lhv, 0) with a dual quaternion
+     */
+    template< typename T>
+    constexpr dualquaternion<T> operator*(const quaternionU<T>& lhv, const dualquaternion<T>& dq_rhv){
+        return dualquaternion<T>(lhv * dq_rhv.qr_, lhv * dq_rhv.qd_);
+    }
+
+    /**
+     * \brief Dual quaternion product (qr1 qr2, qr1 qd2 + qd1 qr2)
+     */
+    template<typename T>
+    constexpr dualquaternion<T> operator*(dualquaternion<T> dq_lhv, const dualquaternion<T>& dq_rhv){
+        
+        dq_lhv *= dq_rhv;
+
+        return dq_lhv;
+    }
+
+    /**
+     * \brief Apply the rigid transformation to a point, see transform()
+     */
+    template<typename T>
+    constexpr std::array<T, 3> operator*(const dualquaternion<T>& dq_lhv, const std::array<T, 3>& p_rhv){
+        return transform(dq_lhv, p_rhv);
+    }
+
+    /**
+     * \brief Sum of two unit dual quaternions, normalised back to a unit dual quaternion as in linear blending:
+     * both parts are divided by |qr1 + qr2|, then the dual part is made orthogonal to the real one
+     */
+    template<typename T>
+    constexpr dualquaternion<T> operator+(const dualquaternion<T>& dq_lhv, const dualquaternion<T>& dq_rhv){
+
+        const quaternion<T> r(  dq_lhv.qr_.w() + dq_rhv.qr_.w(), dq_lhv.qr_.x() + dq_rhv.qr_.x(),
+                                dq_lhv.qr_.y() + dq_rhv.qr_.y(), dq_lhv.qr_.z() + dq_rhv.qr_.z());
+        const auto n = r.norm();
+        const T k = (n != 0.0) ? T(1 / n) : T(1);
+
+        dualquaternion<T> dq_res(   quaternionU<T>(r),
+                                    quaternion<T>(  k * (dq_lhv.qd_.w() + dq_rhv.qd_.w()), k * (dq_lhv.qd_.x() + dq_rhv.qd_.x()),
+                                                    k * (dq_lhv.qd_.y() + dq_rhv.qd_.y()), k * (dq_lhv.qd_.z() + dq_rhv.qd_.z())));
+        dq_res.normalise();
+
+        return dq_res;
+    }
+
+    /*
+        ------------------------------ Fcn definition ------------------------------
+    */
+
+    /**
+     * \brief Quaternion conjugate (qr*, qd*). For unit dual quaternions it is the inverse.
+     */
+    template<typename T>
+    constexpr dualquaternion<T> conjugate(dualquaternion<T> dq_lhv){
+        
+        dq_lhv.qr_.conjugate();
+        dq_lhv.qd_.conjugate();
+        
+        return dq_lhv;
+    } 
+
+    /**
+     * \brief Dual-number conjugate (qr, -qd)
+     */
+    template<typename T>
+    constexpr dualquaternion<T> dual_conjugate(dualquaternion<T> dq_lhv){
+
+        dq_lhv.qd_ = dq_lhv.qd_ * -1.0;
+
+        return dq_lhv;
+    }
+
+    /**
+     * \brief Combined conjugate (qr*, -qd*), used to transform points as dq (1 + e p) dq~
+     */
+    template<typename T>
+    constexpr dualquaternion<T> combined_conjugate(dualquaternion<T> dq_lhv){
+
+        dq_lhv.qr_.conjugate();
+        dq_lhv.qd_ = quaternion<T>(-dq_lhv.qd_.w(), dq_lhv.qd_.x(), dq_lhv.qd_.y(), dq_lhv.qd_.z());
+
+        return dq_lhv;
+    }
+
+    /**
+     * \brief Dual quaternion multiplied by its quaternion conjugate, (|qr|^2, 2 <qr, qd>)
+     */
+    template<typename T>
+    constexpr dualquaternion<T> norm(const dualquaternion<T>& dq_lhv){
+        
+        return dq_lhv * conjugate(dq_lhv);
+    } 
+
+    /**
+     * \brief Normalised copy of the dual quaternion
+     */
+    template<typename T>
+    constexpr dualquaternion<T> normalise(dualquaternion<T> dq_in) noexcept{
+
+        dq_in.normalise();
+
+        return dq_in;
+    }
+
+    /**
+     * \brief Inverse (qr^-1, -qr^-1 qd qr^-1)
+     */
+    template<typename T>
+    constexpr dualquaternion<T> inverse(const dualquaternion<T>& dq_in){
+
+        const auto qr_inv = inverse(dq_in.qr_);
+
+        return dualquaternion<T>(qr_inv, qr_inv * dq_in.qd_ * qr_inv * -1.0);
+    }
+
+    /**
+     * \brief Translation encoded by the dual quaternion
+     */
+    template<typename T>
+    constexpr std::array<T, 3> translation(const dualquaternion<T>& dq_in) noexcept{
+        return dq_in.translation();
+    }
+
+    /**
+     * \brief Transform a point, p' = R p + t. The triple product dq (1 + e p) dq~ is replaced by the cross-product
+     * rotation of rotate() plus the translation extracted from the dual part.
+     * \param dq_in unit dual quaternion
+     * \param p point to transform
+     */
+    template<typename T>
+    constexpr std::array<T, 3> transform(const dualquaternion<T>& dq_in, const std::array<T, 3>& p) noexcept{
+
+        const auto t = dq_in.translation();
+        const auto v = rotate(dq_in.qr_, p);
+
+        return {v[0] + t[0], v[1] + t[1], v[2] + t[2]};
+    }
+}
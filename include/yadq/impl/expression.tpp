@@ -0,0 +1,114 @@
+#include <yadq/expression.hpp>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief Node type of an operand of the expression operators: quaternions become leaves
+         */
+        template<typename Q, typename = void>
+        struct as_expression{
+            using type = expr_leaf<Q>;
+        };
+
+        template<typename Q>
+        struct as_expression<Q, std::enable_if_t<is_quaternion_expression_v<Q>>>{
+            using type = Q;
+        };
+
+        /**
+         * \brief Components of the eager value of a node, normalising the unitary sums that were left pending.
+         * The normalisation is the one of quaternion::normalise().
+         */
+        template<typename E>
+        constexpr auto exact_raw(const E& e) noexcept{
+            auto r = e.raw();
+
+            if constexpr (!E::exact){
+                const double w = r[0], x = r[1], y = r[2], z = r[3];
+                if (const double d = math::sqrt(w * w + x * x + y * y + z * z); d != 0.0){
+                    r[0] /= d;
+                    r[1] /= d;
+                    r[2] /= d;
+                    r[3] /= d;
+                }
+            }
+            return r;
+        }
+
+        template<typename L, typename R>
+        constexpr std::array<typename L::value_type, 4> expr_product<L, R>::raw() const noexcept{
+            static_assert(std::is_same_v<typename L::value_type, typename R::value_type>, "Operands must share their value type");
+
+            if constexpr (is_quaternionU_v<result_type>){
+                return hamilton(lhv_.raw(), rhv_.raw());
+            }else{
+                return hamilton(exact_raw(lhv_), exact_raw(rhv_));
+            }
+        }
+
+        template<typename L, typename R, int Sign>
+        constexpr std::array<typename L::value_type, 4> expr_sum<L, R, Sign>::raw() const noexcept{
+            static_assert(std::is_same_v<typename L::value_type, typename R::value_type>, "Operands must share their value type");
+
+            const auto l = exact_raw(lhv_);
+            const auto r = exact_raw(rhv_);
+
+            if constexpr (Sign > 0){
+                return {l[0] + r[0], l[1] + r[1], l[2] + r[2], l[3] + r[3]};
+            }else{
+                return {l[0] - r[0], l[1] - r[1], l[2] - r[2], l[3] - r[3]};
+            }
+        }
+
+        template<typename E>
+        constexpr std::array<typename E::value_type, 4> expr_scale<E>::raw() const noexcept{
+            const auto r = exact_raw(e_);
+            return {value_type(r[0] * s_), value_type(r[1] * s_), value_type(r[2] * s_), value_type(r[3] * s_)};
+        }
+    }
+
+    template<typename E>
+    constexpr auto quaternion_expression<E>::eval() const noexcept{
+        using Q = typename E::result_type;
+
+        // The constructor of a quaternionU applies its policy: the single normalisation of the tree
+        const auto r = derived().raw();
+        return Q(r[0], r[1], r[2], r[3]);
+    }
+
+    /*
+        ------------------------------ Operators definition ------------------------------
+    */
+
+    template<typename L, typename R, std::enable_if_t<is_quaternion_expression_operands_v<L, R>, int>>
+    constexpr auto operator*(const L& lhv, const R& rhv) noexcept{
+        return detail::expr_product<typename detail::as_expression<L>::type, typename detail::as_expression<R>::type>(lhv, rhv);
+    }
+
+    template<typename L, typename R, std::enable_if_t<is_quaternion_expression_operands_v<L, R>, int>>
+    constexpr auto operator+(const L& lhv, const R& rhv) noexcept{
+        return detail::expr_sum<typename detail::as_expression<L>::type, typename detail::as_expression<R>::type, 1>(lhv, rhv);
+    }
+
+    template<typename L, typename R, std::enable_if_t<is_quaternion_expression_operands_v<L, R>, int>>
+    constexpr auto operator-(const L& lhv, const R& rhv) noexcept{
+        return detail::expr_sum<typename detail::as_expression<L>::type, typename detail::as_expression<R>::type, -1>(lhv, rhv);
+    }
+
+    template<typename E>
+    constexpr auto operator*(const quaternion_expression<E>& e, double s) noexcept{
+        return detail::expr_scale<E>(e.derived(), s);
+    }
+
+    template<typename E>
+    constexpr auto operator*(double s, const quaternion_expression<E>& e) noexcept{
+        return detail::expr_scale<E>(e.derived(), s);
+    }
+
+    template<typename E>
+    constexpr auto conjugate(const quaternion_expression<E>& e) noexcept{
+        return detail::expr_conjugate<E>(e.derived());
+    }
+}
@@ -0,0 +1,235 @@
+#include <yadq/frame_graph.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+namespace yadq{
+
+    template<typename T>
+    frame_graph<T>::frame_graph(std::string root_name):  parents_{root}, children_(1), depths_{0}, edges_(1), names_{std::move(root_name)},
+                                                        worlds_(1), stale_{0} {
+        if (!names_[root].empty()){
+            ids_.emplace(names_[root], root);
+        }
+    }
+
+    template<typename T>
+    void frame_graph<T>::check_frame(frame_id frame) const{
+        if (frame >= parents_.size()){
+            throw std::out_of_range("frame_graph: unknown frame");
+        }
+    }
+
+    template<typename T>
+    typename frame_graph<T>::frame_id frame_graph<T>::add_frame(frame_id parent, const value_type& parent_T_frame, std::string name){
+
+        const std::unique_lock<std::shared_mutex> lock(mutex_);
+
+        check_frame(parent);
+        if (!name.empty() && ids_.count(name) != 0){
+            throw std::invalid_argument("frame_graph: frame name already used");
+        }
+
+        const frame_id id = parents_.size();
+
+        parents_.push_back(parent);
+        children_.emplace_back();
+        children_[parent].push_back(id);
+        depths_.push_back(depths_[parent] + 1);
+        edges_.push_back(parent_T_frame);
+        if (!name.empty()){
+            ids_.emplace(name, id);
+        }
+        names_.push_back(std::move(name));
+
+        // Below a stale parent the new frame is stale too, otherwise its transform is one product away
+        stale_.push_back(stale_[parent]);
+        worlds_.push_back(stale_[parent] ? value_type() : worlds_[parent] * parent_T_frame);
+
+        return id;
+    }
+
+    template<typename T>
+    void frame_graph<T>::invalidate(frame_id frame){
+
+        std::vector<frame_id>& pending = scratch_;
+        pending.assign(1, frame);
+        while (!pending.empty()){
+            const frame_id k = pending.back();
+            pending.pop_back();
+
+            if (!stale_[k]){
+                stale_[k] = 1;
+                pending.insert(pending.end(), children_[k].begin(), children_[k].end());
+            }
+        }
+    }
+
+    template<typename T>
+    void frame_graph<T>::set_transform(frame_id frame, const value_type& parent_T_frame){
+        set_transforms(&frame, &parent_T_frame, 1);
+    }
+
+    template<typename T>
+    void frame_graph<T>::set_transforms(const frame_id* frames, const value_type* parent_T_frames, std::size_t n){
+
+        const std::unique_lock<std::shared_mutex> lock(mutex_);
+
+        for (std::size_t i = 0; i < n; ++i){
+            check_frame(frames[i]);
+            if (frames[i] == root){
+                throw std::invalid_argument("frame_graph: the root frame has no parent edge");
+            }
+        }
+
+        for (std::size_t i = 0; i < n; ++i){
+            edges_[frames[i]] = parent_T_frames[i];
+            invalidate(frames[i]);
+        }
+    }
+
+    template<typename T>
+    std::size_t frame_graph<T>::size() const{
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        return parents_.size();
+    }
+
+    template<typename T>
+    typename frame_graph<T>::frame_id frame_graph<T>::parent(frame_id frame) const{
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        check_frame(frame);
+        return parents_[frame];
+    }
+
+    template<typename T>
+    std::size_t frame_graph<T>::depth(frame_id frame) const{
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        check_frame(frame);
+        return depths_[frame];
+    }
+
+    template<typename T>
+    std::string frame_graph<T>::name(frame_id frame) const{
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        check_frame(frame);
+        return names_[frame];
+    }
+
+    template<typename T>
+    std::optional<typename frame_graph<T>::frame_id> frame_graph<T>::find(const std::string& name) const{
+
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+
+        const auto it = ids_.find(name);
+        if (it == ids_.end()){
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    template<typename T>
+    typename frame_graph<T>::value_type frame_graph<T>::transform(frame_id frame) const{
+        const std::shared_lock<std::shared_mutex> lock(mutex_);
+        check_frame(frame);
+        return edges_[frame];
+    }
+
+    template<typename T>
+    void frame_graph<T>::refresh_path(frame_id frame) const{
+
+        // The root is never stale: climb to the first fresh ancestor, then compose back down
+        std::vector<frame_id>& path = scratch_;
+        path.clear();
+        for (frame_id k = frame; stale_[k]; k = parents_[k]){
+            path.push_back(k);
+        }
+
+        for (auto it = path.rbegin(); it != path.rend(); ++it){
+            worlds_[*it] = worlds_[parents_[*it]] * edges_[*it];
+            stale_[*it] = 0;
+        }
+    }
+
+    template<typename T>
+    template<typename F>
+    auto frame_graph<T>::with_fresh(frame_id a, const frame_id* frames, std::size_t n, F&& f) const{
+
+        {
+            const std::shared_lock<std::shared_mutex> lock(mutex_);
+
+            check_frame(a);
+            bool fresh = !stale_[a];
+            for (std::size_t i = 0; i < n; ++i){
+                check_frame(frames[i]);
+                fresh = fresh && !stale_[frames[i]];
+            }
+            if (fresh){
+                return f();
+            }
+        }
+
+        // Frames are never removed, so the ids checked above stay valid
+        const std::unique_lock<std::shared_mutex> lock(mutex_);
+        refresh_path(a);
+        for (std::size_t i = 0; i < n; ++i){
+            refresh_path(frames[i]);
+        }
+        return f();
+    }
+
+    template<typename T>
+    typename frame_graph<T>::value_type frame_graph<T>::relative(frame_id a, frame_id b) const noexcept{
+        // The conjugate of a unit dual quaternion is its inverse
+        return a == root ? worlds_[b] : conjugate(worlds_[a]) * worlds_[b];
+    }
+
+    template<typename T>
+    typename frame_graph<T>::value_type frame_graph<T>::world(frame_id frame) const{
+        return with_fresh(frame, nullptr, 0, [&](){
+            return worlds_[frame];
+        });
+    }
+
+    template<typename T>
+    typename frame_graph<T>::value_type frame_graph<T>::lookup(frame_id a, frame_id b) const{
+
+        return with_fresh(a, &b, 1, [&](){
+            return relative(a, b);
+        });
+    }
+
+    template<typename T>
+    void frame_graph<T>::lookup(frame_id a, const frame_id* frames, value_type* out, std::size_t n) const{
+
+        with_fresh(a, frames, n, [&](){
+            const value_type a_T_root = conjugate(worlds_[a]);
+            for (std::size_t i = 0; i < n; ++i){
+                out[i] = a_T_root * worlds_[frames[i]];
+            }
+            return n;
+        });
+    }
+
+    template<typename T>
+    std::vector<typename frame_graph<T>::value_type> frame_graph<T>::lookup(frame_id a, const std::vector<frame_id>& frames) const{
+
+        std::vector<value_type> out(frames.size());
+        lookup(a, frames.data(), out.data(), frames.size());
+
+        return out;
+    }
+
+    template<typename T>
+    void frame_graph<T>::refresh(){
+
+        const std::unique_lock<std::shared_mutex> lock(mutex_);
+
+        // Parents have smaller ids than their children, so one pass in id order sees every parent fresh
+        for (frame_id k = 1; k < parents_.size(); ++k){
+            if (stale_[k]){
+                worlds_[k] = worlds_[parents_[k]] * edges_[k];
+                stale_[k] = 0;
+            }
+        }
+    }
+}
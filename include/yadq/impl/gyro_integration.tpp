@@ -0,0 +1,225 @@
+#include <yadq/gyro_integration.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief One integration step of the quaternion (w, x, y, z) between the rates a and b, for V a scalar or
+         * a simd pack. Returns the squared half angle of the exponential, so that pack callers can redo the lanes
+         * beyond the series of exp_rotation (always 0 for rk4).
+         */
+        template<integration_scheme S, typename T, typename V>
+        inline V gyro_step(V& w, V& x, V& y, V& z, V ax, V ay, V az, V bx, V by, V bz, V dt) noexcept{
+
+            using std::sqrt;
+
+            const V half = splat<V>(T(0.5));
+
+            if constexpr (S == integration_scheme::rk4){
+                // dq/dt = q (0, omega) / 2
+                const auto derivative = [half](V qw, V qx, V qy, V qz, V ox, V oy, V oz, V& dw, V& dx, V& dy, V& dz){
+                    dw = -half * (qx * ox + qy * oy + qz * oz);
+                    dx = half * (qw * ox + (qy * oz - qz * oy));
+                    dy = half * (qw * oy + (qz * ox - qx * oz));
+                    dz = half * (qw * oz + (qx * oy - qy * ox));
+                };
+
+                const V mx = half * (ax + bx), my = half * (ay + by), mz = half * (az + bz);
+                const V h = half * dt;
+
+                V k1w, k1x, k1y, k1z, k2w, k2x, k2y, k2z, k3w, k3x, k3y, k3z, k4w, k4x, k4y, k4z;
+
+                derivative(w, x, y, z, ax, ay, az, k1w, k1x, k1y, k1z);
+                derivative(w + h * k1w, x + h * k1x, y + h * k1y, z + h * k1z, mx, my, mz, k2w, k2x, k2y, k2z);
+                derivative(w + h * k2w, x + h * k2x, y + h * k2y, z + h * k2z, mx, my, mz, k3w, k3x, k3y, k3z);
+                derivative(w + dt * k3w, x + dt * k3x, y + dt * k3y, z + dt * k3z, bx, by, bz, k4w, k4x, k4y, k4z);
+
+                const V s = dt * splat<V>(T(1) / 6);
+                const V two = splat<V>(T(2));
+
+                w = w + s * (k1w + two * (k2w + k3w) + k4w);
+                x = x + s * (k1x + two * (k2x + k3x) + k4x);
+                y = y + s * (k1y + two * (k2y + k3y) + k4y);
+                z = z + s * (k1z + two * (k2z + k3z) + k4z);
+
+                const V inv = splat<V>(T(1)) / sqrt(w * w + x * x + y * y + z * z);
+                w = w * inv; x = x * inv; y = y * inv; z = z * inv;
+
+                return splat<V>(T(0));
+            }else{
+                // Rotation vector of the step: mean rate, plus the coning term for magnus
+                const V h = half * dt;
+                V rx = h * (ax + bx), ry = h * (ay + by), rz = h * (az + bz);
+
+                if constexpr (S == integration_scheme::magnus){
+                    const V c = dt * dt * splat<V>(T(1) / 12);
+                    rx = rx + c * (ay * bz - az * by);
+                    ry = ry + c * (az * bx - ax * bz);
+                    rz = rz + c * (ax * by - ay * bx);
+                }
+
+                const V u = (rx * rx + ry * ry + rz * rz) * splat<V>(T(0.25));
+
+                V ew, ex, ey, ez;
+                exp_rotation<T>(rx, ry, rz, u, ew, ex, ey, ez);
+
+                // q e, then an exact renormalisation against the drift of repeated products
+                V rw = w * ew - x * ex - y * ey - z * ez;
+                V rx_ = w * ex + x * ew + y * ez - z * ey;
+                V ry_ = w * ey - x * ez + y * ew + z * ex;
+                V rz_ = w * ez + x * ey - y * ex + z * ew;
+
+                const V inv = splat<V>(T(1)) / sqrt(rw * rw + rx_ * rx_ + ry_ * ry_ + rz_ * rz_);
+                w = rw * inv; x = rx_ * inv; y = ry_ * inv; z = rz_ * inv;
+
+                return u;
+            }
+        }
+
+        /**
+         * \brief Call f with the scheme as a compile-time constant
+         */
+        template<typename F>
+        inline void dispatch_scheme(integration_scheme scheme, F&& f){
+            switch (scheme){
+                case integration_scheme::exponential: f(std::integral_constant<integration_scheme, integration_scheme::exponential>{}); break;
+                case integration_scheme::magnus: f(std::integral_constant<integration_scheme, integration_scheme::magnus>{}); break;
+                case integration_scheme::rk4: f(std::integral_constant<integration_scheme, integration_scheme::rk4>{}); break;
+            }
+        }
+    }
+
+    namespace simd{
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /**
+             * \brief Integrate the Pk::width quaternions starting at i. Lanes rotating by more than the series of
+             * exp_rotation covers (pi / 2 per step) are redone one by one with the scalar step.
+             */
+            template<typename Pk, integration_scheme S, typename T>
+            inline void integrate_block(quaternion_lanes<T> q, point_lanes<const T> a, point_lanes<const T> b, T dt, std::size_t i) noexcept{
+
+                constexpr std::size_t W = Pk::width;
+
+                const Pk w0 = Pk::load_unaligned(q.w + i), x0 = Pk::load_unaligned(q.x + i), y0 = Pk::load_unaligned(q.y + i), z0 = Pk::load_unaligned(q.z + i);
+
+                Pk w = w0, x = x0, y = y0, z = z0;
+                const Pk u = detail::gyro_step<S, T>(   w, x, y, z,
+                                                        Pk::load_unaligned(a.x + i), Pk::load_unaligned(a.y + i), Pk::load_unaligned(a.z + i),
+                                                        Pk::load_unaligned(b.x + i), Pk::load_unaligned(b.y + i), Pk::load_unaligned(b.z + i),
+                                                        Pk::broadcast(dt));
+
+                w.store_unaligned(q.w + i);
+                x.store_unaligned(q.x + i);
+                y.store_unaligned(q.y + i);
+                z.store_unaligned(q.z + i);
+
+                if constexpr (S != integration_scheme::rk4){
+                    alignas(alignment) T u_lanes[W];
+                    u.store(u_lanes);
+
+                    bool large = false;
+                    for (std::size_t j = 0; j < W; ++j){
+                        large |= !(u_lanes[j] <= detail::series_half_angle_sq<T>);
+                    }
+
+                    if (large){
+                        alignas(alignment) T old[4][W];
+                        w0.store(old[0]);
+                        x0.store(old[1]);
+                        y0.store(old[2]);
+                        z0.store(old[3]);
+
+                        for (std::size_t j = 0; j < W; ++j){
+                            if (!(u_lanes[j] <= detail::series_half_angle_sq<T>)){
+                                const std::size_t k = i + j;
+                                T sw = old[0][j], sx = old[1][j], sy = old[2][j], sz = old[3][j];
+
+                                detail::gyro_step<S, T>(sw, sx, sy, sz, a.x[k], a.y[k], a.z[k], b.x[k], b.y[k], b.z[k], dt);
+
+                                q.w[k] = sw;
+                                q.x[k] = sx;
+                                q.y[k] = sy;
+                                q.z[k] = sz;
+                            }
+                        }
+                    }
+                }
+            }
+
+            template<integration_scheme S, typename T>
+            void integrate(quaternion_lanes<T> q, point_lanes<const T> a, point_lanes<const T> b, T dt, std::size_t begin, std::size_t end) noexcept{
+
+                std::size_t i = begin;
+
+                for (; i + pack<T>::width <= end; i += pack<T>::width){
+                    integrate_block<pack<T>, S>(q, a, b, dt, i);
+                }
+
+                for (; i < end; ++i){
+                    integrate_block<scalar_pack<T>, S>(q, a, b, dt, i);
+                }
+            }
+        }
+    }
+
+    template<typename T, typename P>
+    quaternionU<T, P> integrate(const quaternionU<T, P>& q_in, const std::array<T, 3>& omega0, const std::array<T, 3>& omega1, T dt, integration_scheme scheme) noexcept{
+
+        T w = q_in.w(), x = q_in.x(), y = q_in.y(), z = q_in.z();
+
+        detail::dispatch_scheme(scheme, [&](auto s){
+            detail::gyro_step<decltype(s)::value, T>(w, x, y, z, omega0[0], omega0[1], omega0[2], omega1[0], omega1[1], omega1[2], dt);
+        });
+
+        return quaternionU<T, P>(w, x, y, z);
+    }
+
+    template<typename T>
+    void integrate( quaternion_batch<T>& q, detail::non_deduced_t<point_lanes<const T>> omega0, detail::non_deduced_t<point_lanes<const T>> omega1,
+                    detail::non_deduced_t<T> dt, integration_scheme scheme, const parallel_config& config){
+
+        const quaternion_lanes<T> lanes = q.lanes();
+
+        detail::dispatch_scheme(scheme, [&](auto s){
+            detail::parallel_for(q.size(), config, [&](std::size_t begin, std::size_t end){
+                simd::integrate<decltype(s)::value>(lanes, omega0, omega1, dt, begin, end);
+            });
+        });
+    }
+
+    /*
+        ------------------------------ gyro_integrator ------------------------------
+    */
+
+    template<typename _T>
+    gyro_integrator<_T>::gyro_integrator(std::size_t sensors, integration_scheme scheme): gyro_integrator(quaternion_batch<_T>(sensors), scheme) {}
+
+    template<typename _T>
+    gyro_integrator<_T>::gyro_integrator(quaternion_batch<_T> orientations, integration_scheme scheme): orientations_(std::move(orientations)), scheme_(scheme){
+        for (auto& r : rates_){
+            r.resize(orientations_.size());
+        }
+    }
+
+    template<typename _T>
+    void gyro_integrator<_T>::update(point_lanes<const _T> omega, _T dt, const parallel_config& config){
+
+        const std::size_t n = orientations_.size();
+
+        const point_lanes<const _T> previous = primed_ ? point_lanes<const _T>{rates_[0].data(), rates_[1].data(), rates_[2].data()} : omega;
+
+        integrate(orientations_, previous, omega, dt, scheme_, config);
+
+        std::copy_n(omega.x, n, rates_[0].data());
+        std::copy_n(omega.y, n, rates_[1].data());
+        std::copy_n(omega.z, n, rates_[2].data());
+        primed_ = true;
+    }
+}
@@ -0,0 +1,413 @@
+#include <yadq/mean.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief Unit eigenvector of the largest eigenvalue of the symmetric 4x4 matrix given by its distinct
+         * entries (a00, a01, a02, a03, a11, a12, a13, a22, a23, a33), by cyclic Jacobi rotations
+         */
+        inline std::array<double, 4> dominant_eigenvector(const std::array<double, 10>& m) noexcept{
+
+            double a[4][4] = {  {m[0], m[1], m[2], m[3]},
+                                {m[1], m[4], m[5], m[6]},
+                                {m[2], m[5], m[7], m[8]},
+                                {m[3], m[6], m[8], m[9]}};
+            double v[4][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+
+            for (int sweep = 0; sweep < 32; ++sweep){
+
+                double off = 0, diag = 0;
+                for (int p = 0; p < 4; ++p){
+                    diag += a[p][p] * a[p][p];
+                    for (int q = p + 1; q < 4; ++q){
+                        off += a[p][q] * a[p][q];
+                    }
+                }
+
+                if (!(off > 1e-32 * diag)){
+                    break;
+                }
+
+                for (int p = 0; p < 3; ++p){
+                    for (int q = p + 1; q < 4; ++q){
+                        if (a[p][q] == 0){
+                            continue;
+                        }
+
+                        // Rotation in the (p, q) plane cancelling a[p][q]
+                        const double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+                        const double t = std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                        const double c = 1 / std::sqrt(t * t + 1);
+                        const double s = t * c;
+
+                        for (int k = 0; k < 4; ++k){
+                            const double akp = a[k][p], akq = a[k][q];
+                            a[k][p] = c * akp - s * akq;
+                            a[k][q] = s * akp + c * akq;
+                        }
+                        for (int k = 0; k < 4; ++k){
+                            const double apk = a[p][k], aqk = a[q][k];
+                            a[p][k] = c * apk - s * aqk;
+                            a[q][k] = s * apk + c * aqk;
+                        }
+                        for (int k = 0; k < 4; ++k){
+                            const double vkp = v[k][p], vkq = v[k][q];
+                            v[k][p] = c * vkp - s * vkq;
+                            v[k][q] = s * vkp + c * vkq;
+                        }
+                    }
+                }
+            }
+
+            int best = 0;
+            for (int k = 1; k < 4; ++k){
+                if (a[k][k] > a[best][best]){
+                    best = k;
+                }
+            }
+
+            const double sign = v[0][best] < 0 ? -1.0 : 1.0;
+            return {sign * v[0][best], sign * v[1][best], sign * v[2][best], sign * v[3][best]};
+        }
+
+        /**
+         * \brief Quaternion of w >= 0 from a non-zero direction of R^4
+         */
+        template<typename T>
+        quaternionU<T> unit_from(double w, double x, double y, double z){
+
+            const double norm = std::sqrt(w * w + x * x + y * y + z * z);
+
+            if (!(norm > 0)){
+                throw std::invalid_argument("mean: the samples cancel out");
+            }
+
+            const double s = (w < 0 ? -1.0 : 1.0) / norm;
+            return quaternionU<T>(T(s * w), T(s * x), T(s * y), T(s * z));
+        }
+
+        inline void check_mean_input(std::size_t count, double weight){
+            if (count == 0){
+                throw std::invalid_argument("mean: no samples");
+            }
+            if (!(weight != 0)){
+                throw std::invalid_argument("mean: the total weight is zero");
+            }
+        }
+    }
+
+    namespace simd{
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /**
+             * \brief Add to `sums` the N sums computed by f(acc, i) over [begin, end). f accumulates element i into
+             * an std::array of N packs, wide or scalar. Partial sums are kept in T over blocks of a few hundred
+             * elements only, and added to the double totals in between.
+             */
+            template<typename T, std::size_t N, typename F>
+            void block_sums(std::size_t begin, std::size_t end, std::array<double, N>& sums, F&& f){
+
+                constexpr std::size_t W = pack<T>::width;
+                constexpr std::size_t block = 512;
+
+                for (std::size_t b = begin; b < end; b += block){
+                    const std::size_t e = std::min(end, b + block);
+
+                    std::array<pack<T>, N> acc;
+                    std::array<scalar_pack<T>, N> tail;
+                    acc.fill(pack<T>::broadcast(T(0)));
+                    tail.fill(scalar_pack<T>::broadcast(T(0)));
+
+                    std::size_t i = b;
+                    for (; i + W <= e; i += W){
+                        f(acc, i);
+                    }
+                    for (; i < e; ++i){
+                        f(tail, i);
+                    }
+
+                    for (std::size_t k = 0; k < N; ++k){
+                        alignas(alignment) T lanes[W];
+                        T t;
+                        acc[k].store(lanes);
+                        tail[k].store(&t);
+
+                        double s = t;
+                        for (std::size_t j = 0; j < W; ++j){
+                            s += lanes[j];
+                        }
+                        sums[k] += s;
+                    }
+                }
+            }
+
+            /**
+             * \brief Distinct entries of sum_i w_i q_i q_i^T over [begin, end), unit weights when weights is null
+             */
+            template<typename T>
+            void markley_moments(quaternion_lanes<const T> q, const T* weights, std::size_t begin, std::size_t end, std::array<double, 10>& m){
+
+                block_sums<T>(begin, end, m, [&](auto& acc, std::size_t i){
+                    using Pk = typename std::decay_t<decltype(acc)>::value_type;
+
+                    const Pk w = Pk::load_unaligned(q.w + i), x = Pk::load_unaligned(q.x + i);
+                    const Pk y = Pk::load_unaligned(q.y + i), z = Pk::load_unaligned(q.z + i);
+
+                    Pk ww = w, wx = x, wy = y, wz = z;
+                    if (weights != nullptr){
+                        const Pk k = Pk::load_unaligned(weights + i);
+                        ww = k * w; wx = k * x; wy = k * y; wz = k * z;
+                    }
+
+                    acc[0] = acc[0] + ww * w;
+                    acc[1] = acc[1] + ww * x;
+                    acc[2] = acc[2] + ww * y;
+                    acc[3] = acc[3] + ww * z;
+                    acc[4] = acc[4] + wx * x;
+                    acc[5] = acc[5] + wx * y;
+                    acc[6] = acc[6] + wx * z;
+                    acc[7] = acc[7] + wy * y;
+                    acc[8] = acc[8] + wy * z;
+                    acc[9] = acc[9] + wz * z;
+                });
+            }
+
+            /**
+             * \brief Sum over [begin, end) of the weighted samples, each flipped to the hemisphere of r
+             */
+            template<typename T>
+            void aligned_sum(quaternion_lanes<const T> q, const T* weights, const std::array<T, 4>& r, std::size_t begin, std::size_t end, std::array<double, 4>& s){
+
+                block_sums<T>(begin, end, s, [&](auto& acc, std::size_t i){
+                    using Pk = typename std::decay_t<decltype(acc)>::value_type;
+
+                    const Pk w = Pk::load_unaligned(q.w + i), x = Pk::load_unaligned(q.x + i);
+                    const Pk y = Pk::load_unaligned(q.y + i), z = Pk::load_unaligned(q.z + i);
+
+                    const Pk dot = Pk::broadcast(r[0]) * w + Pk::broadcast(r[1]) * x + Pk::broadcast(r[2]) * y + Pk::broadcast(r[3]) * z;
+                    const Pk one = Pk::broadcast(T(1));
+                    Pk k = select_gt(-dot, Pk::broadcast(T(0)), -one, one);
+                    if (weights != nullptr){
+                        k = k * Pk::load_unaligned(weights + i);
+                    }
+
+                    acc[0] = acc[0] + k * w;
+                    acc[1] = acc[1] + k * x;
+                    acc[2] = acc[2] + k * y;
+                    acc[3] = acc[3] + k * z;
+                });
+            }
+        }
+    }
+
+    namespace detail {
+
+        /**
+         * \brief Run f(begin, end, partial) on the chunks of [0, n), one partial per thread, and return the sum
+         * of the partials in chunk order
+         */
+        template<std::size_t N, typename F>
+        std::array<double, N> parallel_sums(std::size_t n, const parallel_config& config, F&& f){
+
+            const unsigned chunks = thread_count(n, config);
+            std::vector<std::array<double, N>> partials(chunks, std::array<double, N>{});
+
+            parallel_chunks(n, chunks, [&](unsigned k, std::size_t begin, std::size_t end){
+                f(begin, end, partials[k]);
+            });
+
+            std::array<double, N> total{};
+            for (const auto& p : partials){
+                for (std::size_t k = 0; k < N; ++k){
+                    total[k] += p[k];
+                }
+            }
+            return total;
+        }
+
+        template<typename T>
+        double total_weight(const T* weights, std::size_t n){
+            if (weights == nullptr){
+                return static_cast<double>(n);
+            }
+
+            double total = 0;
+            for (std::size_t i = 0; i < n; ++i){
+                total += weights[i];
+            }
+            return total;
+        }
+    }
+
+    /*
+        ------------------------------ quaternion_accumulator ------------------------------
+    */
+
+    template<typename _T>
+    template<typename P>
+    void quaternion_accumulator<_T>::add(const quaternionU<_T, P>& q_in, _T weight) noexcept{
+
+        const double w = q_in.w(), x = q_in.x(), y = q_in.y(), z = q_in.z();
+        const double k = weight;
+
+        moments_[0] += k * w * w;
+        moments_[1] += k * w * x;
+        moments_[2] += k * w * y;
+        moments_[3] += k * w * z;
+        moments_[4] += k * x * x;
+        moments_[5] += k * x * y;
+        moments_[6] += k * x * z;
+        moments_[7] += k * y * y;
+        moments_[8] += k * y * z;
+        moments_[9] += k * z * z;
+
+        weight_ += k;
+        ++count_;
+    }
+
+    template<typename _T>
+    void quaternion_accumulator<_T>::add(const quaternion_batch<_T>& q_in, const _T* weights, const parallel_config& config){
+
+        const quaternion_lanes<const _T> lanes = q_in.lanes();
+
+        const auto m = detail::parallel_sums<10>(q_in.size(), config, [&](std::size_t begin, std::size_t end, std::array<double, 10>& partial){
+            simd::markley_moments(lanes, weights, begin, end, partial);
+        });
+
+        for (std::size_t k = 0; k < 10; ++k){
+            moments_[k] += m[k];
+        }
+
+        weight_ += detail::total_weight(weights, q_in.size());
+        count_ += q_in.size();
+    }
+
+    template<typename _T>
+    quaternion_accumulator<_T>& quaternion_accumulator<_T>::merge(const quaternion_accumulator& other) noexcept{
+
+        for (std::size_t k = 0; k < 10; ++k){
+            moments_[k] += other.moments_[k];
+        }
+
+        weight_ += other.weight_;
+        count_ += other.count_;
+        return *this;
+    }
+
+    template<typename _T>
+    quaternionU<_T> quaternion_accumulator<_T>::mean() const{
+
+        detail::check_mean_input(count_, weight_);
+
+        const auto v = detail::dominant_eigenvector(moments_);
+        return detail::unit_from<_T>(v[0], v[1], v[2], v[3]);
+    }
+
+    /*
+        ------------------------------ Free functions ------------------------------
+    */
+
+    template<typename T>
+    quaternionU<T> mean(const quaternion_batch<T>& q_in, const parallel_config& config){
+
+        quaternion_accumulator<T> acc;
+        acc.add(q_in, nullptr, config);
+        return acc.mean();
+    }
+
+    template<typename T>
+    quaternionU<T> mean(const quaternion_batch<T>& q_in, const detail::non_deduced_t<T>* weights, const parallel_config& config){
+
+        quaternion_accumulator<T> acc;
+        acc.add(q_in, weights, config);
+        return acc.mean();
+    }
+
+    template<typename It, typename>
+    auto mean(It first, It last){
+
+        using Q = typename std::iterator_traits<It>::value_type;
+
+        quaternion_accumulator<typename Q::value_type> acc;
+        for (; first != last; ++first){
+            acc.add(*first);
+        }
+
+        const auto m = acc.mean();
+        return Q(m.w(), m.x(), m.y(), m.z());
+    }
+
+    template<typename T>
+    quaternionU<T> iterative_mean(  const quaternion_batch<T>& q_in, const detail::non_deduced_t<T>* weights,
+                                    const mean_options& options, const parallel_config& config){
+
+        const std::size_t n = q_in.size();
+        detail::check_mean_input(n, detail::total_weight(weights, n));
+
+        const quaternion_lanes<const T> lanes = q_in.lanes();
+
+        // Chordal mean, from the first sample: the estimate only changes when a sample changes hemisphere
+        std::array<double, 4> r = {lanes.w[0], lanes.x[0], lanes.y[0], lanes.z[0]};
+
+        for (std::size_t it = 0; it < options.max_iterations; ++it){
+            const std::array<T, 4> r_t = {T(r[0]), T(r[1]), T(r[2]), T(r[3])};
+
+            const auto s = detail::parallel_sums<4>(n, config, [&](std::size_t begin, std::size_t end, std::array<double, 4>& partial){
+                simd::aligned_sum(lanes, weights, r_t, begin, end, partial);
+            });
+
+            const double norm = std::sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2] + s[3] * s[3]);
+            if (!(norm > 0)){
+                throw std::invalid_argument("mean: the samples cancel out");
+            }
+
+            const std::array<double, 4> next = {s[0] / norm, s[1] / norm, s[2] / norm, s[3] / norm};
+            const bool stable = (next == r);
+            r = next;
+
+            if (stable){
+                break;
+            }
+        }
+
+        if (options.metric == mean_metric::chordal){
+            return detail::unit_from<T>(r[0], r[1], r[2], r[3]);
+        }
+
+        // Karcher mean: gradient steps along the mean rotation vector of the samples seen from the estimate
+        quaternionU<double> m(r[0], r[1], r[2], r[3]);
+        const double inv_weight = 1 / detail::total_weight(weights, n);
+
+        for (std::size_t it = 0; it < options.max_iterations; ++it){
+            auto m_inv = m;
+            m_inv.conjugate();
+
+            const auto s = detail::parallel_sums<3>(n, config, [&](std::size_t begin, std::size_t end, std::array<double, 3>& partial){
+                for (std::size_t i = begin; i < end; ++i){
+                    const double k = weights != nullptr ? double(weights[i]) : 1.0;
+                    const auto v = log_map(m_inv * quaternionU<double>(lanes.w[i], lanes.x[i], lanes.y[i], lanes.z[i]));
+                    partial[0] += k * v[0];
+                    partial[1] += k * v[1];
+                    partial[2] += k * v[2];
+                }
+            });
+
+            const std::array<double, 3> step = {s[0] * inv_weight, s[1] * inv_weight, s[2] * inv_weight};
+            m = m * exp_map(step);
+
+            if (std::sqrt(step[0] * step[0] + step[1] * step[1] + step[2] * step[2]) <= options.tolerance){
+                break;
+            }
+        }
+
+        return detail::unit_from<T>(m.w(), m.x(), m.y(), m.z());
+    }
+}
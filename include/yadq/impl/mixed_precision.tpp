@@ -0,0 +1,187 @@
+#include <yadq/mixed_precision.hpp>
+
+#include <cmath>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief Error-free sum: s + e == a + b exactly, s being the rounded sum
+         */
+        template<typename T>
+        inline void two_sum(T a, T b, T& s, T& e) noexcept{
+            s = a + b;
+            const T bb = s - a;
+            e = (a - (s - bb)) + (b - bb);
+        }
+
+        /**
+         * \brief Error-free sum when |a| >= |b|
+         */
+        template<typename T>
+        inline void fast_two_sum(T a, T b, T& s, T& e) noexcept{
+            s = a + b;
+            e = b - (s - a);
+        }
+
+        /**
+         * \brief Error-free product: p + e == a * b exactly, p being the rounded product. A single FMA when the
+         * target has a fast one, Dekker's product on Veltkamp halves otherwise.
+         */
+        template<typename T>
+        inline void two_prod(T a, T b, T& p, T& e) noexcept{
+            p = a * b;
+#if defined(FP_FAST_FMA) && defined(FP_FAST_FMAF)
+            e = std::fma(a, b, -p);
+#else
+            // 2^12 + 1 for float, 2^27 + 1 for double
+            constexpr T split = std::is_same_v<T, float> ? T(4097) : T(134217729);
+
+            const T ca = split * a, cb = split * b;
+            const T a_hi = ca - (ca - a), a_lo = a - a_hi;
+            const T b_hi = cb - (cb - b), b_lo = b - b_hi;
+
+            e = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+#endif
+        }
+
+        /**
+         * \brief Hamilton product (hi + lo) * r in compensated arithmetic, the result as hi_out + lo_out. Every
+         * product and sum of the hi parts is error-free; the errors and the lo terms are summed in T. The outputs
+         * may alias the inputs.
+         */
+        template<typename T>
+        inline void compensated_hamilton(   const std::array<T, 4>& hi, const std::array<T, 4>& lo, const std::array<T, 4>& r,
+                                            std::array<T, 4>& hi_out, std::array<T, 4>& lo_out) noexcept{
+
+            YADQ_COUNT(hamilton_products);
+
+            // Component c is the sum over i of sign[c][i] * l[i] * r[index[c][i]]
+            constexpr std::size_t index[4][4] = {{0, 1, 2, 3}, {1, 0, 3, 2}, {2, 3, 0, 1}, {3, 2, 1, 0}};
+            constexpr T sign[4][4] = {{1, -1, -1, -1}, {1, 1, 1, -1}, {1, -1, 1, 1}, {1, 1, -1, 1}};
+
+            std::array<T, 4> h, l;
+
+            for (std::size_t c = 0; c < 4; ++c){
+                T sum = 0, err = 0;
+
+                for (std::size_t i = 0; i < 4; ++i){
+                    const T b = sign[c][i] * r[index[c][i]];
+
+                    T p, e_prod, e_sum;
+                    two_prod(hi[i], b, p, e_prod);
+                    two_sum(sum, p, sum, e_sum);
+
+                    err += e_sum + e_prod + lo[i] * b;
+                }
+
+                fast_two_sum(sum, err, h[c], l[c]);
+            }
+
+            hi_out = h;
+            lo_out = l;
+        }
+    }
+
+    template<accumulation A, typename Q, typename>
+    Q accurate_prod(const Q& q_lhv, const Q& q_rhv) noexcept{
+
+        using T = typename Q::value_type;
+
+        if constexpr (A == accumulation::wide){
+            const auto p = detail::hamilton<double>({q_lhv.w(), q_lhv.x(), q_lhv.y(), q_lhv.z()}, {q_rhv.w(), q_rhv.x(), q_rhv.y(), q_rhv.z()});
+
+            return Q(static_cast<T>(p[0]), static_cast<T>(p[1]), static_cast<T>(p[2]), static_cast<T>(p[3]));
+        }else{
+            std::array<T, 4> hi, lo;
+            detail::compensated_hamilton<T>({q_lhv.w(), q_lhv.x(), q_lhv.y(), q_lhv.z()}, {0, 0, 0, 0}, {q_rhv.w(), q_rhv.x(), q_rhv.y(), q_rhv.z()}, hi, lo);
+
+            // hi is the sum rounded to T: lo is below half an ULP of it
+            return Q(hi[0], hi[1], hi[2], hi[3]);
+        }
+    }
+
+    template<typename _T, accumulation _A>
+    composition_chain<_T, _A>::composition_chain(const quaternionU<_T>& q_start) noexcept{
+
+        if constexpr (_A == accumulation::wide){
+            this->q_ = {q_start.w(), q_start.x(), q_start.y(), q_start.z()};
+        }else{
+            this->hi_ = {q_start.w(), q_start.x(), q_start.y(), q_start.z()};
+        }
+    }
+
+    template<typename _T, accumulation _A>
+    template<typename Q, typename>
+    composition_chain<_T, _A>& composition_chain<_T, _A>::operator*=(const Q& q_in) noexcept{
+
+        if constexpr (_A == accumulation::wide){
+            this->q_ = detail::hamilton<double>(this->q_, {q_in.w(), q_in.x(), q_in.y(), q_in.z()});
+        }else{
+            detail::compensated_hamilton<_T>(this->hi_, this->lo_, {q_in.w(), q_in.x(), q_in.y(), q_in.z()}, this->hi_, this->lo_);
+        }
+
+        if (++size_ % rescale_period == 0){
+            rescale();
+        }
+
+        return (*this);
+    }
+
+    template<typename _T, accumulation _A>
+    void composition_chain<_T, _A>::rescale() noexcept{
+
+        if constexpr (_A == accumulation::wide){
+            auto& q = this->q_;
+            const double d = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+            if (d != 0.0){
+                for (auto& c : q){
+                    c /= d;
+                }
+            }
+        }else{
+            auto& hi = this->hi_;
+            auto& lo = this->lo_;
+            const _T d = std::sqrt(hi[0] * hi[0] + hi[1] * hi[1] + hi[2] * hi[2] + hi[3] * hi[3]);
+
+            if (d != 0){
+                // Any factor keeps the rotation: k only needs to be close to 1 / |q|, the scaling itself is exact
+                const _T k = _T(1) / d;
+
+                for (std::size_t c = 0; c < 4; ++c){
+                    _T p, e;
+                    detail::two_prod(hi[c], k, p, e);
+                    detail::fast_two_sum(p, e + lo[c] * k, hi[c], lo[c]);
+                }
+            }
+        }
+    }
+
+    template<typename _T, accumulation _A>
+    quaternionU<double> composition_chain<_T, _A>::value_wide() const noexcept{
+
+        if constexpr (_A == accumulation::wide){
+            const auto& q = this->q_;
+            return quaternionU<double>(q[0], q[1], q[2], q[3]);
+        }else{
+            const auto& hi = this->hi_;
+            const auto& lo = this->lo_;
+            return quaternionU<double>( double(hi[0]) + lo[0], double(hi[1]) + lo[1],
+                                        double(hi[2]) + lo[2], double(hi[3]) + lo[3]);
+        }
+    }
+
+    template<typename _T, accumulation _A>
+    quaternionU<_T> composition_chain<_T, _A>::value() const noexcept{
+
+        if constexpr (_A == accumulation::wide){
+            return quaternionU<_T>(value_wide());
+        }else{
+            // hi is the product rounded to T; normalising it accumulates the norm in double
+            const auto& hi = this->hi_;
+            return quaternionU<_T>(hi[0], hi[1], hi[2], hi[3]);
+        }
+    }
+}
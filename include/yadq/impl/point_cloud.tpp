@@ -0,0 +1,124 @@
+#include <yadq/point_cloud.hpp>
+
+namespace yadq{
+
+    namespace simd{
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /**
+             * \brief Apply p' = R p + t to n SoA points, R with the cross-product form used by rotate(q, v), any alignment
+             * \param q rotation as [w, x, y, z]
+             * \param t translation
+             */
+            template<typename T>
+            void transform_points(const std::array<T, 4>& q, const std::array<T, 3>& t, point_lanes<const T> in, point_lanes<T> out, std::size_t n) noexcept{
+
+                using Pk = pack<T>;
+
+                const Pk qw = Pk::broadcast(q[0]), qx = Pk::broadcast(q[1]), qy = Pk::broadcast(q[2]), qz = Pk::broadcast(q[3]);
+                const Pk px = Pk::broadcast(t[0]), py = Pk::broadcast(t[1]), pz = Pk::broadcast(t[2]);
+                const Pk two = Pk::broadcast(T(2));
+
+                std::size_t i = 0;
+
+                for (; i + Pk::width <= n; i += Pk::width){
+                    const Pk vx = Pk::load_unaligned(in.x + i), vy = Pk::load_unaligned(in.y + i), vz = Pk::load_unaligned(in.z + i);
+
+                    const Pk tx = two * (qy * vz - qz * vy);
+                    const Pk ty = two * (qz * vx - qx * vz);
+                    const Pk tz = two * (qx * vy - qy * vx);
+
+                    (vx + qw * tx + (qy * tz - qz * ty) + px).store_unaligned(out.x + i);
+                    (vy + qw * ty + (qz * tx - qx * tz) + py).store_unaligned(out.y + i);
+                    (vz + qw * tz + (qx * ty - qy * tx) + pz).store_unaligned(out.z + i);
+                }
+
+                for (; i < n; ++i){
+                    const T vx = in.x[i], vy = in.y[i], vz = in.z[i];
+
+                    const T tx = 2 * (q[2] * vz - q[3] * vy);
+                    const T ty = 2 * (q[3] * vx - q[1] * vz);
+                    const T tz = 2 * (q[1] * vy - q[2] * vx);
+
+                    out.x[i] = vx + q[0] * tx + (q[2] * tz - q[3] * ty) + t[0];
+                    out.y[i] = vy + q[0] * ty + (q[3] * tx - q[1] * tz) + t[1];
+                    out.z[i] = vz + q[0] * tz + (q[1] * ty - q[2] * tx) + t[2];
+                }
+            }
+
+            /**
+             * \brief Transform n interleaved xyz points. Transposing blocks to SoA costs more than it saves on a
+             * memory-bound stream, so this is a plain loop over the same formula that the compiler vectorises.
+             */
+            template<typename T>
+            void transform_points_interleaved(const std::array<T, 4>& q, const std::array<T, 3>& t, const T* in, T* out, std::size_t n) noexcept{
+
+                const T qw = q[0], qx = q[1], qy = q[2], qz = q[3];
+                const T px = t[0], py = t[1], pz = t[2];
+
+                for (std::size_t i = 0; i < n; ++i){
+                    const T vx = in[3 * i], vy = in[3 * i + 1], vz = in[3 * i + 2];
+
+                    const T tx = 2 * (qy * vz - qz * vy);
+                    const T ty = 2 * (qz * vx - qx * vz);
+                    const T tz = 2 * (qx * vy - qy * vx);
+
+                    out[3 * i] = vx + qw * tx + (qy * tz - qz * ty) + px;
+                    out[3 * i + 1] = vy + qw * ty + (qz * tx - qx * tz) + py;
+                    out[3 * i + 2] = vz + qw * tz + (qx * ty - qy * tx) + pz;
+                }
+            }
+        }
+    }
+
+    namespace detail {
+
+        template<typename T>
+        void transform_points(const std::array<T, 4>& q, const std::array<T, 3>& t, const T* points_in, T* points_out, std::size_t n, const parallel_config& config){
+
+            parallel_for(n, config, [&](std::size_t begin, std::size_t end){
+                simd::transform_points_interleaved<T>(q, t, points_in + 3 * begin, points_out + 3 * begin, end - begin);
+            });
+        }
+
+        template<typename T>
+        void transform_points(const std::array<T, 4>& q, const std::array<T, 3>& t, point_lanes<const T> points_in, point_lanes<T> points_out, std::size_t n, const parallel_config& config){
+
+            parallel_for(n, config, [&](std::size_t begin, std::size_t end){
+                simd::transform_points<T>(  q, t,
+                                            point_lanes<const T>{points_in.x + begin, points_in.y + begin, points_in.z + begin},
+                                            point_lanes<T>{points_out.x + begin, points_out.y + begin, points_out.z + begin},
+                                            end - begin);
+            });
+        }
+    }
+
+    template<typename T, typename P>
+    void rotate(const quaternionU<T, P>& q_in, const detail::non_deduced_t<T>* points_in, detail::non_deduced_t<T>* points_out, std::size_t n, const parallel_config& config){
+
+        detail::transform_points<T>({q_in.w(), q_in.x(), q_in.y(), q_in.z()}, {0, 0, 0}, points_in, points_out, n, config);
+    }
+
+    template<typename T, typename P>
+    void rotate(const quaternionU<T, P>& q_in, detail::non_deduced_t<point_lanes<const T>> points_in, detail::non_deduced_t<point_lanes<T>> points_out, std::size_t n, const parallel_config& config){
+
+        detail::transform_points<T>({q_in.w(), q_in.x(), q_in.y(), q_in.z()}, {0, 0, 0}, points_in, points_out, n, config);
+    }
+
+    template<typename T>
+    void transform(const dualquaternion<T>& dq_in, const detail::non_deduced_t<T>* points_in, detail::non_deduced_t<T>* points_out, std::size_t n, const parallel_config& config){
+
+        const auto& qr = dq_in.qr_;
+
+        detail::transform_points<T>({qr.w(), qr.x(), qr.y(), qr.z()}, dq_in.translation(), points_in, points_out, n, config);
+    }
+
+    template<typename T>
+    void transform(const dualquaternion<T>& dq_in, detail::non_deduced_t<point_lanes<const T>> points_in, detail::non_deduced_t<point_lanes<T>> points_out, std::size_t n, const parallel_config& config){
+
+        const auto& qr = dq_in.qr_;
+
+        detail::transform_points<T>({qr.w(), qr.x(), qr.y(), qr.z()}, dq_in.translation(), points_in, points_out, n, config);
+    }
+}
@@ -0,0 +1,169 @@
+#include <yadq/publication.hpp>
+
+#include <stdexcept>
+#include <thread>
+#include <yadq/slerp.hpp>
+#include <yadq/sclerp.hpp>
+
+namespace yadq{
+
+    /*
+        The writer makes the sequence odd, writes the words and makes it even again with a release store. A reader
+        loads the sequence with acquire, the words, then the sequence again: equal even sequences mean no store
+        overlapped the copy. A word read from an overlapping store was released after the odd sequence, so the
+        second load sees the sequence change; the words carry that ordering, no standalone fence is needed.
+    */
+
+    template<typename V>
+    void seqlock<V>::store(const V& v) noexcept{
+
+        const std::uint64_t s = seq_.load(std::memory_order_relaxed);
+
+        seq_.store(s + 1, std::memory_order_relaxed);
+        data_.store(v);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    template<typename V>
+    bool seqlock<V>::try_load(V& v) const noexcept{
+
+        const std::uint64_t s = seq_.load(std::memory_order_acquire);
+        if (s & 1){
+            return false;
+        }
+
+        data_.load(v);
+
+        return seq_.load(std::memory_order_relaxed) == s;
+    }
+
+    template<typename V>
+    V seqlock<V>::load() const noexcept{
+
+        V v;
+        for (unsigned attempt = 1; !try_load(v); ++attempt){
+            // A store takes a few nanoseconds: spin first, then let the writer run if it was preempted
+            if (attempt % 64 == 0){
+                std::this_thread::yield();
+            }
+        }
+        return v;
+    }
+
+    namespace detail {
+
+        /**
+         * \brief Value between a and b at u in [0, 1]; the value of a for types without an interpolation
+         */
+        template<typename V>
+        V interpolate_stamped(const V& a, const V&, double) noexcept{
+            return a;
+        }
+
+        template<typename T>
+        quaternionU<T> interpolate_stamped(const quaternionU<T>& a, const quaternionU<T>& b, double u) noexcept{
+            return slerp_plan<T>(a, b)(static_cast<T>(u));
+        }
+
+        template<typename T>
+        dualquaternion<T> interpolate_stamped(const dualquaternion<T>& a, const dualquaternion<T>& b, double u) noexcept{
+            return sclerp_plan<T>(a, b)(static_cast<T>(u));
+        }
+    }
+
+    template<typename V>
+    pose_history<V>::pose_history(std::size_t capacity): capacity_(capacity){
+        if (capacity == 0){
+            throw std::invalid_argument("pose_history needs a capacity of at least one value");
+        }
+        slots_ = std::make_unique<slot[]>(capacity);
+    }
+
+    template<typename V>
+    void pose_history<V>::push(double time, const V& v){
+
+        const std::uint64_t i = head_.load(std::memory_order_relaxed);
+        if (i != 0 && !(time > last_time_)){
+            throw std::invalid_argument("pose_history timestamps must be strictly increasing");
+        }
+        last_time_ = time;
+
+        slot& s = slots_[i % capacity_];
+        s.seq.store(2 * i + 1, std::memory_order_relaxed);
+        s.data.store(stamped<V>{time, v});
+        s.seq.store(2 * i + 2, std::memory_order_release);
+
+        head_.store(i + 1, std::memory_order_release);
+    }
+
+    template<typename V>
+    bool pose_history<V>::read(std::uint64_t i, stamped<V>& out) const noexcept{
+
+        const slot& s = slots_[i % capacity_];
+        const std::uint64_t expected = 2 * i + 2;
+
+        if (s.seq.load(std::memory_order_acquire) != expected){
+            return false;
+        }
+
+        s.data.load(out);
+
+        return s.seq.load(std::memory_order_relaxed) == expected;
+    }
+
+    template<typename V>
+    std::optional<stamped<V>> pose_history<V>::latest() const noexcept{
+
+        // The latest value can only be overwritten after capacity() more pushes: retry from the new head
+        for (;;){
+            const std::uint64_t n = head_.load(std::memory_order_acquire);
+            if (n == 0){
+                return std::nullopt;
+            }
+
+            stamped<V> out;
+            if (read(n - 1, out)){
+                return out;
+            }
+        }
+    }
+
+    template<typename V>
+    std::optional<V> pose_history<V>::at(double time) const noexcept{
+
+        const std::uint64_t n = head_.load(std::memory_order_acquire);
+        if (n == 0){
+            return std::nullopt;
+        }
+
+        // Last value at or before time, among the kept ones. Values overwritten during the search are older
+        // than all the others: the search moves past them, and the final reads check the bracket.
+        std::uint64_t lo = n > capacity_ ? n - capacity_ : 0;
+        std::uint64_t hi = n - 1;
+        stamped<V> probe;
+
+        while (lo < hi){
+            const std::uint64_t mid = lo + (hi - lo + 1) / 2;
+            if (!read(mid, probe) || probe.time <= time){
+                lo = mid;
+            }else{
+                hi = mid - 1;
+            }
+        }
+
+        stamped<V> a;
+        if (!read(lo, a) || a.time > time){
+            return std::nullopt;
+        }
+        if (a.time == time){
+            return a.value;
+        }
+
+        stamped<V> b;
+        if (lo + 1 == n || !read(lo + 1, b) || b.time < time){
+            return std::nullopt;
+        }
+
+        return detail::interpolate_stamped(a.value, b.value, (time - a.time) / (b.time - a.time));
+    }
+}
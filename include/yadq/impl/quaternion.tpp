@@ -7,6 +7,17 @@ namespace yadq{
     using quaternionUf = quaternionU<float>;
     using quaternionUd = quaternionU<double>;
 
+    namespace detail {
+
+        /**
+         * \brief Plain quaternion holding the observed components of q_in (no policy state)
+         */
+        template<typename T>
+        constexpr auto as_quaternion(const T& q_in) noexcept{
+            return quaternion<typename T::value_type>(q_in.w(), q_in.x(), q_in.y(), q_in.z());
+        }
+    }
+
     /*
         ------------------------------ Operators definition ------------------------------
     */ 
@@ -20,11 +31,7 @@ namespace yadq{
                     q_lhv.y() / rhv,
                     q_lhv.z() / rhv);
 
-       if constexpr (is_quaternionU_v<T>){
-            return normalise(q_res);
-        }else{
-            return q_res;
-        }
+        return q_res;
     }
 
     template<   typename T,
@@ -37,11 +44,7 @@ namespace yadq{
                     q_lhv.y() + q_rhv.y(),
                     q_lhv.z() + q_rhv.z());
 
-        if constexpr (is_quaternionU_v<T> && is_quaternionU_v<U>){
-            return normalise(q_res);
-        }else{
-            return q_res;
-        }
+        return q_res;
     }    
 
     template<   typename T,
@@ -50,11 +53,11 @@ namespace yadq{
     constexpr auto operator*(const T& q_lhv, const U& q_rhv) noexcept{
 
         if constexpr (is_quaternion_v<T> && is_quaternionU_v<U>){
-            return hamilton_prod(q_lhv, static_cast<T>(q_rhv));
+            return hamilton_prod(q_lhv, detail::as_quaternion(q_rhv));
         }
         
         if constexpr (is_quaternionU_v<T> && is_quaternion_v<U>){
-            return hamilton_prod(static_cast<U>(q_lhv), q_rhv);
+            return hamilton_prod(detail::as_quaternion(q_lhv), q_rhv);
         }
 
         if constexpr ((is_quaternionU_v<T> && is_quaternionU_v<U>) || (is_quaternion_v<T> && is_quaternion_v<U>)){
@@ -84,11 +87,7 @@ namespace yadq{
                     q_lhv.y() - q_rhv.y(),
                     q_lhv.z() - q_rhv.z());
 
-        if constexpr (is_quaternionU_v<T> && is_quaternionU_v<U>){
-            return normalise(q_res);
-        }else{
-            return q_res;
-        }
+        return q_res;
     }
 
     /*
@@ -99,6 +98,8 @@ namespace yadq{
                 typename =  std::enable_if_t<is_base_of_quaternion_v<T>>>
     constexpr auto normalise(const T& q_in) noexcept{
 
+        YADQ_COUNT(normalisations);
+
         if(auto d = q_in.norm(); d != 0.0) {
 
             T q_res(    q_in.w() / d, 
@@ -112,6 +113,27 @@ namespace yadq{
   
     }
 
+    /**
+     * \brief Bring a quaternion close to unit norm, e.g. the product of two unitary quaternions, back to it with the
+     * given strategy (see norm_strategy for the error bounds)
+     */
+    template<norm_strategy S, typename T>
+    constexpr quaternion<T> renormalise(const quaternion<T>& q_in) noexcept{
+
+        if constexpr (S == norm_strategy::exact){
+            quaternion<T> q_res(q_in);
+            q_res.normalise();
+            return q_res;
+        }else{
+            YADQ_COUNT(normalisations);
+
+            const T w = q_in.w(), x = q_in.x(), y = q_in.y(), z = q_in.z();
+            const T k = detail::inverse_norm<S>(w * w + x * x + y * y + z * z);
+
+            return quaternion<T>(w * k, x * k, y * k, z * k);
+        }
+    }
+
     template<typename T>
     std::ostream& operator<<(std::ostream &os, const quaternion<T>& q_in) noexcept{ 
         return os << "w: " << q_in.w() << " x: " << q_in.x() << " y: " << q_in.y() << " z: " << q_in.z();
@@ -121,26 +143,36 @@ namespace yadq{
                 typename =  std::enable_if_t<is_base_of_quaternion_v<T>>>
     constexpr inline auto hamilton_prod(const T& q_lhv, const T& q_rhv) noexcept{
 
-        T q_res(    q_lhv.w() * q_rhv.w() - q_lhv.x() * q_rhv.x() - q_lhv.y() * q_rhv.y() - q_lhv.z() * q_rhv.z(),
-                    q_lhv.w() * q_rhv.x() + q_lhv.x() * q_rhv.w() + q_lhv.y() * q_rhv.z() - q_lhv.z() * q_rhv.y(),
-                    q_lhv.w() * q_rhv.y() - q_lhv.x() * q_rhv.z() + q_lhv.y() * q_rhv.w() + q_lhv.z() * q_rhv.x(),
-                    q_lhv.w() * q_rhv.z() + q_lhv.x() * q_rhv.y() - q_lhv.y() * q_rhv.x() + q_lhv.z() * q_rhv.w());
+        if constexpr (is_quaternionU_v<T>){
+            // Unitary products go through the normalisation policy
+            T q_res(q_lhv);
+            q_res *= q_rhv;
+            return q_res;
+        }else{
+            YADQ_COUNT(hamilton_products);
 
-        return q_res;
+            T q_res(    q_lhv.w() * q_rhv.w() - q_lhv.x() * q_rhv.x() - q_lhv.y() * q_rhv.y() - q_lhv.z() * q_rhv.z(),
+                        q_lhv.w() * q_rhv.x() + q_lhv.x() * q_rhv.w() + q_lhv.y() * q_rhv.z() - q_lhv.z() * q_rhv.y(),
+                        q_lhv.w() * q_rhv.y() - q_lhv.x() * q_rhv.z() + q_lhv.y() * q_rhv.w() + q_lhv.z() * q_rhv.x(),
+                        q_lhv.w() * q_rhv.z() + q_lhv.x() * q_rhv.y() - q_lhv.y() * q_rhv.x() + q_lhv.z() * q_rhv.w());
+
+            return q_res;
+        }
     }
 
 
-    template< typename T>
-    constexpr auto inverse(const quaternionU<T>& q_in) {
+    template< typename T, typename P>
+    constexpr auto inverse(const quaternionU<T, P>& q_in) {
 
         if(!q_in.empty()){
-            quaternionU<T> q_conj = q_in;
+            quaternionU<T, P> q_conj = q_in;
             q_conj.conjugate();
 
-            return q_conj / pow(q_in.norm(), 2);
+            const auto n = q_in.norm();
+            return q_conj / (n * n);
         }
         else{
-            return quaternionU<T>(0, 0, 0, 0);
+            return quaternionU<T, P>(0, 0, 0, 0);
         }
     }
 
@@ -152,16 +184,30 @@ namespace yadq{
         return q_res;
     }
 
+    /**
+     * \brief Quaternion exponential, exp(w + v) = e^w (cos|v|, sin|v| v / |v|). A quaternionU result is
+     * renormalised, which drops the e^w factor. For rotation vectors see exp_map().
+     */
     template<   typename T,
                 typename =  std::enable_if_t<is_base_of_quaternion_v<T>>>
     constexpr auto exp(const T& q_in) noexcept{
 
-        T v(0, q_in.x(), q_in.y(), q_in.z());
-        auto v_norm = v.norm();
+        const auto v_norm = std::sqrt(q_in.x() * q_in.x() + q_in.y() * q_in.y() + q_in.z() * q_in.z());
+        const auto e = std::exp(q_in.w());
 
-        return std::exp(q_in.w()) + (std::cos(v_norm) + (v / v_norm) * std::sin(v_norm));
+        YADQ_COUNT_N(trig_calls, v_norm > 0 ? 2 : 1);
+
+        // sin|v| / |v| tends to 1
+        const auto k = v_norm > 0 ? e * std::sin(v_norm) / v_norm : e;
+
+        return T(e * std::cos(v_norm), k * q_in.x(), k * q_in.y(), k * q_in.z());
     }
 
+    /**
+     * \brief Quaternion logarithm, empty for the null quaternion. A quaternionU result is renormalised, which
+     * keeps the direction of the rotation axis only. For rotation vectors see log_map().
+     * Negative reals have a logarithm along every axis: (log|q|, pi, 0, 0), along x, is returned.
+     */
     template<   typename T,
                 typename =  std::enable_if_t<is_base_of_quaternion_v<T>>>
     constexpr std::optional<T> log(const T& q_in) noexcept{
@@ -170,12 +216,20 @@ namespace yadq{
             return std::nullopt;
         }
 
-        T v(0, q_in.x(), q_in.y(), q_in.z());
-        auto v_norm = v.norm();
+        const auto n = q_in.norm();
+        const auto v_norm = std::sqrt(q_in.x() * q_in.x() + q_in.y() * q_in.y() + q_in.z() * q_in.z());
 
-        auto theta = std::acos(q_in.w() / q_in.norm());
+        YADQ_COUNT_N(trig_calls, v_norm > 0 ? 1 : 0);
 
-        return std::log(v_norm) + (v / v_norm) * theta;
+        if (v_norm == 0 && q_in.w() < 0){
+            return T(std::log(n), static_cast<decltype(n)>(math::detail::pi), 0, 0);
+        }
+
+        // log(q) = (log|q|, acos(w / |q|) v / |v|), the vector part vanishes for positive reals. atan2 keeps
+        // small angles accurate, where acos of a w rounded to 1 returns 0.
+        const auto k = v_norm > 0 ? std::atan2(v_norm, q_in.w()) / v_norm : 0;
+
+        return T(std::log(n), k * q_in.x(), k * q_in.y(), k * q_in.z());
     }
 
 
@@ -186,44 +240,123 @@ namespace yadq{
         return q_lhv.x() * q_rhv.x() + q_lhv.y() * q_rhv.y() + q_lhv.z() * q_rhv.z();
     }
 
-    template< typename T>
-    constexpr quaternionU<T> interpolation(const quaternionU<T>& q_start, const quaternionU<T>& q_end, double t, InterpType interp_type = InterpType::LERP) noexcept{
-        switch (interp_type)
-        {
-        case InterpType::LERP:{                
-                return q_start * (1.0 - t) + q_end * t;
-            }
-        case InterpType::SLERP:{
-                auto omega = dot(q_start, q_end);
-                return ((std::sin(1 - t) * omega) / std::sin(omega)) * q_start + (sin(t * omega) / sin(omega)) * q_end;
+    template< typename T, typename P>
+    constexpr quaternionU<T, P> interpolation(const quaternionU<T, P>& q_start, const quaternionU<T, P>& q_end, double t, InterpType interp_type = InterpType::LERP) noexcept{
+        return YADQ_TIMED(interpolation, [&]() -> quaternionU<T, P>{
+            switch (interp_type)
+            {
+            case InterpType::LERP:{                
+                    return q_start * (1.0 - t) + q_end * t;
+                }
+            case InterpType::SLERP:{
+                    // Angle between the 4D vectors, taking the shortest path on the hypersphere
+                    const auto d = q_start.w() * q_end.w() + q_start.x() * q_end.x() + q_start.y() * q_end.y() + q_start.z() * q_end.z();
+                    const double sign = d < 0 ? -1.0 : 1.0;
+                    const double omega = std::acos(std::min(1.0, sign * d));
+                    const double sin_omega = std::sin(omega);
+
+                    YADQ_COUNT_N(trig_calls, 2);
+
+                    // Nearly parallel quaternions: the normalised LERP is exact to working precision
+                    if (sin_omega < 1e-6){
+                        return q_start * (1.0 - t) + q_end * (sign * t);
+                    }
+
+                    YADQ_COUNT_N(trig_calls, 2);
+
+                    return q_start * (std::sin((1.0 - t) * omega) / sin_omega) + q_end * (sign * std::sin(t * omega) / sin_omega);
+                }
+            default: {
+                    return q_start;
+                }
             }
-        default: {
-                return q_start;
-            }
-        }
+        });
     }
 
-    template< typename T>
-    constexpr auto quatToRotation(const quaternionU<T>& q_in) noexcept{
+    /**
+     * \brief Rotate a 3D vector, v' = q v q*, without building the pure quaternion. Uses the cross-product form
+     * t = 2 (q_v x v), v' = v + w t + q_v x t (15 multiplications instead of two Hamilton products).
+     * \param q_in unitary quaternion describing the rotation
+     * \param v vector to rotate
+     */
+    template< typename T, typename P>
+    constexpr std::array<T, 3> rotate(const quaternionU<T, P>& q_in, const std::array<T, 3>& v) noexcept{
 
-        auto a0 = pow(q_in.w(), 2);
-        auto a1 = pow(q_in.x(), 2);
-        auto a2 = pow(q_in.y(), 2);
-        auto a3 = pow(q_in.z(), 2);
+        const T qw = q_in.w(), qx = q_in.x(), qy = q_in.y(), qz = q_in.z();
 
-        auto a4 = q_in.w() * q_in.x();
-        auto a5 = q_in.w() * q_in.y();
-        auto a6 = q_in.w() * q_in.z();
+        const T tx = 2 * (qy * v[2] - qz * v[1]);
+        const T ty = 2 * (qz * v[0] - qx * v[2]);
+        const T tz = 2 * (qx * v[1] - qy * v[0]);
 
-        auto a7 = q_in.x() * q_in.y();
-        auto a8 = q_in.x() * q_in.z();
+        return {    v[0] + qw * tx + (qy * tz - qz * ty),
+                    v[1] + qw * ty + (qz * tx - qx * tz),
+                    v[2] + qw * tz + (qx * ty - qy * tx)};
+    }
+
+    /**
+     * \brief Rotation matrix of a unitary quaternion, row-major
+     * \param q_in unitary quaternion
+     */
+    template< typename T, typename P>
+    constexpr auto quatToRotation(const quaternionU<T, P>& q_in) noexcept{
+        return YADQ_TIMED(quat_to_rotation, [&](){
+            const T a0 = q_in.w() * q_in.w();
+            const T a1 = q_in.x() * q_in.x();
+            const T a2 = q_in.y() * q_in.y();
+            const T a3 = q_in.z() * q_in.z();
+
+            auto a4 = q_in.w() * q_in.x();
+            auto a5 = q_in.w() * q_in.y();
+            auto a6 = q_in.w() * q_in.z();
+
+            auto a7 = q_in.x() * q_in.y();
+            auto a8 = q_in.x() * q_in.z();
         
-        auto a9 = q_in.y() * q_in.z();
+            auto a9 = q_in.y() * q_in.z();
+
+            std::array<T, 9> R = {  2 * (a0 + a1) - 1, 2 * (a7 - a6), 2 * (a8 + a5),
+                                    2 * (a7 + a6), 2 * (a0 + a2) - 1, 2 * (a9 - a4),
+                                    2 * (a8 - a5), 2 * (a9 + a4), 2 * (a0 + a3) - 1};
+
+            return R;
+        });
+    }
+
+    /**
+     * \brief Unitary quaternion of a row-major rotation matrix (Shepperd's method). The largest of 4w^2, 4x^2, 4y^2,
+     * 4z^2 is read from the diagonal and used as the pivot, so the result never comes from a small component.
+     * The result is q or -q depending on the pivot.
+     * \param R rotation matrix, row-major
+     */
+    template<typename T>
+    constexpr quaternionU<T> rotationToQuat(const std::array<T, 9>& R) noexcept{
 
-        std::array<T, 9> R = {  2 * (a0 + a1) - 1, 2 * (a7 - a6), 2 * (a8 + a5),
-                                2 * (a7 + a6), 2 * (a0 + a2) - 1, 2 * (a9 - a4),
-                                2 * (a8 - a5), 2 * (a9 + a4), 2 * (a0 + a3) - 1};
+        const T d0 = 1 + R[0] + R[4] + R[8];
+        const T d1 = 1 + R[0] - R[4] - R[8];
+        const T d2 = 1 - R[0] + R[4] - R[8];
+        const T d3 = 1 - R[0] - R[4] + R[8];
+
+        // 4wx, 4wy, 4wz, 4xy, 4xz, 4yz
+        const T a = R[7] - R[5], b = R[2] - R[6], c = R[3] - R[1];
+        const T e = R[3] + R[1], f = R[2] + R[6], g = R[7] + R[5];
+
+        std::array<T, 4> v{d0, a, b, c};
+        T pivot = d0;
+
+        if (d1 > pivot){
+            v = {a, d1, e, f};
+            pivot = d1;
+        }
+        if (d2 > pivot){
+            v = {b, e, d2, g};
+            pivot = d2;
+        }
+        if (d3 > pivot){
+            v = {c, f, g, d3};
+            pivot = d3;
+        }
 
-        return R;
+        // v = 4 q_k q with q_k the pivot component: normalising it is all that is left
+        return quaternionU<T>(v[0], v[1], v[2], v[3]);
     }
 }
\ No newline at end of file
@@ -0,0 +1,273 @@
+#include <yadq/quaternion_batch.hpp>
+
+namespace yadq{
+
+    namespace simd{
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /*
+                ------------------------------ Kernels ------------------------------
+
+                All kernels run over n elements, n being a multiple of pack<T>::width (the padded size of a batch).
+                Outputs may alias inputs: every pack is fully loaded before being stored.
+            */
+
+            template<typename T>
+            void multiply(quaternion_lanes<const T> l, quaternion_lanes<const T> r, quaternion_lanes<T> res, std::size_t n) noexcept{
+
+                using P = pack<T>;
+
+                for (std::size_t i = 0; i < n; i += P::width){
+                    const P lw = P::load(l.w + i), lx = P::load(l.x + i), ly = P::load(l.y + i), lz = P::load(l.z + i);
+                    const P rw = P::load(r.w + i), rx = P::load(r.x + i), ry = P::load(r.y + i), rz = P::load(r.z + i);
+
+                    (lw * rw - lx * rx - ly * ry - lz * rz).store(res.w + i);
+                    (lw * rx + lx * rw + ly * rz - lz * ry).store(res.x + i);
+                    (lw * ry - lx * rz + ly * rw + lz * rx).store(res.y + i);
+                    (lw * rz + lx * ry - ly * rx + lz * rw).store(res.z + i);
+                }
+            }
+
+            template<typename T>
+            void conjugate(quaternion_lanes<const T> q, quaternion_lanes<T> res, std::size_t n) noexcept{
+
+                using P = pack<T>;
+
+                for (std::size_t i = 0; i < n; i += P::width){
+                    P::load(q.w + i).store(res.w + i);
+                    (-P::load(q.x + i)).store(res.x + i);
+                    (-P::load(q.y + i)).store(res.y + i);
+                    (-P::load(q.z + i)).store(res.z + i);
+                }
+            }
+
+            template<typename T>
+            void normalise(quaternion_lanes<const T> q, quaternion_lanes<T> res, std::size_t n) noexcept{
+
+                using P = pack<T>;
+                const P one = P::broadcast(T(1));
+
+                for (std::size_t i = 0; i < n; i += P::width){
+                    const P w = P::load(q.w + i), x = P::load(q.x + i), y = P::load(q.y + i), z = P::load(q.z + i);
+
+                    // Null quaternions are left untouched, as quaternion::normalise does
+                    const P d = zero_to(sqrt(w * w + x * x + y * y + z * z), one);
+
+                    (w / d).store(res.w + i);
+                    (x / d).store(res.x + i);
+                    (y / d).store(res.y + i);
+                    (z / d).store(res.z + i);
+                }
+            }
+
+            /**
+             * \brief Renormalisation of quaternions close to unit norm, same operations as detail::inverse_norm
+             */
+            template<norm_strategy S, typename T>
+            void renormalise(quaternion_lanes<const T> q, quaternion_lanes<T> res, std::size_t n) noexcept{
+
+                if constexpr (S == norm_strategy::exact){
+                    normalise<T>(q, res, n);
+                }else{
+                    using P = pack<T>;
+                    const P half = P::broadcast(T(0.5)), one_half = P::broadcast(T(1.5));
+                    const P one = P::broadcast(T(1)), three = P::broadcast(T(3));
+
+                    for (std::size_t i = 0; i < n; i += P::width){
+                        const P w = P::load(q.w + i), x = P::load(q.x + i), y = P::load(q.y + i), z = P::load(q.z + i);
+                        const P s = w * w + x * x + y * y + z * z;
+
+                        P k;
+                        if constexpr (S == norm_strategy::newton){
+                            const P k0 = one_half - half * s;
+                            k = k0 * (one_half - half * s * k0 * k0);
+                        }else{
+                            k = (three + s) / (one + three * s);
+                        }
+
+                        (w * k).store(res.w + i);
+                        (x * k).store(res.x + i);
+                        (y * k).store(res.y + i);
+                        (z * k).store(res.z + i);
+                    }
+                }
+            }
+
+            template<typename T>
+            void inverse(quaternion_lanes<const T> q, quaternion_lanes<T> res, std::size_t n) noexcept{
+
+                using P = pack<T>;
+                const P one = P::broadcast(T(1));
+
+                for (std::size_t i = 0; i < n; i += P::width){
+                    const P w = P::load(q.w + i), x = P::load(q.x + i), y = P::load(q.y + i), z = P::load(q.z + i);
+
+                    // Null quaternions map to the null quaternion, as yadq::inverse does
+                    const P d = zero_to(w * w + x * x + y * y + z * z, one);
+
+                    (w / d).store(res.w + i);
+                    (-x / d).store(res.x + i);
+                    (-y / d).store(res.y + i);
+                    (-z / d).store(res.z + i);
+                }
+            }
+
+            template<typename T>
+            void dot(quaternion_lanes<const T> l, quaternion_lanes<const T> r, T* res, std::size_t n) noexcept{
+
+                using P = pack<T>;
+
+                std::size_t i = 0;
+
+                for (; i + P::width <= n; i += P::width){
+                    (P::load(l.x + i) * P::load(r.x + i) + P::load(l.y + i) * P::load(r.y + i) + P::load(l.z + i) * P::load(r.z + i)).store_unaligned(res + i);
+                }
+
+                for (; i < n; ++i){
+                    res[i] = l.x[i] * r.x[i] + l.y[i] * r.y[i] + l.z[i] * r.z[i];
+                }
+            }
+        }
+    }
+
+    /*
+        ------------------------------ Fcn definition ------------------------------
+
+        Accuracy with respect to the scalar quaternion operators, element by element:
+        - multiply, conjugate, dot: bit-identical to hamilton_prod, conjugate and dot on quaternion<T>.
+        - normalise: bit-identical for double; for float within 1 ULP, because quaternion<float>::norm()
+          accumulates the squares in double.
+        - inverse: conj(q) / (w^2 + x^2 + y^2 + z^2), with no square root; for unit quaternions within 2 ULP of
+          inverse(quaternionU).
+        The bit-identical claims assume the scalar code is not contracted into FMA (e.g. -ffp-contract=fast on
+        an FMA target); in that case the difference stays within 2 ULP of the largest partial product.
+    */
+
+    namespace detail {
+
+        template<typename T>
+        inline void check_same_size(const quaternion_batch<T>& lhv, const quaternion_batch<T>& rhv){
+            if (lhv.size() != rhv.size()){
+                throw std::invalid_argument("quaternion batches must have the same size");
+            }
+        }
+    }
+
+    /**
+     * \brief Element-wise Hamilton product, res[i] = lhv[i] * rhv[i]. res may be one of the inputs.
+     */
+    template<typename T>
+    void multiply(const quaternion_batch<T>& lhv, const quaternion_batch<T>& rhv, quaternion_batch<T>& res){
+
+        detail::check_same_size(lhv, rhv);
+        res.resize(lhv.size());
+
+        simd::multiply<T>(lhv.lanes(), rhv.lanes(), res.lanes(), lhv.padded_size());
+    }
+
+    template<typename T>
+    quaternion_batch<T> multiply(const quaternion_batch<T>& lhv, const quaternion_batch<T>& rhv){
+
+        quaternion_batch<T> res(lhv.size());
+        multiply(lhv, rhv, res);
+        return res;
+    }
+
+    /**
+     * \brief Element-wise conjugate. res may be the input.
+     */
+    template<typename T>
+    void conjugate(const quaternion_batch<T>& q_in, quaternion_batch<T>& res){
+
+        res.resize(q_in.size());
+
+        simd::conjugate<T>(q_in.lanes(), res.lanes(), q_in.padded_size());
+    }
+
+    template<typename T>
+    quaternion_batch<T> conjugate(const quaternion_batch<T>& q_in){
+
+        quaternion_batch<T> res(q_in.size());
+        conjugate(q_in, res);
+        return res;
+    }
+
+    /**
+     * \brief Element-wise normalisation. Null quaternions are left unchanged. res may be the input.
+     */
+    template<typename T>
+    void normalise(const quaternion_batch<T>& q_in, quaternion_batch<T>& res){
+
+        res.resize(q_in.size());
+
+        simd::normalise<T>(q_in.lanes(), res.lanes(), q_in.padded_size());
+    }
+
+    template<typename T>
+    quaternion_batch<T> normalise(const quaternion_batch<T>& q_in){
+
+        quaternion_batch<T> res(q_in.size());
+        normalise(q_in, res);
+        return res;
+    }
+
+    /**
+     * \brief Element-wise renormalisation of quaternions close to unit norm with the given strategy, e.g.
+     * renormalise<norm_strategy::newton>(q_in, res) after a multiply of unitary batches. Matches the scalar
+     * renormalise bit for bit (without FMA contraction). res may be the input.
+     */
+    template<norm_strategy S, typename T>
+    void renormalise(const quaternion_batch<T>& q_in, quaternion_batch<T>& res){
+
+        res.resize(q_in.size());
+
+        simd::renormalise<S, T>(q_in.lanes(), res.lanes(), q_in.padded_size());
+    }
+
+    template<norm_strategy S, typename T>
+    quaternion_batch<T> renormalise(const quaternion_batch<T>& q_in){
+
+        quaternion_batch<T> res(q_in.size());
+        renormalise<S>(q_in, res);
+        return res;
+    }
+
+    /**
+     * \brief Element-wise inverse conj(q) / |q|^2. Null quaternions map to the null quaternion. res may be the input.
+     */
+    template<typename T>
+    void inverse(const quaternion_batch<T>& q_in, quaternion_batch<T>& res){
+
+        res.resize(q_in.size());
+
+        simd::inverse<T>(q_in.lanes(), res.lanes(), q_in.padded_size());
+    }
+
+    template<typename T>
+    quaternion_batch<T> inverse(const quaternion_batch<T>& q_in){
+
+        quaternion_batch<T> res(q_in.size());
+        inverse(q_in, res);
+        return res;
+    }
+
+    /**
+     * \brief Element-wise dot product with the same semantic as dot(q, q). res must hold size() values.
+     */
+    template<typename T>
+    void dot(const quaternion_batch<T>& lhv, const quaternion_batch<T>& rhv, T* res){
+
+        detail::check_same_size(lhv, rhv);
+
+        simd::dot<T>(lhv.lanes(), rhv.lanes(), res, lhv.size());
+    }
+
+    template<typename T>
+    std::vector<T> dot(const quaternion_batch<T>& lhv, const quaternion_batch<T>& rhv){
+
+        std::vector<T> res(lhv.size());
+        dot(lhv, rhv, res.data());
+        return res;
+    }
+}
@@ -0,0 +1,141 @@
+#include <yadq/rotation_batch.hpp>
+
+namespace yadq{
+
+    namespace simd{
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /*
+                The arithmetic runs on SoA packs; matrices are gathered to / scattered from a small aligned block,
+                one pack of matrices at a time.
+            */
+
+            template<typename T>
+            void quat_to_matrix(quaternion_lanes<const T> q, T* m, std::size_t n, const matrix_layout& layout) noexcept{
+
+                using P = pack<T>;
+
+                const P one = P::broadcast(T(1));
+                const P two = P::broadcast(T(2));
+
+                alignas(alignment) T block[9][P::width];
+
+                for (std::size_t i = 0; i < n; i += P::width){
+                    const P w = P::load(q.w + i), x = P::load(q.x + i), y = P::load(q.y + i), z = P::load(q.z + i);
+
+                    const P a0 = w * w, a1 = x * x, a2 = y * y, a3 = z * z;
+                    const P a4 = w * x, a5 = w * y, a6 = w * z;
+                    const P a7 = x * y, a8 = x * z, a9 = y * z;
+
+                    (two * (a0 + a1) - one).store(block[0]);
+                    (two * (a7 - a6)).store(block[1]);
+                    (two * (a8 + a5)).store(block[2]);
+                    (two * (a7 + a6)).store(block[3]);
+                    (two * (a0 + a2) - one).store(block[4]);
+                    (two * (a9 - a4)).store(block[5]);
+                    (two * (a8 - a5)).store(block[6]);
+                    (two * (a9 + a4)).store(block[7]);
+                    (two * (a0 + a3) - one).store(block[8]);
+
+                    const std::size_t count = n - i < P::width ? n - i : P::width;
+
+                    for (std::size_t j = 0; j < count; ++j){
+                        T* mj = m + (i + j) * layout.stride;
+
+                        for (std::size_t e = 0; e < 9; ++e){
+                            mj[layout.rotation[e]] = block[e][j];
+                        }
+
+                        if (layout.homogeneous_row){
+                            mj[layout.bottom_row[0]] = 0;
+                            mj[layout.bottom_row[1]] = 0;
+                            mj[layout.bottom_row[2]] = 0;
+                            mj[layout.bottom_row[3]] = 1;
+                        }
+                    }
+                }
+            }
+
+            template<typename T>
+            void matrix_to_quat(const T* m, quaternion_lanes<T> q, std::size_t n, const matrix_layout& layout) noexcept{
+
+                using P = pack<T>;
+
+                const P one = P::broadcast(T(1));
+
+                alignas(alignment) T block[9][P::width];
+
+                for (std::size_t i = 0; i < n; i += P::width){
+
+                    const std::size_t count = n - i < P::width ? n - i : P::width;
+
+                    for (std::size_t j = 0; j < P::width; ++j){
+                        if (j < count){
+                            const T* mj = m + (i + j) * layout.stride;
+                            for (std::size_t e = 0; e < 9; ++e){
+                                block[e][j] = mj[layout.rotation[e]];
+                            }
+                        }else{
+                            // Identity in the tail, which maps exactly to the identity padding of the batch
+                            for (std::size_t e = 0; e < 9; ++e){
+                                block[e][j] = (e % 4 == 0) ? T(1) : T(0);
+                            }
+                        }
+                    }
+
+                    const P r0 = P::load(block[0]), r1 = P::load(block[1]), r2 = P::load(block[2]);
+                    const P r3 = P::load(block[3]), r4 = P::load(block[4]), r5 = P::load(block[5]);
+                    const P r6 = P::load(block[6]), r7 = P::load(block[7]), r8 = P::load(block[8]);
+
+                    const P d0 = one + r0 + r4 + r8;
+                    const P d1 = one + r0 - r4 - r8;
+                    const P d2 = one - r0 + r4 - r8;
+                    const P d3 = one - r0 - r4 + r8;
+
+                    const P a = r7 - r5, b = r2 - r6, c = r3 - r1;
+                    const P e = r3 + r1, f = r2 + r6, g = r7 + r5;
+
+                    // Branch-free pivot selection, same order and comparisons as rotationToQuat
+                    P vw = d0, vx = a, vy = b, vz = c, pivot = d0;
+
+                    vw = select_gt(d1, pivot, a, vw);
+                    vx = select_gt(d1, pivot, d1, vx);
+                    vy = select_gt(d1, pivot, e, vy);
+                    vz = select_gt(d1, pivot, f, vz);
+                    pivot = select_gt(d1, pivot, d1, pivot);
+
+                    vw = select_gt(d2, pivot, b, vw);
+                    vx = select_gt(d2, pivot, e, vx);
+                    vy = select_gt(d2, pivot, d2, vy);
+                    vz = select_gt(d2, pivot, g, vz);
+                    pivot = select_gt(d2, pivot, d2, pivot);
+
+                    vw = select_gt(d3, pivot, c, vw);
+                    vx = select_gt(d3, pivot, f, vx);
+                    vy = select_gt(d3, pivot, g, vy);
+                    vz = select_gt(d3, pivot, d3, vz);
+                    pivot = select_gt(d3, pivot, d3, pivot);
+
+                    // v = 4 q_k q, normalised with one square root and one division per pack
+                    const P s = one / sqrt(vw * vw + vx * vx + vy * vy + vz * vz);
+
+                    (vw * s).store(q.w + i);
+                    (vx * s).store(q.x + i);
+                    (vy * s).store(q.y + i);
+                    (vz * s).store(q.z + i);
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    void quatToRotation(const quaternion_batch<T>& q_in, T* matrices, matrix_shape shape, matrix_order order) noexcept{
+        simd::quat_to_matrix<T>(q_in.lanes(), matrices, q_in.size(), matrix_layout::make(shape, order));
+    }
+
+    template<typename T>
+    void rotationToQuat(const T* matrices, quaternion_batch<T>& q_out, matrix_shape shape, matrix_order order) noexcept{
+        simd::matrix_to_quat<T>(matrices, q_out.lanes(), q_out.size(), matrix_layout::make(shape, order));
+    }
+}
@@ -0,0 +1,119 @@
+#include <yadq/rotation_map.hpp>
+
+#include <type_traits>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief Taylor coefficients of cos(h) and sin(h) / h in u = h^2. Truncated so that the first dropped term
+         * is below the precision of T for h <= pi / 4.
+         */
+        template<typename T>
+        struct half_angle_series;
+
+        template<>
+        struct half_angle_series<double>{
+            static constexpr std::size_t terms = 9;
+            static constexpr double cos[terms] = {  1.0, -1.0 / 2, 1.0 / 24, -1.0 / 720, 1.0 / 40320, -1.0 / 3628800, 1.0 / 479001600,
+                                                    -1.0 / 87178291200.0, 1.0 / 20922789888000.0};
+            static constexpr double sinc[terms] = { 1.0, -1.0 / 6, 1.0 / 120, -1.0 / 5040, 1.0 / 362880, -1.0 / 39916800, 1.0 / 6227020800.0,
+                                                    -1.0 / 1307674368000.0, 1.0 / 355687428096000.0};
+        };
+
+        template<>
+        struct half_angle_series<float>{
+            static constexpr std::size_t terms = 6;
+            static constexpr float cos[terms] = {1.0f, -1.0f / 2, 1.0f / 24, -1.0f / 720, 1.0f / 40320, -1.0f / 3628800};
+            static constexpr float sinc[terms] = {1.0f, -1.0f / 6, 1.0f / 120, -1.0f / 5040, 1.0f / 362880, -1.0f / 39916800};
+        };
+
+        /**
+         * \brief Largest squared half angle covered by half_angle_series, (pi / 4)^2
+         */
+        template<typename T>
+        constexpr T series_half_angle_sq = T(0.6168502750680849);
+
+        /**
+         * \brief Broadcast a constant to V, a scalar or a simd pack
+         */
+        template<typename V, typename T>
+        inline V splat(T s) noexcept{
+            if constexpr (std::is_arithmetic_v<V>){
+                return V(s);
+            }else{
+                return V::broadcast(s);
+            }
+        }
+
+        /**
+         * \brief Exponential of the rotation vector (rx, ry, rz) into (w, x, y, z), the components of a unitary
+         * quaternion. Written once for scalars and simd packs: for V = T rotations beyond the series fall back to
+         * std::sin and std::cos, packs only evaluate the series and callers handle the lanes beyond
+         * series_half_angle_sq themselves.
+         * \param u squared half angle, (rx^2 + ry^2 + rz^2) / 4
+         */
+        template<typename T, typename V>
+        inline void exp_rotation(V rx, V ry, V rz, V u, V& w, V& x, V& y, V& z) noexcept{
+
+            using S = half_angle_series<T>;
+
+            V c = splat<V>(S::cos[S::terms - 1]);
+            V s = splat<V>(S::sinc[S::terms - 1]);
+
+            for (std::size_t k = S::terms - 1; k-- > 0;){
+                c = c * u + splat<V>(S::cos[k]);
+                s = s * u + splat<V>(S::sinc[k]);
+            }
+
+            if constexpr (std::is_same_v<V, T>){
+                if (u > series_half_angle_sq<T>){
+                    YADQ_COUNT_N(trig_calls, 2);
+                    const T h = std::sqrt(u);
+                    c = std::cos(h);
+                    s = std::sin(h) / h;
+                }
+            }
+
+            // sin(h) r / |r| = sinc(h) r / 2
+            const V k = s * splat<V>(T(0.5));
+
+            w = c;
+            x = k * rx;
+            y = k * ry;
+            z = k * rz;
+        }
+    }
+
+    template<typename T>
+    quaternionU<T> exp_map(const std::array<T, 3>& r) noexcept{
+
+        T w, x, y, z;
+        detail::exp_rotation<T>(r[0], r[1], r[2], (r[0] * r[0] + r[1] * r[1] + r[2] * r[2]) * T(0.25), w, x, y, z);
+
+        return quaternionU<T>(w, x, y, z);
+    }
+
+    template<typename T, typename P>
+    std::array<T, 3> log_map(const quaternionU<T, P>& q_in) noexcept{
+
+        // Shortest rotation: w >= 0
+        const T sign = q_in.w() < 0 ? T(-1) : T(1);
+        const T w = sign * q_in.w(), x = sign * q_in.x(), y = sign * q_in.y(), z = sign * q_in.z();
+
+        const T n2 = x * x + y * y + z * z;
+
+        // 2 atan2(n, w) / n; for n / w below 1e-4 the series 2 / w (1 - n^2 / (3 w^2)) is exact to double precision
+        T k;
+        if (n2 < T(1e-8) * w * w){
+            k = 2 / w * (1 - n2 / (3 * w * w));
+        }else{
+            YADQ_COUNT(trig_calls);
+            const T n = std::sqrt(n2);
+            k = 2 * std::atan2(n, w) / n;
+        }
+
+        return {k * x, k * y, k * z};
+    }
+}
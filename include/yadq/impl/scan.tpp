@@ -0,0 +1,103 @@
+#include <yadq/scan.hpp>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief Running product acc *= q_in[i] over [begin, end), renormalised every `block` elements.
+         * When Store, q_out[i] receives the product before (exclusive) or after (inclusive) the update.
+         */
+        template<bool Store, bool Inclusive, typename Q>
+        void scan_range(Q& acc, const Q* q_in, Q* q_out, std::size_t begin, std::size_t end, std::size_t block){
+
+            std::size_t since_renormalise = 0;
+
+            for (std::size_t i = begin; i < end; ++i){
+                const Q q = q_in[i];
+
+                if constexpr (Store && !Inclusive){
+                    q_out[i] = acc;
+                }
+
+                acc *= q;
+
+                if (block != 0 && ++since_renormalise == block){
+                    acc.normalise();
+                    since_renormalise = 0;
+                }
+
+                if constexpr (Store && Inclusive){
+                    q_out[i] = acc;
+                }
+            }
+        }
+
+        template<bool Inclusive, typename Q>
+        void product_scan(const Q* q_in, Q* q_out, std::size_t n, const Q& init, const scan_config& config){
+
+            const unsigned chunks = thread_count(n, config.parallel);
+            const std::size_t block = config.renormalise_block;
+
+            if (chunks <= 1){
+                Q acc = init;
+                scan_range<true, Inclusive>(acc, q_in, q_out, 0, n, block);
+                return;
+            }
+
+            // Reduce every chunk but the last one
+            std::vector<Q> carries(chunks, Q());
+
+            parallel_chunks(n, chunks, [&](unsigned k, std::size_t begin, std::size_t end){
+                if (k + 1 < chunks){
+                    Q acc;
+                    scan_range<false, Inclusive>(acc, q_in, q_out, begin, end, block);
+                    carries[k + 1] = acc;
+                }
+            });
+
+            // Chain the carries: carries[k] becomes the product of everything before chunk k
+            carries[0] = init;
+
+            for (unsigned k = 1; k < chunks; ++k){
+                carries[k] = carries[k - 1] * carries[k];
+
+                if (block != 0){
+                    carries[k].normalise();
+                }
+            }
+
+            // Scan every chunk from its carry
+            parallel_chunks(n, chunks, [&](unsigned k, std::size_t begin, std::size_t end){
+                Q acc = carries[k];
+                scan_range<true, Inclusive>(acc, q_in, q_out, begin, end, block);
+            });
+        }
+    }
+
+    template<typename Q>
+    void inclusive_product_scan(const Q* q_in, Q* q_out, std::size_t n, const scan_config& config){
+        detail::product_scan<true>(q_in, q_out, n, Q(), config);
+    }
+
+    template<typename Q>
+    void exclusive_product_scan(const Q* q_in, Q* q_out, std::size_t n, const detail::non_deduced_t<Q>& init, const scan_config& config){
+        detail::product_scan<false>(q_in, q_out, n, init, config);
+    }
+
+    template<typename Q>
+    std::vector<Q> inclusive_product_scan(const std::vector<Q>& q_in, const scan_config& config){
+
+        std::vector<Q> q_out(q_in.size());
+        inclusive_product_scan(q_in.data(), q_out.data(), q_in.size(), config);
+        return q_out;
+    }
+
+    template<typename Q>
+    std::vector<Q> exclusive_product_scan(const std::vector<Q>& q_in, const detail::non_deduced_t<Q>& init, const scan_config& config){
+
+        std::vector<Q> q_out(q_in.size());
+        exclusive_product_scan(q_in.data(), q_out.data(), q_in.size(), init, config);
+        return q_out;
+    }
+}
@@ -0,0 +1,276 @@
+#include <yadq/sclerp.hpp>
+
+#include <stdexcept>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief -dq, the same motion
+         */
+        template<typename T>
+        dualquaternion<T> negated(const dualquaternion<T>& dq) noexcept{
+            return dualquaternion<T>(   quaternionU<T>(-dq.qr_.w(), -dq.qr_.x(), -dq.qr_.y(), -dq.qr_.z()),
+                                        quaternion<T>(-dq.qd_.w(), -dq.qd_.x(), -dq.qd_.y(), -dq.qd_.z()));
+        }
+
+        /**
+         * \brief 4D dot product of the real parts
+         */
+        template<typename T>
+        T real_dot(const dualquaternion<T>& a, const dualquaternion<T>& b) noexcept{
+            return a.qr_.w() * b.qr_.w() + a.qr_.x() * b.qr_.x() + a.qr_.y() * b.qr_.y() + a.qr_.z() * b.qr_.z();
+        }
+
+        /**
+         * \brief Unit dual quaternion of a non-zero sum r + e d: the real part is normalised by the quaternionU
+         * constructor, the dual part scaled by the same factor and made orthogonal to it
+         */
+        template<typename T>
+        dualquaternion<T> normalised_blend(const std::array<T, 4>& r, const std::array<T, 4>& d) noexcept{
+
+            const T inv_norm = 1 / std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+
+            dualquaternion<T> dq(   quaternionU<T>(r[0], r[1], r[2], r[3]),
+                                    quaternion<T>(inv_norm * d[0], inv_norm * d[1], inv_norm * d[2], inv_norm * d[3]));
+            dq.normalise();
+
+            return dq;
+        }
+    }
+
+    template<typename T>
+    dualquaternion<T> exp_map(const std::array<T, 6>& twist) noexcept{
+
+        const T wx = twist[0], wy = twist[1], wz = twist[2];
+        const T vx = twist[3], vy = twist[4], vz = twist[5];
+
+        const T theta2 = wx * wx + wy * wy + wz * wz;
+        const T theta = std::sqrt(theta2);
+        const T h = theta / 2;
+
+        YADQ_COUNT_N(trig_calls, 2);
+        const T s = std::sin(h);
+        const T c = std::cos(h);
+
+        // k = sin(h) / theta, from its Taylor series where the division loses accuracy
+        const T k = theta > T(1e-3) ? s / theta : T(0.5) * (1 - h * h / 6 * (1 - h * h / 20));
+
+        // Component of v along the axis, d l; it only contributes at second order in theta near zero
+        const T wv = wx * vx + wy * vy + wz * vz;
+        const T a = theta2 > T(1e-30) ? wv / theta2 : 0;
+        const T px = a * wx, py = a * wy, pz = a * wz;
+
+        // Real part (cos h, sin h l); dual part (-d / 2 sin h, sin h m + d / 2 cos h l) with theta m = v - d l
+        return dualquaternion<T>(   quaternionU<T>(c, k * wx, k * wy, k * wz),
+                                    quaternion<T>(  -T(0.5) * k * wv,
+                                                    k * (vx - px) + T(0.5) * c * px,
+                                                    k * (vy - py) + T(0.5) * c * py,
+                                                    k * (vz - pz) + T(0.5) * c * pz));
+    }
+
+    template<typename T>
+    std::array<T, 6> log_map(const dualquaternion<T>& dq_in) noexcept{
+
+        // Shortest path: dq and -dq are the same motion
+        const T sign = dq_in.qr_.w() < 0 ? -1 : 1;
+        const T qw = sign * dq_in.qr_.w(), qx = sign * dq_in.qr_.x(), qy = sign * dq_in.qr_.y(), qz = sign * dq_in.qr_.z();
+        const std::array<T, 3> t = dq_in.translation();
+
+        const T s = std::sqrt(qx * qx + qy * qy + qz * qz);
+
+        YADQ_COUNT(trig_calls);
+        const T h = std::atan2(s, qw);
+
+        // w = theta l = 2 h / sin(h) q_v, and h cot(h), from their Taylor series near 0
+        const T two_h_over_s = h > T(1e-3) ? 2 * h / s : 2 * (1 + h * h / 6 * (1 + 7 * h * h / 60));
+        const T h_cot_h = h > T(1e-3) ? h * qw / s : 1 - h * h / 3 * (1 + h * h / 15);
+
+        const std::array<T, 3> w = {two_h_over_s * qx, two_h_over_s * qy, two_h_over_s * qz};
+        const T theta2 = w[0] * w[0] + w[1] * w[1] + w[2] * w[2];
+
+        // d l, the translation along the axis
+        const T a = theta2 > T(1e-30) ? (t[0] * w[0] + t[1] * w[1] + t[2] * w[2]) / theta2 : 0;
+        const std::array<T, 3> p = {a * w[0], a * w[1], a * w[2]};
+
+        // v = d l + theta m, with theta m = (t x w) / 2 + h cot(h) (t - d l)
+        return {w[0], w[1], w[2],
+                p[0] + T(0.5) * (t[1] * w[2] - t[2] * w[1]) + h_cot_h * (t[0] - p[0]),
+                p[1] + T(0.5) * (t[2] * w[0] - t[0] * w[2]) + h_cot_h * (t[1] - p[1]),
+                p[2] + T(0.5) * (t[0] * w[1] - t[1] * w[0]) + h_cot_h * (t[2] - p[2])};
+    }
+
+    template<typename T>
+    dualquaternion<T> pow(const dualquaternion<T>& dq_in, T t) noexcept{
+
+        std::array<T, 6> twist = log_map(dq_in);
+        for (auto& c : twist){
+            c *= t;
+        }
+
+        return exp_map(twist);
+    }
+
+    template<typename T>
+    dualquaternion<T> sclerp(const dualquaternion<T>& dq_start, const dualquaternion<T>& dq_end, T t) noexcept{
+        return dq_start * pow(conjugate(dq_start) * dq_end, t);
+    }
+
+    template<typename T>
+    dualquaternion<T> dlb(const dualquaternion<T>& dq_start, const dualquaternion<T>& dq_end, T t) noexcept{
+
+        const T a = 1 - t;
+        const T b = detail::real_dot(dq_start, dq_end) < 0 ? -t : t;
+
+        return detail::normalised_blend<T>( {   a * dq_start.qr_.w() + b * dq_end.qr_.w(), a * dq_start.qr_.x() + b * dq_end.qr_.x(),
+                                                a * dq_start.qr_.y() + b * dq_end.qr_.y(), a * dq_start.qr_.z() + b * dq_end.qr_.z()},
+                                            {   a * dq_start.qd_.w() + b * dq_end.qd_.w(), a * dq_start.qd_.x() + b * dq_end.qd_.x(),
+                                                a * dq_start.qd_.y() + b * dq_end.qd_.y(), a * dq_start.qd_.z() + b * dq_end.qd_.z()});
+    }
+
+    template<typename T>
+    dualquaternion<T> dlb(const dualquaternion<T>* dq_in, const T* weights, std::size_t n){
+
+        if (n == 0){
+            throw std::invalid_argument("dlb: no dual quaternions");
+        }
+
+        std::array<T, 4> r{}, d{};
+        for (std::size_t i = 0; i < n; ++i){
+            const T w = detail::real_dot(dq_in[0], dq_in[i]) < 0 ? -weights[i] : weights[i];
+
+            r[0] += w * dq_in[i].qr_.w(); r[1] += w * dq_in[i].qr_.x(); r[2] += w * dq_in[i].qr_.y(); r[3] += w * dq_in[i].qr_.z();
+            d[0] += w * dq_in[i].qd_.w(); d[1] += w * dq_in[i].qd_.x(); d[2] += w * dq_in[i].qd_.y(); d[3] += w * dq_in[i].qd_.z();
+        }
+
+        if (r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3] == 0){
+            throw std::invalid_argument("dlb: the weighted sum vanishes");
+        }
+
+        return detail::normalised_blend(r, d);
+    }
+
+    template<typename _T>
+    sclerp_plan<_T>::sclerp_plan(const dualquaternion<_T>& dq_start, const dualquaternion<_T>& dq_end, sclerp_mode mode):
+        dq_start_(dq_start), axis_{0, 0, 0}, moment_{0, 0, 0}, half_angle_(0), pitch_(0), dq_end_(dq_end), mode_(mode){
+
+        dualquaternion<_T> d = conjugate(dq_start) * dq_end;
+
+        // Shortest path: dq and -dq are the same motion
+        if (d.qr_.w() < 0){
+            d = detail::negated(d);
+            dq_end_ = detail::negated(dq_end);
+        }
+
+        rotation_ = d.qr_;
+        translation_ = d.translation();
+
+        const _T vx = d.qr_.x(), vy = d.qr_.y(), vz = d.qr_.z();
+        const _T sin_half = std::sqrt(vx * vx + vy * vy + vz * vz);
+
+        YADQ_COUNT(trig_calls);
+        half_angle_ = std::atan2(sin_half, d.qr_.w());
+        screw_ = half_angle_ > _T(5e-7);
+
+        if (!screw_){
+            // Pure translation: the axis is its direction, the pitch its length
+            const _T norm = std::sqrt(translation_[0] * translation_[0] + translation_[1] * translation_[1] + translation_[2] * translation_[2]);
+            if (norm > 0){
+                axis_ = {translation_[0] / norm, translation_[1] / norm, translation_[2] / norm};
+                pitch_ = norm;
+            }
+            return;
+        }
+
+        axis_ = {vx / sin_half, vy / sin_half, vz / sin_half};
+
+        const std::array<_T, 3>& p = translation_;
+        const std::array<_T, 3>& l = axis_;
+
+        pitch_ = p[0] * l[0] + p[1] * l[1] + p[2] * l[2];
+
+        // m = (p x l + cot(angle / 2) (p - pitch l)) / 2, p being the relative translation
+        const _T cot_half = d.qr_.w() / sin_half;
+
+        moment_ = { _T(0.5) * ((p[1] * l[2] - p[2] * l[1]) + cot_half * (p[0] - pitch_ * l[0])),
+                    _T(0.5) * ((p[2] * l[0] - p[0] * l[2]) + cot_half * (p[1] - pitch_ * l[1])),
+                    _T(0.5) * ((p[0] * l[1] - p[1] * l[0]) + cot_half * (p[2] - pitch_ * l[2]))};
+    }
+
+    template<typename _T>
+    dualquaternion<_T> sclerp_plan<_T>::operator()(_T t) const noexcept{
+        return mode_ == sclerp_mode::dlb ? evaluate_dlb(t) : evaluate_exact(t);
+    }
+
+    template<typename _T>
+    dualquaternion<_T> sclerp_plan<_T>::evaluate_dlb(_T t) const noexcept{
+
+        const _T a = 1 - t;
+        const dualquaternion<_T>& p = dq_start_;
+        const dualquaternion<_T>& q = dq_end_;
+
+        return detail::normalised_blend<_T>({   a * p.qr_.w() + t * q.qr_.w(), a * p.qr_.x() + t * q.qr_.x(),
+                                                a * p.qr_.y() + t * q.qr_.y(), a * p.qr_.z() + t * q.qr_.z()},
+                                            {   a * p.qd_.w() + t * q.qd_.w(), a * p.qd_.x() + t * q.qd_.x(),
+                                                a * p.qd_.y() + t * q.qd_.y(), a * p.qd_.z() + t * q.qd_.z()});
+    }
+
+    template<typename _T>
+    dualquaternion<_T> sclerp_plan<_T>::evaluate_exact(_T t) const noexcept{
+
+        if (!screw_){
+            // Normalised LERP of a rotation below 1e-6 rad is exact to working precision
+            const quaternionU<_T> r((1 - t) + t * rotation_.w(), t * rotation_.x(), t * rotation_.y(), t * rotation_.z());
+            const std::array<_T, 3> p = {t * translation_[0], t * translation_[1], t * translation_[2]};
+
+            return dq_start_ * dualquaternion<_T>(r, p);
+        }
+
+        YADQ_COUNT_N(trig_calls, 2);
+
+        const _T h = t * half_angle_;
+        const _T s = std::sin(h);
+        const _T c = std::cos(h);
+        const _T half_pitch = _T(0.5) * t * pitch_;
+
+        // Screw (t angle, t pitch, axis, moment) as a dual quaternion
+        const dualquaternion<_T> d_t(   quaternionU<_T>(c, s * axis_[0], s * axis_[1], s * axis_[2]),
+                                        quaternion<_T>( -half_pitch * s,
+                                                        s * moment_[0] + half_pitch * c * axis_[0],
+                                                        s * moment_[1] + half_pitch * c * axis_[1],
+                                                        s * moment_[2] + half_pitch * c * axis_[2]));
+
+        return dq_start_ * d_t;
+    }
+
+    template<typename _T>
+    void sclerp_plan<_T>::evaluate(const _T* t, dualquaternion<_T>* dq_out, std::size_t n) const noexcept{
+
+        // The mode is tested once, the loops have no branch
+        if (mode_ == sclerp_mode::dlb){
+            for (std::size_t i = 0; i < n; ++i){
+                dq_out[i] = evaluate_dlb(t[i]);
+            }
+        }else{
+            for (std::size_t i = 0; i < n; ++i){
+                dq_out[i] = evaluate_exact(t[i]);
+            }
+        }
+    }
+
+    template<typename _T>
+    void sclerp_plan<_T>::evaluate(const _T* t, dualquaternion<_T>* dq_out, std::size_t n, const parallel_config& config) const{
+        detail::parallel_chunks(n, detail::thread_count(n, config), [&](unsigned, std::size_t begin, std::size_t end){
+            evaluate(t + begin, dq_out + begin, end - begin);
+        });
+    }
+
+    template<typename _T>
+    std::vector<dualquaternion<_T>> sclerp_plan<_T>::evaluate(const std::vector<_T>& t) const{
+
+        std::vector<dualquaternion<_T>> dq_out(t.size());
+        evaluate(t.data(), dq_out.data(), t.size());
+        return dq_out;
+    }
+}
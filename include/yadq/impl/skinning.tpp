@@ -0,0 +1,150 @@
+#include <yadq/skinning.hpp>
+
+namespace yadq{
+
+    namespace simd{
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /**
+             * \brief Skin the Pk::width vertices starting at i. Bones and weights are gathered in a small aligned
+             * block, the blend runs on packs. Written once for pack<T> and for the scalar tail (scalar_pack<T>).
+             */
+            template<typename Pk, bool Normals, typename T, std::size_t K>
+            inline void skin_vertices(  const dualquaternion<T>* palette, const bone_influences<T, K>& influences,
+                                        point_lanes<const T> p_in, point_lanes<const T> n_in,
+                                        point_lanes<T> p_out, point_lanes<T> n_out, std::size_t i) noexcept{
+
+                constexpr std::size_t W = Pk::width;
+
+                // 8 dual quaternion components and the weight of one influence for every vertex
+                alignas(alignment) T block[9][W];
+
+                auto gather = [&](std::size_t k){
+                    for (std::size_t j = 0; j < W; ++j){
+                        const std::size_t slot = (i + j) * K + k;
+                        const auto& dq = palette[influences.bones[slot]];
+
+                        block[0][j] = dq.qr_.w();
+                        block[1][j] = dq.qr_.x();
+                        block[2][j] = dq.qr_.y();
+                        block[3][j] = dq.qr_.z();
+                        block[4][j] = dq.qd_.w();
+                        block[5][j] = dq.qd_.x();
+                        block[6][j] = dq.qd_.y();
+                        block[7][j] = dq.qd_.z();
+                        block[8][j] = influences.weights[slot];
+                    }
+                };
+
+                // The first influence is the pivot of the sign correction
+                gather(0);
+
+                const Pk pw = Pk::load(block[0]), px = Pk::load(block[1]), py = Pk::load(block[2]), pz = Pk::load(block[3]);
+                const Pk w0 = Pk::load(block[8]);
+
+                Pk rw = w0 * pw, rx = w0 * px, ry = w0 * py, rz = w0 * pz;
+                Pk dw = w0 * Pk::load(block[4]), dx = w0 * Pk::load(block[5]), dy = w0 * Pk::load(block[6]), dz = w0 * Pk::load(block[7]);
+
+                const Pk zero = Pk::broadcast(T(0));
+
+                for (std::size_t k = 1; k < K; ++k){
+                    gather(k);
+
+                    const Pk qw = Pk::load(block[0]), qx = Pk::load(block[1]), qy = Pk::load(block[2]), qz = Pk::load(block[3]);
+                    const Pk wk = Pk::load(block[8]);
+
+                    // Antipodal bones (negative 4D dot with the pivot) are blended with a negated weight
+                    const Pk s = select_gt(zero, qw * pw + qx * px + qy * py + qz * pz, -wk, wk);
+
+                    rw = rw + s * qw;
+                    rx = rx + s * qx;
+                    ry = ry + s * qy;
+                    rz = rz + s * qz;
+                    dw = dw + s * Pk::load(block[4]);
+                    dx = dx + s * Pk::load(block[5]);
+                    dy = dy + s * Pk::load(block[6]);
+                    dz = dz + s * Pk::load(block[7]);
+                }
+
+                // Single normalisation: the dual part is scaled by the same factor
+                const Pk inv = Pk::broadcast(T(1)) / sqrt(rw * rw + rx * rx + ry * ry + rz * rz);
+
+                rw = rw * inv; rx = rx * inv; ry = ry * inv; rz = rz * inv;
+                dw = dw * inv; dx = dx * inv; dy = dy * inv; dz = dz * inv;
+
+                const Pk two = Pk::broadcast(T(2));
+
+                // Translation 2 qd qr*, as dualquaternion::translation()
+                const Pk tx = two * (rw * dx - dw * rx + (ry * dz - rz * dy));
+                const Pk ty = two * (rw * dy - dw * ry + (rz * dx - rx * dz));
+                const Pk tz = two * (rw * dz - dw * rz + (rx * dy - ry * dx));
+
+                auto rotate_lanes = [&](point_lanes<const T> in, point_lanes<T> out, bool translate){
+                    const Pk vx = Pk::load_unaligned(in.x + i), vy = Pk::load_unaligned(in.y + i), vz = Pk::load_unaligned(in.z + i);
+
+                    const Pk cx = two * (ry * vz - rz * vy);
+                    const Pk cy = two * (rz * vx - rx * vz);
+                    const Pk cz = two * (rx * vy - ry * vx);
+
+                    Pk ox = vx + rw * cx + (ry * cz - rz * cy);
+                    Pk oy = vy + rw * cy + (rz * cx - rx * cz);
+                    Pk oz = vz + rw * cz + (rx * cy - ry * cx);
+
+                    if (translate){
+                        ox = ox + tx;
+                        oy = oy + ty;
+                        oz = oz + tz;
+                    }
+
+                    ox.store_unaligned(out.x + i);
+                    oy.store_unaligned(out.y + i);
+                    oz.store_unaligned(out.z + i);
+                };
+
+                rotate_lanes(p_in, p_out, true);
+
+                if constexpr (Normals){
+                    rotate_lanes(n_in, n_out, false);
+                }
+            }
+
+            template<bool Normals, typename T, std::size_t K>
+            void skin(  const dualquaternion<T>* palette, const bone_influences<T, K>& influences,
+                        point_lanes<const T> p_in, point_lanes<const T> n_in,
+                        point_lanes<T> p_out, point_lanes<T> n_out, std::size_t begin, std::size_t end) noexcept{
+
+                std::size_t i = begin;
+
+                for (; i + pack<T>::width <= end; i += pack<T>::width){
+                    skin_vertices<pack<T>, Normals>(palette, influences, p_in, n_in, p_out, n_out, i);
+                }
+
+                for (; i < end; ++i){
+                    skin_vertices<scalar_pack<T>, Normals>(palette, influences, p_in, n_in, p_out, n_out, i);
+                }
+            }
+        }
+    }
+
+    template<typename T, std::size_t K>
+    void skin(  const dualquaternion<T>* palette, const bone_influences<T, K>& influences,
+                detail::non_deduced_t<point_lanes<const T>> positions_in, detail::non_deduced_t<point_lanes<T>> positions_out,
+                std::size_t n, const parallel_config& config){
+
+        detail::parallel_for(n, config, [&](std::size_t begin, std::size_t end){
+            simd::skin<false>(palette, influences, positions_in, positions_in, positions_out, positions_out, begin, end);
+        });
+    }
+
+    template<typename T, std::size_t K>
+    void skin(  const dualquaternion<T>* palette, const bone_influences<T, K>& influences,
+                detail::non_deduced_t<point_lanes<const T>> positions_in, detail::non_deduced_t<point_lanes<const T>> normals_in,
+                detail::non_deduced_t<point_lanes<T>> positions_out, detail::non_deduced_t<point_lanes<T>> normals_out,
+                std::size_t n, const parallel_config& config){
+
+        detail::parallel_for(n, config, [&](std::size_t begin, std::size_t end){
+            simd::skin<true>(palette, influences, positions_in, normals_in, positions_out, normals_out, begin, end);
+        });
+    }
+}
@@ -0,0 +1,97 @@
+#include <yadq/slerp.hpp>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief sin(x) / x as a polynomial in u = x^2, minimax in relative error over the closed x in [0, pi/2],
+         * where the error equioscillates at 5.31e-9 (endpoints included)
+         */
+        template<typename T>
+        constexpr T sinc_poly(T u) noexcept{
+            return T(0.9999999946860073) + u * (T(-0.16666656684007158) + u * (T(0.0083330251389695) + u * (T(-0.00019807418727439723) + u * T(2.6019030676854223e-06))));
+        }
+    }
+
+    template<typename _T>
+    template<typename P>
+    slerp_plan<_T>::slerp_plan(const quaternionU<_T, P>& q_start, const quaternionU<_T, P>& q_end, slerp_mode mode):
+        q_start_{q_start.w(), q_start.x(), q_start.y(), q_start.z()},
+        q_end_{q_end.w(), q_end.x(), q_end.y(), q_end.z()},
+        mode_(mode){
+
+        const _T d = q_start_[0] * q_end_[0] + q_start_[1] * q_end_[1] + q_start_[2] * q_end_[2] + q_start_[3] * q_end_[3];
+
+        // Shortest path: q and -q are the same rotation
+        if (d < 0){
+            for (auto& c : q_end_){
+                c = -c;
+            }
+        }
+
+        // theta = 2 atan2(|q1 - q0|, |q1 + q0|) stays accurate for nearly parallel quaternions, unlike acos(dot)
+        _T diff = 0;
+        _T sum = 0;
+        for (std::size_t i = 0; i < 4; ++i){
+            diff += (q_end_[i] - q_start_[i]) * (q_end_[i] - q_start_[i]);
+            sum += (q_end_[i] + q_start_[i]) * (q_end_[i] + q_start_[i]);
+        }
+
+        YADQ_COUNT_N(trig_calls, 2);
+
+        theta_ = 2 * std::atan2(std::sqrt(diff), std::sqrt(sum));
+
+        const _T sin_theta = std::sin(theta_);
+
+        if (sin_theta == 0){
+            // Identical end points: the polynomial weights reduce to the exact LERP
+            inv_sin_ = 0;
+            inv_sinc_ = 1;
+            mode_ = slerp_mode::fast;
+        }else{
+            inv_sin_ = 1 / sin_theta;
+            inv_sinc_ = theta_ / sin_theta;
+        }
+    }
+
+    template<typename _T>
+    inline quaternionU<_T> slerp_plan<_T>::evaluate_fast(_T t) const noexcept{
+
+        const _T s = 1 - t;
+        const _T a = s * theta_;
+        const _T b = t * theta_;
+
+        // sin(s theta) / sin(theta) = s sinc(s theta) theta / sin(theta)
+        return combine( s * detail::sinc_poly(a * a) * inv_sinc_,
+                        t * detail::sinc_poly(b * b) * inv_sinc_);
+    }
+
+    template<typename _T>
+    quaternionU<_T> slerp_plan<_T>::operator()(_T t) const noexcept{
+        return mode_ == slerp_mode::fast ? evaluate_fast(t) : evaluate_exact(t);
+    }
+
+    template<typename _T>
+    void slerp_plan<_T>::evaluate(const _T* t, quaternionU<_T>* q_out, std::size_t n) const noexcept{
+
+        // The mode is tested once, the loops have no branch
+        if (mode_ == slerp_mode::fast){
+            for (std::size_t i = 0; i < n; ++i){
+                q_out[i] = evaluate_fast(t[i]);
+            }
+        }else{
+            for (std::size_t i = 0; i < n; ++i){
+                q_out[i] = evaluate_exact(t[i]);
+            }
+        }
+    }
+
+    template<typename _T>
+    std::vector<quaternionU<_T>> slerp_plan<_T>::evaluate(const std::vector<_T>& t) const{
+
+        std::vector<quaternionU<_T>> q_out(t.size());
+        evaluate(t.data(), q_out.data(), t.size());
+        return q_out;
+    }
+}
@@ -0,0 +1,313 @@
+#include <yadq/trajectory.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace yadq{
+
+    namespace detail {
+
+        /**
+         * \brief SQUAD control point of q between q_prev and q_next, q exp(-(log(q* q_next) + log(q* q_prev)) / 4)
+         */
+        template<typename T>
+        quaternionU<T> squad_control(const quaternionU<T>& q_prev, const quaternionU<T>& q, const quaternionU<T>& q_next) noexcept{
+
+            // Logarithms of the plain products, which quaternionU would renormalise to their axis. Their real
+            // parts are log|.| of unit quaternions, rounding only, and exp drops them when renormalised.
+            const quaternion<T> l_next = *log(quaternion<T>(conjugate(q) * q_next));
+            const quaternion<T> l_prev = *log(quaternion<T>(conjugate(q) * q_prev));
+
+            return q * quaternionU<T>(exp((l_next + l_prev) * -0.25));
+        }
+    }
+
+    template<typename Q>
+    trajectory<Q>::trajectory(std::vector<double> times, std::vector<Q> values, trajectory_interp mode):
+        mode_(mode), times_(std::move(times)), values_(std::move(values)){
+
+        if (times_.size() != values_.size()){
+            throw std::invalid_argument("trajectory needs as many timestamps as values");
+        }
+
+        for (std::size_t i = 1; i < times_.size(); ++i){
+            if (!(times_[i] > times_[i - 1])){
+                throw std::invalid_argument("trajectory timestamps must be strictly increasing");
+            }
+        }
+
+        update(0);
+    }
+
+    template<typename Q>
+    void trajectory<Q>::push_back(double time, const Q& value){
+
+        if (!times_.empty() && !(time > times_.back())){
+            throw std::invalid_argument("trajectory timestamps must be strictly increasing");
+        }
+
+        times_.push_back(time);
+        values_.push_back(value);
+
+        // The previous last keyframe gets a successor, which changes its smooth constants
+        update(times_.size() >= 2 ? times_.size() - 2 : 0);
+    }
+
+    template<typename Q>
+    void trajectory<Q>::reserve(std::size_t n){
+
+        const std::size_t segments = n > 0 ? n - 1 : 0;
+
+        times_.reserve(n);
+        values_.reserve(n);
+        inv_durations_.reserve(segments);
+
+        if (mode_ == trajectory_interp::linear){
+            plans_.reserve(segments);
+        }else{
+            rotations_.reserve(n);
+            controls_.reserve(n);
+            rotation_plans_.reserve(segments);
+            control_plans_.reserve(segments);
+
+            if constexpr (traits::dual){
+                positions_.reserve(n);
+                tangents_.reserve(n);
+            }
+        }
+    }
+
+    template<typename Q>
+    void trajectory<Q>::update(std::size_t first){
+
+        using T = scalar_type;
+
+        const std::size_t n = times_.size();
+
+        // Segments from first - 1 onwards touch a changed keyframe
+        const std::size_t first_segment = first > 0 ? first - 1 : 0;
+        const std::size_t segments = n > 0 ? n - 1 : 0;
+
+        inv_durations_.resize(first_segment);
+        for (std::size_t k = first_segment; k < segments; ++k){
+            inv_durations_.push_back(1.0 / (times_[k + 1] - times_[k]));
+        }
+
+        if (mode_ == trajectory_interp::linear){
+            plans_.erase(plans_.begin() + static_cast<std::ptrdiff_t>(std::min(first_segment, plans_.size())), plans_.end());
+            for (std::size_t k = first_segment; k < segments; ++k){
+                plans_.emplace_back(values_[k], values_[k + 1]);
+            }
+            return;
+        }
+
+        // Rotations on the hemisphere of their predecessor, so that control points follow the shortest paths
+        rotations_.resize(n);
+        for (std::size_t i = first; i < n; ++i){
+            quaternionU<T> q;
+            if constexpr (traits::dual){
+                q = values_[i].qr_;
+            }else{
+                q = values_[i];
+            }
+
+            if (i > 0 && q.w() * rotations_[i - 1].w() + q.x() * rotations_[i - 1].x() + q.y() * rotations_[i - 1].y() + q.z() * rotations_[i - 1].z() < 0){
+                q = quaternionU<T>(-q.w(), -q.x(), -q.y(), -q.z());
+            }
+            rotations_[i] = q;
+        }
+
+        // End points are their own control points
+        controls_.resize(n);
+        for (std::size_t i = first; i < n; ++i){
+            controls_[i] = (i == 0 || i + 1 == n) ? rotations_[i] : detail::squad_control(rotations_[i - 1], rotations_[i], rotations_[i + 1]);
+        }
+
+        const auto erase_from = [first_segment](auto& v){
+            v.erase(v.begin() + static_cast<std::ptrdiff_t>(std::min(first_segment, v.size())), v.end());
+        };
+
+        erase_from(rotation_plans_);
+        erase_from(control_plans_);
+        for (std::size_t k = first_segment; k < segments; ++k){
+            rotation_plans_.emplace_back(rotations_[k], rotations_[k + 1]);
+            control_plans_.emplace_back(controls_[k], controls_[k + 1]);
+        }
+
+        if constexpr (traits::dual){
+            positions_.resize(n);
+            for (std::size_t i = first; i < n; ++i){
+                positions_[i] = values_[i].translation();
+            }
+
+            // Catmull-Rom tangents for uneven spacing, one-sided differences at the end points
+            tangents_.resize(n);
+            for (std::size_t i = first; i < n; ++i){
+                std::array<T, 3>& m = tangents_[i];
+
+                if (n < 2){
+                    m = {0, 0, 0};
+                }else if (i == 0 || i + 1 == n){
+                    const std::size_t a = i == 0 ? 0 : i - 1;
+                    const T inv_h = static_cast<T>(inv_durations_[a]);
+                    for (std::size_t c = 0; c < 3; ++c){
+                        m[c] = (positions_[a + 1][c] - positions_[a][c]) * inv_h;
+                    }
+                }else{
+                    const T h0 = static_cast<T>(times_[i] - times_[i - 1]);
+                    const T h1 = static_cast<T>(times_[i + 1] - times_[i]);
+                    for (std::size_t c = 0; c < 3; ++c){
+                        m[c] = ((positions_[i][c] - positions_[i - 1][c]) * (h1 / h0) + (positions_[i + 1][c] - positions_[i][c]) * (h0 / h1)) / (h0 + h1);
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename Q>
+    void trajectory<Q>::check_not_empty() const{
+        if (times_.empty()){
+            throw std::out_of_range("query on an empty trajectory");
+        }
+    }
+
+    template<typename Q>
+    std::size_t trajectory<Q>::locate(double time, std::size_t hint) const noexcept{
+
+        if (times_.size() < 2){
+            return 0;
+        }
+
+        const std::size_t last = times_.size() - 2;
+
+        if (time < times_[hint]){
+            // Backwards: binary search below the hint
+            const auto it = std::upper_bound(times_.begin(), times_.begin() + static_cast<std::ptrdiff_t>(hint), time);
+            return it == times_.begin() ? 0 : static_cast<std::size_t>(it - times_.begin()) - 1;
+        }
+
+        // Forwards: the next few segments first, then galloping from the hint
+        std::size_t k = hint;
+        for (int step = 0; step < 4; ++step){
+            if (k == last || time < times_[k + 1]){
+                return k;
+            }
+            ++k;
+        }
+
+        std::size_t lo = k;
+        std::size_t bound = 1;
+        while (lo + bound <= last && times_[lo + bound] <= time){
+            lo += bound;
+            bound *= 2;
+        }
+
+        // times_[lo] <= time, and time < times_[lo + bound] when lo + bound <= last
+        const std::size_t hi = std::min(lo + bound, last + 1);
+        const auto it = std::upper_bound(times_.begin() + static_cast<std::ptrdiff_t>(lo + 1), times_.begin() + static_cast<std::ptrdiff_t>(hi), time);
+        return static_cast<std::size_t>(it - times_.begin()) - 1;
+    }
+
+    template<typename Q>
+    Q trajectory<Q>::evaluate_segment(std::size_t k, double time) const noexcept{
+
+        using T = scalar_type;
+
+        if (times_.size() < 2){
+            return values_.front();
+        }
+
+        const T u = static_cast<T>(std::clamp((time - times_[k]) * inv_durations_[k], 0.0, 1.0));
+
+        if (mode_ == trajectory_interp::linear){
+            return plans_[k](u);
+        }
+
+        // SQUAD: slerp(slerp(q_k, q_k+1, u), slerp(s_k, s_k+1, u), 2 u (1 - u))
+        const quaternionU<T> r = interpolation(rotation_plans_[k](u), control_plans_[k](u), 2 * u * (1 - u), InterpType::SLERP);
+
+        if constexpr (traits::dual){
+            const T dt = static_cast<T>(times_[k + 1] - times_[k]);
+            const T u2 = u * u;
+            const T u3 = u2 * u;
+
+            // Cubic Hermite basis
+            const T h00 = 2 * u3 - 3 * u2 + 1;
+            const T h10 = (u3 - 2 * u2 + u) * dt;
+            const T h01 = 3 * u2 - 2 * u3;
+            const T h11 = (u3 - u2) * dt;
+
+            const std::array<T, 3>& p0 = positions_[k];
+            const std::array<T, 3>& p1 = positions_[k + 1];
+            const std::array<T, 3>& m0 = tangents_[k];
+            const std::array<T, 3>& m1 = tangents_[k + 1];
+
+            return Q(r, std::array<T, 3>{   h00 * p0[0] + h10 * m0[0] + h01 * p1[0] + h11 * m1[0],
+                                            h00 * p0[1] + h10 * m0[1] + h01 * p1[1] + h11 * m1[1],
+                                            h00 * p0[2] + h10 * m0[2] + h01 * p1[2] + h11 * m1[2]});
+        }else{
+            return r;
+        }
+    }
+
+    template<typename Q>
+    Q trajectory<Q>::operator()(double time) const{
+
+        check_not_empty();
+
+        const auto it = std::upper_bound(times_.begin(), times_.end(), time);
+        const std::size_t k = it == times_.begin() ? 0 : static_cast<std::size_t>(it - times_.begin()) - 1;
+
+        // The last keyframe belongs to the last segment
+        return evaluate_segment(k + 1 == times_.size() && k > 0 ? k - 1 : k, time);
+    }
+
+    template<typename Q>
+    void trajectory<Q>::evaluate(const double* times, Q* out, std::size_t n) const{
+
+        if (n == 0){
+            return;
+        }
+
+        check_not_empty();
+
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            k = locate(times[i], k);
+            out[i] = evaluate_segment(k, times[i]);
+        }
+    }
+
+    template<typename Q>
+    std::vector<Q> trajectory<Q>::evaluate(const std::vector<double>& times) const{
+
+        std::vector<Q> out(times.size());
+        evaluate(times.data(), out.data(), times.size());
+        return out;
+    }
+
+    template<typename Q>
+    void trajectory<Q>::evaluate(const double* times, Q* out, std::size_t n, const parallel_config& config) const{
+
+        if (n == 0){
+            return;
+        }
+
+        check_not_empty();
+
+        detail::parallel_chunks(n, detail::thread_count(n, config), [&](unsigned, std::size_t begin, std::size_t end){
+            evaluate(times + begin, out + begin, end - begin);
+        });
+    }
+
+    template<typename Q>
+    std::vector<Q> trajectory<Q>::evaluate(const std::vector<double>& times, const parallel_config& config) const{
+
+        std::vector<Q> out(times.size());
+        evaluate(times.data(), out.data(), times.size(), config);
+
+        return out;
+    }
+}
@@ -0,0 +1,254 @@
+#include <yadq/trajectory_file.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yadq{
+
+    namespace detail {
+
+        [[noreturn]] inline void throw_file_error(const std::string& what, const std::string& path){
+            throw std::system_error(errno, std::generic_category(), what + " " + path);
+        }
+
+        /**
+         * \brief Owning file descriptor
+         */
+        struct file_descriptor{
+            int fd{-1};
+
+            file_descriptor(const std::string& path, int flags){
+                do {
+                    fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+                } while (fd < 0 && errno == EINTR);
+
+                if (fd < 0){
+                    throw_file_error("cannot open", path);
+                }
+            }
+
+            file_descriptor(const file_descriptor&) = delete;
+            file_descriptor& operator=(const file_descriptor&) = delete;
+
+            ~file_descriptor(){
+                if (fd >= 0){
+                    ::close(fd);
+                }
+            }
+
+            int release() noexcept{
+                return std::exchange(fd, -1);
+            }
+        };
+
+        /**
+         * \brief Write n bytes at offset, retrying on partial writes
+         */
+        inline void write_all(int fd, const void* data, std::size_t n, std::uint64_t offset){
+
+            const char* p = static_cast<const char*>(data);
+
+            while (n > 0){
+                const ssize_t w = ::pwrite(fd, p, n, static_cast<off_t>(offset));
+
+                if (w < 0){
+                    if (errno == EINTR){
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "trajectory write failed");
+                }
+
+                p += w;
+                n -= static_cast<std::size_t>(w);
+                offset += static_cast<std::uint64_t>(w);
+            }
+        }
+
+        template<typename Q>
+        trajectory_header make_header(std::uint64_t count) noexcept{
+
+            trajectory_header h{};
+
+            std::memcpy(h.magic, trajectory_header::magic_value, sizeof(h.magic));
+            h.version = trajectory_header::current_version;
+            h.kind = static_cast<std::uint32_t>(record_traits<Q>::kind);
+            h.scalar_size = sizeof(typename record_traits<Q>::value_type);
+            h.record_size = sizeof(trajectory_record<Q>);
+            h.count = count;
+            h.data_offset = sizeof(trajectory_header);
+
+            return h;
+        }
+
+        /**
+         * \brief Check that a header describes records of type Q and that file_size bytes hold all of them
+         */
+        template<typename Q>
+        void check_header(const trajectory_header& h, std::uint64_t file_size, const std::string& path){
+
+            const trajectory_header expected = make_header<Q>(0);
+
+            if (std::memcmp(h.magic, expected.magic, sizeof(h.magic)) != 0){
+                throw std::runtime_error("not a trajectory file: " + path);
+            }
+            if (h.version != expected.version){
+                throw std::runtime_error("unsupported trajectory file version " + std::to_string(h.version) + ": " + path);
+            }
+            if (h.kind != expected.kind || h.scalar_size != expected.scalar_size || h.record_size != expected.record_size){
+                throw std::runtime_error("trajectory file records do not match the requested type: " + path);
+            }
+            if (h.data_offset < sizeof(trajectory_header) || h.data_offset % alignof(trajectory_record<Q>) != 0 || h.data_offset > file_size ||
+                h.count > (file_size - h.data_offset) / h.record_size){
+                throw std::runtime_error("truncated trajectory file: " + path);
+            }
+        }
+    }
+
+    /*
+        ------------------------------ trajectory_reader ------------------------------
+    */
+
+    template<typename Q>
+    trajectory_reader<Q>::trajectory_reader(const std::string& path, access_pattern pattern){
+
+        detail::file_descriptor file(path, O_RDONLY);
+
+        struct stat st;
+        if (::fstat(file.fd, &st) != 0){
+            detail::throw_file_error("cannot stat", path);
+        }
+
+        const std::uint64_t file_size = static_cast<std::uint64_t>(st.st_size);
+
+        if (file_size < sizeof(trajectory_header)){
+            throw std::runtime_error("not a trajectory file: " + path);
+        }
+
+        // The mapping outlives the descriptor, which is closed on return
+        void* map = ::mmap(nullptr, static_cast<std::size_t>(file_size), PROT_READ, MAP_SHARED, file.fd, 0);
+        if (map == MAP_FAILED){
+            detail::throw_file_error("cannot map", path);
+        }
+
+        map_ = map;
+        map_size_ = static_cast<std::size_t>(file_size);
+
+        try {
+            detail::check_header<Q>(header(), file_size, path);
+        } catch (...){
+            ::munmap(map_, map_size_);
+            throw;
+        }
+
+        records_ = reinterpret_cast<const record_type*>(static_cast<const char*>(map_) + header().data_offset);
+        size_ = static_cast<std::size_t>(header().count);
+
+        if (pattern != access_pattern::normal){
+            // Only a hint: failures are ignored
+            ::madvise(map_, map_size_, pattern == access_pattern::sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        }
+    }
+
+    template<typename Q>
+    trajectory_reader<Q>::~trajectory_reader(){
+        if (map_ != nullptr){
+            ::munmap(map_, map_size_);
+        }
+    }
+
+    template<typename Q>
+    const typename trajectory_reader<Q>::record_type& trajectory_reader<Q>::at(std::size_t i) const{
+        if (i >= size_){
+            throw std::out_of_range("trajectory_reader index out of range");
+        }
+        return records_[i];
+    }
+
+    template<typename Q>
+    void trajectory_reader<Q>::swap(trajectory_reader& other) noexcept{
+        std::swap(map_, other.map_);
+        std::swap(map_size_, other.map_size_);
+        std::swap(records_, other.records_);
+        std::swap(size_, other.size_);
+    }
+
+    /*
+        ------------------------------ trajectory_appender ------------------------------
+    */
+
+    template<typename Q>
+    trajectory_appender<Q>::trajectory_appender(const std::string& path, open_mode mode, std::size_t buffer_records): capacity_(std::max<std::size_t>(1, buffer_records)){
+
+        detail::file_descriptor file(path, O_RDWR | O_CREAT | (mode == open_mode::truncate ? O_TRUNC : 0));
+
+        struct stat st;
+        if (::fstat(file.fd, &st) != 0){
+            detail::throw_file_error("cannot stat", path);
+        }
+
+        const std::uint64_t file_size = static_cast<std::uint64_t>(st.st_size);
+
+        if (file_size == 0){
+            const trajectory_header h = detail::make_header<Q>(0);
+            detail::write_all(file.fd, &h, sizeof(h), 0);
+        } else {
+            trajectory_header h;
+
+            if (file_size < sizeof(h) || ::pread(file.fd, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h))){
+                throw std::runtime_error("not a trajectory file: " + path);
+            }
+
+            detail::check_header<Q>(h, file_size, path);
+            written_ = h.count;
+            data_offset_ = h.data_offset;
+
+            // Records written after the last flush are not part of the file and get overwritten. The file is never
+            // shrunk: readers may map it, and touching a page past its end raises SIGBUS.
+        }
+
+        buffer_.reserve(capacity_);
+        fd_ = file.release();
+    }
+
+    template<typename Q>
+    trajectory_appender<Q>::~trajectory_appender(){
+        try {
+            flush();
+        } catch (...){
+            // Destructors do not throw; call flush() to observe errors
+        }
+        ::close(fd_);
+    }
+
+    template<typename Q>
+    void trajectory_appender<Q>::write_buffer(){
+
+        if (buffer_.empty()){
+            return;
+        }
+
+        detail::write_all(fd_, buffer_.data(), buffer_.size() * sizeof(record_type), data_offset_ + written_ * sizeof(record_type));
+
+        written_ += buffer_.size();
+        buffer_.clear();
+    }
+
+    template<typename Q>
+    void trajectory_appender<Q>::flush(){
+
+        write_buffer();
+
+        // The count goes last: a reader never sees records that are not fully written
+        const std::uint64_t count = written_;
+        detail::write_all(fd_, &count, sizeof(count), offsetof(trajectory_header, count));
+    }
+}
@@ -0,0 +1,342 @@
+#ifndef YADQ_INSTRUMENTATION_HPP
+#define YADQ_INSTRUMENTATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include <yadq/constexpr_math.hpp>
+#include <yadq/instrumentation_hooks.hpp>
+
+/*
+    Hot-path instrumentation, off by default. Define YADQ_INSTRUMENTATION to count, per thread, the scalar
+    operations listed in instrumentation::counter; define YADQ_INSTRUMENTATION_TIMERS (which implies the former)
+    to also time the functions listed in instrumentation::timer. The macros must be set identically in every
+    translation unit of a program, e.g. through the YADQ_INSTRUMENTATION CMake option.
+
+    Disabled, every hook of yadq/instrumentation_hooks.hpp expands to nothing and the library headers do not
+    include this one. Enabled or not, the quaternion types keep their trivial copies (batches and trajectory
+    files rely on it), so copies are not counted, only conversions. Constant evaluation is never counted nor
+    timed.
+*/
+
+namespace yadq{
+
+    namespace instrumentation{
+
+        /**
+        * \brief Operations counted when YADQ_INSTRUMENTATION is defined. Only the scalar code paths count: the
+        * SIMD batch kernels do not.
+        * constructions: quaternion / quaternionU built from components, by default or from an axis and angle
+        * conversions: conversions from quaternion to quaternionU; copies are trivial and not counted
+        * normalisations: exact or first-order renormalisations, the implicit ones of quaternionU included
+        * hamilton_products: quaternion products
+        * trig_calls: evaluations of sin, cos, acos and atan2
+        * allocations: allocations made through aligned_allocator (batches, point clouds)
+        */
+        enum class counter : std::size_t {constructions, conversions, normalisations, hamilton_products, trig_calls, allocations};
+
+        constexpr std::size_t counter_count = 6;
+
+        /**
+        * \brief Functions timed when YADQ_INSTRUMENTATION_TIMERS is defined
+        */
+        enum class timer : std::size_t {interpolation, quat_to_rotation, dual_product};
+
+        constexpr std::size_t timer_count = 3;
+
+#if defined(YADQ_INSTRUMENTATION)
+        constexpr bool enabled = true;
+#else
+        constexpr bool enabled = false;
+#endif
+
+#if defined(YADQ_INSTRUMENTATION_TIMERS)
+        constexpr bool timers_enabled = true;
+#else
+        constexpr bool timers_enabled = false;
+#endif
+
+        /**
+         * \brief Printable name of a counter
+         */
+        constexpr const char* name(counter c) noexcept{
+            constexpr const char* names[counter_count] = {"constructions", "conversions", "normalisations", "hamilton_products", "trig_calls", "allocations"};
+            return names[static_cast<std::size_t>(c)];
+        }
+
+        /**
+         * \brief Printable name of a timer
+         */
+        constexpr const char* name(timer t) noexcept{
+            constexpr const char* names[timer_count] = {"interpolation", "quatToRotation", "dualquaternion product"};
+            return names[static_cast<std::size_t>(t)];
+        }
+
+        /**
+        * \struct timer_stats
+        * \brief Number of timed calls and their total duration
+        */
+        struct timer_stats{
+            std::uint64_t calls = 0;
+            std::uint64_t nanoseconds = 0;
+        };
+
+        /**
+        * \struct snapshot
+        * \brief Values of every counter and timer at one point. The difference of two snapshots gives the cost of
+        * the code run in between.
+        */
+        struct snapshot{
+            std::array<std::uint64_t, counter_count> counters{};
+            std::array<timer_stats, timer_count> timers{};
+
+            constexpr std::uint64_t operator[](counter c) const noexcept{
+                return counters[static_cast<std::size_t>(c)];
+            }
+
+            constexpr const timer_stats& operator[](timer t) const noexcept{
+                return timers[static_cast<std::size_t>(t)];
+            }
+
+            snapshot& operator+=(const snapshot& other) noexcept{
+                for (std::size_t i = 0; i < counter_count; ++i){
+                    counters[i] += other.counters[i];
+                }
+                for (std::size_t i = 0; i < timer_count; ++i){
+                    timers[i].calls += other.timers[i].calls;
+                    timers[i].nanoseconds += other.timers[i].nanoseconds;
+                }
+                return *this;
+            }
+
+            snapshot& operator-=(const snapshot& other) noexcept{
+                for (std::size_t i = 0; i < counter_count; ++i){
+                    counters[i] -= other.counters[i];
+                }
+                for (std::size_t i = 0; i < timer_count; ++i){
+                    timers[i].calls -= other.timers[i].calls;
+                    timers[i].nanoseconds -= other.timers[i].nanoseconds;
+                }
+                return *this;
+            }
+        };
+
+        inline snapshot operator+(snapshot lhv, const snapshot& rhv) noexcept{
+            return lhv += rhv;
+        }
+
+        inline snapshot operator-(snapshot lhv, const snapshot& rhv) noexcept{
+            return lhv -= rhv;
+        }
+
+        /**
+         * \brief One line per counter, then one per timer that was called
+         */
+        inline std::ostream& operator<<(std::ostream& os, const snapshot& s){
+            for (std::size_t i = 0; i < counter_count; ++i){
+                os << name(static_cast<counter>(i)) << ": " << s.counters[i] << '\n';
+            }
+            for (std::size_t i = 0; i < timer_count; ++i){
+                if (s.timers[i].calls != 0){
+                    os << name(static_cast<timer>(i)) << ": " << s.timers[i].calls << " calls, " << s.timers[i].nanoseconds << " ns\n";
+                }
+            }
+            return os;
+        }
+
+        namespace detail {
+
+            /**
+             * \brief Counters of one thread. Only the owner writes them, with a relaxed load and store rather than
+             * a locked read-modify-write; other threads may read them at any time.
+             */
+            struct thread_block{
+                std::array<std::atomic<std::uint64_t>, counter_count> counters{};
+                std::array<std::atomic<std::uint64_t>, timer_count> calls{};
+                std::array<std::atomic<std::uint64_t>, timer_count> nanoseconds{};
+
+                thread_block();
+                ~thread_block();
+
+                snapshot read() const noexcept{
+                    snapshot s;
+                    for (std::size_t i = 0; i < counter_count; ++i){
+                        s.counters[i] = counters[i].load(std::memory_order_relaxed);
+                    }
+                    for (std::size_t i = 0; i < timer_count; ++i){
+                        s.timers[i].calls = calls[i].load(std::memory_order_relaxed);
+                        s.timers[i].nanoseconds = nanoseconds[i].load(std::memory_order_relaxed);
+                    }
+                    return s;
+                }
+
+                void clear() noexcept{
+                    for (auto& c : counters){
+                        c.store(0, std::memory_order_relaxed);
+                    }
+                    for (std::size_t i = 0; i < timer_count; ++i){
+                        calls[i].store(0, std::memory_order_relaxed);
+                        nanoseconds[i].store(0, std::memory_order_relaxed);
+                    }
+                }
+            };
+
+            /**
+             * \brief Blocks of the running threads, and the totals of the threads that exited
+             */
+            struct registry{
+                std::mutex mutex;
+                std::vector<const thread_block*> blocks;
+                snapshot retired;
+            };
+
+            inline registry& global_registry(){
+                static registry r;
+                return r;
+            }
+
+            inline thread_block::thread_block(){
+                registry& r = global_registry();
+                const std::lock_guard<std::mutex> lock(r.mutex);
+                r.blocks.push_back(this);
+            }
+
+            inline thread_block::~thread_block(){
+                registry& r = global_registry();
+                const std::lock_guard<std::mutex> lock(r.mutex);
+                r.retired += read();
+                r.blocks.erase(std::find(r.blocks.begin(), r.blocks.end(), this));
+            }
+
+            inline thread_block& local_block(){
+                thread_local thread_block block;
+                return block;
+            }
+
+            inline void add(std::atomic<std::uint64_t>& c, std::uint64_t n) noexcept{
+                c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+
+            inline void increment(counter c, std::uint64_t n) noexcept{
+                add(local_block().counters[static_cast<std::size_t>(c)], n);
+            }
+        }
+
+        /**
+         * \brief Counters of the calling thread, zero when instrumentation is disabled
+         */
+        inline snapshot thread_snapshot(){
+            if constexpr (enabled){
+                return detail::local_block().read();
+            }else{
+                return {};
+            }
+        }
+
+        /**
+         * \brief Counters summed over every thread, the ones that already exited included
+         */
+        inline snapshot global_snapshot(){
+            if constexpr (enabled){
+                detail::registry& r = detail::global_registry();
+                const std::lock_guard<std::mutex> lock(r.mutex);
+
+                snapshot s = r.retired;
+                for (const auto* b : r.blocks){
+                    s += b->read();
+                }
+                return s;
+            }else{
+                return {};
+            }
+        }
+
+        /**
+         * \brief Reset the counters of the calling thread
+         */
+        inline void reset(){
+            if constexpr (enabled){
+                detail::local_block().clear();
+            }
+        }
+
+        /**
+         * \brief Reset the counters of every thread. Increments racing with the reset may be lost.
+         */
+        inline void reset_all(){
+            if constexpr (enabled){
+                detail::registry& r = detail::global_registry();
+                const std::lock_guard<std::mutex> lock(r.mutex);
+
+                r.retired = snapshot();
+                for (const auto* b : r.blocks){
+                    const_cast<detail::thread_block*>(b)->clear();
+                }
+            }
+        }
+
+        /**
+        * \class scoped_timer
+        * \brief Add the lifetime of the object to a timer of the calling thread. Does nothing unless
+        * YADQ_INSTRUMENTATION_TIMERS is defined.
+        */
+        class scoped_timer{
+            public:
+                explicit scoped_timer(timer t) noexcept: timer_(t){
+                    if constexpr (timers_enabled){
+                        start_ = std::chrono::steady_clock::now();
+                    }
+                }
+
+                scoped_timer(const scoped_timer&) = delete;
+                scoped_timer& operator=(const scoped_timer&) = delete;
+
+                ~scoped_timer(){
+                    if constexpr (timers_enabled){
+                        const auto elapsed = std::chrono::steady_clock::now() - start_;
+                        const auto i = static_cast<std::size_t>(timer_);
+
+                        detail::thread_block& b = detail::local_block();
+                        detail::add(b.calls[i], 1);
+                        detail::add(b.nanoseconds[i], static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+                    }
+                }
+
+            private:
+                timer timer_;
+                std::chrono::steady_clock::time_point start_{};
+        };
+
+        namespace detail {
+
+            template<typename F>
+            auto run_timed(timer t, F& f){
+                const scoped_timer scope(t);
+                return f();
+            }
+        }
+
+        /**
+         * \brief Return f(), timed by t when timers are enabled. Usable in constexpr functions: constant
+         * evaluation calls f directly.
+         */
+        template<typename F>
+        constexpr auto timed([[maybe_unused]] timer t, F&& f){
+#if defined(YADQ_INSTRUMENTATION_TIMERS)
+            if (!YADQ_IS_CONSTANT_EVALUATED()){
+                return detail::run_timed(t, f);
+            }
+#endif
+            return f();
+        }
+    }
+}
+
+#endif
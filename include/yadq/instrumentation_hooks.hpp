@@ -0,0 +1,25 @@
+#ifndef YADQ_INSTRUMENTATION_HOOKS_HPP
+#define YADQ_INSTRUMENTATION_HOOKS_HPP
+
+/*
+    Hooks placed on the hot paths, see yadq/instrumentation.hpp. Disabled, they expand to nothing and the
+    library headers do not include the instrumentation runtime.
+    YADQ_COUNT(name), YADQ_COUNT_N(name, n): add 1 or n to instrumentation::counter::name
+    YADQ_TIMED(name, f): return f(), timed by instrumentation::timer::name
+*/
+#if defined(YADQ_INSTRUMENTATION_TIMERS) && !defined(YADQ_INSTRUMENTATION)
+    #define YADQ_INSTRUMENTATION
+#endif
+
+#if defined(YADQ_INSTRUMENTATION)
+    #define YADQ_COUNT_N(name, n) \
+        do{ if (!YADQ_IS_CONSTANT_EVALUATED()){ ::yadq::instrumentation::detail::increment(::yadq::instrumentation::counter::name, n); } }while(false)
+    #define YADQ_TIMED(name, ...) ::yadq::instrumentation::timed(::yadq::instrumentation::timer::name, __VA_ARGS__)
+#else
+    #define YADQ_COUNT_N(name, n) static_cast<void>(0)
+    #define YADQ_TIMED(name, ...) (__VA_ARGS__)()
+#endif
+
+#define YADQ_COUNT(name) YADQ_COUNT_N(name, 1)
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef MEAN_HPP
+#define MEAN_HPP
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/rotation_map.hpp>
+#include <yadq/parallel.hpp>
+#include <yadq/simd.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Rotation averaging ------------------------------
+
+        Every mean is insensitive to the sign of the samples (q and -q are the same rotation) and is returned
+        with w >= 0. The means of an empty set, or of a set of total weight zero, throw std::invalid_argument.
+    */
+
+    /**
+    * \class quaternion_accumulator
+    * \brief Streaming accumulator of the Markley average: M = sum_i w_i q_i q_i^T, the mean being the
+    * eigenvector of the largest eigenvalue of M (the quaternion minimising the weighted sum of squared chordal
+    * distances between rotation matrices). Only the 10 distinct entries of M are kept, in double whatever T:
+    * samples are never stored, and accumulators of disjoint sets merge by adding their moments.
+    */
+    template<typename _T>
+    class quaternion_accumulator{
+        static_assert(std::is_same_v<_T, float> || std::is_same_v<_T, double>, "This class only supports floating point types");
+        public:
+            using value_type = _T;
+
+            /**
+             * \brief Add a sample
+             * \param q_in unitary quaternion
+             * \param weight weight of the sample
+             */
+            template<typename P>
+            void add(const quaternionU<_T, P>& q_in, _T weight = 1) noexcept;
+            /**
+             * \brief Add every quaternion of a batch, with SIMD
+             * \param q_in unitary quaternions
+             * \param weights q_in.size() weights, nullptr for unit weights
+             * \param config threading settings
+             */
+            void add(const quaternion_batch<_T>& q_in, const _T* weights = nullptr, const parallel_config& config = {});
+            /**
+             * \brief Add the samples of another accumulator
+             */
+            quaternion_accumulator& merge(const quaternion_accumulator& other) noexcept;
+
+            quaternion_accumulator& operator+=(const quaternion_accumulator& other) noexcept{
+                return merge(other);
+            }
+            /**
+             * \brief Remove every sample
+             */
+            void clear() noexcept{
+                *this = quaternion_accumulator();
+            }
+            /**
+             * \brief Number of samples added
+             */
+            inline std::size_t count() const noexcept{
+                return count_;
+            }
+            /**
+             * \brief Sum of the weights
+             */
+            inline double total_weight() const noexcept{
+                return weight_;
+            }
+            /**
+             * \brief Distinct entries of M: ww, wx, wy, wz, xx, xy, xz, yy, yz, zz
+             */
+            inline const std::array<double, 10>& moments() const noexcept{
+                return moments_;
+            }
+            /**
+             * \brief Markley mean of the samples added so far
+             */
+            quaternionU<_T> mean() const;
+
+        private:
+            std::array<double, 10> moments_{};
+            double weight_{0};
+            std::size_t count_{0};
+    };
+
+    using quaternion_accumulatorf = quaternion_accumulator<float>;
+    using quaternion_accumulatord = quaternion_accumulator<double>;
+
+    /**
+     * \brief Markley mean of a batch
+     * \param q_in unitary quaternions
+     * \param config threading settings
+     */
+    template<typename T>
+    quaternionU<T> mean(const quaternion_batch<T>& q_in, const parallel_config& config = {});
+
+    /**
+     * \brief Weighted Markley mean of a batch
+     * \param q_in unitary quaternions
+     * \param weights q_in.size() weights
+     * \param config threading settings
+     */
+    template<typename T>
+    quaternionU<T> mean(const quaternion_batch<T>& q_in, const detail::non_deduced_t<T>* weights, const parallel_config& config = {});
+
+    /**
+     * \brief Markley mean of a range of quaternionU objects, in one pass
+     * \param first iterator to the first quaternion
+     * \param last iterator past the last quaternion
+     */
+    template<   typename It,
+                typename = std::enable_if_t<is_quaternionU_v<typename std::iterator_traits<It>::value_type>>>
+    auto mean(It first, It last);
+
+    /**
+    * \brief Metric minimised by iterative_mean
+    * chordal: sum of squared chord lengths min(|q - q_i|, |q + q_i|)^2. Each iteration aligns the samples with
+    * the hemisphere of the current estimate and normalises their sum; it stops when no sample changes hemisphere.
+    * geodesic: sum of squared rotation angles between q and the samples (Karcher mean). Each iteration moves
+    * along the mean of the rotation vectors log_map(q* q_i), starting from the chordal mean.
+    */
+    enum class mean_metric {chordal, geodesic};
+
+    /**
+    * \struct mean_options
+    * \brief Settings of iterative_mean
+    */
+    struct mean_options{
+        mean_metric metric = mean_metric::chordal;
+        /**
+         * Maximum number of passes over the samples
+         */
+        std::size_t max_iterations = 50;
+        /**
+         * Geodesic only: stop when an update rotates the estimate by less than this angle (radians)
+         */
+        double tolerance = 1e-12;
+    };
+
+    /**
+     * \brief Iterative mean of a batch, one pass over the samples per iteration
+     * \param q_in unitary quaternions
+     * \param weights q_in.size() weights, nullptr for unit weights
+     * \param options metric and stopping criteria
+     * \param config threading settings
+     */
+    template<typename T>
+    quaternionU<T> iterative_mean(  const quaternion_batch<T>& q_in, const detail::non_deduced_t<T>* weights = nullptr,
+                                    const mean_options& options = {}, const parallel_config& config = {});
+}
+
+#include <yadq/impl/mean.tpp>
+
+#endif
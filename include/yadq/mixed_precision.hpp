@@ -0,0 +1,124 @@
+#ifndef MIXED_PRECISION_HPP
+#define MIXED_PRECISION_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <yadq/quaternion.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Mixed precision ------------------------------
+
+        quaternion<float> halves the memory of quaternion<double>, but a chain of float products loses about an
+        ULP of float per composition: after 10^7 compositions the attitude is off by milliradians. The tools
+        below keep float storage and only widen the arithmetic that accumulates error:
+        - norms: quaternion<float>::norm() and normalise() already accumulate in double;
+        - single products: accurate_prod rounds the exact product once to float;
+        - long chains: composition_chain keeps the running product in a wider format and rounds on read.
+
+        Two accumulations are available. accumulation::wide computes in double. accumulation::compensated stays
+        in the storage type and carries every value as an unevaluated sum hi + lo, with error-free products
+        (two-product, through FMA when the target has it) and sums (two-sum): roughly twice the precision of the
+        storage type, for targets where double arithmetic is slow or unavailable.
+
+        Conversions between quaternion<float> and quaternion<double> (and quaternionU, dualquaternion) are
+        explicit constructors.
+    */
+
+    /**
+     * \brief Arithmetic used for the mixed-precision products
+     */
+    enum class accumulation {wide, compensated};
+
+    namespace detail {
+
+        /**
+         * \brief Running product of a composition_chain: double components
+         */
+        template<typename _T, accumulation _A>
+        struct chain_state {
+            std::array<double, 4> q_{1, 0, 0, 0};
+        };
+
+        /**
+         * \brief Running product of a composition_chain: hi + lo per component, in the storage type
+         */
+        template<typename _T>
+        struct chain_state<_T, accumulation::compensated> {
+            std::array<_T, 4> hi_{1, 0, 0, 0};
+            std::array<_T, 4> lo_{0, 0, 0, 0};
+        };
+    }
+
+    /**
+     * \brief Hamilton product of two quaternions of the same type, computed with more precision than the storage
+     * type and rounded once. A quaternionU product is normalised before rounding.
+     * \param q_lhv left operand
+     * \param q_rhv right operand
+     */
+    template<   accumulation A = accumulation::wide,
+                typename Q,
+                typename = std::enable_if_t<is_base_of_quaternion_v<Q>>>
+    Q accurate_prod(const Q& q_lhv, const Q& q_rhv) noexcept;
+
+    /**
+    * \class composition_chain
+    * \brief Product of a long chain of rotations, q_0 * q_1 * ... * q_n, stored as T but accumulated with the
+    * chosen arithmetic. The running product is rescaled to unit norm every rescale_period compositions, which
+    * only changes its magnitude, never the rotation it encodes.
+    */
+    template<typename _T, accumulation _A = accumulation::wide>
+    class composition_chain : private detail::chain_state<_T, _A>{
+        static_assert(std::is_same_v<_T, float> || std::is_same_v<_T, double>, "This class only supports floating point types");
+        public:
+            using value_type = _T;
+
+            static constexpr accumulation mode = _A;
+            static constexpr std::size_t rescale_period = 1024;
+
+            /**
+             * \brief Empty chain, the identity rotation
+             */
+            composition_chain() noexcept = default;
+            /**
+             * \brief Chain starting from a rotation
+             * \param q_start first rotation of the chain
+             */
+            explicit composition_chain(const quaternionU<_T>& q_start) noexcept;
+            /**
+             * \brief Compose on the right with a rotation: chain = chain * q_in
+             * \param q_in rotation, stored as T; its observed components are used
+             */
+            template<   typename Q,
+                        typename = std::enable_if_t<is_base_of_quaternion_v<Q> && std::is_same_v<typename Q::value_type, _T>>>
+            composition_chain& operator*=(const Q& q_in) noexcept;
+            /**
+             * \brief Current product, normalised and rounded to T
+             */
+            quaternionU<_T> value() const noexcept;
+            /**
+             * \brief Current product, normalised in double
+             */
+            quaternionU<double> value_wide() const noexcept;
+            /**
+             * \brief Number of rotations composed since construction
+             */
+            inline std::size_t size() const noexcept{
+                return size_;
+            }
+
+        private:
+            /**
+             * \brief Scale the running product back to unit norm
+             */
+            void rescale() noexcept;
+
+            std::size_t size_{0};
+    };
+}
+
+#include <yadq/impl/mixed_precision.tpp>
+
+#endif
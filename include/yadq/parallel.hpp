@@ -0,0 +1,139 @@
+#ifndef YADQ_PARALLEL_HPP
+#define YADQ_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace yadq{
+
+    /**
+    * \struct parallel_config
+    * \brief Threading settings of the batch functions. The default runs on the calling thread only.
+    * Threads are started by each call and joined before it returns: starting one costs tens of microseconds, so a
+    * thread is only added for every grain elements, and inputs below 2 * grain elements never leave the calling
+    * thread.
+    */
+    struct parallel_config{
+        /**
+         * Maximum number of threads, the calling one included. 0 uses std::thread::hardware_concurrency()
+         */
+        unsigned threads = 1;
+        /**
+         * Minimum number of elements handled by each thread
+         */
+        std::size_t grain = 1 << 14;
+    };
+
+    namespace detail {
+
+        /**
+         * \brief Keep a parameter out of template argument deduction, so that implicit conversions apply to it
+         */
+        template<typename T>
+        struct non_deduced{
+            using type = T;
+        };
+
+        template<typename T>
+        using non_deduced_t = typename non_deduced<T>::type;
+
+        /**
+         * \brief Number of threads actually used to process n elements: 1 below 2 * grain elements, where starting
+         * a thread costs more than it saves
+         */
+        inline unsigned thread_count(std::size_t n, const parallel_config& config) noexcept{
+
+            unsigned threads = config.threads != 0 ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+            const std::size_t chunks = std::max<std::size_t>(1, n / std::max<std::size_t>(1, config.grain));
+
+            return static_cast<unsigned>(std::min<std::size_t>(threads, chunks));
+        }
+
+        /**
+        * \struct thread_joiner
+        * \brief Join every joinable thread of a vector on destruction, also when unwinding
+        */
+        struct thread_joiner{
+            std::vector<std::thread>& threads;
+
+            ~thread_joiner(){
+                for (auto& t : threads){
+                    if (t.joinable()){
+                        t.join();
+                    }
+                }
+            }
+        };
+
+        /**
+         * \brief Split [0, n) in `chunks` contiguous chunks and call f(chunk, begin, end) on each, one chunk per
+         * thread. The calling thread processes the first chunk. Boundaries only depend on n and chunks, so two
+         * calls with the same arguments see the same chunks.
+         * Every chunk runs even if another one throws: the first exception caught is rethrown once all threads are
+         * joined. A chunk whose thread cannot be started runs on the calling thread instead.
+         */
+        template<typename F>
+        void parallel_chunks(std::size_t n, unsigned chunks, F&& f){
+
+            if (chunks <= 1){
+                f(0u, std::size_t(0), n);
+                return;
+            }
+
+            const std::size_t chunk = (n + chunks - 1) / chunks;
+
+            std::exception_ptr error;
+            std::mutex error_mutex;
+
+            auto run = [&f, &error, &error_mutex](unsigned t, std::size_t begin, std::size_t end) noexcept{
+                try{
+                    f(t, begin, end);
+                }catch (...){
+                    const std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error){
+                        error = std::current_exception();
+                    }
+                }
+            };
+
+            std::vector<std::thread> workers;
+            workers.reserve(chunks - 1);
+
+            {
+                const thread_joiner joiner{workers};
+
+                for (unsigned t = 1; t < chunks; ++t){
+                    const std::size_t begin = std::min(n, t * chunk);
+                    const std::size_t end = std::min(n, begin + chunk);
+                    try{
+                        workers.emplace_back(run, t, begin, end);
+                    }catch (const std::system_error&){
+                        run(t, begin, end);
+                    }
+                }
+
+                run(0u, std::size_t(0), std::min(n, chunk));
+            }
+
+            if (error){
+                std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * \brief Split [0, n) in contiguous chunks and call f(begin, end) on each, one chunk per thread.
+         * The calling thread processes the first chunk.
+         */
+        template<typename F>
+        void parallel_for(std::size_t n, const parallel_config& config, F&& f){
+            parallel_chunks(n, thread_count(n, config), [&f](unsigned, std::size_t begin, std::size_t end){ f(begin, end); });
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef POINT_CLOUD_HPP
+#define POINT_CLOUD_HPP
+
+#include <array>
+#include <cstddef>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/simd.hpp>
+#include <yadq/parallel.hpp>
+
+namespace yadq{
+
+    /**
+    * \struct point_lanes
+    * \brief Structure-of-arrays view over a point cloud: three caller-owned arrays of coordinates. The arrays do
+    * not need any particular alignment.
+    */
+    template<typename _T>
+    struct point_lanes{
+        _T* x;
+        _T* y;
+        _T* z;
+
+        /**
+         * \brief Implicit conversion to a read-only view
+         */
+        operator point_lanes<const _T>() const noexcept{
+            return {x, y, z};
+        }
+    };
+
+    /**
+     * \brief Rotate n points stored interleaved as [x0, y0, z0, x1, y1, z1, ...]. points_out may be points_in.
+     * \param q_in unitary quaternion describing the rotation
+     * \param points_in 3 * n input coordinates
+     * \param points_out 3 * n output coordinates
+     * \param n number of points
+     * \param config threading settings
+     */
+    template<typename T, typename P>
+    void rotate(const quaternionU<T, P>& q_in, const detail::non_deduced_t<T>* points_in, detail::non_deduced_t<T>* points_out, std::size_t n, const parallel_config& config = {});
+
+    /**
+     * \brief Rotate n points stored as separate coordinate arrays. The output lanes may be the input ones.
+     * \param q_in unitary quaternion describing the rotation
+     * \param points_in input coordinates
+     * \param points_out output coordinates
+     * \param n number of points
+     * \param config threading settings
+     */
+    template<typename T, typename P>
+    void rotate(const quaternionU<T, P>& q_in, detail::non_deduced_t<point_lanes<const T>> points_in, detail::non_deduced_t<point_lanes<T>> points_out, std::size_t n, const parallel_config& config = {});
+
+    /**
+     * \brief Apply the rigid transformation p' = R p + t to n interleaved points. The translation is extracted
+     * once, so every point costs a rotation and an addition. points_out may be points_in.
+     * \param dq_in unit dual quaternion describing the transformation
+     * \param points_in 3 * n input coordinates
+     * \param points_out 3 * n output coordinates
+     * \param n number of points
+     * \param config threading settings
+     */
+    template<typename T>
+    void transform(const dualquaternion<T>& dq_in, const detail::non_deduced_t<T>* points_in, detail::non_deduced_t<T>* points_out, std::size_t n, const parallel_config& config = {});
+
+    /**
+     * \brief Apply the rigid transformation p' = R p + t to n points stored as separate coordinate arrays.
+     * The output lanes may be the input ones.
+     * \param dq_in unit dual quaternion describing the transformation
+     * \param points_in input coordinates
+     * \param points_out output coordinates
+     * \param n number of points
+     * \param config threading settings
+     */
+    template<typename T>
+    void transform(const dualquaternion<T>& dq_in, detail::non_deduced_t<point_lanes<const T>> points_in, detail::non_deduced_t<point_lanes<T>> points_out, std::size_t n, const parallel_config& config = {});
+}
+
+#include <yadq/impl/point_cloud.tpp>
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef PUBLICATION_HPP
+#define PUBLICATION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Lock-free publication ------------------------------
+
+        One writer thread publishes values (typically the latest pose, a dualquaternion) that any number of
+        reader threads read without locks. Both primitives are sequence locks: the writer never waits, readers
+        retry if the writer overwrote the value while they were copying it, so a reader never returns a torn
+        value. The payload is copied word by word through release stores and acquire loads, which keeps the
+        protocol free of data races in the C++ memory model without standalone fences, so ThreadSanitizer checks
+        it too. On x86 these compile to plain moves.
+
+        Values must be trivially copyable: quaternion, quaternionU and dualquaternion are.
+    */
+
+    namespace detail {
+
+        /**
+         * \brief Trivially copyable value stored as 64-bit atomic words. Words are stored with release and loaded
+         * with acquire: a reader that sees a word of a store also sees the sequence update made before it.
+         */
+        template<typename V>
+        class atomic_words{
+            static_assert(std::is_trivially_copyable_v<V>, "published values must be trivially copyable");
+            public:
+                static constexpr std::size_t words = (sizeof(V) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+                void store(const V& v) noexcept{
+                    std::uint64_t buffer[words] = {};
+                    std::memcpy(buffer, &v, sizeof(V));
+                    for (std::size_t i = 0; i < words; ++i){
+                        data_[i].store(buffer[i], std::memory_order_release);
+                    }
+                }
+
+                void load(V& v) const noexcept{
+                    std::uint64_t buffer[words];
+                    for (std::size_t i = 0; i < words; ++i){
+                        buffer[i] = data_[i].load(std::memory_order_acquire);
+                    }
+                    std::memcpy(&v, buffer, sizeof(V));
+                }
+
+            private:
+                std::atomic<std::uint64_t> data_[words] = {};
+        };
+
+        /**
+         * Size of a cache line, used to keep the writer's and the readers' data apart
+         */
+        constexpr std::size_t cache_line = 64;
+    }
+
+    /**
+    * \class seqlock
+    * \brief Latest value published by a single writer, read by any number of threads without locks. store() is
+    * wait-free; load() retries while a store is in progress, so it is lock-free and never returns a torn value.
+    */
+    template<typename V>
+    class alignas(detail::cache_line) seqlock{
+        public:
+            using value_type = V;
+
+            /**
+             * \brief Constructor
+             * \param v initial value, readable before the first store
+             */
+            explicit seqlock(const V& v = V()) noexcept{
+                data_.store(v);
+            }
+
+            seqlock(const seqlock&) = delete;
+            seqlock& operator=(const seqlock&) = delete;
+
+            /**
+             * \brief Publish a value. Only one thread may store.
+             */
+            void store(const V& v) noexcept;
+            /**
+             * \brief Latest published value
+             */
+            V load() const noexcept;
+            /**
+             * \brief Single read attempt, false if a store overlapped it (v is then unspecified)
+             */
+            bool try_load(V& v) const noexcept;
+            /**
+             * \brief Number of completed stores. Readers can compare versions to detect new values.
+             */
+            std::uint64_t version() const noexcept{
+                return seq_.load(std::memory_order_acquire) / 2;
+            }
+
+        private:
+            // Odd while a store is in progress
+            std::atomic<std::uint64_t> seq_{0};
+            detail::atomic_words<V> data_;
+    };
+
+    /**
+    * \struct stamped
+    * \brief Value with its timestamp
+    */
+    template<typename V>
+    struct stamped{
+        double time;
+        V value;
+    };
+
+    /**
+    * \class pose_history
+    * \brief Ring of the last capacity() values published by a single writer at increasing timestamps, read by any
+    * number of threads without locks. Each slot is a sequence lock; a reader that finds a slot overwritten by
+    * the writer treats it as too old.
+    *
+    * at(time) interpolates between the two values around time: SLERP for quaternionU, ScLERP for
+    * dualquaternion, and the value at or before time for the other types.
+    */
+    template<typename V>
+    class pose_history{
+        public:
+            using value_type = V;
+
+            /**
+             * \brief Constructor. Throws std::invalid_argument if capacity is 0.
+             * \param capacity number of values kept
+             */
+            explicit pose_history(std::size_t capacity);
+
+            pose_history(const pose_history&) = delete;
+            pose_history& operator=(const pose_history&) = delete;
+
+            /**
+             * \brief Publish a value, overwriting the oldest one when the ring is full. Only one thread may push.
+             * Throws std::invalid_argument if time is not greater than the previous one.
+             */
+            void push(double time, const V& v);
+            /**
+             * \brief Number of values kept
+             */
+            inline std::size_t capacity() const noexcept{
+                return capacity_;
+            }
+            /**
+             * \brief Number of values pushed since construction
+             */
+            inline std::uint64_t count() const noexcept{
+                return head_.load(std::memory_order_acquire);
+            }
+            /**
+             * \brief Latest value, none before the first push
+             */
+            std::optional<stamped<V>> latest() const noexcept;
+            /**
+             * \brief Value at time, interpolated between the kept values around it. None if time is after the
+             * latest value or before the oldest one still kept.
+             */
+            std::optional<V> at(double time) const noexcept;
+
+        private:
+            struct alignas(detail::cache_line) slot{
+                // 2 i + 2 once value i is written, odd while it is being written
+                std::atomic<std::uint64_t> seq{0};
+                detail::atomic_words<stamped<V>> data;
+            };
+
+            /**
+             * \brief Read value i, false if it is not written yet or was overwritten
+             */
+            bool read(std::uint64_t i, stamped<V>& out) const noexcept;
+
+            std::size_t capacity_;
+            std::unique_ptr<slot[]> slots_;
+            // Only used by the writer
+            double last_time_{0};
+            alignas(detail::cache_line) std::atomic<std::uint64_t> head_{0};
+    };
+}
+
+#include <yadq/impl/publication.tpp>
+
+#endif
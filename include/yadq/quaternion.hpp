@@ -11,6 +11,7 @@
                                  QUATERNION_VERSION_MINOR * 100 + \
                                  QUATERNION_VERSION_PATCH)
 
+#include <algorithm>
 #include <utility>
 #include <type_traits>
 #include <iostream>
@@ -18,11 +19,139 @@
 #include <optional>
 #include <array>
 #include <yadq/yadq_type_traits.hpp>
+#include <yadq/constexpr_math.hpp>
+#include <yadq/instrumentation_hooks.hpp>
+
+#if defined(YADQ_INSTRUMENTATION)
+    #include <yadq/instrumentation.hpp>
+#endif
 
 namespace yadq{
 
     enum class InterpType {SLERP, LERP};
 
+    /**
+    * \brief quaternionU policy: normalise after every operation (default)
+    */
+    struct normalise_eager {};
+
+    /**
+    * \brief quaternionU policy: operations only mark the quaternion as dirty, the norm is restored when a value is
+    * observed (w(), x(), y(), z(), get(), norm()). Intermediate products carry the magnitude of their operands.
+    * Observers are const and never write: the inverse norm of a dirty quaternion is recomputed by every
+    * observation, so several threads may read the same object. Call normalise() to pay it once before many reads.
+    */
+    struct normalise_lazy {};
+
+    /**
+    * \brief quaternionU policy: exact normalisation on construction and sums, products renormalise every N
+    * compositions with the first-order correction q *= (3 - |q|^2) / 2
+    */
+    template<std::size_t N>
+    struct normalise_periodic {
+        static_assert(N > 0, "The renormalisation period must be positive");
+        static constexpr std::size_t period = N;
+    };
+
+    /**
+    * \brief How a quaternion already close to unit norm is brought back to it. With s = |q|^2 = 1 + e, q is
+    * scaled by an approximation of 1 / sqrt(s) that only uses the storage type:
+    * - exact: the division by sqrt(s) of quaternion::normalise (norm accumulated in double).
+    * - newton: one Newton-Raphson step for 1 / sqrt(s) from the first-order estimate (3 - s) / 2. Multiplications
+    *   only; the norm is off by 27 e^4 / 128, plus rounding.
+    * - pade: the [1/1] Pade approximant of 1 / sqrt(s) around 1, (3 + s) / (1 + 3 s). One division; the norm is off
+    *   by e^3 / 32, plus rounding.
+    * After a product of unit quaternions e is a few ULP, and both approximations are exact up to rounding: a few
+    * ULP of the storage type. At |e| = 1e-3 the truncation reaches 2e-13 (newton) and 3e-11 (pade); at |e| = 0.1,
+    * 2e-5 and 3e-5. Far from unit norm only exact is meaningful.
+    */
+    enum class norm_strategy {exact, newton, pade};
+
+    /**
+    * \brief quaternionU policy: products renormalise with the strategy S, construction and sums exactly. Meant for
+    * long chains of products, where the operands are always close to unit norm.
+    */
+    template<norm_strategy S = norm_strategy::newton>
+    struct normalise_fast {
+        static constexpr norm_strategy strategy = S;
+    };
+
+    template<typename>
+    struct is_normalise_fast : std::false_type {};
+
+    template<norm_strategy S>
+    struct is_normalise_fast<normalise_fast<S>> : std::true_type {};
+
+    template<typename P>
+    constexpr bool is_normalise_fast_v = is_normalise_fast<P>::value;
+
+    template<typename>
+    struct is_normalise_periodic : std::false_type {};
+
+    template<std::size_t N>
+    struct is_normalise_periodic<normalise_periodic<N>> : std::true_type {};
+
+    template<typename P>
+    constexpr bool is_normalise_periodic_v = is_normalise_periodic<P>::value;
+
+    /**
+    * \brief Tag of the quaternionU constructor taking components already of unit norm, which are stored as given.
+    * Meant for results that are unit by construction (e.g. slerp weights), to skip the square root and divisions.
+    */
+    struct unit_norm_t {
+        explicit unit_norm_t() = default;
+    };
+
+    inline constexpr unit_norm_t unit_norm{};
+
+    namespace detail {
+
+        /**
+         * \brief Per-policy bookkeeping stored alongside the components of a quaternionU
+         */
+        template<typename _T, typename _Policy>
+        struct normalisation_state {};
+
+        template<typename _T>
+        struct normalisation_state<_T, normalise_lazy> {
+            // Inverse norm of the stored components, 0 while dirty. Only non-const members write it.
+            _T scale_{1};
+        };
+
+        template<typename _T, std::size_t N>
+        struct normalisation_state<_T, normalise_periodic<N>> {
+            std::size_t compositions_{0};
+        };
+
+        /**
+         * \brief Approximation of 1 / sqrt(s) for s close to 1, see norm_strategy
+         * \param s squared norm
+         */
+        template<norm_strategy S, typename _T>
+        constexpr _T inverse_norm(_T s) noexcept{
+            static_assert(S != norm_strategy::exact, "the exact strategy divides by the norm instead");
+
+            if constexpr (S == norm_strategy::newton){
+                const _T y = _T(1.5) - _T(0.5) * s;
+                return y * (_T(1.5) - _T(0.5) * s * y * y);
+            }else{
+                return (_T(3) + s) / (_T(1) + _T(3) * s);
+            }
+        }
+
+        /**
+         * \brief Hamilton product on raw [w, x, y, z] components
+         */
+        template<typename _T>
+        constexpr std::array<_T, 4> hamilton(const std::array<_T, 4>& l, const std::array<_T, 4>& r) noexcept{
+            YADQ_COUNT(hamilton_products);
+            return {    l[0] * r[0] - l[1] * r[1] - l[2] * r[2] - l[3] * r[3],
+                        l[0] * r[1] + l[1] * r[0] + l[2] * r[3] - l[3] * r[2],
+                        l[0] * r[2] - l[1] * r[3] + l[2] * r[0] + l[3] * r[1],
+                        l[0] * r[3] + l[1] * r[2] - l[2] * r[1] + l[3] * r[0]};
+        }
+    }
+
     /**
     * \class quaternion
     * \brief A class describing general quaternions and providing operations between quaternions objects.
@@ -34,11 +163,11 @@ namespace yadq{
             using qT = quaternion<_T>;    
 
         protected:
+            /**
+             * Components stored contiguously as [w, x, y, z]. This is the only data member so the class stays
+             * standard-layout and trivially copyable, with sizeof(quaternion<T>) == 4 * sizeof(T).
+             */
             std::array<_T, 4> data_;
-            _T& w_{data_[0]};
-            _T& x_{data_[1]};
-            _T& y_{data_[2]};
-            _T& z_{data_[3]};  
         public:
             
             using value_type = _T;
@@ -46,7 +175,9 @@ namespace yadq{
             /**
              * \brief Empty constructor
              */
-            quaternion(): data_{1, 0, 0, 0} {}
+            constexpr quaternion(): data_{1, 0, 0, 0} {
+                YADQ_COUNT(constructions);
+            }
             /**
              * \brief Constructor with single parameters
              * \param x X component of the quaternion
@@ -54,30 +185,38 @@ namespace yadq{
              * \param z Z component of the quaternion
              * \param w W component of the quaternion
              */
-            quaternion(_T w, _T x, _T y, _T z): data_{w, x, y, z} {}
+            constexpr quaternion(_T w, _T x, _T y, _T z): data_{w, x, y, z} {
+                YADQ_COUNT(constructions);
+            }
             /**
              * \brief Copy constructor
              * \param q_in object to copy
              */
-            quaternion(const qT& q_in): data_(q_in.data_) {}
+            constexpr quaternion(const qT& q_in) = default;
+            /**
+             * \brief Conversion from a quaternion of the other value_type, rounded to nearest when narrowing
+             * \param q_in quaternion to convert; the observed components of a quaternionU are used
+             */
+            template<   typename Q,
+                        typename = std::enable_if_t<is_base_of_quaternion_v<Q> && !std::is_same_v<typename Q::value_type, _T>>>
+            explicit constexpr quaternion(const Q& q_in): data_{static_cast<_T>(q_in.w()), static_cast<_T>(q_in.x()), static_cast<_T>(q_in.y()), static_cast<_T>(q_in.z())} {
+                YADQ_COUNT(constructions);
+            }
             /**
              * \brief Assignment operator
              * \param q_in object to copy
              */
-            constexpr qT& operator=(const qT& q_in){
-                data_ = q_in.data_;
-                return (*this);
-            } 
+            constexpr qT& operator=(const qT& q_in) = default;
             /**
              * \brief Sum and assign to quaternions
              * \param q_in object to add
              */
             constexpr qT& operator+=(const qT& q_in) noexcept{
     
-                w_ += q_in.w_;
-                x_ += q_in.x_;
-                y_ += q_in.y_;
-                z_ += q_in.z_;
+                data_[0] += q_in.data_[0];
+                data_[1] += q_in.data_[1];
+                data_[2] += q_in.data_[2];
+                data_[3] += q_in.data_[3];
 
                 return (*this);
             }
@@ -86,10 +225,10 @@ namespace yadq{
              * \param rhv value to divide by
              */
             constexpr qT& operator/=(const _T rhv) {
-                w_ /= rhv;
-                x_ /= rhv;
-                y_ /= rhv;
-                z_ /= rhv;
+                data_[0] /= rhv;
+                data_[1] /= rhv;
+                data_[2] /= rhv;
+                data_[3] /= rhv;
 
                 return (*this);
             }
@@ -108,20 +247,20 @@ namespace yadq{
              * \param value value to multiply
              */
             constexpr qT operator*(double value) const noexcept{
-                return qT(  w_ * value, 
-                            x_ * value, 
-                            y_ * value, 
-                            z_ * value);
+                return qT(  data_[0] * value, 
+                            data_[1] * value, 
+                            data_[2] * value, 
+                            data_[3] * value);
             }
             /**
              * \brief Add a scalar to the quaternion
              * \param value value to add
              */
             constexpr qT operator+(double value) const noexcept{
-                return qT(  w_ + value, 
-                            x_ + value, 
-                            y_ + value, 
-                            z_ + value);
+                return qT(  data_[0] + value, 
+                            data_[1] + value, 
+                            data_[2] + value, 
+                            data_[3] + value);
             }
             /**
              * \brief Subtract a scalar to the quaternion-
@@ -129,51 +268,53 @@ namespace yadq{
              */
             constexpr qT operator-(double value) const noexcept{
 
-                return qT(  w_ - value,
-                            x_ - value,
-                            y_ - value,
-                            z_ - value);
+                return qT(  data_[0] - value,
+                            data_[1] - value,
+                            data_[2] - value,
+                            data_[3] - value);
             }
             /**
              * \brief Check if the quaternion is empty
              */
             constexpr bool empty() const{
-                return (w_ == 0 && x_ == 0 && y_ == 0 && z_ == 0);
+                return (data_[0] == 0 && data_[1] == 0 && data_[2] == 0 && data_[3] == 0);
             }
             /**
              * \brief Compute the norm of the quaternion
              */
             constexpr inline auto norm() const noexcept{
-                return std::sqrt(std::pow(w_, 2) + std::pow(x_, 2) + std::pow(y_, 2) + std::pow(z_, 2));
+                // Accumulated in double as std::pow(x, 2) did, so float quaternions keep the same rounding
+                const double w = data_[0], x = data_[1], y = data_[2], z = data_[3];
+                return math::sqrt(w * w + x * x + y * y + z * z);
             }
             /**
              * \brief Return w component of the quaternion
              */
-            inline auto w() const noexcept{
-                return w_;
+            constexpr inline auto w() const noexcept{
+                return data_[0];
             }
             /**
              * \brief Return x component of the quaternion
              */
-            inline auto x() const noexcept{
-                return x_;
+            constexpr inline auto x() const noexcept{
+                return data_[1];
             }
             /**
              * \brief Return y component of the quaternion
              */
-            inline auto y() const noexcept{
-                return y_;
+            constexpr inline auto y() const noexcept{
+                return data_[2];
             }
             /**
              * \brief Return z component of the quaternion
              */
-            inline auto z() const noexcept{
-                return z_;
+            constexpr inline auto z() const noexcept{
+                return data_[3];
             }
             /**
              * \brief Get the raw data
              */
-            inline auto& get() const noexcept{
+            constexpr inline auto& get() const noexcept{
                 return data_;
             }
             /**
@@ -181,11 +322,13 @@ namespace yadq{
              */
             constexpr inline void normalise() {
 
+                YADQ_COUNT(normalisations);
+
                 if(auto d = norm(); d != 0.0) {
-                    w_ /= d;
-                    x_ /= d;
-                    y_ /= d;
-                    z_ /= d;
+                    data_[0] /= d;
+                    data_[1] /= d;
+                    data_[2] /= d;
+                    data_[3] /= d;
                 }
             }
             /**
@@ -193,9 +336,9 @@ namespace yadq{
              */
             constexpr inline void conjugate() {
 
-                x_ *= -1;
-                y_ *= -1;
-                z_ *= -1;
+                data_[1] *= -1;
+                data_[2] *= -1;
+                data_[3] *= -1;
 
             }
 
@@ -203,27 +346,33 @@ namespace yadq{
 
     /**
     * \class quaternionU
-    * \brief A class representing unitary quaternions. The normalisation is done internally at every operations.
+    * \brief A class representing unitary quaternions. When the unit norm is restored is decided by the normalisation
+    * policy (see normalise_eager, normalise_lazy and normalise_periodic); by default it is done at every operation.
+    * Copies never renormalise: the policy keeps the invariant on the operations that can break it.
     */
-    template<typename _T>
-    class quaternionU : public quaternion<_T>{
+    template<typename _T, typename _Policy>
+    class quaternionU : public quaternion<_T>, private detail::normalisation_state<_T, _Policy>{
+        private:
+            using qUT = quaternionU<_T, _Policy>;
+
+            static constexpr bool is_lazy = std::is_same_v<_Policy, normalise_lazy>;
+            static constexpr bool is_periodic = is_normalise_periodic_v<_Policy>;
+            static constexpr bool is_fast = is_normalise_fast_v<_Policy>;
+
         public:
-            /**
-            * Exposing quaternion<T> functions
-            */
-            using quaternion<_T>::operator*;
-            using quaternion<_T>::operator+;
-            using quaternion<_T>::operator-;
+
+            using policy_type = _Policy;
 
             /**
              * \brief Empty constructor
              */
-            quaternionU(): quaternion<_T>(){}
+            constexpr quaternionU(): quaternion<_T>(){}
             /**
              * \brief Copy constructor from a quaternion object
              */
-            quaternionU(const quaternion<_T>& q_in): quaternion<_T>(q_in){
-                this->normalise();
+            constexpr quaternionU(const quaternion<_T>& q_in): quaternion<_T>(q_in){
+                YADQ_COUNT(conversions);
+                restore_unit_norm();
             }
             /**
              * \brief Constructor with single parameters
@@ -232,50 +381,281 @@ namespace yadq{
              * \param z Z component of the quaternion
              * \param w W component of the quaternion
              */
-            quaternionU(_T w, _T x, _T y, _T z): quaternion<_T>(w, x, y, z) {
-                quaternion<_T>::normalise();
+            constexpr quaternionU(_T w, _T x, _T y, _T z): quaternion<_T>(w, x, y, z) {
+                restore_unit_norm();
             }
+            /**
+             * \brief Constructor from components of unit norm up to rounding, stored without renormalisation
+             * \param w W component of the quaternion
+             * \param x X component of the quaternion
+             * \param y Y component of the quaternion
+             * \param z Z component of the quaternion
+             */
+            constexpr quaternionU(unit_norm_t, _T w, _T x, _T y, _T z) noexcept: quaternion<_T>(w, x, y, z) {}
             /**
              * \brief Constructor by axis/angle
              * \param axis three coordinates of the axis
              * \param angle rotation angle around the axis
              */
-            quaternionU(const std::array<_T, 3>& axis, _T angle) {
+            constexpr quaternionU(const std::array<_T, 3>& axis, _T angle) {
                 
-                this->w_ = std::cos(angle / 2.0);
+                const double half_angle = angle / 2.0;
+                const double ax = axis[0], ay = axis[1], az = axis[2];
+
+                YADQ_COUNT_N(trig_calls, 4);
 
-                auto axis_norm = std::sqrt(std::pow(axis[0], 2) + std::pow(axis[1], 2) + std::pow(axis[2], 2));
-                this->x_ = axis[0] * std::sin(angle / 2.0) / axis_norm;
-                this->y_ = axis[1] * std::sin(angle / 2.0) / axis_norm;
-                this->z_ = axis[2] * std::sin(angle / 2.0) / axis_norm;
+                this->data_[0] = math::cos(half_angle);
 
-                this->normalise();
+                const double axis_norm = math::sqrt(ax * ax + ay * ay + az * az);
+                this->data_[1] = ax * math::sin(half_angle) / axis_norm;
+                this->data_[2] = ay * math::sin(half_angle) / axis_norm;
+                this->data_[3] = az * math::sin(half_angle) / axis_norm;
+
+                restore_unit_norm();
             }
             /**
-             * \brief Copy contructor by unitary quaternions
+             * \brief Copy contructor by unitary quaternions. The source already satisfies the policy invariant.
              * \param q_in unitary quaternion to copy
              */
-            quaternionU(const quaternionU<_T>& q_in): quaternion<_T>(q_in) {
-                this->normalise();
+            constexpr quaternionU(const qUT& q_in) = default;
+            /**
+             * \brief Conversion from a quaternion of the other value_type. The result is renormalised, since
+             * rounding to float moves the norm away from one by up to an ULP.
+             * \param q_in quaternion to convert
+             */
+            template<   typename Q,
+                        typename = std::enable_if_t<is_base_of_quaternion_v<Q> && !std::is_same_v<typename Q::value_type, _T>>>
+            explicit constexpr quaternionU(const Q& q_in): quaternion<_T>(q_in){
+                restore_unit_norm();
             }
             /**
              * \brief Default assignment operator
              * \param q_in unitary quaternion to copy
              */
-            constexpr quaternionU<_T>& operator=(const quaternionU<_T>& q_in) = default;
+            constexpr qUT& operator=(const qUT& q_in) = default;
            /**
              * \brief Sum and assign to unitary quaternions
              * \param q_in object to add
              */
-            constexpr quaternionU<_T>& operator+=(const quaternionU<_T>& q_in){
-                    
-                *this = static_cast<quaternion<_T>>(*this) + q_in;
+            constexpr qUT& operator+=(const qUT& q_in){
+
+                this->data_ = {w() + q_in.w(), x() + q_in.x(), y() + q_in.y(), z() + q_in.z()};
+
+                restore_unit_norm();
+                return (*this);
+            }
+            /**
+             * \brief Compose with another unitary quaternion (Hamilton product)
+             * \param q_in unitary quaternion to multiply
+             */
+            constexpr qUT& operator*=(const qUT& q_in) noexcept{
+
+                this->data_ = detail::hamilton(this->data_, q_in.data_);
+
+                if constexpr (is_lazy){
+                    this->scale_ = 0;
+                }else if constexpr (is_periodic){
+                    if (++this->compositions_ >= _Policy::period){
+                        first_order_correction();
+                    }
+                }else if constexpr (is_fast){
+                    fast_renormalise();
+                }else{
+                    quaternion<_T>::normalise();
+                }
+
+                return (*this);
+            }
+            /**
+             * \brief Divide the quaternion by a scalar
+             * \param rhv value to divide by
+             */
+            constexpr qUT& operator/=(const _T rhv) {
+                quaternion<_T>::operator/=(rhv);
 
-                quaternion<_T>::normalise();
+                restore_unit_norm();
                 return (*this);
             }
+            /**
+             * \brief Multiply a scalar to the quaternion
+             * \param value value to multiply
+             */
+            constexpr quaternion<_T> operator*(double value) const noexcept{
+                return quaternion<_T>(w() * value, x() * value, y() * value, z() * value);
+            }
+            /**
+             * \brief Add a scalar to the quaternion
+             * \param value value to add
+             */
+            constexpr quaternion<_T> operator+(double value) const noexcept{
+                return quaternion<_T>(w() + value, x() + value, y() + value, z() + value);
+            }
+            /**
+             * \brief Subtract a scalar to the quaternion
+             * \param value value to subtract
+             */
+            constexpr quaternion<_T> operator-(double value) const noexcept{
+                return quaternion<_T>(w() - value, x() - value, y() - value, z() - value);
+            }
+            /**
+             * \brief Compute the norm of the observed quaternion
+             */
+            constexpr inline auto norm() const noexcept{
+                if constexpr (is_lazy){
+                    return quaternion<_T>::norm() * scale();
+                }else{
+                    return quaternion<_T>::norm();
+                }
+            }
+            /**
+             * \brief Return w component of the quaternion
+             */
+            constexpr inline auto w() const noexcept{
+                return component(0);
+            }
+            /**
+             * \brief Return x component of the quaternion
+             */
+            constexpr inline auto x() const noexcept{
+                return component(1);
+            }
+            /**
+             * \brief Return y component of the quaternion
+             */
+            constexpr inline auto y() const noexcept{
+                return component(2);
+            }
+            /**
+             * \brief Return z component of the quaternion
+             */
+            constexpr inline auto z() const noexcept{
+                return component(3);
+            }
+            /**
+             * \brief Get the raw data. With the lazy policy a normalised copy is returned instead of a reference.
+             */
+            constexpr inline decltype(auto) get() const noexcept{
+                if constexpr (is_lazy){
+                    return std::array<_T, 4>{w(), x(), y(), z()};
+                }else{
+                    return quaternion<_T>::get();
+                }
+            }
+            /**
+             * \brief Normalise the quaternion exactly, whatever the policy
+             */
+            constexpr inline void normalise() {
+                if constexpr (is_lazy){
+                    const _T k = scale();
+                    this->data_ = {this->data_[0] * k, this->data_[1] * k, this->data_[2] * k, this->data_[3] * k};
+                    this->scale_ = 1;
+                }else{
+                    quaternion<_T>::normalise();
+                    if constexpr (is_periodic){
+                        this->compositions_ = 0;
+                    }
+                }
+            }
+            /**
+             * \brief Number of compositions since the last renormalisation (periodic policy only)
+             */
+            constexpr std::size_t compositions() const noexcept{
+                static_assert(is_periodic, "compositions() is only available with the periodic policy");
+                return this->compositions_;
+            }
+
+        private:
+            /**
+             * \brief Restore the unit norm after an arbitrary update of the components
+             */
+            constexpr inline void restore_unit_norm() {
+                if constexpr (is_lazy){
+                    this->scale_ = 0;
+                }else{
+                    normalise();
+                }
+            }
+            /**
+             * \brief Cheap renormalisation for quaternions close to unit norm: q *= (3 - |q|^2) / 2
+             */
+            constexpr inline void first_order_correction() noexcept{
+                auto& d = this->data_;
+                const _T k = (_T(3) - (d[0] * d[0] + d[1] * d[1] + d[2] * d[2] + d[3] * d[3])) / _T(2);
+
+                YADQ_COUNT(normalisations);
+
+                d[0] *= k;
+                d[1] *= k;
+                d[2] *= k;
+                d[3] *= k;
+
+                this->compositions_ = 0;
+            }
+            /**
+             * \brief Renormalisation of a product with the strategy of the policy (fast policy only)
+             */
+            constexpr inline void fast_renormalise() noexcept{
+                if constexpr (_Policy::strategy == norm_strategy::exact){
+                    quaternion<_T>::normalise();
+                }else{
+                    auto& d = this->data_;
+                    const _T k = detail::inverse_norm<_Policy::strategy>(d[0] * d[0] + d[1] * d[1] + d[2] * d[2] + d[3] * d[3]);
+
+                    YADQ_COUNT(normalisations);
+
+                    d[0] *= k;
+                    d[1] *= k;
+                    d[2] *= k;
+                    d[3] *= k;
+                }
+            }
+            /**
+             * \brief Inverse norm of the stored components (lazy policy only), computed without caching while dirty
+             */
+            constexpr inline _T scale() const noexcept{
+                if (this->scale_ == 0){
+                    YADQ_COUNT(normalisations);
+                    const auto d = quaternion<_T>::norm();
+                    return (d != 0.0) ? _T(1) / d : _T(1);
+                }
+                return this->scale_;
+            }
+            /**
+             * \brief Observed value of the i-th component
+             */
+            constexpr inline _T component(std::size_t i) const noexcept{
+                if constexpr (is_lazy){
+                    return this->data_[i] * scale();
+                }else{
+                    return this->data_[i];
+                }
+            }
     };
 
+    /*
+        ------------------------------ Storage layout guarantees ------------------------------
+    */
+
+    static_assert(sizeof(quaternion<float>) == 4 * sizeof(float), "quaternion<float> must not carry storage beyond its four components");
+    static_assert(sizeof(quaternion<double>) == 4 * sizeof(double), "quaternion<double> must not carry storage beyond its four components");
+    static_assert(sizeof(quaternionU<float>) == 4 * sizeof(float), "quaternionU<float> must not carry storage beyond its four components");
+    static_assert(sizeof(quaternionU<double>) == 4 * sizeof(double), "quaternionU<double> must not carry storage beyond its four components");
+
+    static_assert(std::is_standard_layout_v<quaternion<float>> && std::is_standard_layout_v<quaternion<double>>, "quaternion must be standard-layout");
+    static_assert(std::is_standard_layout_v<quaternionU<float>> && std::is_standard_layout_v<quaternionU<double>>, "quaternionU must be standard-layout");
+
+    static_assert(std::is_trivially_copyable_v<quaternion<float>> && std::is_trivially_copyable_v<quaternion<double>>, "quaternion must be trivially copyable");
+    static_assert(std::is_trivially_copyable_v<quaternionU<float>> && std::is_trivially_copyable_v<quaternionU<double>>, "quaternionU must be trivially copyable");
+
+    // The lazy and periodic policies store their bookkeeping next to the components: they remain trivially
+    // copyable, but are larger than four components, are not standard-layout and must not be reinterpreted as
+    // arrays of T.
+    static_assert(sizeof(quaternionU<float, normalise_lazy>) == 5 * sizeof(float), "the lazy policy adds the inverse norm to the components");
+    static_assert(sizeof(quaternionU<double, normalise_lazy>) == 5 * sizeof(double), "the lazy policy adds the inverse norm to the components");
+    static_assert(sizeof(quaternionU<double, normalise_periodic<8>>) == 4 * sizeof(double) + sizeof(std::size_t), "the periodic policy adds a composition counter to the components");
+    static_assert(std::is_trivially_copyable_v<quaternionU<float, normalise_lazy>> && std::is_trivially_copyable_v<quaternionU<double, normalise_lazy>>, "quaternionU<T, normalise_lazy> must be trivially copyable");
+    static_assert(std::is_trivially_copyable_v<quaternionU<float, normalise_periodic<8>>> && std::is_trivially_copyable_v<quaternionU<double, normalise_periodic<8>>>, "quaternionU<T, normalise_periodic> must be trivially copyable");
+
 }
 
 #include <yadq/impl/quaternion.tpp>
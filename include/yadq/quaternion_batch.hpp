@@ -0,0 +1,164 @@
+#ifndef QUATERNION_BATCH_HPP
+#define QUATERNION_BATCH_HPP
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <yadq/quaternion.hpp>
+#include <yadq/simd.hpp>
+
+namespace yadq{
+
+    /**
+    * \struct quaternion_lanes
+    * \brief Raw view over the four SoA lanes of a batch, as consumed by the SIMD kernels
+    */
+    template<typename _T>
+    struct quaternion_lanes{
+        _T* w;
+        _T* x;
+        _T* y;
+        _T* z;
+    };
+
+    /**
+    * \class quaternion_batch
+    * \brief Structure-of-arrays container of quaternions. Each component lives in its own lane, aligned to
+    * simd::alignment and padded to a whole SIMD block; padding slots always hold the identity so kernels can
+    * run over the padded length without a remainder loop.
+    */
+    template<typename _T>
+    class quaternion_batch{
+        static_assert(std::is_same_v<_T, float> || std::is_same_v<_T, double>, "This class only supports floating point types");
+        private:
+            using lane_type = std::vector<_T, aligned_allocator<_T, simd::alignment>>;
+
+            std::size_t size_{0};
+            std::array<lane_type, 4> lanes_;
+
+        public:
+
+            using value_type = _T;
+
+            /**
+             * \brief Empty constructor
+             */
+            quaternion_batch() = default;
+            /**
+             * \brief Constructor of n identity quaternions
+             * \param n number of quaternions
+             */
+            explicit quaternion_batch(std::size_t n){
+                resize(n);
+            }
+            /**
+             * \brief Constructor from a range of quaternion or quaternionU objects
+             * \param first iterator to the first quaternion
+             * \param last iterator past the last quaternion
+             */
+            template<   typename It,
+                        typename = std::enable_if_t<is_base_of_quaternion_v<typename std::iterator_traits<It>::value_type>>>
+            quaternion_batch(It first, It last){
+                resize(static_cast<std::size_t>(std::distance(first, last)));
+
+                for (std::size_t i = 0; first != last; ++first, ++i){
+                    set(i, *first);
+                }
+            }
+            /**
+             * \brief Number of quaternions stored
+             */
+            inline std::size_t size() const noexcept{
+                return size_;
+            }
+            /**
+             * \brief Length of every lane, including the identity padding
+             */
+            inline std::size_t padded_size() const noexcept{
+                return lanes_[0].size();
+            }
+            /**
+             * \brief Check if the batch is empty
+             */
+            inline bool empty() const noexcept{
+                return size_ == 0;
+            }
+            /**
+             * \brief Resize the batch, new quaternions are set to the identity
+             * \param n number of quaternions
+             */
+            void resize(std::size_t n){
+                const std::size_t n_padded = simd::padded_size<_T>(n);
+
+                for (std::size_t c = 0; c < 4; ++c){
+                    lanes_[c].resize(n_padded, c == 0 ? _T(1) : _T(0));
+
+                    // Slots that fall back into the padding must hold the identity again
+                    for (std::size_t i = n; i < std::min(size_, n_padded); ++i){
+                        lanes_[c][i] = (c == 0 ? _T(1) : _T(0));
+                    }
+                }
+
+                size_ = n;
+            }
+            /**
+             * \brief Pointers to the w lane
+             */
+            inline _T* w() noexcept{ return lanes_[0].data(); }
+            inline const _T* w() const noexcept{ return lanes_[0].data(); }
+            /**
+             * \brief Pointers to the x lane
+             */
+            inline _T* x() noexcept{ return lanes_[1].data(); }
+            inline const _T* x() const noexcept{ return lanes_[1].data(); }
+            /**
+             * \brief Pointers to the y lane
+             */
+            inline _T* y() noexcept{ return lanes_[2].data(); }
+            inline const _T* y() const noexcept{ return lanes_[2].data(); }
+            /**
+             * \brief Pointers to the z lane
+             */
+            inline _T* z() noexcept{ return lanes_[3].data(); }
+            inline const _T* z() const noexcept{ return lanes_[3].data(); }
+            /**
+             * \brief View over the four lanes
+             */
+            inline quaternion_lanes<_T> lanes() noexcept{
+                return {w(), x(), y(), z()};
+            }
+            inline quaternion_lanes<const _T> lanes() const noexcept{
+                return {w(), x(), y(), z()};
+            }
+            /**
+             * \brief Gather the i-th quaternion
+             * \param i index of the quaternion
+             */
+            inline quaternion<_T> get(std::size_t i) const noexcept{
+                return quaternion<_T>(lanes_[0][i], lanes_[1][i], lanes_[2][i], lanes_[3][i]);
+            }
+            /**
+             * \brief Scatter a quaternion into the i-th slot
+             * \param i index of the quaternion
+             * \param q_in quaternion or quaternionU to store
+             */
+            template<   typename Q,
+                        typename = std::enable_if_t<is_base_of_quaternion_v<Q>>>
+            inline void set(std::size_t i, const Q& q_in) noexcept{
+                lanes_[0][i] = q_in.w();
+                lanes_[1][i] = q_in.x();
+                lanes_[2][i] = q_in.y();
+                lanes_[3][i] = q_in.z();
+            }
+    };
+
+    using quaternion_batchf = quaternion_batch<float>;
+    using quaternion_batchd = quaternion_batch<double>;
+}
+
+#include <yadq/impl/quaternion_batch.tpp>
+
+#endif
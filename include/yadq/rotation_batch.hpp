@@ -0,0 +1,90 @@
+#ifndef ROTATION_BATCH_HPP
+#define ROTATION_BATCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/simd.hpp>
+
+namespace yadq{
+
+    /**
+    * \brief Storage order of the matrices in a buffer
+    */
+    enum class matrix_order {row_major, column_major};
+
+    /**
+    * \brief Shape of the matrices in a buffer. mat3x4 and mat4x4 are homogeneous transforms: only the rotation
+    * block (and the bottom row of mat4x4) is written, the translation column is left untouched so pose buffers
+    * keep their translations.
+    */
+    enum class matrix_shape {mat3x3, mat3x4, mat4x4};
+
+    /**
+    * \struct matrix_layout
+    * \brief Offsets of the entries written inside one matrix. rotation lists the 3x3 block in row-major order of
+    * the entries; bottom_row is only used by mat4x4.
+    */
+    struct matrix_layout{
+        std::array<std::size_t, 9> rotation;
+        std::array<std::size_t, 4> bottom_row;
+        std::size_t stride;
+        bool homogeneous_row;
+
+        /**
+         * \brief Layout of a given shape and storage order
+         */
+        static constexpr matrix_layout make(matrix_shape shape, matrix_order order) noexcept{
+
+            const std::size_t rows = shape == matrix_shape::mat4x4 ? 4 : 3;
+            const std::size_t cols = shape == matrix_shape::mat3x3 ? 3 : 4;
+
+            matrix_layout layout{{}, {}, rows * cols, shape == matrix_shape::mat4x4};
+
+            for (std::size_t r = 0; r < 3; ++r){
+                for (std::size_t c = 0; c < 3; ++c){
+                    layout.rotation[3 * r + c] = offset(r, c, rows, cols, order);
+                }
+            }
+
+            for (std::size_t c = 0; c < 4; ++c){
+                layout.bottom_row[c] = offset(3, c, rows, cols, order);
+            }
+
+            return layout;
+        }
+
+        /**
+         * \brief Offset of entry (r, c)
+         */
+        static constexpr std::size_t offset(std::size_t r, std::size_t c, std::size_t rows, std::size_t cols, matrix_order order) noexcept{
+            return order == matrix_order::row_major ? r * cols + c : c * rows + r;
+        }
+    };
+
+    /**
+     * \brief Rotation matrices of a batch of unitary quaternions, written to a caller-provided buffer
+     * \param q_in unitary quaternions
+     * \param matrices q_in.size() matrices of the given shape, contiguous
+     * \param shape shape of each matrix
+     * \param order storage order of each matrix
+     */
+    template<typename T>
+    void quatToRotation(const quaternion_batch<T>& q_in, T* matrices, matrix_shape shape = matrix_shape::mat3x3, matrix_order order = matrix_order::row_major) noexcept;
+
+    /**
+     * \brief Unitary quaternions of a buffer of rotation matrices (Shepperd's method, as rotationToQuat). q_out
+     * must already hold the number of matrices to convert: nothing is allocated.
+     * \param matrices q_out.size() matrices of the given shape, contiguous
+     * \param q_out output quaternions
+     * \param shape shape of each matrix
+     * \param order storage order of each matrix
+     */
+    template<typename T>
+    void rotationToQuat(const T* matrices, quaternion_batch<T>& q_out, matrix_shape shape = matrix_shape::mat3x3, matrix_order order = matrix_order::row_major) noexcept;
+}
+
+#include <yadq/impl/rotation_batch.tpp>
+
+#endif
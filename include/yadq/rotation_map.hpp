@@ -0,0 +1,37 @@
+#ifndef ROTATION_MAP_HPP
+#define ROTATION_MAP_HPP
+
+#include <array>
+#include <cmath>
+#include <yadq/quaternion.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Exponential and logarithm maps ------------------------------
+
+        Rotations as rotation vectors r = angle * axis, the tangent space of unitary quaternions:
+        exp_map(r) = (cos(|r| / 2), sin(|r| / 2) r / |r|) and log_map is its inverse. Unlike the generic exp() and
+        log() of quaternions, both work on the half angle directly and have no division by |r| near zero: up to a
+        rotation of pi / 2 the exponential is a Taylor series in |r|^2, accurate to the precision of T, which
+        needs neither a square root nor a division; larger rotations fall back to std::sin and std::cos.
+    */
+
+    /**
+     * \brief Unitary quaternion of a rotation vector
+     * \param r rotation vector, angle (radians) times unit axis
+     */
+    template<typename T>
+    quaternionU<T> exp_map(const std::array<T, 3>& r) noexcept;
+
+    /**
+     * \brief Rotation vector of a unitary quaternion, with an angle in [0, pi]: q and -q give the same vector
+     * \param q_in unitary quaternion
+     */
+    template<typename T, typename P>
+    std::array<T, 3> log_map(const quaternionU<T, P>& q_in) noexcept;
+}
+
+#include <yadq/impl/rotation_map.tpp>
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef SCAN_HPP
+#define SCAN_HPP
+
+#include <cstddef>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/parallel.hpp>
+
+namespace yadq{
+
+    /**
+    * \struct scan_config
+    * \brief Settings of the prefix products
+    */
+    struct scan_config{
+        /**
+         * Threading settings. Each thread scans one contiguous chunk.
+         */
+        parallel_config parallel{};
+        /**
+         * Call normalise() on the running product every renormalise_block elements and on every chunk carry,
+         * 0 leaves the norm to the element type (e.g. quaternionU<T, normalise_lazy> or the dual part of a
+         * dualquaternion, which are not renormalised by the product).
+         */
+        std::size_t renormalise_block = 0;
+    };
+
+    /**
+     * \brief Inclusive prefix products, q_out[i] = q_in[0] * q_in[1] * ... * q_in[i]. q_out may be q_in.
+     * The sequence is split in one chunk per thread: every chunk but the last is first reduced, the carries are
+     * chained on the calling thread and each chunk is then scanned from its carry, so 2n products are
+     * computed in total against n for a single thread.
+     * \param q_in n quaternionU or dualquaternion
+     * \param q_out n output values
+     * \param n number of values
+     * \param config threading and renormalisation settings
+     */
+    template<typename Q>
+    void inclusive_product_scan(const Q* q_in, Q* q_out, std::size_t n, const scan_config& config = {});
+
+    /**
+     * \brief Exclusive prefix products, q_out[0] = init and q_out[i] = init * q_in[0] * ... * q_in[i - 1].
+     * q_out may be q_in.
+     * \param q_in n quaternionU or dualquaternion
+     * \param q_out n output values
+     * \param n number of values
+     * \param init leftmost factor, the identity by default
+     * \param config threading and renormalisation settings
+     */
+    template<typename Q>
+    void exclusive_product_scan(const Q* q_in, Q* q_out, std::size_t n, const detail::non_deduced_t<Q>& init = Q(), const scan_config& config = {});
+
+    template<typename Q>
+    std::vector<Q> inclusive_product_scan(const std::vector<Q>& q_in, const scan_config& config = {});
+
+    template<typename Q>
+    std::vector<Q> exclusive_product_scan(const std::vector<Q>& q_in, const detail::non_deduced_t<Q>& init = Q(), const scan_config& config = {});
+}
+
+#include <yadq/impl/scan.tpp>
+
+#endif
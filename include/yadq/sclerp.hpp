@@ -0,0 +1,185 @@
+#ifndef SCLERP_HPP
+#define SCLERP_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/parallel.hpp>
+
+namespace yadq{
+
+    /*
+        ------------------------------ Screw exponential and logarithm maps ------------------------------
+
+        A unit dual quaternion is a screw motion: a rotation of angle theta about a line of direction l and moment
+        m, and a translation d along it. Its logarithm is the twist [w, v] with w = theta l, the rotation vector as
+        in log_map() of quaternions, and v = d l + theta m. A pure translation t has the twist [0, t]. Powers and
+        ScLERP follow: dq^t = exp_map(t log_map(dq)), sclerp(a, b, t) = a (a* b)^t. Both maps are written in terms
+        of sin(theta / 2) / theta and (theta / 2) cot(theta / 2), which stay smooth as theta goes to 0, so small
+        rotations need no special case.
+    */
+
+    /**
+     * \brief Unit dual quaternion of a twist
+     * \param twist [w, v], rotation vector w followed by v = d l + theta m
+     */
+    template<typename T>
+    dualquaternion<T> exp_map(const std::array<T, 6>& twist) noexcept;
+
+    /**
+     * \brief Twist of a unit dual quaternion, with a rotation angle in [0, pi]: dq and -dq give the same twist
+     * \param dq_in unit dual quaternion
+     */
+    template<typename T>
+    std::array<T, 6> log_map(const dualquaternion<T>& dq_in) noexcept;
+
+    /**
+     * \brief Power of a unit dual quaternion, the screw motion with t times its angle and translation
+     */
+    template<typename T>
+    dualquaternion<T> pow(const dualquaternion<T>& dq_in, T t) noexcept;
+
+    /**
+     * \brief Screw linear interpolation, dq_start (dq_start* dq_end)^t along the shortest path. To evaluate the
+     * same segment many times, build a sclerp_plan.
+     */
+    template<typename T>
+    dualquaternion<T> sclerp(const dualquaternion<T>& dq_start, const dualquaternion<T>& dq_end, T t) noexcept;
+
+    /**
+     * \brief Dual quaternion linear blending of two unit dual quaternions, the normalised (1 - t) dq_start + t dq_end
+     * with dq_end on the side of dq_start. It needs no trigonometry and stays a rigid motion, close to the screw
+     * path of sclerp() for small relative rotations (see sclerp_mode), but not at constant velocity.
+     */
+    template<typename T>
+    dualquaternion<T> dlb(const dualquaternion<T>& dq_start, const dualquaternion<T>& dq_end, T t) noexcept;
+
+    /**
+     * \brief Dual quaternion linear blending of n unit dual quaternions with weights. Each one is aligned to the
+     * first (antipodality) before the weighted sum is normalised. Throws std::invalid_argument if n is 0 or the
+     * weighted sum vanishes.
+     * \param dq_in n unit dual quaternions
+     * \param weights n weights
+     * \param n number of dual quaternions
+     */
+    template<typename T>
+    dualquaternion<T> dlb(const dualquaternion<T>* dq_in, const T* weights, std::size_t n);
+
+    /**
+    * \brief Evaluation strategy of a sclerp_plan
+    * exact: screw motion at constant velocity, one sin/cos pair per sample.
+    * dlb: dual quaternion linear blending of the end points, see dlb(), without trigonometry. For a relative
+    * rotation of 0.1 rad the deviation from exact stays below 5e-6 rad in rotation and 1e-4 of the relative
+    * translation, 5e-3 rad and 1e-2 for a rotation of 1 rad.
+    */
+    enum class sclerp_mode {exact, dlb};
+
+    /**
+    * \class sclerp_plan
+    * \brief Screw linear interpolation between two fixed unit dual quaternions, dq(t) = dq_start (dq_start* dq_end)^t.
+    * The relative motion is decomposed once on construction into its screw: rotation angle, pitch (translation
+    * along the axis), unit axis and moment of the axis line. Each sample scales angle and pitch by t and rebuilds
+    * the dual quaternion, one sin/cos pair and one product. The result moves at constant linear and angular
+    * velocity along the screw, the shortest path is taken. Relative motions with a rotation angle below 1e-6 rad
+    * are interpolated as a pure translation.
+    */
+    template<typename _T>
+    class sclerp_plan{
+        static_assert(std::is_same_v<_T, float> || std::is_same_v<_T, double>, "This class only supports floating point types");
+        private:
+            dualquaternion<_T> dq_start_;
+            std::array<_T, 3> axis_;
+            std::array<_T, 3> moment_;
+            _T half_angle_;
+            _T pitch_;
+            // Relative motion, used when the rotation is negligible
+            quaternionU<_T> rotation_;
+            std::array<_T, 3> translation_;
+            bool screw_;
+            // End point on the side of dq_start, for the dlb mode
+            dualquaternion<_T> dq_end_;
+            sclerp_mode mode_;
+
+        public:
+
+            using value_type = _T;
+
+            /**
+             * \brief Constructor from the two end points
+             * \param dq_start unit dual quaternion at t = 0
+             * \param dq_end unit dual quaternion at t = 1
+             * \param mode evaluation strategy
+             */
+            sclerp_plan(const dualquaternion<_T>& dq_start, const dualquaternion<_T>& dq_end, sclerp_mode mode = sclerp_mode::exact);
+            /**
+             * \brief Evaluation strategy
+             */
+            inline sclerp_mode mode() const noexcept{
+                return mode_;
+            }
+            /**
+             * \brief Rotation angle of the relative motion, in [0, pi]
+             */
+            inline _T angle() const noexcept{
+                return 2 * half_angle_;
+            }
+            /**
+             * \brief Translation of the relative motion along the screw axis
+             */
+            inline _T pitch() const noexcept{
+                return pitch_;
+            }
+            /**
+             * \brief Unit screw axis in the frame of dq_start. For a pure translation, its direction (zero if there
+             * is no motion at all)
+             */
+            inline const std::array<_T, 3>& axis() const noexcept{
+                return axis_;
+            }
+            /**
+             * \brief Moment of the screw axis line, p x axis for any point p of the line
+             */
+            inline const std::array<_T, 3>& moment() const noexcept{
+                return moment_;
+            }
+            /**
+             * \brief Interpolated dual quaternion at t
+             * \param t interpolation parameter, 0 gives dq_start and 1 gives dq_end
+             */
+            dualquaternion<_T> operator()(_T t) const noexcept;
+            /**
+             * \brief Interpolate n samples, dq_out[i] = (*this)(t[i])
+             * \param t n interpolation parameters
+             * \param dq_out n output dual quaternions
+             * \param n number of samples
+             */
+            void evaluate(const _T* t, dualquaternion<_T>* dq_out, std::size_t n) const noexcept;
+            /**
+             * \brief Interpolate every sample of t
+             * \param t interpolation parameters
+             */
+            std::vector<dualquaternion<_T>> evaluate(const std::vector<_T>& t) const;
+            /**
+             * \brief Interpolate n samples on several threads
+             * \param t n interpolation parameters
+             * \param dq_out n output dual quaternions
+             * \param n number of samples
+             * \param config threading settings
+             */
+            void evaluate(const _T* t, dualquaternion<_T>* dq_out, std::size_t n, const parallel_config& config) const;
+
+        private:
+            dualquaternion<_T> evaluate_exact(_T t) const noexcept;
+            dualquaternion<_T> evaluate_dlb(_T t) const noexcept;
+    };
+
+    using sclerp_planf = sclerp_plan<float>;
+    using sclerp_pland = sclerp_plan<double>;
+}
+
+#include <yadq/impl/sclerp.tpp>
+
+#endif
@@ -0,0 +1,328 @@
+#ifndef YADQ_SIMD_HPP
+#define YADQ_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <new>
+#include <limits>
+#include <type_traits>
+#include <yadq/instrumentation_hooks.hpp>
+
+#if defined(YADQ_INSTRUMENTATION)
+    #include <yadq/instrumentation.hpp>
+#endif
+
+/*
+    Instruction set used by the batch kernels, picked at compile time from the target flags. Define
+    YADQ_DISABLE_SIMD to force the scalar fallback. Every ISA lives in its own inline namespace so translation
+    units built with different -m flags never share a kernel symbol: AVX2+FMA and SSE4.2 get their own namespace
+    even though they reuse the AVX and SSE2 packs, since the compiler may still use the extra instructions.
+*/
+#if defined(YADQ_DISABLE_SIMD)
+    #define YADQ_SIMD_ISA scalar
+#elif defined(__AVX512F__)
+    #define YADQ_SIMD_ISA avx512
+    #include <immintrin.h>
+#elif defined(__AVX2__) && defined(__FMA__)
+    #define YADQ_SIMD_ISA avx2
+    #include <immintrin.h>
+#elif defined(__AVX__)
+    #define YADQ_SIMD_ISA avx
+    #include <immintrin.h>
+#elif defined(__SSE4_2__)
+    #define YADQ_SIMD_ISA sse42
+    #include <emmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #define YADQ_SIMD_ISA sse2
+    #include <emmintrin.h>
+#else
+    #define YADQ_SIMD_ISA scalar
+#endif
+
+namespace yadq{
+
+    /**
+    * \class aligned_allocator
+    * \brief Minimal allocator returning storage aligned to _Align bytes, used for the SoA lanes
+    */
+    template<typename _T, std::size_t _Align>
+    class aligned_allocator{
+        static_assert((_Align & (_Align - 1)) == 0, "Alignment must be a power of two");
+        public:
+            using value_type = _T;
+
+            template<typename U>
+            struct rebind{
+                using other = aligned_allocator<U, _Align>;
+            };
+
+            aligned_allocator() noexcept = default;
+
+            template<typename U>
+            aligned_allocator(const aligned_allocator<U, _Align>&) noexcept {}
+
+            /**
+             * \brief Allocate n objects aligned to _Align
+             * \param n number of objects
+             */
+            _T* allocate(std::size_t n){
+                if (n > std::numeric_limits<std::size_t>::max() / sizeof(_T)){
+                    throw std::bad_array_new_length();
+                }
+                YADQ_COUNT(allocations);
+                return static_cast<_T*>(::operator new(n * sizeof(_T), std::align_val_t(_Align)));
+            }
+            /**
+             * \brief Release storage obtained by allocate
+             * \param p pointer to release
+             */
+            void deallocate(_T* p, std::size_t) noexcept{
+                ::operator delete(p, std::align_val_t(_Align));
+            }
+
+            template<typename U>
+            bool operator==(const aligned_allocator<U, _Align>&) const noexcept{ return true; }
+
+            template<typename U>
+            bool operator!=(const aligned_allocator<U, _Align>&) const noexcept{ return false; }
+    };
+
+    namespace simd{
+
+        /**
+         * Alignment and padding granularity of every SoA buffer, wide enough for the largest supported register
+         */
+        constexpr std::size_t alignment = 64;
+
+        /**
+         * \brief Round n up to a whole number of alignment-sized blocks of T
+         * \param n number of elements
+         */
+        template<typename T>
+        constexpr std::size_t padded_size(std::size_t n) noexcept{
+            constexpr std::size_t block = alignment / sizeof(T);
+            return (n + block - 1) / block * block;
+        }
+
+        inline namespace YADQ_SIMD_ISA{
+
+            /**
+            * \struct pack
+            * \brief Register-sized group of lanes with the handful of operations needed by the batch kernels.
+            * load()/store() expect aligned pointers. No fused multiply-add is used and negation is a product by -1, so
+            * results match the scalar quaternion code. pack<T, true> is always the one-lane version, used by
+            * kernels written once for both their vector body and their scalar tail.
+            */
+            template<typename T, bool Scalar = false>
+            struct pack{
+                static constexpr std::size_t width = 1;
+                T v;
+
+                static pack load(const T* p) noexcept{ return {*p}; }
+                static pack load_unaligned(const T* p) noexcept{ return {*p}; }
+                static pack broadcast(T s) noexcept{ return {s}; }
+                void store(T* p) const noexcept{ *p = v; }
+                void store_unaligned(T* p) const noexcept{ *p = v; }
+
+                friend pack operator+(pack a, pack b) noexcept{ return {a.v + b.v}; }
+                friend pack operator-(pack a, pack b) noexcept{ return {a.v - b.v}; }
+                friend pack operator*(pack a, pack b) noexcept{ return {a.v * b.v}; }
+                friend pack operator/(pack a, pack b) noexcept{ return {a.v / b.v}; }
+                friend pack operator-(pack a) noexcept{ return {a.v * T(-1)}; }
+                friend pack sqrt(pack a) noexcept{ return {std::sqrt(a.v)}; }
+                /**
+                 * \brief Replace the lanes of a equal to zero with the lanes of r
+                 */
+                friend pack zero_to(pack a, pack r) noexcept{ return {a.v != T(0) ? a.v : r.v}; }
+                /**
+                 * \brief Lanes of x where a > b, lanes of y elsewhere
+                 */
+                friend pack select_gt(pack a, pack b, pack x, pack y) noexcept{ return {a.v > b.v ? x.v : y.v}; }
+            };
+
+            template<typename T>
+            using scalar_pack = pack<T, true>;
+
+#if defined(__AVX512F__) && !defined(YADQ_DISABLE_SIMD)
+            template<>
+            struct pack<double>{
+                static constexpr std::size_t width = 8;
+                __m512d v;
+
+                static pack load(const double* p) noexcept{ return {_mm512_load_pd(p)}; }
+                static pack load_unaligned(const double* p) noexcept{ return {_mm512_loadu_pd(p)}; }
+                static pack broadcast(double s) noexcept{ return {_mm512_set1_pd(s)}; }
+                void store(double* p) const noexcept{ _mm512_store_pd(p, v); }
+                void store_unaligned(double* p) const noexcept{ _mm512_storeu_pd(p, v); }
+
+                friend pack operator+(pack a, pack b) noexcept{ return {_mm512_add_pd(a.v, b.v)}; }
+                friend pack operator-(pack a, pack b) noexcept{ return {_mm512_sub_pd(a.v, b.v)}; }
+                friend pack operator*(pack a, pack b) noexcept{ return {_mm512_mul_pd(a.v, b.v)}; }
+                friend pack operator/(pack a, pack b) noexcept{ return {_mm512_div_pd(a.v, b.v)}; }
+                friend pack operator-(pack a) noexcept{ return {_mm512_mul_pd(a.v, _mm512_set1_pd(-1.0))}; }
+                // The unmasked intrinsic reads an uninitialised pass-through operand in GCC 12, which warns
+                friend pack sqrt(pack a) noexcept{ return {_mm512_maskz_sqrt_pd(~__mmask8(0), a.v)}; }
+                friend pack zero_to(pack a, pack r) noexcept{
+                    return {_mm512_mask_blend_pd(_mm512_cmp_pd_mask(a.v, _mm512_setzero_pd(), _CMP_EQ_OQ), a.v, r.v)};
+                }
+                friend pack select_gt(pack a, pack b, pack x, pack y) noexcept{
+                    return {_mm512_mask_blend_pd(_mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ), y.v, x.v)};
+                }
+            };
+
+            template<>
+            struct pack<float>{
+                static constexpr std::size_t width = 16;
+                __m512 v;
+
+                static pack load(const float* p) noexcept{ return {_mm512_load_ps(p)}; }
+                static pack load_unaligned(const float* p) noexcept{ return {_mm512_loadu_ps(p)}; }
+                static pack broadcast(float s) noexcept{ return {_mm512_set1_ps(s)}; }
+                void store(float* p) const noexcept{ _mm512_store_ps(p, v); }
+                void store_unaligned(float* p) const noexcept{ _mm512_storeu_ps(p, v); }
+
+                friend pack operator+(pack a, pack b) noexcept{ return {_mm512_add_ps(a.v, b.v)}; }
+                friend pack operator-(pack a, pack b) noexcept{ return {_mm512_sub_ps(a.v, b.v)}; }
+                friend pack operator*(pack a, pack b) noexcept{ return {_mm512_mul_ps(a.v, b.v)}; }
+                friend pack operator/(pack a, pack b) noexcept{ return {_mm512_div_ps(a.v, b.v)}; }
+                friend pack operator-(pack a) noexcept{ return {_mm512_mul_ps(a.v, _mm512_set1_ps(-1.0f))}; }
+                friend pack sqrt(pack a) noexcept{ return {_mm512_maskz_sqrt_ps(~__mmask16(0), a.v)}; }
+                friend pack zero_to(pack a, pack r) noexcept{
+                    return {_mm512_mask_blend_ps(_mm512_cmp_ps_mask(a.v, _mm512_setzero_ps(), _CMP_EQ_OQ), a.v, r.v)};
+                }
+                friend pack select_gt(pack a, pack b, pack x, pack y) noexcept{
+                    return {_mm512_mask_blend_ps(_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ), y.v, x.v)};
+                }
+            };
+#elif defined(__AVX__) && !defined(YADQ_DISABLE_SIMD)
+            template<>
+            struct pack<double>{
+                static constexpr std::size_t width = 4;
+                __m256d v;
+
+                static pack load(const double* p) noexcept{ return {_mm256_load_pd(p)}; }
+                static pack load_unaligned(const double* p) noexcept{ return {_mm256_loadu_pd(p)}; }
+                static pack broadcast(double s) noexcept{ return {_mm256_set1_pd(s)}; }
+                void store(double* p) const noexcept{ _mm256_store_pd(p, v); }
+                void store_unaligned(double* p) const noexcept{ _mm256_storeu_pd(p, v); }
+
+                friend pack operator+(pack a, pack b) noexcept{ return {_mm256_add_pd(a.v, b.v)}; }
+                friend pack operator-(pack a, pack b) noexcept{ return {_mm256_sub_pd(a.v, b.v)}; }
+                friend pack operator*(pack a, pack b) noexcept{ return {_mm256_mul_pd(a.v, b.v)}; }
+                friend pack operator/(pack a, pack b) noexcept{ return {_mm256_div_pd(a.v, b.v)}; }
+                friend pack operator-(pack a) noexcept{ return {_mm256_mul_pd(a.v, _mm256_set1_pd(-1.0))}; }
+                friend pack sqrt(pack a) noexcept{ return {_mm256_sqrt_pd(a.v)}; }
+                friend pack zero_to(pack a, pack r) noexcept{
+                    return {_mm256_blendv_pd(a.v, r.v, _mm256_cmp_pd(a.v, _mm256_setzero_pd(), _CMP_EQ_OQ))};
+                }
+                friend pack select_gt(pack a, pack b, pack x, pack y) noexcept{
+                    return {_mm256_blendv_pd(y.v, x.v, _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ))};
+                }
+            };
+
+            template<>
+            struct pack<float>{
+                static constexpr std::size_t width = 8;
+                __m256 v;
+
+                static pack load(const float* p) noexcept{ return {_mm256_load_ps(p)}; }
+                static pack load_unaligned(const float* p) noexcept{ return {_mm256_loadu_ps(p)}; }
+                static pack broadcast(float s) noexcept{ return {_mm256_set1_ps(s)}; }
+                void store(float* p) const noexcept{ _mm256_store_ps(p, v); }
+                void store_unaligned(float* p) const noexcept{ _mm256_storeu_ps(p, v); }
+
+                friend pack operator+(pack a, pack b) noexcept{ return {_mm256_add_ps(a.v, b.v)}; }
+                friend pack operator-(pack a, pack b) noexcept{ return {_mm256_sub_ps(a.v, b.v)}; }
+                friend pack operator*(pack a, pack b) noexcept{ return {_mm256_mul_ps(a.v, b.v)}; }
+                friend pack operator/(pack a, pack b) noexcept{ return {_mm256_div_ps(a.v, b.v)}; }
+                friend pack operator-(pack a) noexcept{ return {_mm256_mul_ps(a.v, _mm256_set1_ps(-1.0f))}; }
+                friend pack sqrt(pack a) noexcept{ return {_mm256_sqrt_ps(a.v)}; }
+                friend pack zero_to(pack a, pack r) noexcept{
+                    return {_mm256_blendv_ps(a.v, r.v, _mm256_cmp_ps(a.v, _mm256_setzero_ps(), _CMP_EQ_OQ))};
+                }
+                friend pack select_gt(pack a, pack b, pack x, pack y) noexcept{
+                    return {_mm256_blendv_ps(y.v, x.v, _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ))};
+                }
+            };
+#elif (defined(__SSE2__) || defined(_M_X64)) && !defined(YADQ_DISABLE_SIMD)
+            template<>
+            struct pack<double>{
+                static constexpr std::size_t width = 2;
+                __m128d v;
+
+                static pack load(const double* p) noexcept{ return {_mm_load_pd(p)}; }
+                static pack load_unaligned(const double* p) noexcept{ return {_mm_loadu_pd(p)}; }
+                static pack broadcast(double s) noexcept{ return {_mm_set1_pd(s)}; }
+                void store(double* p) const noexcept{ _mm_store_pd(p, v); }
+                void store_unaligned(double* p) const noexcept{ _mm_storeu_pd(p, v); }
+
+                friend pack operator+(pack a, pack b) noexcept{ return {_mm_add_pd(a.v, b.v)}; }
+                friend pack operator-(pack a, pack b) noexcept{ return {_mm_sub_pd(a.v, b.v)}; }
+                friend pack operator*(pack a, pack b) noexcept{ return {_mm_mul_pd(a.v, b.v)}; }
+                friend pack operator/(pack a, pack b) noexcept{ return {_mm_div_pd(a.v, b.v)}; }
+                friend pack operator-(pack a) noexcept{ return {_mm_mul_pd(a.v, _mm_set1_pd(-1.0))}; }
+                friend pack sqrt(pack a) noexcept{ return {_mm_sqrt_pd(a.v)}; }
+                friend pack zero_to(pack a, pack r) noexcept{
+                    const __m128d m = _mm_cmpeq_pd(a.v, _mm_setzero_pd());
+                    return {_mm_or_pd(_mm_and_pd(m, r.v), _mm_andnot_pd(m, a.v))};
+                }
+                friend pack select_gt(pack a, pack b, pack x, pack y) noexcept{
+                    const __m128d m = _mm_cmpgt_pd(a.v, b.v);
+                    return {_mm_or_pd(_mm_and_pd(m, x.v), _mm_andnot_pd(m, y.v))};
+                }
+            };
+
+            template<>
+            struct pack<float>{
+                static constexpr std::size_t width = 4;
+                __m128 v;
+
+                static pack load(const float* p) noexcept{ return {_mm_load_ps(p)}; }
+                static pack load_unaligned(const float* p) noexcept{ return {_mm_loadu_ps(p)}; }
+                static pack broadcast(float s) noexcept{ return {_mm_set1_ps(s)}; }
+                void store(float* p) const noexcept{ _mm_store_ps(p, v); }
+                void store_unaligned(float* p) const noexcept{ _mm_storeu_ps(p, v); }
+
+                friend pack operator+(pack a, pack b) noexcept{ return {_mm_add_ps(a.v, b.v)}; }
+                friend pack operator-(pack a, pack b) noexcept{ return {_mm_sub_ps(a.v, b.v)}; }
+                friend pack operator*(pack a, pack b) noexcept{ return {_mm_mul_ps(a.v, b.v)}; }
+                friend pack operator/(pack a, pack b) noexcept{ return {_mm_div_ps(a.v, b.v)}; }
+                friend pack operator-(pack a) noexcept{ return {_mm_mul_ps(a.v, _mm_set1_ps(-1.0f))}; }
+                friend pack sqrt(pack a) noexcept{ return {_mm_sqrt_ps(a.v)}; }
+                friend pack zero_to(pack a, pack r) noexcept{
+                    const __m128 m = _mm_cmpeq_ps(a.v, _mm_setzero_ps());
+                    return {_mm_or_ps(_mm_and_ps(m, r.v), _mm_andnot_ps(m, a.v))};
+                }
+                friend pack select_gt(pack a, pack b, pack x, pack y) noexcept{
+                    const __m128 m = _mm_cmpgt_ps(a.v, b.v);
+                    return {_mm_or_ps(_mm_and_ps(m, x.v), _mm_andnot_ps(m, y.v))};
+                }
+            };
+#endif
+
+            /**
+             * \brief Name of the instruction set the kernels of this translation unit were built for
+             */
+            constexpr const char* isa_name() noexcept{
+#if defined(YADQ_DISABLE_SIMD)
+                return "scalar";
+#elif defined(__AVX512F__)
+                return "avx512";
+#elif defined(__AVX2__) && defined(__FMA__)
+                return "avx2";
+#elif defined(__AVX__)
+                return "avx";
+#elif defined(__SSE4_2__)
+                return "sse42";
+#elif defined(__SSE2__) || defined(_M_X64)
+                return "sse2";
+#else
+                return "scalar";
+#endif
+            }
+        }
+    }
+}
+
+#endif
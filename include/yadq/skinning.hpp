@@ -0,0 +1,64 @@
+#ifndef SKINNING_HPP
+#define SKINNING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/point_cloud.hpp>
+#include <yadq/parallel.hpp>
+#include <yadq/simd.hpp>
+
+namespace yadq{
+
+    /**
+    * \struct bone_influences
+    * \brief Per-vertex skinning influences, K per vertex stored contiguously: bones[v * K + k] and
+    * weights[v * K + k]. Weights of a vertex are expected to sum to 1; unused slots must still reference a valid
+    * bone (e.g. 0) with a zero weight.
+    */
+    template<typename _T, std::size_t K>
+    struct bone_influences{
+        static_assert(K == 4 || K == 8, "Skinning supports 4 or 8 influences per vertex");
+
+        static constexpr std::size_t count = K;
+
+        const std::uint32_t* bones;
+        const _T* weights;
+    };
+
+    /**
+     * \brief Dual quaternion linear blending (DLB) of n vertices. Each vertex blends its K bones with the sign of
+     * every bone aligned to the first one (antipodality), normalises the blend once and applies it to the position.
+     * \param palette bone transformations, unit dual quaternions
+     * \param influences bone indices and weights of every vertex
+     * \param positions_in rest positions
+     * \param positions_out deformed positions, may be positions_in
+     * \param n number of vertices
+     * \param config threading settings, vertices are split in contiguous chunks
+     */
+    template<typename T, std::size_t K>
+    void skin(  const dualquaternion<T>* palette, const bone_influences<T, K>& influences,
+                detail::non_deduced_t<point_lanes<const T>> positions_in, detail::non_deduced_t<point_lanes<T>> positions_out,
+                std::size_t n, const parallel_config& config = {});
+
+    /**
+     * \brief Dual quaternion linear blending of n vertices and their normals. Normals are only rotated.
+     * \param palette bone transformations, unit dual quaternions
+     * \param influences bone indices and weights of every vertex
+     * \param positions_in rest positions
+     * \param normals_in rest normals
+     * \param positions_out deformed positions, may be positions_in
+     * \param normals_out deformed normals, may be normals_in
+     * \param n number of vertices
+     * \param config threading settings, vertices are split in contiguous chunks
+     */
+    template<typename T, std::size_t K>
+    void skin(  const dualquaternion<T>* palette, const bone_influences<T, K>& influences,
+                detail::non_deduced_t<point_lanes<const T>> positions_in, detail::non_deduced_t<point_lanes<const T>> normals_in,
+                detail::non_deduced_t<point_lanes<T>> positions_out, detail::non_deduced_t<point_lanes<T>> normals_out,
+                std::size_t n, const parallel_config& config = {});
+}
+
+#include <yadq/impl/skinning.tpp>
+
+#endif
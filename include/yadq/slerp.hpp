@@ -0,0 +1,107 @@
+#ifndef SLERP_HPP
+#define SLERP_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <yadq/quaternion.hpp>
+
+namespace yadq{
+
+    /**
+    * \brief Evaluation strategy of a slerp_plan
+    * exact: sin() of both weights, as interpolation(..., InterpType::SLERP).
+    * fast: weights from a minimax polynomial of sin(x)/x on [0, pi/2]. The relative error of the polynomial is
+    * below 5.4e-9, which bounds the rotation angle error by 1.6e-8 rad for t in [0, 1] (2 sqrt(2) times the
+    * weight error, the weights summing to at most sqrt(2) on the shortest path). Float results are dominated by
+    * float rounding (about 1e-6 rad). Outside [0, 1] the polynomial is extrapolated and the bound does not hold.
+    * Samples are not renormalised: in both modes their norm is off by the weight error, plus rounding.
+    */
+    enum class slerp_mode {exact, fast};
+
+    /**
+    * \class slerp_plan
+    * \brief Spherical linear interpolation between two fixed unitary quaternions. Angle, 1 / sin(angle) and the
+    * shortest-path sign are computed once on construction, so each sample only evaluates the two weights.
+    * Nearly parallel and identical quaternions need no special case at evaluation time.
+    */
+    template<typename _T>
+    class slerp_plan{
+        static_assert(std::is_same_v<_T, float> || std::is_same_v<_T, double>, "This class only supports floating point types");
+        private:
+            std::array<_T, 4> q_start_;
+            std::array<_T, 4> q_end_;
+            _T theta_;
+            _T inv_sin_;
+            _T inv_sinc_;
+            slerp_mode mode_;
+
+        public:
+
+            using value_type = _T;
+
+            /**
+             * \brief Constructor from the two end points
+             * \param q_start quaternion at t = 0
+             * \param q_end quaternion at t = 1
+             * \param mode evaluation strategy
+             */
+            template<typename P>
+            slerp_plan(const quaternionU<_T, P>& q_start, const quaternionU<_T, P>& q_end, slerp_mode mode = slerp_mode::exact);
+            /**
+             * \brief Angle between the two end points on the 4D hypersphere (half of the rotation angle)
+             */
+            inline _T angle() const noexcept{
+                return theta_;
+            }
+            /**
+             * \brief Evaluation strategy
+             */
+            inline slerp_mode mode() const noexcept{
+                return mode_;
+            }
+            /**
+             * \brief Interpolated quaternion at t
+             * \param t interpolation parameter, 0 gives q_start and 1 gives q_end
+             */
+            quaternionU<_T> operator()(_T t) const noexcept;
+            /**
+             * \brief Interpolate n samples, q_out[i] = (*this)(t[i])
+             * \param t n interpolation parameters
+             * \param q_out n output quaternions
+             * \param n number of samples
+             */
+            void evaluate(const _T* t, quaternionU<_T>* q_out, std::size_t n) const noexcept;
+            /**
+             * \brief Interpolate every sample of t
+             * \param t interpolation parameters
+             */
+            std::vector<quaternionU<_T>> evaluate(const std::vector<_T>& t) const;
+
+        private:
+
+            // The slerp weights keep the unit norm of the end points: the result is not renormalised
+            inline quaternionU<_T> combine(_T w_start, _T w_end) const noexcept{
+                return quaternionU<_T>( unit_norm,
+                                        w_start * q_start_[0] + w_end * q_end_[0],
+                                        w_start * q_start_[1] + w_end * q_end_[1],
+                                        w_start * q_start_[2] + w_end * q_end_[2],
+                                        w_start * q_start_[3] + w_end * q_end_[3]);
+            }
+
+            inline quaternionU<_T> evaluate_exact(_T t) const noexcept{
+                YADQ_COUNT_N(trig_calls, 2);
+                return combine(std::sin((1 - t) * theta_) * inv_sin_, std::sin(t * theta_) * inv_sin_);
+            }
+
+            inline quaternionU<_T> evaluate_fast(_T t) const noexcept;
+    };
+
+    using slerp_planf = slerp_plan<float>;
+    using slerp_pland = slerp_plan<double>;
+}
+
+#include <yadq/impl/slerp.tpp>
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef TRAJECTORY_HPP
+#define TRAJECTORY_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/slerp.hpp>
+#include <yadq/sclerp.hpp>
+#include <yadq/parallel.hpp>
+
+namespace yadq{
+
+    /**
+    * \brief Interpolation between the keyframes of a trajectory
+    * linear: SLERP for quaternions, ScLERP for dual quaternions. Continuous, with velocity jumps at keyframes.
+    * smooth: SQUAD for the rotation and, for dual quaternions, a cubic Hermite spline with Catmull-Rom tangents for
+    * the translation. Angular and linear velocities are continuous across keyframes (exactly for evenly spaced
+    * rotation keyframes); the curve still passes through every keyframe.
+    */
+    enum class trajectory_interp {linear, smooth};
+
+    namespace detail {
+
+        template<typename Q>
+        struct trajectory_traits;
+
+        template<typename T>
+        struct trajectory_traits<quaternionU<T>>{
+            using scalar_type = T;
+            using plan_type = slerp_plan<T>;
+            static constexpr bool dual = false;
+        };
+
+        template<typename T>
+        struct trajectory_traits<dualquaternion<T>>{
+            using scalar_type = T;
+            using plan_type = sclerp_plan<T>;
+            static constexpr bool dual = true;
+        };
+    }
+
+    /**
+    * \class trajectory
+    * \brief Time-indexed sequence of keyframes, quaternionU or dualquaternion values at strictly increasing
+    * timestamps, interpolated at arbitrary times. The interpolation constants of every segment (SLERP / ScLERP
+    * plans, SQUAD control points, spline tangents) are computed when keyframes are added, so a query locates its
+    * segment and evaluates it. Queries before the first or after the last keyframe are clamped to it.
+    *
+    * Locating a segment costs a binary search for isolated queries; a cursor, or the batch evaluate(), starts
+    * from the segment of the previous query and is amortised O(1) for monotone query streams.
+    */
+    template<typename Q>
+    class trajectory{
+        private:
+            using traits = detail::trajectory_traits<Q>;
+
+        public:
+            using value_type = Q;
+            using scalar_type = typename traits::scalar_type;
+
+            /**
+            * \class cursor
+            * \brief Query handle remembering the segment of the last query. Queries close in time to the previous
+            * one are found by scanning forward from it, the others by a galloping or binary search. A cursor refers
+            * to its trajectory and stays valid across push_back.
+            */
+            class cursor{
+                public:
+                    explicit cursor(const trajectory& tr) noexcept: tr_(&tr) {}
+                    /**
+                     * \brief Value at time, see trajectory::operator()
+                     */
+                    Q operator()(double time){
+                        tr_->check_not_empty();
+                        segment_ = tr_->locate(time, segment_);
+                        return tr_->evaluate_segment(segment_, time);
+                    }
+                    /**
+                     * \brief Segment of the last query, between keyframes segment() and segment() + 1
+                     */
+                    inline std::size_t segment() const noexcept{
+                        return segment_;
+                    }
+
+                private:
+                    const trajectory* tr_;
+                    std::size_t segment_{0};
+            };
+
+            /**
+             * \brief Empty constructor
+             * \param mode interpolation between keyframes
+             */
+            explicit trajectory(trajectory_interp mode = trajectory_interp::linear): mode_(mode) {}
+            /**
+             * \brief Constructor from keyframes
+             * \param times strictly increasing timestamps
+             * \param values keyframe values, as many as times
+             * \param mode interpolation between keyframes
+             */
+            trajectory(std::vector<double> times, std::vector<Q> values, trajectory_interp mode = trajectory_interp::linear);
+            /**
+             * \brief Append a keyframe. The constants of the last segments are updated: with smooth interpolation,
+             * adding a keyframe changes the shape of the previous segment.
+             * \param time timestamp, greater than end_time()
+             * \param value keyframe value
+             */
+            void push_back(double time, const Q& value);
+            /**
+             * \brief Reserve storage for n keyframes
+             */
+            void reserve(std::size_t n);
+            /**
+             * \brief Number of keyframes
+             */
+            inline std::size_t size() const noexcept{
+                return times_.size();
+            }
+            /**
+             * \brief Check if the trajectory has no keyframe
+             */
+            inline bool empty() const noexcept{
+                return times_.empty();
+            }
+            /**
+             * \brief Interpolation between keyframes
+             */
+            inline trajectory_interp mode() const noexcept{
+                return mode_;
+            }
+            /**
+             * \brief Keyframe timestamps
+             */
+            inline const std::vector<double>& times() const noexcept{
+                return times_;
+            }
+            /**
+             * \brief Keyframe values
+             */
+            inline const std::vector<Q>& values() const noexcept{
+                return values_;
+            }
+            /**
+             * \brief Timestamp of the first keyframe
+             */
+            inline double start_time() const noexcept{
+                return times_.front();
+            }
+            /**
+             * \brief Timestamp of the last keyframe
+             */
+            inline double end_time() const noexcept{
+                return times_.back();
+            }
+            /**
+             * \brief Value at time, locating the segment by binary search. Throws std::out_of_range if the trajectory
+             * is empty.
+             * \param time query time, clamped to [start_time(), end_time()]
+             */
+            Q operator()(double time) const;
+            /**
+             * \brief Cursor for streams of queries
+             */
+            inline cursor make_cursor() const noexcept{
+                return cursor(*this);
+            }
+            /**
+             * \brief Values at n times, out[i] = (*this)(times[i]). Each segment search starts from the previous
+             * one: sorted times are located in O(n + size()) overall, unsorted times are still handled.
+             * \param times n query times
+             * \param out n output values
+             * \param n number of queries
+             */
+            void evaluate(const double* times, Q* out, std::size_t n) const;
+            /**
+             * \brief Values at every time of times
+             * \param times query times, ideally sorted
+             */
+            std::vector<Q> evaluate(const std::vector<double>& times) const;
+            /**
+             * \brief Values at n times on several threads, each thread resampling a contiguous block of times
+             * \param times n query times
+             * \param out n output values
+             * \param n number of queries
+             * \param config threading settings
+             */
+            void evaluate(const double* times, Q* out, std::size_t n, const parallel_config& config) const;
+            /**
+             * \brief Values at every time of times on several threads
+             */
+            std::vector<Q> evaluate(const std::vector<double>& times, const parallel_config& config) const;
+
+        private:
+            void check_not_empty() const;
+            /**
+             * \brief Segment k holding time, with times_[k] <= time < times_[k + 1] when time is in range,
+             * searched from segment hint
+             */
+            std::size_t locate(double time, std::size_t hint) const noexcept;
+            Q evaluate_segment(std::size_t k, double time) const noexcept;
+            /**
+             * \brief Recompute the constants of keyframes first onwards and of the segments touching them
+             */
+            void update(std::size_t first);
+
+            trajectory_interp mode_;
+            std::vector<double> times_;
+            std::vector<Q> values_;
+            std::vector<double> inv_durations_;
+            // linear: one plan per segment
+            std::vector<typename traits::plan_type> plans_;
+            // smooth: keyframe rotations on a common hemisphere, their SQUAD control points and one slerp plan per
+            // segment between both
+            std::vector<quaternionU<scalar_type>> rotations_;
+            std::vector<quaternionU<scalar_type>> controls_;
+            std::vector<slerp_plan<scalar_type>> rotation_plans_;
+            std::vector<slerp_plan<scalar_type>> control_plans_;
+            // smooth dual quaternions: keyframe translations and their tangents (per unit time)
+            std::vector<std::array<scalar_type, 3>> positions_;
+            std::vector<std::array<scalar_type, 3>> tangents_;
+    };
+}
+
+#include <yadq/impl/trajectory.tpp>
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef TRAJECTORY_FILE_HPP
+#define TRAJECTORY_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+    #error "yadq/trajectory_file.hpp relies on POSIX mmap"
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    #error "Trajectory files are little-endian and mapped without conversion"
+#endif
+
+namespace yadq{
+
+    /*
+        ------------------------------ File format ------------------------------
+
+        Little-endian, version 1:
+        - a 64-byte trajectory_header;
+        - `count` records from byte data_offset (64), each record_size bytes: a double timestamp followed by the
+          components of the value as stored in memory, [w, x, y, z] for quaternions and [qr, qd] for dual
+          quaternions.
+        Records are aligned to 8 bytes, so the mapped file is used in place. Readers reject files whose version,
+        record kind, scalar size or record size do not match the requested view: any layout change bumps the
+        version. Bytes past the last counted record are ignored.
+    */
+
+    /**
+    * \brief Kind of value stored in a record
+    */
+    enum class record_kind : std::uint32_t {quaternion = 1, dualquaternion = 2};
+
+    /**
+    * \struct trajectory_header
+    * \brief First 64 bytes of a trajectory file
+    */
+    struct trajectory_header{
+        static constexpr char magic_value[8] = {'Y', 'A', 'D', 'Q', 'T', 'R', 'J', '\0'};
+        static constexpr std::uint32_t current_version = 1;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t kind;
+        std::uint32_t scalar_size;
+        std::uint32_t record_size;
+        /**
+         * Number of records, updated by the appender on every flush
+         */
+        std::uint64_t count;
+        std::uint64_t data_offset;
+        std::uint8_t reserved[24];
+    };
+
+    static_assert(sizeof(trajectory_header) == 64, "The trajectory header must be 64 bytes");
+
+    /**
+    * \struct trajectory_record
+    * \brief One timestamped value, as laid out in the file
+    */
+    template<typename Q>
+    struct trajectory_record{
+        double timestamp;
+        Q value;
+    };
+
+    /**
+    * \struct record_traits
+    * \brief Types that can be stored in a trajectory file: quaternion, eager quaternionU and dualquaternion
+    */
+    template<typename Q>
+    struct record_traits;
+
+    template<typename T>
+    struct record_traits<quaternion<T>>{
+        static constexpr record_kind kind = record_kind::quaternion;
+        using value_type = T;
+    };
+
+    template<typename T>
+    struct record_traits<quaternionU<T, normalise_eager>>{
+        static constexpr record_kind kind = record_kind::quaternion;
+        using value_type = T;
+    };
+
+    template<typename T>
+    struct record_traits<dualquaternion<T>>{
+        static constexpr record_kind kind = record_kind::dualquaternion;
+        using value_type = T;
+    };
+
+    /**
+    * \brief Access pattern advised to the kernel for the mapping of a reader
+    */
+    enum class access_pattern {normal, sequential, random};
+
+    /**
+    * \class trajectory_reader
+    * \brief Read-only memory mapping of a trajectory file. Opening reads and checks the header only, records are
+    * paged in on access and exposed in place, without copies. Appending to the file does not change a reader
+    * opened before.
+    */
+    template<typename Q>
+    class trajectory_reader{
+        static_assert(std::is_trivially_copyable_v<Q> && std::is_standard_layout_v<Q>, "Records are used in place");
+        static_assert(sizeof(Q) == (record_traits<Q>::kind == record_kind::quaternion ? 4 : 8) * sizeof(typename record_traits<Q>::value_type),
+                      "The value must hold its components only");
+
+        public:
+            using value_type = Q;
+            using record_type = trajectory_record<Q>;
+            using const_iterator = const record_type*;
+
+            /**
+             * \brief Map a trajectory file
+             * \param path file to open
+             * \param pattern expected access pattern, forwarded to madvise
+             */
+            explicit trajectory_reader(const std::string& path, access_pattern pattern = access_pattern::normal);
+
+            trajectory_reader(const trajectory_reader&) = delete;
+            trajectory_reader& operator=(const trajectory_reader&) = delete;
+
+            trajectory_reader(trajectory_reader&& other) noexcept{
+                swap(other);
+            }
+
+            trajectory_reader& operator=(trajectory_reader&& other) noexcept{
+                trajectory_reader tmp(std::move(other));
+                swap(tmp);
+                return *this;
+            }
+
+            ~trajectory_reader();
+
+            /**
+             * \brief Number of records
+             */
+            inline std::size_t size() const noexcept{
+                return size_;
+            }
+            /**
+             * \brief Check if the file holds no record
+             */
+            inline bool empty() const noexcept{
+                return size_ == 0;
+            }
+            /**
+             * \brief Header of the file
+             */
+            inline const trajectory_header& header() const noexcept{
+                return *static_cast<const trajectory_header*>(map_);
+            }
+            /**
+             * \brief Records, size() of them
+             */
+            inline const record_type* data() const noexcept{
+                return records_;
+            }
+            /**
+             * \brief The i-th record
+             */
+            inline const record_type& operator[](std::size_t i) const noexcept{
+                return records_[i];
+            }
+            /**
+             * \brief The i-th record, with bounds checking
+             */
+            const record_type& at(std::size_t i) const;
+
+            const_iterator begin() const noexcept{ return records_; }
+            const_iterator end() const noexcept{ return records_ + size_; }
+
+        private:
+            void swap(trajectory_reader& other) noexcept;
+
+            void* map_{nullptr};
+            std::size_t map_size_{0};
+            const record_type* records_{nullptr};
+            std::size_t size_{0};
+    };
+
+    /**
+    * \brief How an appender opens its file
+    */
+    enum class open_mode {truncate, append};
+
+    /**
+    * \class trajectory_appender
+    * \brief Streaming writer of a trajectory file. Records are buffered and written in blocks; flush() writes the
+    * pending records and then the record count in the header, so a reader opened afterwards sees every record
+    * appended before the flush. The destructor flushes.
+    */
+    template<typename Q>
+    class trajectory_appender{
+        static_assert(std::is_trivially_copyable_v<Q> && std::is_standard_layout_v<Q>, "Records are written as they are laid out in memory");
+
+        public:
+            using value_type = Q;
+            using record_type = trajectory_record<Q>;
+
+            /**
+             * \brief Create or open a trajectory file
+             * \param path file to write
+             * \param mode truncate starts a new file, and must not be used while readers map it; append continues
+             * an existing one (created if missing) after its recorded count, overwriting data past it without
+             * shrinking the file
+             * \param buffer_records number of records buffered between two writes
+             */
+            explicit trajectory_appender(const std::string& path, open_mode mode = open_mode::truncate, std::size_t buffer_records = 4096);
+
+            trajectory_appender(const trajectory_appender&) = delete;
+            trajectory_appender& operator=(const trajectory_appender&) = delete;
+
+            ~trajectory_appender();
+
+            /**
+             * \brief Append a record
+             * \param timestamp time of the record
+             * \param value quaternion or dual quaternion to store
+             */
+            void append(double timestamp, const Q& value){
+                buffer_.push_back({timestamp, value});
+
+                if (buffer_.size() == capacity_){
+                    write_buffer();
+                }
+            }
+            /**
+             * \brief Write the buffered records and the record count
+             */
+            void flush();
+            /**
+             * \brief Number of records appended, flushed or not
+             */
+            inline std::size_t size() const noexcept{
+                return static_cast<std::size_t>(written_) + buffer_.size();
+            }
+
+        private:
+            void write_buffer();
+
+            int fd_{-1};
+            std::size_t capacity_;
+            std::vector<record_type> buffer_;
+            std::uint64_t written_{0};
+            std::uint64_t data_offset_{sizeof(trajectory_header)};
+    };
+}
+
+#include <yadq/impl/trajectory_file.tpp>
+
+#endif
@@ -3,21 +3,32 @@
 
 #include <yadq/quaternion.hpp>
 #include <type_traits>
+#include <utility>
 
 namespace yadq {
 
     template<typename _T>
     class quaternion;
 
-    template<typename _T>
+    struct normalise_eager;
+
+    template<typename _T, typename _Policy = normalise_eager>
     class quaternionU;
 
-    template<typename>
-    struct is_base_of_quaternion : std::false_type {};
+    namespace detail {
+
+        template<typename T>
+        std::true_type is_base_of_quaternion_test(const volatile quaternion<T>*);
 
-    template<   template<typename...> class Base, 
-                typename... Ts>
-    struct is_base_of_quaternion<Base<Ts...>> : std::is_base_of<quaternion<Ts...>, Base<Ts...>> {}; 
+        std::false_type is_base_of_quaternion_test(const volatile void*);
+    }
+
+    /*
+        Deduced through a pointer conversion so that unrelated class templates (e.g. iterators picked up by the
+        free operators) simply fail deduction instead of instantiating quaternion<> with a foreign type.
+    */
+    template<typename T>
+    struct is_base_of_quaternion : decltype(detail::is_base_of_quaternion_test(std::declval<T*>())) {};
 
     template<typename T>
     constexpr bool is_base_of_quaternion_v = is_base_of_quaternion<T>::value;
@@ -34,11 +45,42 @@ namespace yadq {
     template<typename>
     struct is_quaternionU : std::false_type {};
 
-    template<typename T>
-    struct is_quaternionU<quaternionU<T>> : std::true_type {};
+    template<typename T, typename P>
+    struct is_quaternionU<quaternionU<T, P>> : std::true_type {};
     
     template<typename T>
     constexpr bool is_quaternionU_v = is_quaternionU<T>::value;
+
+    template<typename E>
+    class quaternion_expression;
+
+    namespace detail {
+
+        template<typename E>
+        std::true_type is_quaternion_expression_test(const volatile quaternion_expression<E>*);
+
+        std::false_type is_quaternion_expression_test(const volatile void*);
+    }
+
+    /*
+        Expression nodes derive from quaternion_expression<Node> (see expression.hpp). They are not quaternions:
+        is_base_of_quaternion_v is false for them, so the eager operators never match an expression.
+    */
+    template<typename T>
+    struct is_quaternion_expression : decltype(detail::is_quaternion_expression_test(std::declval<T*>())) {};
+
+    template<typename T>
+    constexpr bool is_quaternion_expression_v = is_quaternion_expression<T>::value;
+
+    /*
+        Operands accepted by the expression operators: at least one expression, the other one an expression, a
+        quaternion or a quaternionU
+    */
+    template<typename L, typename R>
+    constexpr bool is_quaternion_expression_operands_v =
+        (is_quaternion_expression_v<L> || is_quaternion_expression_v<R>) &&
+        (is_quaternion_expression_v<L> || is_quaternion_v<L> || is_quaternionU_v<L>) &&
+        (is_quaternion_expression_v<R> || is_quaternion_v<R> || is_quaternionU_v<R>);
 }
 
 
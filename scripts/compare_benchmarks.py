@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON result files and flag regressions.
+
+Usage:
+    compare_benchmarks.py baseline.json candidate.json [--threshold 0.05] [--metric cpu_time|real_time]
+
+A benchmark regresses when its time in the candidate run exceeds the baseline by more than the threshold
+(relative, 0.05 = 5%). The script exits with status 1 if any regression is found, so it can gate CI.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path, metric):
+    with open(path) as f:
+        data = json.load(f)
+
+    results = {}
+    for b in data.get("benchmarks", []):
+        # With --benchmark_repetitions only the mean aggregate is compared
+        if b.get("run_type") == "aggregate" and b.get("aggregate_name") != "mean":
+            continue
+        name = b.get("run_name", b["name"])
+        results[name] = float(b[metric])
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=0.05, help="relative slowdown flagged as regression")
+    parser.add_argument("--metric", default="cpu_time", choices=["cpu_time", "real_time"])
+    args = parser.parse_args()
+
+    base = load(args.baseline, args.metric)
+    cand = load(args.candidate, args.metric)
+
+    regressions = []
+    width = max((len(n) for n in base), default=10)
+
+    print(f"{'benchmark':<{width}}  {'baseline':>14}  {'candidate':>14}  {'change':>8}")
+    for name in sorted(base):
+        if name not in cand:
+            print(f"{name:<{width}}  {base[name]:>14.1f}  {'missing':>14}")
+            continue
+
+        change = (cand[name] - base[name]) / base[name] if base[name] > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+
+        print(f"{name:<{width}}  {base[name]:>14.1f}  {cand[name]:>14.1f}  {change:>+7.1%}{flag}")
+
+    for name in sorted(set(cand) - set(base)):
+        print(f"{name:<{width}}  {'new':>14}  {cand[name]:>14.1f}")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {args.threshold:.0%}")
+        return 1
+
+    print(f"\nNo regression above {args.threshold:.0%}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,173 @@
+/*
+    Selection of the kernel table. The YADQ_KERNELS_HAVE_<ISA> definitions tell which tables were built for
+    this target; the CPU is queried through the compiler's cpuid builtins, which also check that the OS saves
+    the wide registers.
+*/
+#include <yadq/dispatch.hpp>
+
+#include <atomic>
+#include <cstdlib>
+
+namespace yadq::dispatch{
+
+    namespace detail {
+
+        namespace scalar { const kernel_table* table() noexcept; }
+#ifdef YADQ_KERNELS_HAVE_SSE2
+        namespace sse2 { const kernel_table* table() noexcept; }
+#endif
+#ifdef YADQ_KERNELS_HAVE_SSE42
+        namespace sse42 { const kernel_table* table() noexcept; }
+#endif
+#ifdef YADQ_KERNELS_HAVE_AVX2
+        namespace avx2 { const kernel_table* table() noexcept; }
+#endif
+#ifdef YADQ_KERNELS_HAVE_AVX512
+        namespace avx512 { const kernel_table* table() noexcept; }
+#endif
+    }
+
+    namespace {
+
+        constexpr isa all_isas[] = {isa::scalar, isa::sse2, isa::sse42, isa::avx2, isa::avx512};
+
+        /**
+         * \brief Table built for target, null if it was not built
+         */
+        const detail::kernel_table* built_table(isa target) noexcept{
+            switch (target){
+                case isa::scalar:
+                    return detail::scalar::table();
+#ifdef YADQ_KERNELS_HAVE_SSE2
+                case isa::sse2:
+                    return detail::sse2::table();
+#endif
+#ifdef YADQ_KERNELS_HAVE_SSE42
+                case isa::sse42:
+                    return detail::sse42::table();
+#endif
+#ifdef YADQ_KERNELS_HAVE_AVX2
+                case isa::avx2:
+                    return detail::avx2::table();
+#endif
+#ifdef YADQ_KERNELS_HAVE_AVX512
+                case isa::avx512:
+                    return detail::avx512::table();
+#endif
+                default:
+                    return nullptr;
+            }
+        }
+
+        bool cpu_runs(isa target) noexcept{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_cpu_init();
+            switch (target){
+                case isa::scalar:
+                    return true;
+                case isa::sse2:
+                    return __builtin_cpu_supports("sse2");
+                case isa::sse42:
+                    return __builtin_cpu_supports("sse4.2");
+                case isa::avx2:
+                    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+                case isa::avx512:
+                    return __builtin_cpu_supports("avx512f");
+            }
+            return false;
+#else
+            return target == isa::scalar;
+#endif
+        }
+
+        /**
+         * \brief Table used until select() is called: YADQ_ISA if set and supported, the detected one otherwise
+         */
+        const detail::kernel_table* initial_table() noexcept{
+
+            if (const char* requested = std::getenv("YADQ_ISA")){
+                const auto target = parse(requested);
+                if (target && supported(*target)){
+                    return built_table(*target);
+                }
+            }
+            return built_table(detected());
+        }
+
+        std::atomic<const detail::kernel_table*> active_table_{nullptr};
+    }
+
+    const char* name(isa target) noexcept{
+        switch (target){
+            case isa::scalar:
+                return "scalar";
+            case isa::sse2:
+                return "sse2";
+            case isa::sse42:
+                return "sse42";
+            case isa::avx2:
+                return "avx2";
+            case isa::avx512:
+                return "avx512";
+        }
+        return "unknown";
+    }
+
+    std::optional<isa> parse(std::string_view name) noexcept{
+        for (const isa target : all_isas){
+            if (name == dispatch::name(target)){
+                return target;
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool supported(isa target) noexcept{
+        return built_table(target) != nullptr && cpu_runs(target);
+    }
+
+    std::vector<isa> available(){
+        std::vector<isa> targets;
+        for (const isa target : all_isas){
+            if (supported(target)){
+                targets.push_back(target);
+            }
+        }
+        return targets;
+    }
+
+    isa detected() noexcept{
+        isa best = isa::scalar;
+        for (const isa target : all_isas){
+            if (supported(target)){
+                best = target;
+            }
+        }
+        return best;
+    }
+
+    const detail::kernel_table& detail::active_table() noexcept{
+
+        const kernel_table* table = active_table_.load(std::memory_order_acquire);
+        if (table == nullptr){
+            // Racing first calls pick the same table; a concurrent select() wins over the initial choice
+            const kernel_table* initial = initial_table();
+            if (active_table_.compare_exchange_strong(table, initial, std::memory_order_acq_rel)){
+                table = initial;
+            }
+        }
+        return *table;
+    }
+
+    isa active() noexcept{
+        return detail::active_table().target;
+    }
+
+    bool select(isa target) noexcept{
+        if (!supported(target)){
+            return false;
+        }
+        active_table_.store(built_table(target), std::memory_order_release);
+        return true;
+    }
+}
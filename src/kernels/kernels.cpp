@@ -0,0 +1,37 @@
+/*
+    Kernel table of one instruction set. This file is compiled once per instruction set, with the matching -m
+    flags and YADQ_KERNELS_TARGET naming the table (see CMakeLists.txt). The kernels it instantiates live in the
+    yadq::simd inline namespace of that instruction set, so the copies never collide at link time; nothing else
+    is used here, to keep wide instructions out of the functions shared with the rest of the program.
+*/
+#include <yadq/dispatch.hpp>
+
+#ifndef YADQ_KERNELS_TARGET
+    #error "YADQ_KERNELS_TARGET must name the instruction set of this translation unit"
+#endif
+
+namespace yadq::dispatch::detail{
+
+    namespace {
+
+        template<typename T>
+        constexpr kernels<T> make_kernels() noexcept{
+            return {
+                &simd::multiply<T>,
+                &simd::normalise<T>,
+                &simd::transform_points<T>,
+                &simd::transform_points_interleaved<T>,
+                &simd::quat_to_matrix<T>,
+                &simd::matrix_to_quat<T>
+            };
+        }
+    }
+
+    namespace YADQ_KERNELS_TARGET{
+
+        const kernel_table* table() noexcept{
+            static constexpr kernel_table t{isa::YADQ_KERNELS_TARGET, make_kernels<float>(), make_kernels<double>()};
+            return &t;
+        }
+    }
+}
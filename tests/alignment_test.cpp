@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/rotation_map.hpp>
+#include <yadq/point_cloud.hpp>
+#include <yadq/alignment.hpp>
+
+namespace {
+
+    // Rotation angle between two unitary quaternions, robust for nearly equal inputs
+    template<typename Q1, typename Q2>
+    double rotation_distance(const Q1& q1, const Q2& q2){
+        double diff = 0, sum = 0;
+        const double a[4] = {q1.w(), q1.x(), q1.y(), q1.z()};
+        const double b[4] = {q2.w(), q2.x(), q2.y(), q2.z()};
+        for (int i = 0; i < 4; ++i){
+            diff += (a[i] - b[i]) * (a[i] - b[i]);
+            sum += (a[i] + b[i]) * (a[i] + b[i]);
+        }
+        return 4 * std::atan2(std::sqrt(std::min(diff, sum)), std::sqrt(std::max(diff, sum)));
+    }
+
+    template<typename T>
+    struct cloud{
+        std::vector<T> x, y, z;
+
+        explicit cloud(std::size_t n): x(n), y(n), z(n){}
+
+        yadq::point_lanes<const T> lanes() const{
+            return {x.data(), y.data(), z.data()};
+        }
+
+        std::array<T, 3> get(std::size_t i) const{
+            return {x[i], y[i], z[i]};
+        }
+
+        void set(std::size_t i, const std::array<T, 3>& p){
+            x[i] = p[0];
+            y[i] = p[1];
+            z[i] = p[2];
+        }
+    };
+
+    const yadq::quaternionU<double> rotation(yadq::exp_map(std::array<double, 3>{0.4, -1.1, 2.3}));
+    const std::array<double, 3> translation = {12.5, -3.25, 40};
+
+    // Points spread over a few tens of metres around a large offset, as georeferenced data
+    template<typename T>
+    cloud<T> random_cloud(std::size_t n, T offset, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-20, 20);
+
+        cloud<T> c(n);
+        for (std::size_t i = 0; i < n; ++i){
+            c.set(i, {offset + dist(gen), -offset + dist(gen), T(0.5) * dist(gen)});
+        }
+        return c;
+    }
+
+    // target_i = scale R source_i + t, plus gaussian noise
+    template<typename T>
+    cloud<T> transformed(const cloud<T>& source, double scale, double noise, unsigned seed){
+        std::mt19937 gen(seed);
+        std::normal_distribution<double> dist(0, noise);
+
+        cloud<T> target(source.x.size());
+        for (std::size_t i = 0; i < source.x.size(); ++i){
+            const auto p = source.get(i);
+            const auto v = yadq::rotate(rotation, std::array<double, 3>{p[0], p[1], p[2]});
+            target.set(i, { T(scale * v[0] + translation[0] + (noise > 0 ? dist(gen) : 0)),
+                            T(scale * v[1] + translation[1] + (noise > 0 ? dist(gen) : 0)),
+                            T(scale * v[2] + translation[2] + (noise > 0 ? dist(gen) : 0))});
+        }
+        return target;
+    }
+
+    // A smooth trajectory of n poses
+    std::vector<yadq::dualquaternion<double>> trajectory(std::size_t n){
+        std::vector<yadq::dualquaternion<double>> poses;
+        for (std::size_t i = 0; i < n; ++i){
+            const double s = 0.05 * double(i);
+            const yadq::quaternionU<double> q(yadq::exp_map(std::array<double, 3>{0.1 * std::sin(s), 0.2 * std::cos(s), s}));
+            poses.emplace_back(q, std::array<double, 3>{10 * std::cos(s), 10 * std::sin(s), 0.1 * s});
+        }
+        return poses;
+    }
+}
+
+TEST(Alignment, RecoversRigid) {
+
+    const auto source = random_cloud<double>(1000, 1e6, 1);
+    const auto target = transformed(source, 1, 0, 2);
+
+    const auto a = yadq::align<double>(source.lanes(), target.lanes(), 1000);
+
+    EXPECT_LT(rotation_distance(a.rotation, rotation), 1e-9);
+    EXPECT_EQ(a.scale, 1.0);
+    for (std::size_t j = 0; j < 3; ++j){
+        EXPECT_NEAR(a.translation[j], translation[j], 1e-6 * 1e6);
+    }
+    EXPECT_LT(a.rmse, 1e-6);
+
+    // The transformation itself maps every point onto its target
+    const auto p = a.apply(source.get(10));
+    EXPECT_NEAR(p[0], target.x[10], 1e-6);
+    EXPECT_NEAR(p[1], target.y[10], 1e-6);
+    EXPECT_NEAR(p[2], target.z[10], 1e-6);
+
+    const auto ate = yadq::absolute_trajectory_error(a, source.lanes(), target.lanes(), 1000);
+    EXPECT_EQ(ate.count, 1000u);
+    EXPECT_LT(ate.max, 1e-6);
+
+    const auto pose = a.pose();
+    const auto q = yadq::transform(pose, source.get(10));
+    EXPECT_NEAR(q[0], target.x[10], 1e-6);
+}
+
+TEST(Alignment, Similarity) {
+
+    constexpr std::size_t n = 5000;
+    constexpr double noise = 0.01;
+
+    const auto source = random_cloud<double>(n, 100, 3);
+    const auto target = transformed(source, 2.5, noise, 4);
+
+    const auto a = yadq::align<double>(source.lanes(), target.lanes(), n, yadq::alignment_model::similarity);
+    EXPECT_NEAR(a.scale, 2.5, 1e-4);
+    EXPECT_LT(rotation_distance(a.rotation, rotation), 1e-4);
+
+    // Residuals are the isotropic noise: rmse close to sqrt(3) sigma, the same from the moments and from the points
+    const auto ate = yadq::absolute_trajectory_error(a, source.lanes(), target.lanes(), n);
+    EXPECT_NEAR(ate.rmse, std::sqrt(3.0) * noise, 0.05 * noise);
+    EXPECT_NEAR(a.rmse, ate.rmse, 1e-9);
+    EXPECT_LE(ate.mean, ate.rmse);
+    EXPECT_GE(ate.max, ate.rmse);
+
+    // Without a scale, the same data cannot be aligned
+    const auto rigid = yadq::align<double>(source.lanes(), target.lanes(), n);
+    EXPECT_EQ(rigid.scale, 1.0);
+    EXPECT_LT(rotation_distance(rigid.rotation, rotation), 1e-3);
+    EXPECT_GT(rigid.rmse, 1.0);
+}
+
+TEST(Alignment, StreamingAndThreads) {
+
+    constexpr std::size_t n = 100000;
+
+    const auto source = random_cloud<double>(n, 1e5, 5);
+    const auto target = transformed(source, 1, 0.05, 6);
+
+    yadq::alignment_accumulator<double> one_by_one;
+    for (std::size_t i = 0; i < n; ++i){
+        one_by_one.add(source.get(i), target.get(i));
+    }
+
+    yadq::alignment_accumulator<double> batch;
+    batch.add(source.lanes(), target.lanes(), n);
+
+    yadq::alignment_accumulator<double> threaded;
+    threaded.add(source.lanes(), target.lanes(), n, {4, 1000});
+
+    // Two halves, accumulated separately and merged
+    const std::size_t h = n / 3;
+    const auto s = source.lanes();
+    const auto t = target.lanes();
+    yadq::alignment_accumulator<double> first, second;
+    first.add(s, t, h);
+    second.add({s.x + h, s.y + h, s.z + h}, {t.x + h, t.y + h, t.z + h}, n - h, {3, 100});
+    first += second;
+
+    const auto reference = batch.solve();
+
+    for (const auto* acc : {&one_by_one, &threaded, &first}){
+        EXPECT_EQ(acc->count(), n);
+        const auto a = acc->solve();
+        EXPECT_LT(rotation_distance(a.rotation, reference.rotation), 1e-12);
+        for (std::size_t j = 0; j < 3; ++j){
+            EXPECT_NEAR(a.translation[j], reference.translation[j], 1e-7);
+        }
+        EXPECT_NEAR(a.rmse, reference.rmse, 1e-9);
+    }
+
+    const auto ate = yadq::absolute_trajectory_error(reference, source.lanes(), target.lanes(), n);
+    const auto ate_threaded = yadq::absolute_trajectory_error(reference, source.lanes(), target.lanes(), n, {4, 1000});
+    EXPECT_NEAR(ate.rmse, ate_threaded.rmse, 1e-12);
+    EXPECT_EQ(ate.max, ate_threaded.max);
+
+    batch.clear();
+    EXPECT_EQ(batch.count(), 0u);
+}
+
+TEST(Alignment, Float) {
+
+    constexpr std::size_t n = 20000;
+
+    // Offsets larger than the float precision of the spread would allow without the per-chunk shift
+    const auto source = random_cloud<float>(n, 1000, 7);
+    const auto target = transformed(source, 1, 0, 8);
+
+    const auto a = yadq::align<float>(source.lanes(), target.lanes(), n, yadq::alignment_model::rigid, {2, 1000});
+    EXPECT_LT(rotation_distance(a.rotation, rotation), 1e-5);
+
+    const auto ate = yadq::absolute_trajectory_error(a, source.lanes(), target.lanes(), n);
+    EXPECT_LT(ate.rmse, 1e-2);
+}
+
+TEST(Alignment, Poses) {
+
+    constexpr std::size_t n = 500;
+
+    // The estimate is the ground truth seen from another frame
+    const auto truth = trajectory(n);
+    const yadq::dualquaternion<double> frame(rotation, translation);
+
+    std::vector<yadq::dualquaternion<double>> estimate;
+    for (const auto& p : truth){
+        estimate.push_back(frame * p);
+    }
+
+    const auto a = yadq::align(estimate.data(), truth.data(), n);
+    const auto expected = yadq::conjugate(frame);
+    EXPECT_LT(rotation_distance(a.rotation, expected.qr_), 1e-9);
+    // The rmse of the moments cancels out to about sqrt(epsilon) of the spread, the ATE pass is exact
+    EXPECT_LT(a.rmse, 1e-5);
+
+    const auto ate = yadq::absolute_trajectory_error(a, estimate.data(), truth.data(), n, {2, 100});
+    EXPECT_LT(ate.max, 1e-9);
+
+    // Relative motions do not depend on the frame
+    const auto rpe = yadq::relative_pose_error(estimate.data(), truth.data(), n, 10);
+    EXPECT_EQ(rpe.translation.count, n - 10);
+    EXPECT_LT(rpe.translation.max, 1e-9);
+    EXPECT_LT(rpe.rotation.max, 1e-9);
+
+    // One pose off by d: the motions into and out of it are off by |d|
+    const std::array<double, 3> d = {0.3, 0, -0.4};
+    estimate[100] = yadq::dualquaternion<double>(yadq::quaternionU<double>(), d) * estimate[100];
+
+    const auto off = yadq::relative_pose_error(estimate.data(), truth.data(), n, 1, {3, 50});
+    EXPECT_NEAR(off.translation.max, 0.5, 1e-9);
+    EXPECT_NEAR(off.translation.rmse, 0.5 * std::sqrt(2.0 / (n - 1)), 1e-9);
+    EXPECT_LT(off.rotation.max, 1e-9);
+}
+
+TEST(Alignment, ScaledPoses) {
+
+    constexpr std::size_t n = 300;
+    constexpr double scale = 0.4;
+
+    // A monocular estimate: the ground truth seen from another frame, at an unknown scale
+    const auto truth = trajectory(n);
+    const yadq::dualquaternion<double> frame(rotation, translation);
+
+    std::vector<yadq::dualquaternion<double>> estimate;
+    for (const auto& p : truth){
+        const auto t = p.translation();
+        estimate.push_back(frame * yadq::dualquaternion<double>(p.qr_, std::array<double, 3>{scale * t[0], scale * t[1], scale * t[2]}));
+    }
+
+    const auto a = yadq::align(estimate.data(), truth.data(), n, yadq::alignment_model::similarity);
+    EXPECT_NEAR(a.scale, 1 / scale, 1e-9);
+
+    // Without the scale, the motions differ by their length
+    const auto unscaled = yadq::relative_pose_error(estimate.data(), truth.data(), n, 10);
+    EXPECT_GT(unscaled.translation.max, 0.1);
+
+    const auto rpe = yadq::relative_pose_error(a, estimate.data(), truth.data(), n, 10, {2, 50});
+    EXPECT_EQ(rpe.translation.count, n - 10);
+    EXPECT_LT(rpe.translation.max, 1e-8);
+    EXPECT_LT(rpe.rotation.max, 1e-9);
+
+    // A rigid alignment has a unit scale and gives the plain RPE
+    const auto rigid = yadq::relative_pose_error(yadq::align(truth.data(), truth.data(), n), estimate.data(), truth.data(), n, 10);
+    EXPECT_EQ(rigid.translation.max, unscaled.translation.max);
+}
+
+TEST(Alignment, Errors) {
+
+    yadq::alignment_accumulator<double> empty;
+    EXPECT_THROW(empty.solve(), std::invalid_argument);
+
+    const auto source = random_cloud<double>(10, 0, 9);
+    EXPECT_THROW(yadq::align<double>(source.lanes(), source.lanes(), 0), std::invalid_argument);
+
+    yadq::alignment_accumulator<double> same;
+    same.add({1, 2, 3}, {0, 0, 0});
+    same.add({1, 2, 3}, {1, 1, 1});
+    EXPECT_NO_THROW(same.solve());
+    EXPECT_THROW(same.solve(yadq::alignment_model::similarity), std::invalid_argument);
+
+    const auto poses = trajectory(5);
+    EXPECT_THROW(yadq::relative_pose_error(poses.data(), poses.data(), 5, 0), std::invalid_argument);
+    EXPECT_THROW(yadq::relative_pose_error(poses.data(), poses.data(), 5, 5), std::invalid_argument);
+    EXPECT_NO_THROW(yadq::relative_pose_error(poses.data(), poses.data(), 5, 4));
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/codec.hpp>
+
+namespace {
+
+    template<typename T>
+    std::vector<yadq::quaternionU<T>> random_rotations(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::normal_distribution<T> dist(0, 1);
+
+        std::vector<yadq::quaternionU<T>> v;
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+        }
+
+        // Ties between the largest components, sign flips and tiny components
+        v.emplace_back(1, 0, 0, 0);
+        v.emplace_back(-1, 0, 0, 0);
+        v.emplace_back(0, 0, 0, -1);
+        v.emplace_back(0.5, -0.5, 0.5, -0.5);
+        v.emplace_back(0, 1, -1, 0);
+        v.emplace_back(1, 1e-7, -1e-6, 1e-5);
+        return v;
+    }
+
+    // Rotation angle between two unitary quaternions, q and -q being the same rotation. The atan2 form stays
+    // accurate for tiny angles, where acos of the dot product does not.
+    template<typename Q1, typename Q2>
+    double angle_between(const Q1& q1, const Q2& q2){
+        const double a[4] = {q1.w(), q1.x(), q1.y(), q1.z()};
+        const double b[4] = {q2.w(), q2.x(), q2.y(), q2.z()};
+        const double s = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0 ? -1.0 : 1.0;
+
+        double diff = 0, sum = 0;
+        for (int k = 0; k < 4; ++k){
+            diff += (a[k] - s * b[k]) * (a[k] - s * b[k]);
+            sum += (a[k] + s * b[k]) * (a[k] + s * b[k]);
+        }
+        return 4.0 * std::atan2(std::sqrt(diff), std::sqrt(sum));
+    }
+
+    template<typename Codec, typename T>
+    void check_error_bound(){
+        const auto q = random_rotations<T>(20000, 11);
+
+        double max_error = 0;
+        for (const auto& qi : q){
+            const auto r = Codec::template decode<T>(Codec::encode(qi));
+            max_error = std::max(max_error, angle_between(qi, r));
+        }
+
+        EXPECT_LE(max_error, Codec::max_angle_error);
+        // The bound is not vacuous
+        EXPECT_GE(max_error, Codec::max_angle_error / 20);
+    }
+
+    template<typename Codec, typename T>
+    void check_batch(){
+        const auto q = random_rotations<T>(1003, 5);
+        const yadq::quaternion_batch<T> batch(q.begin(), q.end());
+
+        const auto encoded = yadq::encode<Codec>(batch);
+        ASSERT_EQ(encoded.size(), q.size());
+
+        for (std::size_t i = 0; i < q.size(); ++i){
+            EXPECT_EQ(encoded[i], Codec::encode(q[i])) << "quaternion " << i;
+        }
+
+        yadq::quaternion_batch<T> decoded;
+        yadq::decode<Codec>(encoded.data(), encoded.size(), decoded);
+        ASSERT_EQ(decoded.size(), q.size());
+
+        for (std::size_t i = 0; i < q.size(); ++i){
+            const auto s = Codec::template decode<T>(encoded[i]);
+            const auto b = decoded.get(i);
+            EXPECT_NEAR(b.w(), s.w(), 1e-6);
+            EXPECT_NEAR(b.x(), s.x(), 1e-6);
+            EXPECT_NEAR(b.y(), s.y(), 1e-6);
+            EXPECT_NEAR(b.z(), s.z(), 1e-6);
+        }
+    }
+}
+
+TEST(Codec, StorageSize) {
+    EXPECT_EQ(sizeof(yadq::smallest_three_32::storage_type), 4u);
+    EXPECT_EQ(sizeof(yadq::smallest_three_48::storage_type), 6u);
+    EXPECT_EQ(sizeof(yadq::smallest_three_64::storage_type), 8u);
+    EXPECT_EQ(sizeof(yadq::half_64::storage_type), 8u);
+}
+
+TEST(Codec, ErrorBound) {
+    check_error_bound<yadq::smallest_three_32, double>();
+    check_error_bound<yadq::smallest_three_48, double>();
+    check_error_bound<yadq::smallest_three_64, double>();
+    check_error_bound<yadq::half_64, double>();
+
+    check_error_bound<yadq::smallest_three_32, float>();
+    check_error_bound<yadq::smallest_three_48, float>();
+    check_error_bound<yadq::half_64, float>();
+}
+
+TEST(Codec, HalfConversion) {
+    EXPECT_EQ(yadq::detail::float_to_half(1.0f), 0x3c00);
+    EXPECT_EQ(yadq::detail::float_to_half(-2.0f), 0xc000);
+    EXPECT_EQ(yadq::detail::float_to_half(0.0f), 0x0000);
+    EXPECT_EQ(yadq::detail::float_to_half(-0.0f), 0x8000);
+    EXPECT_EQ(yadq::detail::float_to_half(65504.0f), 0x7bff);
+    EXPECT_EQ(yadq::detail::float_to_half(1e6f), 0x7c00);
+    EXPECT_EQ(yadq::detail::float_to_half(5.9604645e-8f), 0x0001);
+    // 1 + 2^-11 is a tie between 1 and 1 + 2^-10: rounds to the even mantissa
+    EXPECT_EQ(yadq::detail::float_to_half(1.00048828125f), 0x3c00);
+    EXPECT_EQ(yadq::detail::float_to_half(1.00146484375f), 0x3c02);
+
+    // Every finite half survives a round trip through float
+    for (std::uint32_t h = 0; h < 0x10000; ++h){
+        if ((h & 0x7c00) == 0x7c00){
+            continue;
+        }
+        const float f = yadq::detail::half_to_float(static_cast<std::uint16_t>(h));
+        EXPECT_EQ(yadq::detail::float_to_half(f), h);
+    }
+
+    std::vector<float> in(1003), back(1003);
+    std::vector<std::uint16_t> out(1003);
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-2, 2);
+    std::generate(in.begin(), in.end(), [&](){ return dist(gen); });
+
+    yadq::simd::float_to_half<1003>(in.data(), out.data());
+    yadq::simd::half_to_float<1003>(out.data(), back.data());
+
+    for (std::size_t i = 0; i < in.size(); ++i){
+        EXPECT_EQ(out[i], yadq::detail::float_to_half(in[i]));
+        EXPECT_EQ(back[i], yadq::detail::half_to_float(out[i]));
+    }
+}
+
+TEST(Codec, Batch) {
+    check_batch<yadq::smallest_three_32, float>();
+    check_batch<yadq::smallest_three_48, double>();
+    check_batch<yadq::smallest_three_64, double>();
+    check_batch<yadq::half_64, float>();
+    check_batch<yadq::half_64, double>();
+}
+
+TEST(Codec, CompressedTrajectory) {
+    const auto q = random_rotations<double>(300, 9);
+
+    yadq::compressed_trajectory<double, yadq::smallest_three_32> traj(q.begin(), q.end());
+    ASSERT_EQ(traj.size(), q.size());
+    EXPECT_EQ(traj.bytes(), 4 * q.size());
+
+    for (std::size_t i = 0; i < q.size(); ++i){
+        EXPECT_LE(angle_between(traj[i], q[i]), yadq::smallest_three_32::max_angle_error);
+    }
+
+    std::size_t count = 0;
+    for (const auto& qi : traj){
+        EXPECT_EQ(qi.w(), traj[count].w());
+        ++count;
+    }
+    EXPECT_EQ(count, q.size());
+    EXPECT_EQ(traj.end() - traj.begin(), static_cast<std::ptrdiff_t>(q.size()));
+
+    yadq::quaternion_batch<double> range;
+    traj.decode(100, 50, range);
+    ASSERT_EQ(range.size(), 50u);
+    for (std::size_t i = 0; i < 50; ++i){
+        EXPECT_LE(angle_between(range.get(i), q[100 + i]), yadq::smallest_three_32::max_angle_error);
+    }
+
+    EXPECT_THROW(traj.decode(290, 20, range), std::out_of_range);
+    EXPECT_THROW(traj.at(q.size()), std::out_of_range);
+
+    // Bulk construction gives the same encoding as element-wise appends
+    const yadq::quaternion_batch<double> batch(q.begin(), q.end());
+    yadq::compressed_trajectory<double, yadq::smallest_three_32> bulk(batch);
+    ASSERT_EQ(bulk.size(), traj.size());
+    EXPECT_TRUE(std::equal(bulk.data(), bulk.data() + bulk.size(), traj.data()));
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+
+#if YADQ_HAS_CONSTEXPR_MATH
+
+namespace {
+
+    constexpr double tolerance = 1e-12;
+
+    constexpr double abs(double x){
+        return x < 0 ? -x : x;
+    }
+
+    constexpr bool near(double a, double b, double tol = tolerance){
+        return abs(a - b) <= tol;
+    }
+
+    template<typename Q1, typename Q2>
+    constexpr bool near_q(const Q1& q1, const Q2& q2, double tol = tolerance){
+        return near(q1.w(), q2.w(), tol) && near(q1.x(), q2.x(), tol) && near(q1.y(), q2.y(), tol) && near(q1.z(), q2.z(), tol);
+    }
+
+    // q and -q describe the same rotation
+    template<typename Q1, typename Q2>
+    constexpr bool same_rotation(const Q1& q1, const Q2& q2, double tol = tolerance){
+        return near_q(q1, q2, tol) || near_q(q1, q2 * -1.0, tol);
+    }
+
+    constexpr double pi = 3.14159265358979323846;
+
+    // Cube symmetry group: identity, 9 face rotations, 6 edge rotations and 8 vertex rotations
+    constexpr std::array<yadq::quaternionU<double>, 24> cube_group(){
+
+        std::array<yadq::quaternionU<double>, 24> g{};
+        std::size_t n = 1;
+
+        const std::array<std::array<double, 3>, 3> faces = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+        for (const auto& a : faces){
+            for (int k = 1; k <= 3; ++k){
+                g[n++] = yadq::quaternionU<double>(a, k * pi / 2);
+            }
+        }
+
+        const std::array<std::array<double, 3>, 6> edges = {{{1, 1, 0}, {1, -1, 0}, {1, 0, 1}, {1, 0, -1}, {0, 1, 1}, {0, 1, -1}}};
+        for (const auto& a : edges){
+            g[n++] = yadq::quaternionU<double>(a, pi);
+        }
+
+        const std::array<std::array<double, 3>, 4> vertices = {{{1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {-1, 1, 1}}};
+        for (const auto& a : vertices){
+            g[n++] = yadq::quaternionU<double>(a, 2 * pi / 3);
+            g[n++] = yadq::quaternionU<double>(a, 4 * pi / 3);
+        }
+
+        return g;
+    }
+
+    constexpr auto cube = cube_group();
+
+    constexpr bool cube_group_is_closed(){
+        for (const auto& a : cube){
+            for (const auto& b : cube){
+                const auto c = a * b;
+                bool found = false;
+                for (const auto& e : cube){
+                    found = found || same_rotation(c, e, 1e-9);
+                }
+                if (!found){
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Sensor-to-body extrinsic baked at compile time
+    constexpr yadq::quaternionU<double> q_sensor({0, 0, 1}, pi / 2);
+    constexpr yadq::quaternionU<double> q_mount(0.5, 0.5, 0.5, 0.5);
+}
+
+TEST(Constexpr, Math) {
+
+    static_assert(near(yadq::math::sqrt(2.0), 1.4142135623730951));
+    static_assert(near(yadq::math::sqrt(1e-8), 1e-4, 1e-19));
+    static_assert(yadq::math::sqrt(0.0) == 0.0);
+    static_assert(near(yadq::math::sin(pi / 6), 0.5));
+    static_assert(near(yadq::math::cos(pi / 3), 0.5));
+    static_assert(near(yadq::math::sin(-7.0), -0.6569865987187891));
+    static_assert(near(yadq::math::cos(10.0), -0.8390715290764524));
+
+    // Runtime calls go through <cmath>
+    volatile double x = 2.0;
+    EXPECT_EQ(yadq::math::sqrt(static_cast<double>(x)), std::sqrt(2.0));
+    EXPECT_EQ(yadq::math::sin(static_cast<double>(x)), std::sin(2.0));
+}
+
+TEST(Constexpr, Constructors) {
+
+    constexpr yadq::quaternion<double> q(1, 2, 3, 4);
+    constexpr yadq::quaternionU<double> qU(1, 1, 1, 1);
+    constexpr yadq::quaternionU<float> qUf(0, 3, 0, 4);
+
+    static_assert(q.w() == 1 && q.z() == 4);
+    static_assert(near(qU.w(), 0.5) && near(qU.x(), 0.5));
+    static_assert(near(qUf.y(), 0.0) && near(qUf.x(), 0.6, 1e-7) && near(qUf.z(), 0.8, 1e-7));
+    static_assert(near(q_sensor.w(), 0.7071067811865476) && near(q_sensor.z(), 0.7071067811865476));
+    static_assert(near(q.norm(), 5.477225575051661));
+
+    EXPECT_NEAR(q_sensor.z(), std::sin(pi / 4), 1e-15);
+}
+
+TEST(Constexpr, Operations) {
+
+    constexpr auto q_prod = q_sensor * q_mount;
+    constexpr auto q_conj = conjugate(q_mount);
+    constexpr auto q_inv = inverse(q_sensor);
+    constexpr auto q_id = q_sensor * inverse(q_sensor);
+
+    static_assert(near(q_conj.w(), 0.5) && near(q_conj.x(), -0.5) && near(q_conj.y(), -0.5) && near(q_conj.z(), -0.5));
+    static_assert(near(q_inv.w(), q_sensor.w()) && near(q_inv.z(), -q_sensor.z()));
+    static_assert(near_q(q_id, yadq::quaternionU<double>(1, 0, 0, 0)));
+
+    constexpr auto R = quatToRotation(q_sensor);
+    static_assert(near(R[0], 0.0) && near(R[1], -1.0) && near(R[3], 1.0) && near(R[4], 0.0) && near(R[8], 1.0));
+
+    constexpr auto v = rotate(q_prod, std::array<double, 3>{1, 0, 0});
+    constexpr auto v_ref = rotate(q_sensor, rotate(q_mount, std::array<double, 3>{1, 0, 0}));
+    static_assert(near(v[0], v_ref[0]) && near(v[1], v_ref[1]) && near(v[2], v_ref[2]));
+
+    // Runtime results match the compile-time ones
+    const auto q_prod_rt = q_sensor * q_mount;
+    EXPECT_NEAR(q_prod_rt.w(), q_prod.w(), tolerance);
+    EXPECT_NEAR(q_prod_rt.x(), q_prod.x(), tolerance);
+    EXPECT_NEAR(q_prod_rt.y(), q_prod.y(), tolerance);
+    EXPECT_NEAR(q_prod_rt.z(), q_prod.z(), tolerance);
+}
+
+TEST(Constexpr, DualQuaternion) {
+
+    constexpr yadq::dualquaternion<double> dq(q_sensor, {1, 2, 3});
+    constexpr auto t = dq.translation();
+    constexpr auto p = transform(dq, std::array<double, 3>{1, 0, 0});
+
+    static_assert(near(t[0], 1) && near(t[1], 2) && near(t[2], 3));
+    static_assert(near(p[0], 1) && near(p[1], 3) && near(p[2], 3));
+
+    EXPECT_NEAR(p[1], 3.0, tolerance);
+}
+
+TEST(Constexpr, CubeGroup) {
+
+    static_assert(cube_group_is_closed(), "the cube symmetry table must be closed under composition");
+    static_assert(near_q(cube[0], yadq::quaternionU<double>(1, 0, 0, 0)));
+
+    for (const auto& q : cube){
+        EXPECT_NEAR(q.norm(), 1.0, tolerance);
+    }
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/rotation_batch.hpp>
+#include <yadq/point_cloud.hpp>
+#include <yadq/dispatch.hpp>
+
+// The AVX2+FMA and AVX-512 kernels may fuse multiply-adds: a few ULP of the magnitude of the operands
+#define EXPECT_KERNEL_NEAR(a, b, scale) EXPECT_NEAR((a), (b), 16 * std::numeric_limits<std::decay_t<decltype(a)>>::epsilon() * (scale))
+
+namespace {
+
+    using yadq::dispatch::isa;
+
+    template<typename T>
+    yadq::quaternion_batch<T> random_batch(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-2, 2);
+
+        std::vector<yadq::quaternion<T>> v;
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+        }
+        return yadq::quaternion_batch<T>(v.begin(), v.end());
+    }
+
+    template<typename T>
+    std::vector<T> random_points(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-10, 10);
+
+        std::vector<T> v(3 * n);
+        for (auto& c : v){
+            c = dist(gen);
+        }
+        return v;
+    }
+
+    template<typename T>
+    void expect_batch_near(const yadq::quaternion_batch<T>& a, const yadq::quaternion_batch<T>& b, T scale){
+        ASSERT_EQ(a.size(), b.size());
+        for (std::size_t i = 0; i < a.size(); ++i){
+            EXPECT_KERNEL_NEAR(a.w()[i], b.w()[i], scale);
+            EXPECT_KERNEL_NEAR(a.x()[i], b.x()[i], scale);
+            EXPECT_KERNEL_NEAR(a.y()[i], b.y()[i], scale);
+            EXPECT_KERNEL_NEAR(a.z()[i], b.z()[i], scale);
+        }
+    }
+
+    // Every dispatched function of the active table against the header-only one
+    template<typename T>
+    void check_active_kernels(){
+        // Not a multiple of any pack width, so that the padding and the scalar tails are exercised
+        constexpr std::size_t n = 103;
+
+        const auto l = random_batch<T>(n, 1);
+        const auto r = random_batch<T>(n, 2);
+
+        yadq::quaternion_batch<T> res;
+        yadq::dispatch::multiply(l, r, res);
+        expect_batch_near(res, yadq::multiply(l, r), T(16));
+
+        yadq::dispatch::normalise(l, res);
+        expect_batch_near(res, yadq::normalise(l), T(1));
+
+        const auto units = yadq::normalise(l);
+        std::vector<T> matrices(9 * n), expected_matrices(9 * n);
+        yadq::dispatch::quatToRotation(units, matrices.data(), yadq::matrix_shape::mat3x3, yadq::matrix_order::column_major);
+        yadq::quatToRotation(units, expected_matrices.data(), yadq::matrix_shape::mat3x3, yadq::matrix_order::column_major);
+        for (std::size_t i = 0; i < matrices.size(); ++i){
+            EXPECT_KERNEL_NEAR(matrices[i], expected_matrices[i], T(2));
+        }
+
+        yadq::quaternion_batch<T> back(n);
+        yadq::dispatch::rotationToQuat(expected_matrices.data(), back, yadq::matrix_shape::mat3x3, yadq::matrix_order::column_major);
+        yadq::quaternion_batch<T> expected_back(n);
+        yadq::rotationToQuat(expected_matrices.data(), expected_back, yadq::matrix_shape::mat3x3, yadq::matrix_order::column_major);
+        expect_batch_near(back, expected_back, T(2));
+
+        const yadq::quaternionU<T> q(units.get(0));
+        const auto points = random_points<T>(n, 3);
+        std::vector<T> out(3 * n), expected(3 * n);
+        yadq::dispatch::rotate(q, points.data(), out.data(), n);
+        yadq::rotate(q, points.data(), expected.data(), n);
+        for (std::size_t i = 0; i < out.size(); ++i){
+            EXPECT_KERNEL_NEAR(out[i], expected[i], T(40));
+        }
+
+        // Same points as separate lanes, from an offset so that the loads are unaligned
+        std::vector<T> x(n), y(n), z(n), ox(n), oy(n), oz(n);
+        for (std::size_t i = 0; i < n; ++i){
+            x[i] = points[3 * i];
+            y[i] = points[3 * i + 1];
+            z[i] = points[3 * i + 2];
+        }
+        yadq::dispatch::rotate(q, yadq::point_lanes<const T>{x.data() + 1, y.data() + 1, z.data() + 1}, yadq::point_lanes<T>{ox.data(), oy.data(), oz.data()}, n - 1);
+        for (std::size_t i = 0; i + 1 < n; ++i){
+            EXPECT_KERNEL_NEAR(ox[i], expected[3 * (i + 1)], T(40));
+            EXPECT_KERNEL_NEAR(oy[i], expected[3 * (i + 1) + 1], T(40));
+            EXPECT_KERNEL_NEAR(oz[i], expected[3 * (i + 1) + 2], T(40));
+        }
+
+        const yadq::dualquaternion<T> pose(q, std::array<T, 3>{1, -2, 3});
+        yadq::dispatch::transform(pose, points.data(), out.data(), n);
+        yadq::transform(pose, points.data(), expected.data(), n);
+        for (std::size_t i = 0; i < out.size(); ++i){
+            EXPECT_KERNEL_NEAR(out[i], expected[i], T(40));
+        }
+    }
+}
+
+// First test of the file: nothing has called select() yet
+TEST(Dispatch, EnvironmentOverride) {
+
+    const char* requested = std::getenv("YADQ_ISA");
+    const auto target = requested ? yadq::dispatch::parse(requested) : std::nullopt;
+
+    if (target && yadq::dispatch::supported(*target)){
+        EXPECT_EQ(yadq::dispatch::active(), *target);
+    }else{
+        EXPECT_EQ(yadq::dispatch::active(), yadq::dispatch::detected());
+    }
+}
+
+TEST(Dispatch, Names) {
+
+    for (const isa target : {isa::scalar, isa::sse2, isa::sse42, isa::avx2, isa::avx512}){
+        const auto parsed = yadq::dispatch::parse(yadq::dispatch::name(target));
+        ASSERT_TRUE(parsed.has_value());
+        EXPECT_EQ(*parsed, target);
+    }
+    EXPECT_FALSE(yadq::dispatch::parse("avx").has_value());
+    EXPECT_FALSE(yadq::dispatch::parse("").has_value());
+}
+
+TEST(Dispatch, Selection) {
+
+    const isa initial = yadq::dispatch::active();
+    const auto targets = yadq::dispatch::available();
+
+    ASSERT_FALSE(targets.empty());
+    EXPECT_EQ(targets.front(), isa::scalar);
+    EXPECT_EQ(targets.back(), yadq::dispatch::detected());
+
+    for (const isa target : {isa::scalar, isa::sse2, isa::sse42, isa::avx2, isa::avx512}){
+        const bool supported = yadq::dispatch::supported(target);
+        EXPECT_EQ(yadq::dispatch::select(target), supported);
+        if (supported){
+            EXPECT_EQ(yadq::dispatch::active(), target);
+        }
+    }
+
+    EXPECT_TRUE(yadq::dispatch::select(initial));
+    EXPECT_EQ(yadq::dispatch::active(), initial);
+}
+
+TEST(Dispatch, KernelsMatchHeaderOnly) {
+
+    const isa initial = yadq::dispatch::active();
+
+    for (const isa target : yadq::dispatch::available()){
+        SCOPED_TRACE(yadq::dispatch::name(target));
+        ASSERT_TRUE(yadq::dispatch::select(target));
+
+        check_active_kernels<float>();
+        check_active_kernels<double>();
+    }
+
+    yadq::dispatch::select(initial);
+}
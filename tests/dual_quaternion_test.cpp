@@ -1,9 +1,51 @@
 #include <gtest/gtest.h>
 #include <yadq/quaternion.hpp>
 #include <yadq/dual_quaternion.hpp>
+#include <yadq/point_cloud.hpp>
+#include <vector>
 
 #define TOLERANCE (1e-5)
 
+namespace {
+
+    using matrix4 = std::array<double, 16>;
+
+    // Homogeneous 4x4 reference of a rigid transformation, row-major
+    matrix4 to_matrix(const yadq::dualquaternion<double>& dq){
+        const auto R = yadq::quatToRotation(dq.qr_);
+        const auto t = dq.translation();
+
+        return {R[0], R[1], R[2], t[0],
+                R[3], R[4], R[5], t[1],
+                R[6], R[7], R[8], t[2],
+                0, 0, 0, 1};
+    }
+
+    matrix4 matmul(const matrix4& a, const matrix4& b){
+        matrix4 c{};
+        for (int i = 0; i < 4; ++i){
+            for (int j = 0; j < 4; ++j){
+                for (int k = 0; k < 4; ++k){
+                    c[4 * i + j] += a[4 * i + k] * b[4 * k + j];
+                }
+            }
+        }
+        return c;
+    }
+
+    std::array<double, 3> apply_matrix(const matrix4& m, const std::array<double, 3>& p){
+        return {m[0] * p[0] + m[1] * p[1] + m[2] * p[2] + m[3],
+                m[4] * p[0] + m[5] * p[1] + m[6] * p[2] + m[7],
+                m[8] * p[0] + m[9] * p[1] + m[10] * p[2] + m[11]};
+    }
+
+    void expect_matrix_near(const matrix4& a, const matrix4& b){
+        for (std::size_t i = 0; i < 16; ++i){
+            EXPECT_NEAR(a[i], b[i], TOLERANCE) << "entry " << i;
+        }
+    }
+}
+
 TEST(DualQuaternion, Constructor) {
   
     yadq::quaternionU<double> qr(0, 0.7071068, 0, 0.7071068);
@@ -56,3 +98,163 @@ TEST(DualQuaternion, Conjugate) {
     EXPECT_NEAR(dq_res.qd_.y(), -0.0, TOLERANCE);
     EXPECT_NEAR(dq_res.qd_.z(), 0.353553, TOLERANCE);
 }
+
+TEST(DualQuaternion, Translation) {
+
+    yadq::quaternionU<double> qr(0.3, -0.2, 0.9, 0.4);
+    yadq::dualquaternion<double> dq(qr, {1.5, -2, 0.25});
+
+    const auto t = translation(dq);
+
+    EXPECT_NEAR(t[0], 1.5, TOLERANCE);
+    EXPECT_NEAR(t[1], -2.0, TOLERANCE);
+    EXPECT_NEAR(t[2], 0.25, TOLERANCE);
+}
+
+TEST(DualQuaternion, ProductMatchesMatrix) {
+
+    yadq::dualquaternion<double> dq1(yadq::quaternionU<double>(0.3, -0.2, 0.9, 0.4), {1.5, -2, 0.25});
+    yadq::dualquaternion<double> dq2(yadq::quaternionU<double>(-0.7, 0.1, 0.2, 0.6), {-3, 0.5, 4});
+
+    expect_matrix_near(to_matrix(dq1 * dq2), matmul(to_matrix(dq1), to_matrix(dq2)));
+    expect_matrix_near(to_matrix(dq2 * dq1), matmul(to_matrix(dq2), to_matrix(dq1)));
+
+    // Pure rotation on either side
+    yadq::quaternionU<double> q(0.5, 0.5, -0.5, 0.5);
+    yadq::dualquaternion<double> dq_q(q, {0, 0, 0});
+
+    expect_matrix_near(to_matrix(q * dq1), matmul(to_matrix(dq_q), to_matrix(dq1)));
+    expect_matrix_near(to_matrix(dq1 * q), matmul(to_matrix(dq1), to_matrix(dq_q)));
+}
+
+TEST(DualQuaternion, TransformMatchesMatrix) {
+
+    yadq::dualquaternion<double> dq(yadq::quaternionU<double>(0.3, -0.2, 0.9, 0.4), {1.5, -2, 0.25});
+    std::array<double, 3> p = {0.7, -1.1, 2.3};
+
+    const auto p_ref = apply_matrix(to_matrix(dq), p);
+    const auto p_new = dq * p;
+
+    // Reference through the triple product dq (1 + e p) dq~
+    yadq::dualquaternion<double> dq_p(yadq::quaternionU<double>(1, 0, 0, 0), yadq::quaternion<double>(0, p[0], p[1], p[2]));
+    const auto dq_res = dq * dq_p * combined_conjugate(dq);
+
+    for (std::size_t i = 0; i < 3; ++i){
+        EXPECT_NEAR(p_new[i], p_ref[i], TOLERANCE);
+    }
+
+    EXPECT_NEAR(dq_res.qd_.x(), p_ref[0], TOLERANCE);
+    EXPECT_NEAR(dq_res.qd_.y(), p_ref[1], TOLERANCE);
+    EXPECT_NEAR(dq_res.qd_.z(), p_ref[2], TOLERANCE);
+}
+
+TEST(DualQuaternion, Inverse) {
+
+    yadq::dualquaternion<double> dq(yadq::quaternionU<double>(0.3, -0.2, 0.9, 0.4), {1.5, -2, 0.25});
+
+    const auto dq_id = dq * inverse(dq);
+    const matrix4 identity = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+    expect_matrix_near(to_matrix(dq_id), identity);
+    expect_matrix_near(to_matrix(inverse(dq)), to_matrix(conjugate(dq)));
+
+    EXPECT_NEAR(dq_id.qd_.w(), 0.0, TOLERANCE);
+    EXPECT_NEAR(dq_id.qd_.x(), 0.0, TOLERANCE);
+    EXPECT_NEAR(dq_id.qd_.y(), 0.0, TOLERANCE);
+    EXPECT_NEAR(dq_id.qd_.z(), 0.0, TOLERANCE);
+}
+
+TEST(DualQuaternion, Conjugates) {
+
+    yadq::quaternionU<double> qr(0.3, -0.2, 0.9, 0.4);
+    yadq::quaternion<double> qd(1, 2, 3, 4);
+    yadq::dualquaternion<double> dq(qr, qd);
+
+    const auto dq_dual = dual_conjugate(dq);
+    const auto dq_comb = combined_conjugate(dq);
+
+    EXPECT_NEAR(dq_dual.qr_.x(), qr.x(), TOLERANCE);
+    EXPECT_NEAR(dq_dual.qd_.w(), -1.0, TOLERANCE);
+    EXPECT_NEAR(dq_dual.qd_.z(), -4.0, TOLERANCE);
+
+    EXPECT_NEAR(dq_comb.qr_.w(), qr.w(), TOLERANCE);
+    EXPECT_NEAR(dq_comb.qr_.y(), -qr.y(), TOLERANCE);
+    EXPECT_NEAR(dq_comb.qd_.w(), -1.0, TOLERANCE);
+    EXPECT_NEAR(dq_comb.qd_.x(), 2.0, TOLERANCE);
+    EXPECT_NEAR(dq_comb.qd_.y(), 3.0, TOLERANCE);
+    EXPECT_NEAR(dq_comb.qd_.z(), 4.0, TOLERANCE);
+}
+
+TEST(DualQuaternion, Normalise) {
+
+    yadq::quaternionU<double> qr(0.3, -0.2, 0.9, 0.4);
+    yadq::dualquaternion<double> dq(qr, yadq::quaternion<double>(1, 2, 3, 4));
+
+    const auto dq_n = normalise(dq);
+
+    const double k = dq_n.qr_.w() * dq_n.qd_.w() + dq_n.qr_.x() * dq_n.qd_.x() + dq_n.qr_.y() * dq_n.qd_.y() + dq_n.qr_.z() * dq_n.qd_.z();
+    EXPECT_NEAR(k, 0.0, TOLERANCE);
+
+    // Already unit dual quaternions are left unchanged
+    yadq::dualquaternion<double> dq_u(qr, {1.5, -2, 0.25});
+    expect_matrix_near(to_matrix(normalise(dq_u)), to_matrix(dq_u));
+
+    const auto n = norm(dq_u);
+    EXPECT_NEAR(n.qr_.w(), 1.0, TOLERANCE);
+    EXPECT_NEAR(n.qd_.w(), 0.0, TOLERANCE);
+}
+
+TEST(DualQuaternion, Sum) {
+
+    // The default dual quaternion is the identity transformation
+    const yadq::dualquaternion<double> identity;
+    const auto t0 = identity.translation();
+    EXPECT_NEAR(identity.qr_.w(), 1.0, TOLERANCE);
+    EXPECT_NEAR(identity.qd_.w(), 0.0, TOLERANCE);
+    EXPECT_NEAR(t0[0] * t0[0] + t0[1] * t0[1] + t0[2] * t0[2], 0.0, TOLERANCE);
+
+    // Both parts are scaled alike: the sum of a pose with itself is the same pose
+    const yadq::quaternionU<double> qr(0.3, -0.2, 0.9, 0.4);
+    const yadq::dualquaternion<double> a(qr, {1.5, -2, 0.25});
+    expect_matrix_near(to_matrix(a + a), to_matrix(a));
+
+    // Blending two poses gives a unit dual quaternion: unit real part, dual part orthogonal to it
+    const yadq::dualquaternion<double> b(yadq::quaternionU<double>(0.8, 0.1, -0.5, 0.2), {-1, 3, 0.5});
+    const auto s = a + b;
+    EXPECT_NEAR(s.qr_.norm(), 1.0, TOLERANCE);
+    const double k = s.qr_.w() * s.qd_.w() + s.qr_.x() * s.qd_.x() + s.qr_.y() * s.qd_.y() + s.qr_.z() * s.qd_.z();
+    EXPECT_NEAR(k, 0.0, TOLERANCE);
+}
+
+TEST(DualQuaternion, TransformPointCloud) {
+
+    yadq::dualquaternion<double> dq(yadq::quaternionU<double>(0.3, -0.2, 0.9, 0.4), {1.5, -2, 0.25});
+
+    const std::size_t n = 37;
+    std::vector<double> points(3 * n), points_out(3 * n);
+    for (std::size_t i = 0; i < points.size(); ++i){
+        points[i] = 0.1 * static_cast<double>(i) - 5;
+    }
+
+    std::vector<double> xs(n), ys(n), zs(n);
+    for (std::size_t i = 0; i < n; ++i){
+        xs[i] = points[3 * i];
+        ys[i] = points[3 * i + 1];
+        zs[i] = points[3 * i + 2];
+    }
+
+    transform(dq, points.data(), points_out.data(), n);
+    transform(dq, yadq::point_lanes<double>{xs.data(), ys.data(), zs.data()}, yadq::point_lanes<double>{xs.data(), ys.data(), zs.data()}, n);
+
+    for (std::size_t i = 0; i < n; ++i){
+        const auto p_ref = transform(dq, std::array<double, 3>{points[3 * i], points[3 * i + 1], points[3 * i + 2]});
+
+        EXPECT_NEAR(points_out[3 * i], p_ref[0], TOLERANCE);
+        EXPECT_NEAR(points_out[3 * i + 1], p_ref[1], TOLERANCE);
+        EXPECT_NEAR(points_out[3 * i + 2], p_ref[2], TOLERANCE);
+
+        EXPECT_NEAR(xs[i], p_ref[0], TOLERANCE);
+        EXPECT_NEAR(ys[i], p_ref[1], TOLERANCE);
+        EXPECT_NEAR(zs[i], p_ref[2], TOLERANCE);
+    }
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <type_traits>
+#include <yadq/quaternion.hpp>
+#include <yadq/expression.hpp>
+
+namespace {
+
+    template<typename Q1, typename Q2>
+    void expect_near(const Q1& q1, const Q2& q2, double tol = 1e-15){
+        EXPECT_NEAR(q1.w(), q2.w(), tol);
+        EXPECT_NEAR(q1.x(), q2.x(), tol);
+        EXPECT_NEAR(q1.y(), q2.y(), tol);
+        EXPECT_NEAR(q1.z(), q2.z(), tol);
+    }
+
+    const yadq::quaternionU<double> u1(0.3, -0.5, 0.7, 0.2);
+    const yadq::quaternionU<double> u2({0.2, 0.3, 0.9}, 1.1);
+    const yadq::quaternionU<double> u3(-0.6, 0.1, 0.4, 0.5);
+    const yadq::quaternionU<double> u4({1, 0, 0}, -0.4);
+    const yadq::quaternion<double> p1(1.5, -0.5, 2.0, 0.25);
+    const yadq::quaternion<double> p2(-0.3, 0.8, 0.1, -1.2);
+
+    using yadq::expr;
+}
+
+TEST(Expression, Traits) {
+
+    using e_type = decltype(expr(u1) * u2);
+
+    static_assert(yadq::is_quaternion_expression_v<e_type>);
+    static_assert(!yadq::is_quaternion_expression_v<yadq::quaternionU<double>>);
+    static_assert(!yadq::is_base_of_quaternion_v<e_type>);
+    static_assert(!yadq::is_quaternion_v<e_type> && !yadq::is_quaternionU_v<e_type>);
+
+    // Result types follow the eager operators
+    static_assert(std::is_same_v<decltype(evaluate(expr(u1) * u2)), decltype(u1 * u2)>);
+    static_assert(std::is_same_v<decltype(evaluate(expr(u1) * p1)), decltype(u1 * p1)>);
+    static_assert(std::is_same_v<decltype(evaluate(expr(p1) + u1)), decltype(p1 + u1)>);
+    static_assert(std::is_same_v<decltype(evaluate(expr(u1) - p1)), decltype(u1 - p1)>);
+    static_assert(std::is_same_v<decltype(evaluate(expr(u1) * 2.0)), decltype(u1 * 2.0)>);
+
+    // Without expr() nothing changes
+    static_assert(std::is_same_v<decltype(u1 * u2), yadq::quaternionU<double>>);
+}
+
+TEST(Expression, MatchesEager) {
+
+    // The example chain: one normalisation instead of three
+    const yadq::quaternionU<double> r = expr(u1) * u2 * conjugate(u3) + u4;
+    expect_near(r, u1 * u2 * yadq::conjugate(u3) + u4);
+    EXPECT_NEAR(r.norm(), 1.0, 1e-15);
+
+    // Expressions on either side
+    expect_near(evaluate(u1 * (expr(u2) * u3)), u1 * (u2 * u3));
+    expect_near(evaluate(conjugate(expr(u1) * u2) * conjugate(expr(u3))), yadq::conjugate(u1 * u2) * yadq::conjugate(u3));
+    expect_near(evaluate((expr(u1) - u2) * u3), (u1 - u2) * u3);
+
+    // Plain quaternions keep their magnitude
+    expect_near(evaluate(expr(p1) * p2 + p1 * 0.5), p1 * p2 + p1 * 0.5, 1e-14);
+    expect_near(evaluate(2.0 * conjugate(expr(p1)) - p2), yadq::conjugate(p1) * 2.0 - p2, 1e-15);
+}
+
+TEST(Expression, PendingSums) {
+
+    // Unitary sums are normalised before they feed another sum, a scalar product or a mixed product...
+    expect_near(evaluate(expr(u1) + u2 + u3), u1 + u2 + u3);
+    expect_near(evaluate(expr(u1) + u2 - (expr(u3) + u4)), (u1 + u2) - (u3 + u4));
+    expect_near(evaluate((expr(u1) + u2) * 3.0), (u1 + u2) * 3.0, 1e-14);
+    expect_near(evaluate((expr(u1) + u2) * p1), (u1 + u2) * p1, 1e-14);
+
+    // ...but not before a unitary product, the final normalisation covers both
+    const auto r = evaluate((expr(u1) + u2) * (expr(u3) + u4) * u1);
+    expect_near(r, (u1 + u2) * (u3 + u4) * u1);
+    EXPECT_NEAR(r.norm(), 1.0, 1e-15);
+}
+
+TEST(Expression, Policies) {
+
+    using lazy_t = yadq::quaternionU<double, yadq::normalise_lazy>;
+    using periodic_t = yadq::quaternionU<double, yadq::normalise_periodic<4>>;
+
+    const lazy_t l1(u1.w(), u1.x(), u1.y(), u1.z()), l2(u2.w(), u2.x(), u2.y(), u2.z());
+    const lazy_t lr = expr(l1) * l2 * conjugate(l1);
+    static_assert(std::is_same_v<decltype(evaluate(expr(l1) * l2)), lazy_t>);
+    expect_near(lr, u1 * u2 * yadq::conjugate(u1));
+
+    const periodic_t p(u3.w(), u3.x(), u3.y(), u3.z());
+    const periodic_t pr = expr(p) * p * p * p * p;
+    expect_near(pr, u3 * u3 * u3 * u3 * u3, 1e-14);
+    EXPECT_NEAR(pr.norm(), 1.0, 1e-15);
+
+    // Single precision
+    const yadq::quaternionU<float> f1(0.3f, -0.5f, 0.7f, 0.2f), f2({0.2f, 0.3f, 0.9f}, 1.1f);
+    expect_near(evaluate(expr(f1) * f2 + f1), f1 * f2 + f1, 1e-6);
+}
+
+TEST(Expression, Lifetime) {
+
+    // Operands are copied: the expression stays valid once they are gone
+    const auto e = [](){
+        const yadq::quaternionU<double> a(0.1, 0.2, 0.3, 0.4), b({0, 0, 1}, 0.5);
+        return expr(a) * b;
+    }();
+
+    const yadq::quaternionU<double> a(0.1, 0.2, 0.3, 0.4), b({0, 0, 1}, 0.5);
+    expect_near(evaluate(e), a * b);
+}
+
+#if YADQ_HAS_CONSTEXPR_MATH
+
+TEST(Expression, Constexpr) {
+
+    constexpr yadq::quaternionU<double> a({0, 0, 1}, 0.5), b({1, 0, 0}, 0.25);
+    constexpr yadq::quaternionU<double> r = expr(a) * b * conjugate(a);
+    static_assert(r.w() > 0.99 && r.w() < 1.0);
+    expect_near(r, a * b * yadq::conjugate(a));
+}
+
+#endif
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/frame_graph.hpp>
+
+namespace {
+
+    using dq = yadq::dualquaternion<double>;
+    using point = std::array<double, 3>;
+
+    dq random_transform(std::mt19937& gen){
+        std::uniform_real_distribution<double> dist(-1, 1);
+        const yadq::quaternionU<double> r(dist(gen), dist(gen), dist(gen), dist(gen));
+        return dq(r, point{dist(gen), dist(gen), dist(gen)});
+    }
+
+    // Two transforms are compared through their action on a few points, which is sign-independent
+    void expect_same_transform(const dq& a, const dq& b, double tolerance = 1e-9){
+        const point points[3] = {{0, 0, 0}, {1, -2, 0.5}, {-0.3, 0.7, 2}};
+        for (const auto& p : points){
+            const point pa = yadq::transform(a, p);
+            const point pb = yadq::transform(b, p);
+            for (int i = 0; i < 3; ++i){
+                EXPECT_NEAR(pa[i], pb[i], tolerance);
+            }
+        }
+    }
+
+    // Reference root_T_frame recomposed from the edges
+    dq compose_path(const yadq::frame_graph<double>& g, std::size_t frame){
+        dq result;
+        std::vector<std::size_t> path;
+        for (std::size_t k = frame; k != g.root; k = g.parent(k)){
+            path.push_back(k);
+        }
+        for (auto it = path.rbegin(); it != path.rend(); ++it){
+            result = result * g.transform(*it);
+        }
+        return result;
+    }
+
+    // Random tree of n frames, each parent drawn among the previous frames
+    void build_tree(yadq::frame_graph<double>& g, std::size_t n, std::mt19937& gen){
+        for (std::size_t i = 1; i < n; ++i){
+            std::uniform_int_distribution<std::size_t> parent(0, i - 1);
+            g.add_frame(parent(gen), random_transform(gen));
+        }
+    }
+}
+
+TEST(FrameGraph, Structure) {
+    yadq::frame_graph<double> g;
+    const auto robot = g.add_frame(g.root, dq(), "robot");
+    const auto arm = g.add_frame(robot, dq(), "arm");
+    const auto camera = g.add_frame(arm, dq(), "camera");
+
+    EXPECT_EQ(g.size(), 4u);
+    EXPECT_EQ(g.parent(camera), arm);
+    EXPECT_EQ(g.parent(g.root), g.root);
+    EXPECT_EQ(g.depth(camera), 3u);
+    EXPECT_EQ(g.name(arm), "arm");
+    EXPECT_EQ(g.find("world"), g.root);
+    EXPECT_EQ(g.find("camera"), camera);
+    EXPECT_FALSE(g.find("lidar").has_value());
+
+    EXPECT_THROW(g.add_frame(42, dq()), std::out_of_range);
+    EXPECT_THROW(g.add_frame(g.root, dq(), "arm"), std::invalid_argument);
+    EXPECT_THROW(g.set_transform(g.root, dq()), std::invalid_argument);
+    EXPECT_THROW(g.world(42), std::out_of_range);
+    EXPECT_THROW(g.lookup(arm, 42), std::out_of_range);
+}
+
+TEST(FrameGraph, LookupMatchesComposition) {
+    std::mt19937 gen(3);
+    yadq::frame_graph<double> g;
+    build_tree(g, 64, gen);
+
+    for (std::size_t k = 0; k < g.size(); ++k){
+        expect_same_transform(g.world(k), compose_path(g, k));
+    }
+
+    // a_T_b maps coordinates in b to coordinates in a
+    for (std::size_t a = 0; a < g.size(); a += 7){
+        for (std::size_t b = 0; b < g.size(); b += 5){
+            const dq a_T_b = g.lookup(a, b);
+            expect_same_transform(compose_path(g, a) * a_T_b, compose_path(g, b));
+        }
+    }
+}
+
+TEST(FrameGraph, EdgeUpdatesInvalidateSubtree) {
+    std::mt19937 gen(5);
+    yadq::frame_graph<double> g;
+    build_tree(g, 200, gen);
+    g.refresh();
+
+    // Interleave edge changes and lookups, including frames added below stale ones
+    for (int step = 0; step < 100; ++step){
+        std::uniform_int_distribution<std::size_t> frame(1, g.size() - 1);
+        g.set_transform(frame(gen), random_transform(gen));
+        if (step % 10 == 0){
+            g.add_frame(frame(gen), random_transform(gen));
+        }
+
+        const std::size_t probe = frame(gen);
+        expect_same_transform(g.world(probe), compose_path(g, probe));
+    }
+
+    g.refresh();
+    for (std::size_t k = 0; k < g.size(); ++k){
+        expect_same_transform(g.world(k), compose_path(g, k));
+    }
+}
+
+TEST(FrameGraph, BatchLookup) {
+    std::mt19937 gen(7);
+    yadq::frame_graph<double> g;
+    build_tree(g, 50, gen);
+
+    std::vector<std::size_t> frames;
+    for (std::size_t k = 0; k < g.size(); k += 3){
+        frames.push_back(k);
+    }
+
+    // Stale target and sources are refreshed by the batch itself
+    g.set_transform(1, random_transform(gen));
+    g.set_transform(frames[5], random_transform(gen));
+
+    const std::size_t a = 17;
+    const auto out = g.lookup(a, frames);
+    ASSERT_EQ(out.size(), frames.size());
+    for (std::size_t i = 0; i < frames.size(); ++i){
+        expect_same_transform(out[i], g.lookup(a, frames[i]));
+    }
+
+    const std::size_t edges[2] = {4, 9};
+    const dq values[2] = {random_transform(gen), random_transform(gen)};
+    g.set_transforms(edges, values, 2);
+    expect_same_transform(g.transform(9), values[1]);
+    expect_same_transform(g.world(9), compose_path(g, 9));
+}
+
+TEST(FrameGraph, ConcurrentReadsAndUpdates) {
+    std::mt19937 gen(11);
+    yadq::frame_graph<double> g;
+
+    // A chain whose edges are all rotations about z: every composed transform stays a rotation about z, so
+    // readers can check invariants while writers keep changing edges
+    std::size_t last = g.root;
+    for (int i = 0; i < 20; ++i){
+        last = g.add_frame(last, dq(yadq::quaternionU<double>({0, 0, 1}, 0.1), point{0, 0, 0}));
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> failures{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r){
+        readers.emplace_back([&]{
+            while (!stop.load()){
+                const dq w = g.world(last);
+                const point p = yadq::transform(w, point{0, 0, 1});
+                if (std::abs(p[2] - 1) > 1e-9 || std::abs(p[0]) > 1e-9 || std::abs(p[1]) > 1e-9){
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    std::uniform_real_distribution<double> angle(-3, 3);
+    std::uniform_int_distribution<std::size_t> frame(1, last);
+    for (int i = 0; i < 2000; ++i){
+        g.set_transform(frame(gen), dq(yadq::quaternionU<double>({0, 0, 1}, angle(gen)), point{0, 0, 0}));
+    }
+    stop = true;
+    for (auto& t : readers){
+        t.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    expect_same_transform(g.world(last), compose_path(g, last));
+}
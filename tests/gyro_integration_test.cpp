@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/gyro_integration.hpp>
+
+namespace {
+
+    using scheme = yadq::integration_scheme;
+
+    // Rotation angle between two unitary quaternions, robust for nearly equal inputs
+    template<typename Q1, typename Q2>
+    double rotation_distance(const Q1& q1, const Q2& q2){
+        double diff = 0, sum = 0;
+        const double a[4] = {q1.w(), q1.x(), q1.y(), q1.z()};
+        const double b[4] = {q2.w(), q2.x(), q2.y(), q2.z()};
+        for (int i = 0; i < 4; ++i){
+            diff += (a[i] - b[i]) * (a[i] - b[i]);
+            sum += (a[i] + b[i]) * (a[i] + b[i]);
+        }
+        return 4 * std::atan2(std::sqrt(std::min(diff, sum)), std::sqrt(std::max(diff, sum)));
+    }
+
+    // Coning motion: the body spins about an axis which precesses, the rate is known in closed form
+    struct coning{
+        double a = 0.3, f = 5.0;
+
+        // Orientation q(t) = rz(f t) rx(a) rz(-f t)
+        yadq::quaternionU<double> orientation(double t) const{
+            const yadq::quaternionU<double> p({0, 0, 1}, f * t);
+            const yadq::quaternionU<double> r({1, 0, 0}, a);
+            const yadq::quaternionU<double> m({0, 0, 1}, -f * t);
+            return p * r * m;
+        }
+
+        // Body rate of q(t), 2 q* dq/dt by central differences of the closed form
+        std::array<double, 3> rate(double t) const{
+            const double h = 1e-6;
+            const auto q = orientation(t);
+            const auto q1 = orientation(t + h);
+            const auto q0 = orientation(t - h);
+            auto qc = q;
+            qc.conjugate();
+            const yadq::quaternion<double> dq((q1.w() - q0.w()) / (2 * h), (q1.x() - q0.x()) / (2 * h), (q1.y() - q0.y()) / (2 * h), (q1.z() - q0.z()) / (2 * h));
+            const auto w = yadq::quaternion<double>(qc.w(), qc.x(), qc.y(), qc.z()) * dq;
+            return {2 * w.x(), 2 * w.y(), 2 * w.z()};
+        }
+    };
+
+    std::array<double, 3> lerp(const std::array<double, 3>& a, const std::array<double, 3>& b, double t){
+        return {a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1]), a[2] + t * (b[2] - a[2])};
+    }
+
+    // Error after integrating the coning motion over 1 s with steps of dt. The reference solves the same
+    // problem, the rate being linear between samples, with 100 RK4 substeps per step.
+    double coning_error(scheme s, double dt){
+        const coning c;
+        const int steps = static_cast<int>(std::lround(1.0 / dt));
+        const int substeps = 100;
+
+        auto q = c.orientation(0);
+        auto q_ref = q;
+        auto omega0 = c.rate(0);
+        for (int k = 1; k <= steps; ++k){
+            const auto omega1 = c.rate(k * dt);
+            q = yadq::integrate(q, omega0, omega1, dt, s);
+
+            for (int j = 0; j < substeps; ++j){
+                q_ref = yadq::integrate(q_ref, lerp(omega0, omega1, double(j) / substeps), lerp(omega0, omega1, double(j + 1) / substeps), dt / substeps, scheme::rk4);
+            }
+            omega0 = omega1;
+        }
+        return rotation_distance(q, q_ref);
+    }
+}
+
+TEST(GyroIntegration, ConstantRate) {
+
+    const std::array<double, 3> omega = {0.7, -1.2, 2.0};
+    const yadq::quaternionU<double> q0(0.3, -0.2, 0.9, 0.4);
+    const double dt = 1e-3;
+
+    for (auto s : {scheme::exponential, scheme::magnus, scheme::rk4}){
+        auto q = q0;
+        for (int k = 0; k < 1000; ++k){
+            q = yadq::integrate(q, omega, omega, dt, s);
+        }
+
+        const auto ref = q0 * yadq::exp_map(std::array<double, 3>{omega[0], omega[1], omega[2]});
+        EXPECT_NEAR(rotation_distance(q, ref), 0.0, 1e-11);
+        EXPECT_NEAR(q.norm(), 1.0, 1e-14);
+    }
+
+    // One large step about a fixed axis is exact too, beyond the series of the exponential
+    const auto q = yadq::integrate(q0, omega, 2.0);
+    EXPECT_NEAR(rotation_distance(q, q0 * yadq::exp_map(std::array<double, 3>{1.4, -2.4, 4.0})), 0.0, 1e-14);
+}
+
+TEST(GyroIntegration, ConingAccuracy) {
+
+    // The coning correction gains two orders over the plain exponential, RK4 is on par with it
+    const double e_exp = coning_error(scheme::exponential, 1e-2);
+    const double e_magnus = coning_error(scheme::magnus, 1e-2);
+    const double e_rk4 = coning_error(scheme::rk4, 1e-2);
+
+    EXPECT_LT(e_magnus, e_exp / 1000);
+    EXPECT_LT(e_rk4, e_exp / 1000);
+
+    // Convergence orders: halving dt divides the error by about 4 (exponential) and 16 (magnus, rk4)
+    EXPECT_GT(e_exp / coning_error(scheme::exponential, 5e-3), 3.5);
+    EXPECT_GT(e_magnus / coning_error(scheme::magnus, 5e-3), 12.0);
+    EXPECT_GT(e_rk4 / coning_error(scheme::rk4, 5e-3), 12.0);
+}
+
+TEST(GyroIntegration, BatchMatchesScalar) {
+
+    // Odd size for the scalar tail, and a few lanes rotating by more than pi / 2 per step
+    const std::size_t n = 103;
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-1, 1);
+
+    std::vector<yadq::quaternionU<double>> q;
+    std::array<std::vector<double>, 3> w0, w1;
+    for (std::size_t i = 0; i < n; ++i){
+        q.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+        const double scale = (i % 17 == 5) ? 300.0 : 20.0;
+        for (std::size_t c = 0; c < 3; ++c){
+            w0[c].push_back(scale * dist(gen));
+            w1[c].push_back(scale * dist(gen));
+        }
+    }
+
+    const double dt = 1e-2;
+
+    for (auto s : {scheme::exponential, scheme::magnus, scheme::rk4}){
+        for (unsigned threads : {1u, 4u}){
+            yadq::quaternion_batch<double> batch(q.begin(), q.end());
+            yadq::integrate(batch, {w0[0].data(), w0[1].data(), w0[2].data()}, {w1[0].data(), w1[1].data(), w1[2].data()}, dt, s, {threads, 16});
+
+            for (std::size_t i = 0; i < n; ++i){
+                const auto ref = yadq::integrate(q[i], {w0[0][i], w0[1][i], w0[2][i]}, {w1[0][i], w1[1][i], w1[2][i]}, dt, s);
+                const auto b = batch.get(i);
+                EXPECT_NEAR(b.w(), ref.w(), 1e-13) << i;
+                EXPECT_NEAR(b.x(), ref.x(), 1e-13) << i;
+                EXPECT_NEAR(b.y(), ref.y(), 1e-13) << i;
+                EXPECT_NEAR(b.z(), ref.z(), 1e-13) << i;
+            }
+        }
+    }
+}
+
+TEST(GyroIntegration, Integrator) {
+
+    const coning c;
+    const double dt = 1e-3;
+    const std::size_t sensors = 37;
+
+    // Every sensor sees the same coning motion, started from different orientations
+    yadq::quaternion_batch<float> start(sensors);
+    std::vector<yadq::quaternionU<double>> offsets;
+    for (std::size_t i = 0; i < sensors; ++i){
+        offsets.emplace_back(std::array<double, 3>{1, 0.1 * i, 0}, 0.05 * i);
+        start.set(i, offsets.back());
+    }
+
+    yadq::gyro_integrator<float> integrator(start);
+    EXPECT_EQ(integrator.size(), sensors);
+    EXPECT_EQ(integrator.scheme(), scheme::magnus);
+
+    std::array<std::vector<float>, 3> omega;
+    for (auto& o : omega){
+        o.resize(sensors);
+    }
+
+    auto q_ref = offsets[0];
+    auto omega_prev = c.rate(0);
+
+    for (int k = 1; k <= 1000; ++k){
+        const auto r = c.rate(k * dt);
+        for (std::size_t i = 0; i < sensors; ++i){
+            for (std::size_t j = 0; j < 3; ++j){
+                omega[j][i] = static_cast<float>(r[j]);
+            }
+        }
+
+        integrator.update({omega[0].data(), omega[1].data(), omega[2].data()}, static_cast<float>(dt));
+
+        // The first update has no previous rate: constant rate over the step
+        q_ref = yadq::integrate(q_ref, k == 1 ? r : omega_prev, r, dt, scheme::magnus);
+        omega_prev = r;
+    }
+
+    // Single precision over 1000 steps
+    const auto q0 = integrator.orientations().get(0);
+    EXPECT_NEAR(rotation_distance(q0, q_ref), 0.0, 1e-4);
+
+    // q_i(t) = offset_i q_body(t) with q_body(t) = offset_0* q_0(t)
+    auto offset_inv = offsets[0];
+    offset_inv.conjugate();
+    for (std::size_t i = 0; i < sensors; ++i){
+        const auto expected = offsets[i] * (offset_inv * q_ref);
+        EXPECT_NEAR(rotation_distance(integrator.orientations().get(i), expected), 0.0, 1e-4) << i;
+    }
+}
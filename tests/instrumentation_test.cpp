@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/slerp.hpp>
+#include <yadq/instrumentation.hpp>
+
+// The suite runs in every configuration: with instrumentation disabled it checks that nothing is counted,
+// enabled (-DYADQ_INSTRUMENTATION or -DYADQ_INSTRUMENTATION_TIMERS) it checks the counts themselves.
+
+namespace {
+
+    namespace ins = yadq::instrumentation;
+    using ins::counter;
+    using ins::timer;
+
+    // Counters of the calling thread for the code run by f
+    template<typename F>
+    ins::snapshot measure(F&& f){
+        ins::reset();
+        f();
+        return ins::thread_snapshot();
+    }
+}
+
+TEST(Instrumentation, DisabledCountsNothing) {
+    if constexpr (ins::enabled){
+        GTEST_SKIP() << "instrumentation enabled";
+    }
+    const ins::snapshot s = measure([]{
+        const yadq::quaternionU<double> a(1, 2, 3, 4), b(4, 3, 2, 1);
+        volatile double w = (a * b).w();
+        static_cast<void>(w);
+    });
+    for (std::size_t i = 0; i < ins::counter_count; ++i){
+        EXPECT_EQ(s.counters[i], 0u);
+    }
+    EXPECT_EQ(ins::global_snapshot()[counter::hamilton_products], 0u);
+}
+
+TEST(Instrumentation, ConstructionsAndConversions) {
+    if constexpr (!ins::enabled){
+        GTEST_SKIP() << "instrumentation disabled";
+    }
+    const ins::snapshot built = measure([]{
+        const yadq::quaternion<double> q(1, 2, 3, 4);
+        volatile double w = q.w();
+        static_cast<void>(w);
+    });
+    EXPECT_EQ(built[counter::constructions], 1u);
+    EXPECT_EQ(built[counter::normalisations], 0u);
+    EXPECT_EQ(built[counter::conversions], 0u);
+
+    // Plain copies stay trivial, conversions to quaternionU are counted
+    const yadq::quaternion<double> q(1, 2, 3, 4);
+    const ins::snapshot converted = measure([&]{
+        const yadq::quaternion<double> c = q;
+        const yadq::quaternionU<double> u = c;
+        volatile double w = u.w();
+        static_cast<void>(w);
+    });
+    EXPECT_EQ(converted[counter::conversions], 1u);
+    EXPECT_EQ(converted[counter::constructions], 0u);
+    EXPECT_EQ(converted[counter::normalisations], 1u);
+
+    const ins::snapshot unit = measure([]{
+        const yadq::quaternionU<double> u(1, 2, 3, 4);
+        volatile double w = u.w();
+        static_cast<void>(w);
+    });
+    EXPECT_EQ(unit[counter::constructions], 1u);
+    EXPECT_GE(unit[counter::normalisations], 1u);
+}
+
+TEST(Instrumentation, ProductsAndNormalisations) {
+    if constexpr (!ins::enabled){
+        GTEST_SKIP() << "instrumentation disabled";
+    }
+    const yadq::quaternionU<double> a(1, 2, 3, 4), b(4, 3, 2, 1), c(0.5, -1, 2, 0.1);
+    const ins::snapshot eager = measure([&]{
+        const auto r = a * b * c;
+        volatile double w = r.w();
+        static_cast<void>(w);
+    });
+    EXPECT_EQ(eager[counter::hamilton_products], 2u);
+    EXPECT_GE(eager[counter::normalisations], 2u);
+
+    // The lazy policy only normalises when a component is observed
+    using lazy_t = yadq::quaternionU<double, yadq::normalise_lazy>;
+    const lazy_t la(1, 2, 3, 4), lb(4, 3, 2, 1), lc(0.5, -1, 2, 0.1);
+    const ins::snapshot deferred = measure([&]{
+        const auto r = la * lb * lc;
+        static_cast<void>(r);
+    });
+    EXPECT_EQ(deferred[counter::hamilton_products], 2u);
+    EXPECT_LT(deferred[counter::normalisations], eager[counter::normalisations]);
+}
+
+TEST(Instrumentation, SlerpPlanSamples) {
+    if constexpr (!ins::enabled){
+        GTEST_SKIP() << "instrumentation disabled";
+    }
+    const yadq::quaternionU<double> a({0.3, 0.1, -0.2}, 0.7), b({-0.6, 0.2, 0.4}, 2.0);
+    std::vector<double> t(100);
+    for (std::size_t i = 0; i < t.size(); ++i){
+        t[i] = double(i) / 99;
+    }
+
+    // The slerp weights keep the unit norm: samples are never renormalised, and only the exact mode calls sin()
+    for (auto mode : {yadq::slerp_mode::exact, yadq::slerp_mode::fast}){
+        const yadq::slerp_plan<double> plan(a, b, mode);
+        std::vector<yadq::quaternionU<double>> out(t.size());
+        const ins::snapshot s = measure([&]{
+            plan.evaluate(t.data(), out.data(), t.size());
+        });
+        EXPECT_EQ(s[counter::normalisations], 0u);
+        EXPECT_EQ(s[counter::trig_calls], mode == yadq::slerp_mode::exact ? 2 * t.size() : 0u);
+    }
+}
+
+TEST(Instrumentation, TrigAndAllocations) {
+    if constexpr (!ins::enabled){
+        GTEST_SKIP() << "instrumentation disabled";
+    }
+    const ins::snapshot axis_angle = measure([]{
+        const yadq::quaternionU<double> q({0.0, 0.0, 1.0}, 0.7);
+        volatile double w = q.w();
+        static_cast<void>(w);
+    });
+    EXPECT_EQ(axis_angle[counter::trig_calls], 4u);
+
+    const ins::snapshot batch = measure([]{
+        const yadq::quaternion_batch<float> b(100);
+        volatile std::size_t n = b.size();
+        static_cast<void>(n);
+    });
+    EXPECT_GE(batch[counter::allocations], 1u);
+}
+
+TEST(Instrumentation, Timers) {
+    if constexpr (!ins::timers_enabled){
+        GTEST_SKIP() << "timers disabled";
+    }
+    const yadq::quaternionU<double> a(1, 2, 3, 4), b(4, 3, 2, 1);
+    yadq::dualquaternion<double> d1(a, {1.0, 2.0, 3.0}), d2(b, {-1.0, 0.5, 0.0});
+    const ins::snapshot s = measure([&]{
+        volatile double w = yadq::interpolation(a, b, 0.3, yadq::InterpType::SLERP).w();
+        const auto m = yadq::quatToRotation(a);
+        w = m[0];
+        d1 *= d2;
+        d1 *= d2;
+        static_cast<void>(w);
+    });
+    EXPECT_EQ(s[timer::interpolation].calls, 1u);
+    EXPECT_EQ(s[timer::quat_to_rotation].calls, 1u);
+    EXPECT_EQ(s[timer::dual_product].calls, 2u);
+
+    std::ostringstream os;
+    os << s;
+    EXPECT_NE(os.str().find("quatToRotation: 1 calls"), std::string::npos);
+}
+
+TEST(Instrumentation, GlobalSnapshotSumsThreads) {
+    if constexpr (!ins::enabled){
+        GTEST_SKIP() << "instrumentation disabled";
+    }
+    ins::reset_all();
+    std::thread worker([]{
+        const yadq::quaternion<double> a(1, 2, 3, 4), b(4, 3, 2, 1);
+        for (int i = 0; i < 10; ++i){
+            volatile double w = (a * b).w();
+            static_cast<void>(w);
+        }
+    });
+    worker.join();
+
+    // The worker exited: its counts are kept, the calling thread's are not mixed in
+    EXPECT_EQ(ins::global_snapshot()[counter::hamilton_products], 10u);
+    EXPECT_EQ(ins::thread_snapshot()[counter::hamilton_products], 0u);
+
+    ins::reset_all();
+    EXPECT_EQ(ins::global_snapshot()[counter::hamilton_products], 0u);
+}
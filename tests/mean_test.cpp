@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+#include <yadq/rotation_map.hpp>
+#include <yadq/mean.hpp>
+
+namespace {
+
+    // Rotation angle between two unitary quaternions, robust for nearly equal inputs
+    template<typename Q1, typename Q2>
+    double rotation_distance(const Q1& q1, const Q2& q2){
+        double diff = 0, sum = 0;
+        const double a[4] = {q1.w(), q1.x(), q1.y(), q1.z()};
+        const double b[4] = {q2.w(), q2.x(), q2.y(), q2.z()};
+        for (int i = 0; i < 4; ++i){
+            diff += (a[i] - b[i]) * (a[i] - b[i]);
+            sum += (a[i] + b[i]) * (a[i] + b[i]);
+        }
+        return 4 * std::atan2(std::sqrt(std::min(diff, sum)), std::sqrt(std::max(diff, sum)));
+    }
+
+    const yadq::quaternionU<double> center(0.3, -0.5, 0.7, 0.2);
+
+    // Samples spread around center by rotation vectors of a few degrees, with random signs
+    std::vector<yadq::quaternionU<double>> noisy_samples(std::size_t n, double spread, unsigned seed){
+        std::mt19937 gen(seed);
+        std::normal_distribution<double> noise(0, spread);
+        std::bernoulli_distribution flip(0.5);
+
+        std::vector<yadq::quaternionU<double>> samples;
+        for (std::size_t i = 0; i < n; ++i){
+            const auto q = center * yadq::exp_map(std::array<double, 3>{noise(gen), noise(gen), noise(gen)});
+            samples.push_back(flip(gen) ? yadq::quaternionU<double>(-q.w(), -q.x(), -q.y(), -q.z()) : q);
+        }
+        return samples;
+    }
+
+    // Pairs of rotations by +-angle about three axes, symmetric about center: every mean is center
+    std::vector<yadq::quaternionU<double>> symmetric_samples(double angle){
+        std::vector<yadq::quaternionU<double>> samples;
+        const std::array<std::array<double, 3>, 3> axes = {{{1, 0, 0}, {0, 0.6, 0.8}, {0.48, -0.6, 0.64}}};
+        for (const auto& a : axes){
+            samples.push_back(center * yadq::exp_map(std::array<double, 3>{angle * a[0], angle * a[1], angle * a[2]}));
+            samples.push_back(center * yadq::exp_map(std::array<double, 3>{-angle * a[0], -angle * a[1], -angle * a[2]}));
+        }
+        return samples;
+    }
+}
+
+TEST(Mean, Symmetric) {
+
+    const auto samples = symmetric_samples(0.8);
+    const yadq::quaternion_batch<double> batch(samples.begin(), samples.end());
+
+    EXPECT_NEAR(rotation_distance(yadq::mean(batch), center), 0.0, 1e-12);
+    EXPECT_NEAR(rotation_distance(yadq::mean(samples.begin(), samples.end()), center), 0.0, 1e-12);
+    EXPECT_NEAR(rotation_distance(yadq::iterative_mean(batch), center), 0.0, 1e-12);
+    EXPECT_NEAR(rotation_distance(yadq::iterative_mean(batch, nullptr, {yadq::mean_metric::geodesic}), center), 0.0, 1e-12);
+
+    // Returned in the w >= 0 hemisphere
+    const auto m = yadq::mean(batch);
+    EXPECT_GE(m.w(), 0.0);
+    EXPECT_NEAR(m.norm(), 1.0, 1e-15);
+}
+
+TEST(Mean, SignInvariance) {
+
+    const auto samples = noisy_samples(1001, 0.1, 1);
+    std::vector<yadq::quaternionU<double>> flipped;
+    for (const auto& q : samples){
+        flipped.emplace_back(-q.w(), -q.x(), -q.y(), -q.z());
+    }
+
+    const yadq::quaternion_batch<double> a(samples.begin(), samples.end());
+    const yadq::quaternion_batch<double> b(flipped.begin(), flipped.end());
+
+    for (auto metric : {yadq::mean_metric::chordal, yadq::mean_metric::geodesic}){
+        EXPECT_NEAR(rotation_distance(yadq::iterative_mean(a, nullptr, {metric}), yadq::iterative_mean(b, nullptr, {metric})), 0.0, 1e-12);
+    }
+    EXPECT_NEAR(rotation_distance(yadq::mean(a), yadq::mean(b)), 0.0, 1e-12);
+
+    // Noise of 0.1 rad per axis over 1001 samples: all means land close to the center and to each other
+    const auto markley = yadq::mean(a);
+    const auto chordal = yadq::iterative_mean(a);
+    const auto geodesic = yadq::iterative_mean(a, nullptr, {yadq::mean_metric::geodesic});
+
+    EXPECT_LT(rotation_distance(markley, center), 0.02);
+    EXPECT_LT(rotation_distance(chordal, markley), 1e-3);
+    EXPECT_LT(rotation_distance(geodesic, markley), 1e-3);
+}
+
+TEST(Mean, Weights) {
+
+    // Two rotations about the same axis, weighted 3:1: the geodesic mean sits at a quarter of the arc
+    const std::array<double, 3> axis = {0, 0.6, 0.8};
+    const std::vector<yadq::quaternionU<double>> samples = {center, center * yadq::exp_map(std::array<double, 3>{0, 0.6 * 1.2, 0.8 * 1.2})};
+    const yadq::quaternion_batch<double> batch(samples.begin(), samples.end());
+    const double weights[] = {3, 1};
+
+    const auto expected = center * yadq::quaternionU<double>(axis, 0.3);
+    EXPECT_NEAR(rotation_distance(yadq::iterative_mean(batch, weights, {yadq::mean_metric::geodesic}), expected), 0.0, 1e-12);
+
+    // Markley and chordal means stay on the arc, close to the same point
+    EXPECT_LT(rotation_distance(yadq::mean(batch, weights), expected), 0.05);
+    EXPECT_LT(rotation_distance(yadq::iterative_mean(batch, weights), expected), 0.05);
+
+    // Integer weights match repeated samples
+    const std::vector<yadq::quaternionU<double>> repeated = {samples[0], samples[0], samples[0], samples[1]};
+    const yadq::quaternion_batch<double> batch_repeated(repeated.begin(), repeated.end());
+    EXPECT_NEAR(rotation_distance(yadq::mean(batch, weights), yadq::mean(batch_repeated)), 0.0, 1e-14);
+    EXPECT_NEAR(rotation_distance(yadq::iterative_mean(batch, weights), yadq::iterative_mean(batch_repeated)), 0.0, 1e-14);
+}
+
+TEST(Mean, StreamingAndMerge) {
+
+    const auto samples = noisy_samples(2003, 0.3, 2);
+    const yadq::quaternion_batch<double> batch(samples.begin(), samples.end());
+
+    yadq::quaternion_accumulator<double> streamed;
+    for (const auto& q : samples){
+        streamed.add(q);
+    }
+    EXPECT_EQ(streamed.count(), samples.size());
+    EXPECT_DOUBLE_EQ(streamed.total_weight(), double(samples.size()));
+
+    // Two halves accumulated separately then merged, the second one from a batch
+    yadq::quaternion_accumulator<double> first, second;
+    for (std::size_t i = 0; i < 1000; ++i){
+        first.add(samples[i]);
+    }
+    const yadq::quaternion_batch<double> tail(samples.begin() + 1000, samples.end());
+    second.add(tail);
+    first += second;
+
+    EXPECT_EQ(first.count(), samples.size());
+    for (std::size_t k = 0; k < 10; ++k){
+        EXPECT_NEAR(first.moments()[k], streamed.moments()[k], 1e-10) << k;
+    }
+
+    const auto m = streamed.mean();
+    EXPECT_NEAR(rotation_distance(first.mean(), m), 0.0, 1e-12);
+    EXPECT_NEAR(rotation_distance(yadq::mean(batch), m), 0.0, 1e-12);
+
+    first.clear();
+    EXPECT_EQ(first.count(), 0u);
+    EXPECT_THROW(first.mean(), std::invalid_argument);
+}
+
+TEST(Mean, ThreadsAndPrecision) {
+
+    const auto samples = noisy_samples(10007, 0.2, 3);
+    const yadq::quaternion_batch<double> batch(samples.begin(), samples.end());
+    const yadq::quaternion_batch<float> batch_f(samples.begin(), samples.end());
+
+    std::vector<double> weights(samples.size());
+    for (std::size_t i = 0; i < weights.size(); ++i){
+        weights[i] = 0.5 + double(i % 7);
+    }
+
+    for (auto metric : {yadq::mean_metric::chordal, yadq::mean_metric::geodesic}){
+        const auto ref = yadq::iterative_mean(batch, weights.data(), {metric});
+        const auto threaded = yadq::iterative_mean(batch, weights.data(), {metric}, {4, 64});
+        EXPECT_NEAR(rotation_distance(threaded, ref), 0.0, 1e-12);
+
+        const auto single = yadq::iterative_mean(batch_f, nullptr, {metric}, {3, 64});
+        EXPECT_NEAR(rotation_distance(single, yadq::iterative_mean(batch, nullptr, {metric})), 0.0, 1e-5);
+    }
+
+    const auto ref = yadq::mean(batch, weights.data());
+    EXPECT_NEAR(rotation_distance(yadq::mean(batch, weights.data(), {4, 64}), ref), 0.0, 1e-12);
+    EXPECT_NEAR(rotation_distance(yadq::mean(batch_f, {4, 64}), yadq::mean(batch)), 0.0, 1e-5);
+}
+
+TEST(Mean, Errors) {
+
+    const yadq::quaternion_batch<double> empty;
+    EXPECT_THROW(yadq::mean(empty), std::invalid_argument);
+    EXPECT_THROW(yadq::iterative_mean(empty), std::invalid_argument);
+
+    const std::vector<yadq::quaternionU<double>> samples = {center, center};
+    const yadq::quaternion_batch<double> batch(samples.begin(), samples.end());
+    const double weights[] = {1, -1};
+    EXPECT_THROW(yadq::mean(batch, weights), std::invalid_argument);
+    EXPECT_THROW(yadq::iterative_mean(batch, weights), std::invalid_argument);
+}
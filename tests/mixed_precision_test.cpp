@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/mixed_precision.hpp>
+
+namespace {
+
+    using quaternionl = std::array<long double, 4>;
+
+    std::vector<yadq::quaternionU<float>> random_rotations(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dist(-1, 1);
+
+        std::vector<yadq::quaternionU<float>> v;
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+        }
+        return v;
+    }
+
+    quaternionl hamilton(const quaternionl& l, const quaternionl& r){
+        return {    l[0] * r[0] - l[1] * r[1] - l[2] * r[2] - l[3] * r[3],
+                    l[0] * r[1] + l[1] * r[0] + l[2] * r[3] - l[3] * r[2],
+                    l[0] * r[2] - l[1] * r[3] + l[2] * r[0] + l[3] * r[1],
+                    l[0] * r[3] + l[1] * r[2] - l[2] * r[1] + l[3] * r[0]};
+    }
+
+    template<typename Q>
+    quaternionl widen(const Q& q){
+        return {q.w(), q.x(), q.y(), q.z()};
+    }
+
+    // Angle of the rotation between q and the reference, both of any norm
+    template<typename Q>
+    double angle_error(const Q& q, const quaternionl& ref){
+        const quaternionl a = widen(q);
+        const quaternionl d = hamilton({a[0], -a[1], -a[2], -a[3]}, ref);
+        const long double v = std::sqrt(d[1] * d[1] + d[2] * d[2] + d[3] * d[3]);
+        return static_cast<double>(2 * std::atan2(v, std::fabs(d[0])));
+    }
+}
+
+TEST(MixedPrecision, Conversions) {
+
+    static_assert(!std::is_convertible_v<yadq::quaternion<double>, yadq::quaternion<float>>, "narrowing conversions must be explicit");
+    static_assert(!std::is_convertible_v<yadq::quaternion<float>, yadq::quaternion<double>>, "conversions must be explicit");
+    static_assert(std::is_trivially_copyable_v<yadq::quaternion<float>>, "a converting constructor must not change the copy semantics");
+
+    const yadq::quaternion<float> qf(0.1f, -0.2f, 0.3f, 0.4f);
+    const yadq::quaternion<double> qd(qf);
+    EXPECT_EQ(qd.w(), double(0.1f));
+    EXPECT_EQ(qd.z(), double(0.4f));
+    EXPECT_EQ(yadq::quaternion<float>(qd).x(), -0.2f);
+
+    const yadq::quaternion<float> rounded(yadq::quaternion<double>(0.1, 0.2, 0.3, 0.4));
+    EXPECT_EQ(rounded.y(), 0.3f);
+
+    // Rounding to float moves the norm by an ULP: the unitary conversion renormalises
+    const yadq::quaternionU<double> ud({0.3, -0.5, 0.8}, 1.234);
+    const yadq::quaternionU<float> uf(ud);
+    EXPECT_NEAR(uf.norm(), 1.0, 1e-7);
+    EXPECT_NEAR(uf.x(), ud.x(), 1e-7);
+
+    // The observed components of a lazy quaternion are converted, not the stored ones
+    yadq::quaternionU<double, yadq::normalise_lazy> lazy(ud);
+    lazy *= lazy;
+    const yadq::quaternion<float> from_lazy(lazy);
+    EXPECT_NEAR(from_lazy.w(), lazy.w(), 1e-7);
+    EXPECT_NEAR(from_lazy.norm(), 1.0, 1e-6);
+
+    const yadq::dualquaternion<double> dqd(ud, std::array<double, 3>{1.5, -2, 0.25});
+    const yadq::dualquaternion<float> dqf(dqd);
+    const auto t = dqf.translation();
+    EXPECT_NEAR(t[0], 1.5, 1e-6);
+    EXPECT_NEAR(t[1], -2, 1e-6);
+    EXPECT_NEAR(t[2], 0.25, 1e-6);
+}
+
+TEST(MixedPrecision, AccurateProduct) {
+
+    const auto l = random_rotations(1000, 1);
+    const auto r = random_rotations(1000, 2);
+    const float ulp = std::numeric_limits<float>::epsilon();
+
+    for (std::size_t i = 0; i < l.size(); ++i){
+        const yadq::quaternion<float> lq(l[i]), rq(r[i]);
+        const quaternionl ref = hamilton(widen(lq), widen(rq));
+
+        const auto wide = yadq::accurate_prod(lq, rq);
+        const auto compensated = yadq::accurate_prod<yadq::accumulation::compensated>(lq, rq);
+
+        // Rounded once: within half an ULP of the exact product, up to the double rounding of the reference
+        for (std::size_t c = 0; c < 4; ++c){
+            EXPECT_LE(std::fabs(widen(wide)[c] - ref[c]), 0.5001L * ulp * std::fabs(ref[c]) + 1e-45L);
+            EXPECT_LE(std::fabs(widen(compensated)[c] - ref[c]), 0.5001L * ulp * std::fabs(ref[c]) + 1e-45L);
+        }
+    }
+
+    // Unitary products are normalised after the accurate product
+    const auto u = yadq::accurate_prod(l[0], r[0]);
+    EXPECT_NEAR(u.norm(), 1.0, 1e-7);
+    EXPECT_LT(angle_error(u, hamilton(widen(l[0]), widen(r[0]))), 2e-7);
+}
+
+TEST(MixedPrecision, LongChains) {
+
+    // The same 1024 float rotations, composed over and over
+    const auto steps = random_rotations(1024, 3);
+    constexpr std::size_t n = 200000;
+
+    quaternionl ref{1, 0, 0, 0};
+    yadq::quaternionU<float> plain;
+    yadq::composition_chain<float> wide;
+    yadq::composition_chain<float, yadq::accumulation::compensated> compensated;
+
+    for (std::size_t i = 0; i < n; ++i){
+        const auto& q = steps[i % steps.size()];
+        ref = hamilton(ref, widen(q));
+        plain *= q;
+        wide *= q;
+        compensated *= q;
+
+        if (i % 4096 == 0){
+            const long double d = std::sqrt(ref[0] * ref[0] + ref[1] * ref[1] + ref[2] * ref[2] + ref[3] * ref[3]);
+            for (auto& c : ref){
+                c /= d;
+            }
+        }
+    }
+
+    EXPECT_EQ(wide.size(), n);
+    EXPECT_EQ(compensated.size(), n);
+
+    const double plain_error = angle_error(plain, ref);
+    const double wide_error = angle_error(wide.value(), ref);
+    const double compensated_error = angle_error(compensated.value(), ref);
+
+    // The accumulated chains only carry the final rounding to float; the float chain drifts
+    EXPECT_LT(wide_error, 3e-7);
+    EXPECT_LT(compensated_error, 3e-7);
+    EXPECT_GT(plain_error, 10 * wide_error);
+
+    // Before rounding, the accumulated products are far more accurate than float
+    EXPECT_LT(angle_error(wide.value_wide(), ref), 1e-10);
+    EXPECT_LT(angle_error(compensated.value_wide(), ref), 1e-10);
+
+    yadq::composition_chain<double> from_start(yadq::quaternionU<double>({0, 0, 1}, 0.5));
+    from_start *= yadq::quaternionU<double>({0, 0, 1}, 0.25);
+    EXPECT_NEAR(from_start.value().z(), std::sin(0.375), 1e-15);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <yadq/parallel.hpp>
+
+TEST(Parallel, ThreadCount) {
+
+    // Inputs smaller than two grains stay on the calling thread
+    EXPECT_EQ(yadq::detail::thread_count(1000, {8, 1000}), 1u);
+    EXPECT_EQ(yadq::detail::thread_count(1999, {8, 1000}), 1u);
+    EXPECT_EQ(yadq::detail::thread_count(2000, {8, 1000}), 2u);
+    EXPECT_EQ(yadq::detail::thread_count(100000, {8, 1000}), 8u);
+    EXPECT_EQ(yadq::detail::thread_count(100000, {}), 1u);
+}
+
+TEST(Parallel, Chunks) {
+
+    constexpr std::size_t n = 1003;
+    std::vector<int> seen(n, 0);
+
+    yadq::detail::parallel_chunks(n, 4, [&](unsigned, std::size_t begin, std::size_t end){
+        for (std::size_t i = begin; i < end; ++i){
+            ++seen[i];
+        }
+    });
+
+    for (std::size_t i = 0; i < n; ++i){
+        EXPECT_EQ(seen[i], 1);
+    }
+}
+
+TEST(Parallel, Exceptions) {
+
+    // Whichever chunk throws, every chunk still runs and the exception reaches the caller once all are joined
+    for (unsigned thrower : {0u, 2u}){
+        std::atomic<unsigned> done{0};
+        EXPECT_THROW(yadq::detail::parallel_chunks(400, 4, [&](unsigned k, std::size_t, std::size_t){
+            ++done;
+            if (k == thrower){
+                throw std::runtime_error("chunk");
+            }
+        }), std::runtime_error);
+        EXPECT_EQ(done.load(), 4u);
+    }
+
+    EXPECT_THROW(yadq::detail::parallel_for(4000, {4, 100}, [](std::size_t begin, std::size_t){
+        if (begin != 0){
+            throw std::out_of_range("chunk");
+        }
+    }), std::out_of_range);
+}
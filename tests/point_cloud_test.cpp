@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/point_cloud.hpp>
+
+#define TOLERANCE (1e-5)
+
+namespace {
+
+    template<typename T>
+    std::vector<T> random_points(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-10, 10);
+
+        std::vector<T> v(3 * n);
+        for (auto& c : v){
+            c = dist(gen);
+        }
+        return v;
+    }
+}
+
+TEST(PointCloud, RotateInterleaved) {
+
+    yadq::quaternionU<double> q(0.3, -0.2, 0.9, 0.4);
+
+    const std::size_t n = 1001;
+    auto points = random_points<double>(n, 1);
+    std::vector<double> points_out(points.size());
+
+    rotate(q, points.data(), points_out.data(), n);
+
+    for (std::size_t i = 0; i < n; ++i){
+        auto v = rotate(q, {points[3 * i], points[3 * i + 1], points[3 * i + 2]});
+
+        EXPECT_NEAR(points_out[3 * i], v[0], TOLERANCE);
+        EXPECT_NEAR(points_out[3 * i + 1], v[1], TOLERANCE);
+        EXPECT_NEAR(points_out[3 * i + 2], v[2], TOLERANCE);
+    }
+
+    // In place and multithreaded
+    rotate(q, points.data(), points.data(), n, yadq::parallel_config{4, 64});
+
+    for (std::size_t i = 0; i < points.size(); ++i){
+        EXPECT_NEAR(points[i], points_out[i], TOLERANCE);
+    }
+}
+
+TEST(PointCloud, RotateSoA) {
+
+    yadq::quaternionU<float> q({0.2f, 0.3f, 0.9f}, 1.1f);
+
+    const std::size_t n = 517;
+    auto x = random_points<float>(n, 2);
+    auto y = random_points<float>(n, 3);
+    auto z = random_points<float>(n, 4);
+    std::vector<float> x_out(n), y_out(n), z_out(n);
+
+    yadq::point_lanes<float> in{x.data(), y.data(), z.data()};
+    yadq::point_lanes<float> out{x_out.data(), y_out.data(), z_out.data()};
+
+    rotate(q, in, out, n, yadq::parallel_config{3, 100});
+
+    for (std::size_t i = 0; i < n; ++i){
+        auto v = rotate(q, {x[i], y[i], z[i]});
+
+        EXPECT_NEAR(x_out[i], v[0], 1e-4);
+        EXPECT_NEAR(y_out[i], v[1], 1e-4);
+        EXPECT_NEAR(z_out[i], v[2], 1e-4);
+    }
+}
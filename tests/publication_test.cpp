@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/publication.hpp>
+
+namespace {
+
+    using dq = yadq::dualquaternion<double>;
+
+    // Rotation of angle about z
+    yadq::quaternionU<double> rotation_z(double angle){
+        return yadq::quaternionU<double>({0, 0, 1}, angle);
+    }
+
+    // Pose whose every component is derived from k, so that a value mixing two stores is detected
+    dq tagged_pose(double k){
+        return dq(rotation_z(0.001 * k), yadq::quaternion<double>(k, k, k, k));
+    }
+
+    bool consistent(const dq& pose){
+        const double k = pose.qd_.w();
+        const auto r = rotation_z(0.001 * k);
+        return pose.qd_.x() == k && pose.qd_.y() == k && pose.qd_.z() == k && pose.qr_.w() == r.w() && pose.qr_.z() == r.z();
+    }
+}
+
+TEST(Publication, SeqlockStoreLoad) {
+    yadq::seqlock<dq> latest;
+    EXPECT_EQ(latest.version(), 0u);
+    EXPECT_EQ(latest.load().qr_.w(), 1);
+
+    latest.store(tagged_pose(3));
+    EXPECT_EQ(latest.version(), 1u);
+
+    dq pose;
+    ASSERT_TRUE(latest.try_load(pose));
+    EXPECT_TRUE(consistent(pose));
+    EXPECT_EQ(pose.qd_.w(), 3);
+    EXPECT_EQ(latest.load().qd_.w(), 3);
+
+    yadq::seqlock<yadq::quaternionU<float>> attitude(yadq::quaternionU<float>(0, 1, 0, 0));
+    EXPECT_EQ(attitude.load().x(), 1.0f);
+}
+
+TEST(Publication, SeqlockNoTornReads) {
+    yadq::seqlock<dq> latest(tagged_pose(0));
+    constexpr int stores = 200000;
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<int> regressions{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r){
+        readers.emplace_back([&]{
+            double previous = 0;
+            while (!done.load(std::memory_order_relaxed)){
+                const dq pose = latest.load();
+                if (!consistent(pose)){
+                    ++torn;
+                }
+                // A reader never goes back in time
+                if (pose.qd_.w() < previous){
+                    ++regressions;
+                }
+                previous = pose.qd_.w();
+            }
+        });
+    }
+
+    for (int k = 1; k <= stores; ++k){
+        latest.store(tagged_pose(k));
+    }
+    done = true;
+    for (auto& t : readers){
+        t.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(regressions.load(), 0);
+    EXPECT_EQ(latest.version(), static_cast<std::uint64_t>(stores));
+}
+
+TEST(Publication, HistoryLookup) {
+    EXPECT_THROW(yadq::pose_history<dq>(0), std::invalid_argument);
+
+    yadq::pose_history<yadq::quaternionU<double>> history(4);
+    EXPECT_FALSE(history.latest().has_value());
+    EXPECT_FALSE(history.at(0).has_value());
+
+    for (int i = 0; i < 10; ++i){
+        history.push(i, rotation_z(0.1 * i));
+    }
+    EXPECT_THROW(history.push(9, rotation_z(0)), std::invalid_argument);
+    EXPECT_EQ(history.count(), 10u);
+
+    const auto last = history.latest();
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last->time, 9);
+
+    // Values 6 to 9 are kept
+    EXPECT_FALSE(history.at(5.5).has_value());
+    EXPECT_FALSE(history.at(9.5).has_value());
+    ASSERT_TRUE(history.at(6).has_value());
+    EXPECT_NEAR(history.at(6)->z(), rotation_z(0.6).z(), 1e-12);
+
+    const auto mid = history.at(7.25);
+    ASSERT_TRUE(mid.has_value());
+    EXPECT_NEAR(mid->w(), rotation_z(0.725).w(), 1e-12);
+    EXPECT_NEAR(mid->z(), rotation_z(0.725).z(), 1e-12);
+
+    // Pure translations between dual quaternion keys: ScLERP is linear in the translation
+    yadq::pose_history<dq> poses(8);
+    poses.push(0.0, dq(rotation_z(0.3), std::array<double, 3>{0, 0, 0}));
+    poses.push(2.0, dq(rotation_z(0.3), std::array<double, 3>{4, -2, 1}));
+
+    const auto p = poses.at(0.5);
+    ASSERT_TRUE(p.has_value());
+    const auto t = p->translation();
+    EXPECT_NEAR(t[0], 1, 1e-12);
+    EXPECT_NEAR(t[1], -0.5, 1e-12);
+    EXPECT_NEAR(t[2], 0.25, 1e-12);
+}
+
+TEST(Publication, HistoryConcurrentReads) {
+    yadq::pose_history<dq> history(64);
+    constexpr int pushes = 100000;
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<int> wrong{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r){
+        readers.emplace_back([&]{
+            while (!done.load(std::memory_order_relaxed)){
+                const auto last = history.latest();
+                if (!last){
+                    continue;
+                }
+                if (!consistent(last->value) || last->value.qd_.w() != last->time){
+                    ++torn;
+                }
+                // A time a few values back is kept, unless the writer moved on meanwhile
+                const double t = std::floor(last->time) - 10;
+                if (t >= 0){
+                    const auto v = history.at(t);
+                    if (v && (!consistent(*v) || v->qd_.w() != t)){
+                        ++wrong;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < pushes; ++i){
+        history.push(i, tagged_pose(i));
+    }
+    done = true;
+    for (auto& t : readers){
+        t.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(wrong.load(), 0);
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/quaternion_batch.hpp>
+
+#define TOLERANCE (1e-5)
+
+// Documented bound of the batch kernels: a few ULP of the magnitude of the partial products (exact without FMA)
+#define EXPECT_ULP_NEAR(a, b, scale) EXPECT_NEAR((a), (b), 4 * std::numeric_limits<std::decay_t<decltype(a)>>::epsilon() * (scale))
+
+namespace {
+
+    template<typename T>
+    std::vector<yadq::quaternion<T>> random_quaternions(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-2, 2);
+
+        std::vector<yadq::quaternion<T>> v;
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+        }
+        return v;
+    }
+}
+
+TEST(QuaternionBatch, Constructor) {
+
+    yadq::quaternion_batch<double> qb(5);
+
+    EXPECT_EQ(qb.size(), 5u);
+    EXPECT_EQ(qb.padded_size() % (yadq::simd::alignment / sizeof(double)), 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(qb.w()) % yadq::simd::alignment, 0u);
+
+    for (std::size_t i = 0; i < qb.padded_size(); ++i){
+        EXPECT_TRUE(qb.w()[i] == 1);
+        EXPECT_TRUE(qb.x()[i] == 0);
+        EXPECT_TRUE(qb.y()[i] == 0);
+        EXPECT_TRUE(qb.z()[i] == 0);
+    }
+
+    auto v = random_quaternions<double>(37, 1);
+    yadq::quaternion_batch<double> qb_v(v.begin(), v.end());
+
+    EXPECT_EQ(qb_v.size(), 37u);
+    EXPECT_TRUE(qb_v.get(36).w() == v[36].w());
+    EXPECT_TRUE(qb_v.get(36).z() == v[36].z());
+
+    qb_v.resize(3);
+
+    EXPECT_TRUE(qb_v.w()[5] == 1);
+    EXPECT_TRUE(qb_v.x()[5] == 0);
+}
+
+TEST(QuaternionBatch, Multiply) {
+
+    auto v1 = random_quaternions<double>(101, 2);
+    auto v2 = random_quaternions<double>(101, 3);
+
+    yadq::quaternion_batch<double> qb1(v1.begin(), v1.end());
+    yadq::quaternion_batch<double> qb2(v2.begin(), v2.end());
+
+    auto qb_res = multiply(qb1, qb2);
+
+    for (std::size_t i = 0; i < v1.size(); ++i){
+        auto q_res = hamilton_prod(v1[i], v2[i]);
+        auto scale = v1[i].norm() * v2[i].norm();
+
+        EXPECT_ULP_NEAR(qb_res.get(i).w(), q_res.w(), scale);
+        EXPECT_ULP_NEAR(qb_res.get(i).x(), q_res.x(), scale);
+        EXPECT_ULP_NEAR(qb_res.get(i).y(), q_res.y(), scale);
+        EXPECT_ULP_NEAR(qb_res.get(i).z(), q_res.z(), scale);
+    }
+
+    multiply(qb1, qb2, qb1);
+
+    EXPECT_DOUBLE_EQ(qb1.get(100).x(), qb_res.get(100).x());
+
+    yadq::quaternion_batch<double> qb3(7);
+    EXPECT_THROW(multiply(qb1, qb3), std::invalid_argument);
+}
+
+TEST(QuaternionBatch, MultiplyFloat) {
+
+    auto v1 = random_quaternions<float>(45, 4);
+    auto v2 = random_quaternions<float>(45, 5);
+
+    yadq::quaternion_batch<float> qb1(v1.begin(), v1.end());
+    yadq::quaternion_batch<float> qb2(v2.begin(), v2.end());
+
+    auto qb_res = multiply(qb1, qb2);
+
+    for (std::size_t i = 0; i < v1.size(); ++i){
+        auto q_res = hamilton_prod(v1[i], v2[i]);
+        float scale = v1[i].norm() * v2[i].norm();
+
+        EXPECT_ULP_NEAR(qb_res.get(i).w(), q_res.w(), scale);
+        EXPECT_ULP_NEAR(qb_res.get(i).x(), q_res.x(), scale);
+        EXPECT_ULP_NEAR(qb_res.get(i).y(), q_res.y(), scale);
+        EXPECT_ULP_NEAR(qb_res.get(i).z(), q_res.z(), scale);
+    }
+}
+
+TEST(QuaternionBatch, ConjugateNormalise) {
+
+    auto v = random_quaternions<double>(33, 6);
+    v[4] = yadq::quaternion<double>(0, 0, 0, 0);
+
+    yadq::quaternion_batch<double> qb(v.begin(), v.end());
+
+    auto qb_conj = conjugate(qb);
+    auto qb_norm = normalise(qb);
+
+    for (std::size_t i = 0; i < v.size(); ++i){
+        auto q_conj = conjugate(v[i]);
+        auto q_norm = normalise(v[i]);
+
+        EXPECT_DOUBLE_EQ(qb_conj.get(i).w(), q_conj.w());
+        EXPECT_DOUBLE_EQ(qb_conj.get(i).x(), q_conj.x());
+        EXPECT_DOUBLE_EQ(qb_conj.get(i).y(), q_conj.y());
+        EXPECT_DOUBLE_EQ(qb_conj.get(i).z(), q_conj.z());
+
+        EXPECT_ULP_NEAR(qb_norm.get(i).w(), q_norm.w(), 1.0);
+        EXPECT_ULP_NEAR(qb_norm.get(i).x(), q_norm.x(), 1.0);
+        EXPECT_ULP_NEAR(qb_norm.get(i).y(), q_norm.y(), 1.0);
+        EXPECT_ULP_NEAR(qb_norm.get(i).z(), q_norm.z(), 1.0);
+    }
+
+    EXPECT_TRUE(qb_norm.get(4).empty());
+}
+
+TEST(QuaternionBatch, Renormalise) {
+
+    // Products of unitary quaternions, slightly off unit norm
+    std::vector<yadq::quaternion<float>> v;
+    for (const auto& q : random_quaternions<float>(37, 8)){
+        const yadq::quaternion<float> u(yadq::quaternionU<float>(q.w(), q.x(), q.y(), q.z()));
+        v.push_back(u * u);
+    }
+
+    const yadq::quaternion_batch<float> qb(v.begin(), v.end());
+    const auto qb_newton = yadq::renormalise<yadq::norm_strategy::newton>(qb);
+    const auto qb_pade = yadq::renormalise<yadq::norm_strategy::pade>(qb);
+    const auto qb_exact = yadq::renormalise<yadq::norm_strategy::exact>(qb);
+
+    for (std::size_t i = 0; i < v.size(); ++i){
+        const auto q_newton = yadq::renormalise<yadq::norm_strategy::newton>(v[i]);
+        const auto q_pade = yadq::renormalise<yadq::norm_strategy::pade>(v[i]);
+
+        EXPECT_ULP_NEAR(qb_newton.get(i).w(), q_newton.w(), 1.0f);
+        EXPECT_ULP_NEAR(qb_newton.get(i).z(), q_newton.z(), 1.0f);
+        EXPECT_ULP_NEAR(qb_pade.get(i).x(), q_pade.x(), 1.0f);
+        EXPECT_ULP_NEAR(qb_pade.get(i).y(), q_pade.y(), 1.0f);
+
+        EXPECT_NEAR(qb_newton.get(i).norm(), 1.0, 3e-7);
+        EXPECT_NEAR(qb_pade.get(i).norm(), 1.0, 3e-7);
+        EXPECT_NEAR(qb_exact.get(i).norm(), 1.0, 3e-7);
+    }
+}
+
+TEST(QuaternionBatch, InverseDot) {
+
+    auto v = random_quaternions<double>(19, 7);
+    v[0] = yadq::quaternion<double>(0, 0, 0, 0);
+
+    yadq::quaternion_batch<double> qb(v.begin(), v.end());
+
+    auto qb_inv = inverse(qb);
+    auto qb_id = multiply(qb, qb_inv);
+    auto d = dot(qb, qb);
+
+    EXPECT_TRUE(qb_inv.get(0).empty());
+
+    for (std::size_t i = 1; i < v.size(); ++i){
+        EXPECT_NEAR(qb_id.get(i).w(), 1.0, TOLERANCE);
+        EXPECT_NEAR(qb_id.get(i).x(), 0.0, TOLERANCE);
+        EXPECT_NEAR(qb_id.get(i).y(), 0.0, TOLERANCE);
+        EXPECT_NEAR(qb_id.get(i).z(), 0.0, TOLERANCE);
+
+        yadq::quaternionU<double> qU(v[i]);
+        auto qU_inv = inverse(qU);
+        auto qU_batch_inv = yadq::quaternion_batch<double>(&qU, &qU + 1);
+
+        EXPECT_NEAR(inverse(qU_batch_inv).get(0).x(), qU_inv.x(), TOLERANCE);
+
+        EXPECT_ULP_NEAR(d[i], dot(v[i], v[i]), dot(v[i], v[i]));
+    }
+}
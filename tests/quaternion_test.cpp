@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
 #include <yadq/quaternion.hpp>
 #include <yadq/dual_quaternion.hpp>
 
@@ -16,6 +18,26 @@ TEST(Quaternion, DefaultClassInitialisation) {
     
 }
 
+TEST(Quaternion, StorageLayout) {
+
+    static_assert(sizeof(yadq::quaternion<double>) == 4 * sizeof(double));
+    static_assert(sizeof(yadq::quaternion<float>) == 4 * sizeof(float));
+    static_assert(std::is_trivially_copyable_v<yadq::quaternion<double>>);
+    static_assert(std::is_standard_layout_v<yadq::quaternionU<double>>);
+
+    std::vector<yadq::quaternion<double>> v_src{{1, 2, 3, 4}, {5, 6, 7, 8}};
+    std::vector<yadq::quaternion<double>> v_dst(v_src.size());
+
+    std::memcpy(v_dst.data(), v_src.data(), v_src.size() * sizeof(yadq::quaternion<double>));
+
+    EXPECT_TRUE(v_dst[1].w() == 5);
+    EXPECT_TRUE(v_dst[1].x() == 6);
+    EXPECT_TRUE(v_dst[1].y() == 7);
+    EXPECT_TRUE(v_dst[1].z() == 8);
+
+    EXPECT_TRUE(&v_src[0].get()[0] == reinterpret_cast<const double*>(&v_src[0]));
+}
+
 TEST(Quaternion, ClassInitialisation) {
   
 	yadq::quaternion<double> q(1, 2, 3, 4);
@@ -193,6 +215,135 @@ TEST(QuaternionUnitary, MemberOperatorPlus) {
 }
 
 
+TEST(QuaternionUnitary, LazyPolicy) {
+
+    yadq::quaternionU<double, yadq::normalise_lazy> q1(1, 2, 3, 4);
+
+    EXPECT_NEAR(q1.w(), (1.0 / 5.47722557505), TOLERANCE);
+    EXPECT_NEAR(q1.x(), (2.0 / 5.47722557505), TOLERANCE);
+    EXPECT_NEAR(q1.y(), (3.0 / 5.47722557505), TOLERANCE);
+    EXPECT_NEAR(q1.z(), (4.0 / 5.47722557505), TOLERANCE);
+    EXPECT_NEAR(q1.norm(), 1.0, TOLERANCE);
+
+    yadq::quaternionU<double, yadq::normalise_lazy> q2(0, 0.7071068, 0, 0.7071068);
+    yadq::quaternionU<double> q1_eager(1, 2, 3, 4);
+    yadq::quaternionU<double> q2_eager(0, 0.7071068, 0, 0.7071068);
+
+    auto q_res = q1 * q2;
+    auto q_res_eager = q1_eager * q2_eager;
+
+    EXPECT_NEAR(q_res.w(), q_res_eager.w(), TOLERANCE);
+    EXPECT_NEAR(q_res.x(), q_res_eager.x(), TOLERANCE);
+    EXPECT_NEAR(q_res.y(), q_res_eager.y(), TOLERANCE);
+    EXPECT_NEAR(q_res.z(), q_res_eager.z(), TOLERANCE);
+
+    auto data = q_res.get();
+    EXPECT_NEAR(data[1], q_res_eager.x(), TOLERANCE);
+
+    q_res.normalise();
+    EXPECT_NEAR(static_cast<const yadq::quaternion<double>&>(q_res).norm(), 1.0, TOLERANCE);
+
+    // Observing a dirty quaternion does not write to it, so concurrent const reads do not race
+    const auto dirty = q1 * q2;
+    unsigned char before[sizeof(dirty)], after[sizeof(dirty)];
+    std::memcpy(before, &dirty, sizeof(dirty));
+    EXPECT_NEAR(dirty.norm(), 1.0, TOLERANCE);
+    EXPECT_NEAR(dirty.x(), q_res_eager.x(), TOLERANCE);
+    std::memcpy(after, &dirty, sizeof(dirty));
+    EXPECT_EQ(std::memcmp(before, after, sizeof(dirty)), 0);
+}
+
+TEST(QuaternionUnitary, PeriodicPolicy) {
+
+    yadq::quaternionU<double, yadq::normalise_periodic<4>> q_step({0.2, 0.3, 0.9}, 0.01);
+    yadq::quaternionU<double, yadq::normalise_periodic<4>> q_chain;
+    yadq::quaternionU<double> q_step_eager({0.2, 0.3, 0.9}, 0.01);
+    yadq::quaternionU<double> q_chain_eager;
+
+    q_chain *= q_step;
+    q_chain *= q_step;
+    q_chain *= q_step;
+
+    EXPECT_EQ(q_chain.compositions(), 3u);
+
+    q_chain *= q_step;
+
+    EXPECT_EQ(q_chain.compositions(), 0u);
+
+    for (int i = 0; i < 1000; ++i){
+        q_chain_eager *= q_step_eager;
+    }
+    for (int i = 4; i < 1000; ++i){
+        q_chain *= q_step;
+    }
+
+    EXPECT_NEAR(q_chain.norm(), 1.0, 1e-12);
+    EXPECT_NEAR(q_chain.w(), q_chain_eager.w(), TOLERANCE);
+    EXPECT_NEAR(q_chain.x(), q_chain_eager.x(), TOLERANCE);
+    EXPECT_NEAR(q_chain.y(), q_chain_eager.y(), TOLERANCE);
+    EXPECT_NEAR(q_chain.z(), q_chain_eager.z(), TOLERANCE);
+}
+
+TEST(QuaternionUnitary, FastPolicy) {
+
+    yadq::quaternionU<double> q_step_eager({0.2, 0.3, 0.9}, 0.01);
+    yadq::quaternionU<double> q_chain_eager;
+    yadq::quaternionU<double, yadq::normalise_fast<yadq::norm_strategy::newton>> q_step_newton(q_step_eager), q_chain_newton;
+    yadq::quaternionU<double, yadq::normalise_fast<yadq::norm_strategy::pade>> q_step_pade(q_step_eager), q_chain_pade;
+    yadq::quaternionU<float, yadq::normalise_fast<>> q_step_float({0.2f, 0.3f, 0.9f}, 0.01f), q_chain_float;
+
+    // Constructions stay exact
+    const yadq::quaternionU<double, yadq::normalise_fast<>> q_constructed(1, 2, 3, 4);
+    EXPECT_NEAR(q_constructed.norm(), 1.0, 1e-15);
+
+    for (int i = 0; i < 1000; ++i){
+        q_chain_eager *= q_step_eager;
+        q_chain_newton *= q_step_newton;
+        q_chain_pade *= q_step_pade;
+        q_chain_float *= q_step_float;
+    }
+
+    EXPECT_NEAR(q_chain_newton.norm(), 1.0, 1e-15);
+    EXPECT_NEAR(q_chain_pade.norm(), 1.0, 1e-15);
+    EXPECT_NEAR(q_chain_float.norm(), 1.0, 1e-6);
+
+    EXPECT_NEAR(q_chain_newton.w(), q_chain_eager.w(), 1e-12);
+    EXPECT_NEAR(q_chain_newton.z(), q_chain_eager.z(), 1e-12);
+    EXPECT_NEAR(q_chain_pade.w(), q_chain_eager.w(), 1e-12);
+    EXPECT_NEAR(q_chain_pade.z(), q_chain_eager.z(), 1e-12);
+    EXPECT_NEAR(q_chain_float.w(), q_chain_eager.w(), 1e-4);
+    EXPECT_NEAR(q_chain_float.z(), q_chain_eager.z(), 1e-4);
+}
+
+TEST(Quaternion, Renormalise) {
+
+    const yadq::quaternionU<double> q_unit({0.2, -0.3, 0.9}, 1.1);
+
+    // Documented truncation bounds, for s = |q|^2 = 1 + e
+    for (const double e : {1e-1, 1e-3, -1e-3, 1e-6}){
+        const yadq::quaternion<double> q(q_unit * std::sqrt(1 + e));
+
+        const auto newton = yadq::renormalise<yadq::norm_strategy::newton>(q);
+        const auto pade = yadq::renormalise<yadq::norm_strategy::pade>(q);
+        const auto exact = yadq::renormalise<yadq::norm_strategy::exact>(q);
+
+        EXPECT_NEAR(newton.norm(), 1.0, 1.01 * 27 * std::pow(e, 4) / 128 + 4e-16);
+        EXPECT_NEAR(pade.norm(), 1.0, 1.01 * std::pow(std::fabs(e), 3) / 32 + 4e-16);
+        EXPECT_NEAR(exact.norm(), 1.0, 4e-16);
+
+        // Only the norm changes
+        EXPECT_NEAR(newton.x() / newton.norm(), q_unit.x(), 1e-15);
+        EXPECT_NEAR(pade.y() / pade.norm(), q_unit.y(), 1e-15);
+    }
+
+    // Product of two unit float quaternions
+    const yadq::quaternionU<float> a({1.0f, 2.0f, 3.0f}, 0.7f), b({-2.0f, 0.5f, 1.0f}, 2.1f);
+    const yadq::quaternion<float> pa(a), pb(b);
+    const yadq::quaternion<float> p = pa * pb;
+    EXPECT_NEAR(yadq::renormalise<yadq::norm_strategy::newton>(p).norm(), 1.0, 3e-7);
+    EXPECT_NEAR(yadq::renormalise<yadq::norm_strategy::pade>(p).norm(), 1.0, 3e-7);
+}
+
 TEST(CrossFunctions, OperatorMultiplication) {
   
 	yadq::quaternion<double> q1(0, 0.7071068, 0, 0.7071068);
@@ -411,6 +562,29 @@ TEST(CrossFunctions, QuatToRotation) {
     
 }
 
+TEST(CrossFunctions, Rotate) {
+
+    yadq::quaternionU<double> q1({0, 0, 1}, M_PI / 2);
+
+    std::array<double, 3> v = rotate(q1, {1, 0, 0});
+
+    EXPECT_NEAR(v[0], 0.0, TOLERANCE);
+    EXPECT_NEAR(v[1], 1.0, TOLERANCE);
+    EXPECT_NEAR(v[2], 0.0, TOLERANCE);
+
+    yadq::quaternionU<double> q2(0.3, -0.2, 0.9, 0.4);
+    std::array<double, 3> p = {1.5, -2.0, 0.7};
+
+    yadq::quaternion<double> q_p(0, p[0], p[1], p[2]);
+    yadq::quaternion<double> q_ref = hamilton_prod(hamilton_prod(yadq::detail::as_quaternion(q2), q_p), yadq::detail::as_quaternion(conjugate(q2)));
+
+    v = rotate(q2, p);
+
+    EXPECT_NEAR(v[0], q_ref.x(), TOLERANCE);
+    EXPECT_NEAR(v[1], q_ref.y(), TOLERANCE);
+    EXPECT_NEAR(v[2], q_ref.z(), TOLERANCE);
+}
+
 // TEST to add
 TEST(Quaternion, Exponential) {
   
@@ -418,10 +592,30 @@ TEST(Quaternion, Exponential) {
 
     yadq::quaternionU<double> q_res = exp(q);
 
-    EXPECT_NEAR(q_res.w(), 0.433826, TOLERANCE);
-    EXPECT_NEAR(q_res.x(), 0.558386, TOLERANCE);
-    EXPECT_NEAR(q_res.y(), 0.433826, TOLERANCE);
-    EXPECT_NEAR(q_res.z(), 0.558386, TOLERANCE);
+    // e^0 (cos 1, sin 1 v), |v| = 1
+    EXPECT_NEAR(q_res.w(), 0.540302, TOLERANCE);
+    EXPECT_NEAR(q_res.x(), 0.595009, TOLERANCE);
+    EXPECT_NEAR(q_res.y(), 0.0, TOLERANCE);
+    EXPECT_NEAR(q_res.z(), 0.595009, TOLERANCE);
+
+    // Non-unit result, and no division by |v| for real quaternions
+    yadq::quaternion<double> q_gen(0.5, 0, 0.3, -0.4);
+    auto e = exp(q_gen);
+    const double n = 0.5, s = std::exp(0.5) * std::sin(n) / n;
+    EXPECT_NEAR(e.w(), std::exp(0.5) * std::cos(n), TOLERANCE);
+    EXPECT_NEAR(e.y(), 0.3 * s, TOLERANCE);
+    EXPECT_NEAR(e.z(), -0.4 * s, TOLERANCE);
+
+    auto e_real = exp(yadq::quaternion<double>(1, 0, 0, 0));
+    EXPECT_NEAR(e_real.w(), std::exp(1.0), TOLERANCE);
+    EXPECT_EQ(e_real.x(), 0.0);
+
+    // log inverts exp
+    auto l = log(e);
+    ASSERT_TRUE(l.has_value());
+    EXPECT_NEAR(l->w(), 0.5, TOLERANCE);
+    EXPECT_NEAR(l->y(), 0.3, TOLERANCE);
+    EXPECT_NEAR(l->z(), -0.4, TOLERANCE);
 }
 
 TEST(Quaternion, Logarithm) {
@@ -440,6 +634,31 @@ TEST(Quaternion, Logarithm) {
     EXPECT_NEAR(q_res.value().z(), 0.7071068, TOLERANCE);
 }
 
+TEST(Quaternion, LogarithmNegativeReal) {
+
+    // The axis is arbitrary, x is picked, and exp gives the quaternion back
+    const yadq::quaternion<double> q(-2, 0, 0, 0);
+    const auto l = log(q);
+    ASSERT_TRUE(l.has_value());
+    EXPECT_NEAR(l->w(), std::log(2.0), TOLERANCE);
+    EXPECT_NEAR(l->x(), std::acos(-1.0), TOLERANCE);
+    EXPECT_EQ(l->y(), 0.0);
+    EXPECT_EQ(l->z(), 0.0);
+
+    const auto e = exp(*l);
+    EXPECT_NEAR(e.w(), -2, TOLERANCE);
+    EXPECT_NEAR(e.x(), 0, TOLERANCE);
+
+    const auto unit = log(yadq::quaternion<double>(-1, 0, 0, 0));
+    ASSERT_TRUE(unit.has_value());
+    EXPECT_EQ(unit->w(), 0.0);
+    const auto back = exp(*unit);
+    EXPECT_NEAR(back.w(), -1, TOLERANCE);
+    EXPECT_NEAR(back.x(), 0, TOLERANCE);
+    EXPECT_EQ(back.y(), 0.0);
+    EXPECT_EQ(back.z(), 0.0);
+}
+
 
 
 
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/rotation_batch.hpp>
+
+#define TOLERANCE (1e-5)
+
+namespace {
+
+    template<typename T>
+    std::vector<yadq::quaternionU<T>> random_rotations(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-1, 1);
+
+        std::vector<yadq::quaternionU<T>> v;
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+        }
+
+        // Half turns around each axis, where w = 0 and every pivot of Shepperd's method is exercised
+        v.emplace_back(0, 1, 0, 0);
+        v.emplace_back(0, 0, 1, 0);
+        v.emplace_back(0, 0, 0, 1);
+        v.emplace_back(0, 1, 1, 0);
+        v.emplace_back(1, 0, 0, 0);
+        return v;
+    }
+
+    template<typename Q1, typename Q2>
+    void expect_same_rotation(const Q1& q1, const Q2& q2, double tol){
+        const double sign = (q1.w() * q2.w() + q1.x() * q2.x() + q1.y() * q2.y() + q1.z() * q2.z()) < 0 ? -1.0 : 1.0;
+        EXPECT_NEAR(q1.w(), sign * q2.w(), tol);
+        EXPECT_NEAR(q1.x(), sign * q2.x(), tol);
+        EXPECT_NEAR(q1.y(), sign * q2.y(), tol);
+        EXPECT_NEAR(q1.z(), sign * q2.z(), tol);
+    }
+}
+
+TEST(RotationConversion, RotationToQuat) {
+
+    for (const auto& q : random_rotations<double>(200, 1)){
+        expect_same_rotation(yadq::rotationToQuat(quatToRotation(q)), q, 1e-12);
+    }
+
+    // Rotation of pi/2 around z
+    const std::array<double, 9> R = {0, -1, 0, 1, 0, 0, 0, 0, 1};
+    const auto q = yadq::rotationToQuat(R);
+    expect_same_rotation(q, yadq::quaternionU<double>({0, 0, 1}, M_PI / 2), TOLERANCE);
+}
+
+template<typename T>
+class RotationBatch : public ::testing::Test {};
+
+using RotationBatchTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(RotationBatch, RotationBatchTypes);
+
+TYPED_TEST(RotationBatch, QuatToRotation) {
+
+    using T = TypeParam;
+    const double tol = std::is_same_v<T, float> ? 1e-6 : 1e-14;
+
+    const auto q = random_rotations<T>(37, 2);
+    yadq::quaternion_batch<T> batch(q.begin(), q.end());
+
+    for (auto shape : {yadq::matrix_shape::mat3x3, yadq::matrix_shape::mat3x4, yadq::matrix_shape::mat4x4}){
+        for (auto order : {yadq::matrix_order::row_major, yadq::matrix_order::column_major}){
+
+            const std::size_t rows = shape == yadq::matrix_shape::mat4x4 ? 4 : 3;
+            const std::size_t cols = shape == yadq::matrix_shape::mat3x3 ? 3 : 4;
+            const std::size_t stride = rows * cols;
+            auto at = [&](std::size_t r, std::size_t c){
+                return order == yadq::matrix_order::row_major ? r * cols + c : c * rows + r;
+            };
+
+            // The translation column must survive the conversion
+            std::vector<T> m(q.size() * stride, T(7));
+
+            quatToRotation(batch, m.data(), shape, order);
+
+            for (std::size_t i = 0; i < q.size(); ++i){
+                const auto R = quatToRotation(q[i]);
+                const T* mi = m.data() + i * stride;
+
+                for (std::size_t r = 0; r < 3; ++r){
+                    for (std::size_t c = 0; c < 3; ++c){
+                        EXPECT_NEAR(mi[at(r, c)], R[3 * r + c], tol);
+                    }
+                }
+
+                if (cols == 4){
+                    EXPECT_EQ(mi[at(0, 3)], T(7));
+                    EXPECT_EQ(mi[at(1, 3)], T(7));
+                    EXPECT_EQ(mi[at(2, 3)], T(7));
+                }
+
+                if (rows == 4){
+                    EXPECT_EQ(mi[at(3, 0)], T(0));
+                    EXPECT_EQ(mi[at(3, 1)], T(0));
+                    EXPECT_EQ(mi[at(3, 2)], T(0));
+                    EXPECT_EQ(mi[at(3, 3)], T(1));
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(RotationBatch, RotationToQuat) {
+
+    using T = TypeParam;
+    const double tol = std::is_same_v<T, float> ? 1e-6 : 1e-14;
+
+    const auto q = random_rotations<T>(37, 3);
+    yadq::quaternion_batch<T> batch(q.begin(), q.end());
+
+    for (auto shape : {yadq::matrix_shape::mat3x3, yadq::matrix_shape::mat3x4, yadq::matrix_shape::mat4x4}){
+        for (auto order : {yadq::matrix_order::row_major, yadq::matrix_order::column_major}){
+
+            const std::size_t stride = shape == yadq::matrix_shape::mat3x3 ? 9 : (shape == yadq::matrix_shape::mat3x4 ? 12 : 16);
+            std::vector<T> m(q.size() * stride);
+            quatToRotation(batch, m.data(), shape, order);
+
+            yadq::quaternion_batch<T> q_out(q.size());
+            rotationToQuat(m.data(), q_out, shape, order);
+
+            for (std::size_t i = 0; i < q.size(); ++i){
+                expect_same_rotation(q_out.get(i), yadq::rotationToQuat(quatToRotation(q[i])), tol);
+                expect_same_rotation(q_out.get(i), q[i], std::is_same_v<T, float> ? 1e-5 : 1e-12);
+            }
+
+            // The padding keeps the identity
+            for (std::size_t i = q_out.size(); i < q_out.padded_size(); ++i){
+                EXPECT_EQ(q_out.w()[i], T(1));
+                EXPECT_EQ(q_out.x()[i], T(0));
+            }
+        }
+    }
+}
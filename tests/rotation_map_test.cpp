@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <yadq/quaternion.hpp>
+#include <yadq/rotation_map.hpp>
+
+namespace {
+
+    template<typename T>
+    std::array<T, 3> scaled(const std::array<T, 3>& v, T s){
+        return {v[0] * s, v[1] * s, v[2] * s};
+    }
+
+    // Unit axis
+    const std::array<double, 3> axis = {0.48, -0.6, 0.64};
+}
+
+TEST(RotationMap, ExpMatchesAxisAngle) {
+
+    // Both sides of the series limit (pi / 2), up to a full turn
+    for (double angle : {0.0, 1e-9, 1e-4, 0.1, 1.0, 1.5707, 1.5709, 2.5, M_PI, 5.0}){
+        const auto q = yadq::exp_map(scaled(axis, angle));
+        const yadq::quaternionU<double> ref(axis, angle);
+
+        EXPECT_NEAR(q.w(), ref.w(), 1e-15) << angle;
+        EXPECT_NEAR(q.x(), ref.x(), 1e-15) << angle;
+        EXPECT_NEAR(q.y(), ref.y(), 1e-15) << angle;
+        EXPECT_NEAR(q.z(), ref.z(), 1e-15) << angle;
+    }
+
+    const auto qf = yadq::exp_map(std::array<float, 3>{0.3f, -0.2f, 0.5f});
+    const auto qd = yadq::exp_map(std::array<double, 3>{0.3, -0.2, 0.5});
+    EXPECT_NEAR(qf.w(), qd.w(), 1e-7);
+    EXPECT_NEAR(qf.z(), qd.z(), 1e-7);
+}
+
+TEST(RotationMap, SmallAngles) {
+
+    // No loss of relative precision near zero
+    const auto q = yadq::exp_map(std::array<double, 3>{1e-12, -2e-12, 0});
+    EXPECT_EQ(q.w(), 1.0);
+    EXPECT_DOUBLE_EQ(q.x(), 5e-13);
+    EXPECT_DOUBLE_EQ(q.y(), -1e-12);
+
+    const auto r = yadq::log_map(yadq::quaternionU<double>(1, 5e-13, -1e-12, 0));
+    EXPECT_DOUBLE_EQ(r[0], 1e-12);
+    EXPECT_DOUBLE_EQ(r[1], -2e-12);
+    EXPECT_EQ(r[2], 0.0);
+
+    const auto zero = yadq::log_map(yadq::quaternionU<double>());
+    EXPECT_EQ(zero[0], 0.0);
+    EXPECT_EQ(zero[1], 0.0);
+    EXPECT_EQ(zero[2], 0.0);
+}
+
+TEST(RotationMap, LogInvertsExp) {
+
+    for (double angle : {1e-7, 1e-3, 0.5, 2.0, 3.1}){
+        const auto r = yadq::log_map(yadq::exp_map(scaled(axis, angle)));
+        for (std::size_t i = 0; i < 3; ++i){
+            EXPECT_NEAR(r[i], axis[i] * angle, 1e-14) << angle;
+        }
+    }
+
+    // q and -q give the same rotation vector, with an angle in [0, pi]
+    const yadq::quaternionU<double> q(axis, 2.0);
+    const yadq::quaternionU<double> q_neg(-q.w(), -q.x(), -q.y(), -q.z());
+    const auto r = yadq::log_map(q);
+    const auto r_neg = yadq::log_map(q_neg);
+    for (std::size_t i = 0; i < 3; ++i){
+        EXPECT_NEAR(r_neg[i], r[i], 1e-14);
+    }
+
+    // A rotation of 4 rad is the rotation of 2 pi - 4 about the opposite axis
+    const auto r_wrap = yadq::log_map(yadq::quaternionU<double>(axis, 4.0));
+    for (std::size_t i = 0; i < 3; ++i){
+        EXPECT_NEAR(r_wrap[i], -axis[i] * (2 * M_PI - 4.0), 1e-14);
+    }
+}
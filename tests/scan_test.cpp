@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/scan.hpp>
+
+#define TOLERANCE (1e-9)
+
+namespace {
+
+    template<typename Q>
+    std::vector<Q> random_rotations(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> dist(-1, 1);
+
+        std::vector<Q> v;
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(1 + dist(gen), 0.2 * dist(gen), 0.2 * dist(gen), 0.2 * dist(gen));
+        }
+        return v;
+    }
+
+    std::vector<yadq::dualquaternion<double>> random_transforms(std::size_t n, unsigned seed){
+        const auto r = random_rotations<yadq::quaternionU<double>>(n, seed);
+        std::mt19937 gen(seed + 1);
+        std::uniform_real_distribution<double> dist(-1, 1);
+
+        std::vector<yadq::dualquaternion<double>> v;
+        for (std::size_t i = 0; i < n; ++i){
+            v.emplace_back(r[i], std::array<double, 3>{dist(gen), dist(gen), dist(gen)});
+        }
+        return v;
+    }
+
+    template<typename Q1, typename Q2>
+    void expect_near(const Q1& q1, const Q2& q2, double tol = TOLERANCE){
+        EXPECT_NEAR(q1.w(), q2.w(), tol);
+        EXPECT_NEAR(q1.x(), q2.x(), tol);
+        EXPECT_NEAR(q1.y(), q2.y(), tol);
+        EXPECT_NEAR(q1.z(), q2.z(), tol);
+    }
+
+    void expect_near(const yadq::dualquaternion<double>& dq1, const yadq::dualquaternion<double>& dq2, double tol = TOLERANCE){
+        expect_near(dq1.qr_, dq2.qr_, tol);
+        expect_near(dq1.qd_, dq2.qd_, tol);
+    }
+
+    const std::vector<yadq::scan_config> configs = {
+        {},
+        {{4, 1}, 0},
+        {{3, 100}, 0},
+        {{4, 1}, 16},
+    };
+}
+
+TEST(Scan, InclusiveQuaternionU) {
+
+    const auto q = random_rotations<yadq::quaternionU<double>>(1001, 1);
+
+    for (const auto& config : configs){
+        const auto q_scan = yadq::inclusive_product_scan(q, config);
+
+        yadq::quaternionU<double> acc;
+        for (std::size_t i = 0; i < q.size(); ++i){
+            acc *= q[i];
+            expect_near(q_scan[i], acc);
+        }
+    }
+}
+
+TEST(Scan, ExclusiveQuaternionU) {
+
+    const auto q = random_rotations<yadq::quaternionU<double>>(1001, 2);
+    const yadq::quaternionU<double> init({0, 0, 1}, 0.3);
+
+    for (const auto& config : configs){
+        const auto q_scan = yadq::exclusive_product_scan(q, init, config);
+
+        yadq::quaternionU<double> acc = init;
+        for (std::size_t i = 0; i < q.size(); ++i){
+            expect_near(q_scan[i], acc);
+            acc *= q[i];
+        }
+    }
+}
+
+TEST(Scan, InPlace) {
+
+    auto q = random_rotations<yadq::quaternionU<double>>(517, 3);
+    const auto q_ref = yadq::inclusive_product_scan(q);
+
+    yadq::inclusive_product_scan(q.data(), q.data(), q.size(), {{4, 1}, 0});
+
+    for (std::size_t i = 0; i < q.size(); ++i){
+        expect_near(q[i], q_ref[i]);
+    }
+}
+
+TEST(Scan, LazyPolicyRenormalisation) {
+
+    // Factors far from unit norm: without renormalisation the stored magnitude grows as 2^n
+    std::vector<yadq::quaternionU<double, yadq::normalise_lazy>> q;
+    const auto r = random_rotations<yadq::quaternionU<double>>(3000, 4);
+    for (const auto& ri : r){
+        q.emplace_back(2 * ri.w(), 2 * ri.x(), 2 * ri.y(), 2 * ri.z());
+    }
+
+    const auto q_ref = yadq::inclusive_product_scan(r);
+
+    for (const auto& config : {yadq::scan_config{{}, 64}, yadq::scan_config{{4, 1}, 64}}){
+        const auto q_scan = yadq::inclusive_product_scan(q, config);
+
+        for (std::size_t i = 0; i < q.size(); ++i){
+            expect_near(q_scan[i], q_ref[i], 1e-8);
+        }
+    }
+}
+
+TEST(Scan, DualQuaternion) {
+
+    const auto dq = random_transforms(777, 5);
+
+    for (const auto& config : configs){
+        const auto dq_scan = yadq::inclusive_product_scan(dq, config);
+        const auto dq_excl = yadq::exclusive_product_scan(dq, yadq::dualquaternion<double>(), config);
+
+        yadq::dualquaternion<double> acc;
+        for (std::size_t i = 0; i < dq.size(); ++i){
+            expect_near(dq_excl[i], acc, 1e-8);
+            acc *= dq[i];
+            expect_near(dq_scan[i], acc, 1e-8);
+        }
+    }
+}
+
+TEST(Scan, Empty) {
+
+    std::vector<yadq::quaternionU<double>> q;
+    EXPECT_TRUE(yadq::inclusive_product_scan(q, {{4, 1}, 0}).empty());
+    EXPECT_TRUE(yadq::exclusive_product_scan(q).empty());
+}
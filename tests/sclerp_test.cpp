@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/sclerp.hpp>
+
+#define TOLERANCE (1e-9)
+
+namespace {
+
+    // Two rigid transformations are equal if they map a few non coplanar points to the same places
+    void expect_motion_near(const yadq::dualquaternion<double>& a, const yadq::dualquaternion<double>& b, double tol = TOLERANCE){
+        const std::array<std::array<double, 3>, 4> points = {{{0, 0, 0}, {1, 0, 0}, {0, 2, 0}, {0.5, -1, 3}}};
+        for (const auto& p : points){
+            const auto pa = transform(a, p);
+            const auto pb = transform(b, p);
+            for (std::size_t c = 0; c < 3; ++c){
+                EXPECT_NEAR(pa[c], pb[c], tol);
+            }
+        }
+    }
+
+    yadq::dualquaternion<double> negated(const yadq::dualquaternion<double>& dq){
+        return yadq::dualquaternion<double>(yadq::quaternionU<double>(-dq.qr_.w(), -dq.qr_.x(), -dq.qr_.y(), -dq.qr_.z()),
+                                            yadq::quaternion<double>(-dq.qd_.w(), -dq.qd_.x(), -dq.qd_.y(), -dq.qd_.z()));
+    }
+}
+
+TEST(Sclerp, EndPoints) {
+
+    yadq::dualquaternion<double> dq1(yadq::quaternionU<double>(0.3, -0.2, 0.9, 0.4), {1.5, -2, 0.25});
+    yadq::dualquaternion<double> dq2(yadq::quaternionU<double>(-0.7, 0.1, 0.2, 0.6), {-3, 0.5, 4});
+
+    yadq::sclerp_plan<double> plan(dq1, dq2);
+
+    expect_motion_near(plan(0), dq1);
+    expect_motion_near(plan(1), dq2);
+
+    // dq and -dq are the same motion, the plan takes the shortest path either way
+    yadq::sclerp_plan<double> plan_neg(dq1, negated(dq2));
+    EXPECT_NEAR(plan_neg.angle(), plan.angle(), TOLERANCE);
+    EXPECT_LE(plan.angle(), M_PI);
+    expect_motion_near(plan_neg(0.4), plan(0.4));
+}
+
+TEST(Sclerp, PureRotation) {
+
+    const std::array<double, 3> axis = {0.2, -0.5, 0.8};
+    yadq::dualquaternion<double> dq1(yadq::quaternionU<double>(axis, 0.3), {0, 0, 0});
+    yadq::dualquaternion<double> dq2(yadq::quaternionU<double>(axis, 2.1), {0, 0, 0});
+
+    yadq::sclerp_plan<double> plan(dq1, dq2);
+
+    EXPECT_NEAR(plan.angle(), 1.8, TOLERANCE);
+    EXPECT_NEAR(plan.pitch(), 0.0, TOLERANCE);
+
+    for (double t : {0.0, 0.25, 0.5, 0.9, 1.0}){
+        expect_motion_near(plan(t), yadq::dualquaternion<double>(yadq::quaternionU<double>(axis, 0.3 + 1.8 * t), {0, 0, 0}));
+    }
+}
+
+TEST(Sclerp, PureTranslation) {
+
+    yadq::quaternionU<double> q(0.3, -0.2, 0.9, 0.4);
+    yadq::dualquaternion<double> dq1(q, {1.5, -2, 0.25});
+    yadq::dualquaternion<double> dq2(q, {-3, 0.5, 4});
+
+    yadq::sclerp_plan<double> plan(dq1, dq2);
+
+    EXPECT_NEAR(plan.angle(), 0.0, TOLERANCE);
+    EXPECT_NEAR(plan.pitch(), std::sqrt(4.5 * 4.5 + 2.5 * 2.5 + 3.75 * 3.75), TOLERANCE);
+
+    for (double t : {0.0, 0.3, 0.5, 1.0}){
+        expect_motion_near(plan(t), yadq::dualquaternion<double>(q, {1.5 - 4.5 * t, -2 + 2.5 * t, 0.25 + 3.75 * t}));
+    }
+
+    // Identical end points
+    yadq::sclerp_plan<double> same(dq1, dq1);
+    expect_motion_near(same(0.7), dq1);
+}
+
+TEST(Sclerp, ScrewAxis) {
+
+    // Rotation of 2 rad about an axis through c, with a translation of 0.5 along it
+    const std::array<double, 3> l = {0, 0.6, 0.8};
+    const std::array<double, 3> c = {1, 2, -1};
+    const double angle = 2.0, pitch = 0.5;
+
+    const auto screw = [&](double t){
+        yadq::quaternionU<double> r(l, angle * t);
+        const auto rc = rotate(r, c);
+        return yadq::dualquaternion<double>(r, {c[0] - rc[0] + pitch * t * l[0],
+                                                c[1] - rc[1] + pitch * t * l[1],
+                                                c[2] - rc[2] + pitch * t * l[2]});
+    };
+
+    yadq::dualquaternion<double> dq1;
+    yadq::sclerp_plan<double> plan(dq1, screw(1));
+
+    EXPECT_NEAR(plan.angle(), angle, TOLERANCE);
+    EXPECT_NEAR(plan.pitch(), pitch, TOLERANCE);
+    for (std::size_t i = 0; i < 3; ++i){
+        EXPECT_NEAR(plan.axis()[i], l[i], TOLERANCE);
+    }
+
+    // The moment is c x l for any point c of the axis
+    EXPECT_NEAR(plan.moment()[0], c[1] * l[2] - c[2] * l[1], TOLERANCE);
+    EXPECT_NEAR(plan.moment()[1], c[2] * l[0] - c[0] * l[2], TOLERANCE);
+    EXPECT_NEAR(plan.moment()[2], c[0] * l[1] - c[1] * l[0], TOLERANCE);
+
+    for (double t : {0.1, 0.5, 0.8}){
+        expect_motion_near(plan(t), screw(t));
+    }
+
+    // The same screw relative to another start
+    yadq::dualquaternion<double> dq0(yadq::quaternionU<double>(-0.7, 0.1, 0.2, 0.6), {-3, 0.5, 4});
+    yadq::sclerp_plan<double> moved(dq0, dq0 * screw(1));
+    for (double t : {0.1, 0.5, 0.8}){
+        expect_motion_near(moved(t), dq0 * screw(t));
+    }
+}
+
+TEST(Sclerp, ConstantVelocity) {
+
+    yadq::dualquaternion<double> dq1(yadq::quaternionU<double>(0.3, -0.2, 0.9, 0.4), {1.5, -2, 0.25});
+    yadq::dualquaternion<double> dq2(yadq::quaternionU<double>(-0.7, 0.1, 0.2, 0.6), {-3, 0.5, 4});
+
+    yadq::sclerp_plan<double> plan(dq1, dq2);
+
+    // Equal steps compose: the relative motion over [0, 0.25] applied four times gives dq2
+    const auto step = conjugate(dq1) * plan(0.25);
+    expect_motion_near(dq1 * step * step * step * step, dq2);
+    expect_motion_near(plan(0.5) * step, plan(0.75));
+}
+
+TEST(Sclerp, Batch) {
+
+    yadq::dualquaternion<float> dq1(yadq::quaternionU<float>(0.3f, -0.2f, 0.9f, 0.4f), {1.5f, -2, 0.25f});
+    yadq::dualquaternion<float> dq2(yadq::quaternionU<float>(-0.7f, 0.1f, 0.2f, 0.6f), {-3, 0.5f, 4});
+
+    yadq::sclerp_plan<float> plan(dq1, dq2);
+
+    std::vector<float> t;
+    for (int i = 0; i <= 50; ++i){
+        t.push_back(static_cast<float>(i) / 50);
+    }
+
+    const auto dq_out = plan.evaluate(t);
+
+    ASSERT_EQ(dq_out.size(), t.size());
+    for (std::size_t i = 0; i < t.size(); ++i){
+        const auto dq = plan(t[i]);
+        const auto p_out = dq_out[i].translation();
+        const auto p = dq.translation();
+        EXPECT_NEAR(dq_out[i].qr_.w(), dq.qr_.w(), 1e-6);
+        EXPECT_NEAR(dq_out[i].qr_.x(), dq.qr_.x(), 1e-6);
+        for (std::size_t c = 0; c < 3; ++c){
+            EXPECT_NEAR(p_out[c], p[c], 1e-5);
+        }
+    }
+
+    const auto p_end = dq_out.back().translation();
+    EXPECT_NEAR(p_end[0], -3, 1e-4);
+    EXPECT_NEAR(p_end[1], 0.5, 1e-4);
+    EXPECT_NEAR(p_end[2], 4, 1e-4);
+}
+
+TEST(Sclerp, LogExpMaps) {
+
+    const std::vector<yadq::dualquaternion<double>> motions = {
+        yadq::dualquaternion<double>(yadq::quaternionU<double>(0.3, -0.2, 0.9, 0.4), {1.5, -2, 0.25}),
+        yadq::dualquaternion<double>(yadq::quaternionU<double>(-0.7, 0.1, 0.2, 0.6), {-3, 0.5, 4}),
+        yadq::dualquaternion<double>(yadq::quaternionU<double>({0.2, -0.5, 0.8}, 1e-5), {0.5, 1, -2}),
+        yadq::dualquaternion<double>(yadq::quaternionU<double>(1, 0, 0, 0), {0.5, 1, -2}),
+        yadq::dualquaternion<double>(yadq::quaternionU<double>({0, 0, 1}, 3.1), {0, 0, 0})};
+
+    for (const auto& dq : motions){
+        expect_motion_near(yadq::exp_map(yadq::log_map(dq)), dq);
+        // dq and -dq have the same twist
+        const auto a = yadq::log_map(dq);
+        const auto b = yadq::log_map(negated(dq));
+        for (std::size_t c = 0; c < 6; ++c){
+            EXPECT_NEAR(a[c], b[c], TOLERANCE);
+        }
+    }
+
+    // A pure translation t has the twist [0, t]; a rotation by angle about an axis through p has w = angle axis
+    const auto translation = yadq::log_map(motions[3]);
+    EXPECT_NEAR(translation[3], 0.5, TOLERANCE);
+    EXPECT_NEAR(translation[4], 1, TOLERANCE);
+    EXPECT_NEAR(translation[5], -2, TOLERANCE);
+
+    const auto rotation = yadq::log_map(motions[4]);
+    EXPECT_NEAR(rotation[2], 3.1, TOLERANCE);
+    EXPECT_NEAR(rotation[5], 0, TOLERANCE);
+
+    // Powers and free sclerp agree with the plan
+    yadq::sclerp_plan<double> plan(motions[0], motions[1]);
+    for (double t : {0.0, 0.3, 0.7, 1.0}){
+        expect_motion_near(yadq::sclerp(motions[0], motions[1], t), plan(t));
+    }
+    const auto half = yadq::pow(motions[1], 0.5);
+    expect_motion_near(half * half, motions[1]);
+}
+
+TEST(Sclerp, Dlb) {
+
+    yadq::dualquaternion<double> dq1(yadq::quaternionU<double>(0.3, -0.2, 0.9, 0.4), {1.5, -2, 0.25});
+    yadq::dualquaternion<double> dq2(yadq::quaternionU<double>(-0.7, 0.1, 0.2, 0.6), {-3, 0.5, 4});
+
+    yadq::sclerp_plan<double> plan(dq1, dq2, yadq::sclerp_mode::dlb);
+    EXPECT_EQ(plan.mode(), yadq::sclerp_mode::dlb);
+
+    // Exact at the end points, and a rigid motion in between
+    expect_motion_near(plan(0), dq1);
+    expect_motion_near(plan(1), dq2);
+    expect_motion_near(yadq::dlb(dq1, negated(dq2), 0.4), plan(0.4));
+
+    const auto mid = plan(0.5);
+    const auto& r = mid.qr_;
+    const auto& d = mid.qd_;
+    EXPECT_NEAR(r.w() * d.w() + r.x() * d.x() + r.y() * d.y() + r.z() * d.z(), 0, TOLERANCE);
+
+    // Close to the screw path for a small relative motion
+    const auto small_step = yadq::dualquaternion<double>(yadq::quaternionU<double>({0.2, -0.5, 0.8}, 0.1), {0.05, -0.02, 0.1});
+    yadq::sclerp_plan<double> exact(dq1, dq1 * small_step);
+    yadq::sclerp_plan<double> fast(dq1, dq1 * small_step, yadq::sclerp_mode::dlb);
+    for (double t : {0.25, 0.5, 0.75}){
+        expect_motion_near(fast(t), exact(t), 1e-4);
+    }
+
+    // Batch evaluation takes the same branch as the scalar one, on any number of threads
+    std::vector<double> t(1000);
+    for (std::size_t i = 0; i < t.size(); ++i){
+        t[i] = static_cast<double>(i) / 999;
+    }
+    std::vector<yadq::dualquaternion<double>> out(t.size());
+    plan.evaluate(t.data(), out.data(), t.size(), yadq::parallel_config{4, 64});
+    for (std::size_t i = 0; i < t.size(); i += 97){
+        expect_motion_near(out[i], plan(t[i]));
+    }
+
+    // Weighted blend, weights of antipodal inputs flipped
+    const yadq::dualquaternion<double> inputs[3] = {dq1, negated(dq2), dq2};
+    const double weights[3] = {0.5, 0.25, 0.25};
+    expect_motion_near(yadq::dlb(inputs, weights, 3), yadq::dlb(dq1, dq2, 0.5));
+    EXPECT_THROW(yadq::dlb(inputs, weights, 0), std::invalid_argument);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/skinning.hpp>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#define TOLERANCE (1e-5)
+
+namespace {
+
+    template<typename T>
+    struct skin_fixture{
+        std::vector<yadq::dualquaternion<T>> palette;
+        std::vector<std::uint32_t> bones;
+        std::vector<T> weights;
+        std::vector<T> x, y, z, nx, ny, nz;
+    };
+
+    // Random palette and random influences whose weights sum to 1
+    template<typename T, std::size_t K>
+    skin_fixture<T> make_fixture(std::size_t n, std::size_t n_bones, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-1, 1);
+        std::uniform_real_distribution<T> wdist(T(0.05), 1);
+        std::uniform_int_distribution<std::uint32_t> bdist(0, static_cast<std::uint32_t>(n_bones - 1));
+
+        skin_fixture<T> f;
+        for (std::size_t b = 0; b < n_bones; ++b){
+            yadq::quaternionU<T> r(dist(gen), dist(gen), dist(gen), dist(gen));
+            f.palette.emplace_back(r, std::array<T, 3>{dist(gen), dist(gen), dist(gen)});
+        }
+
+        for (std::size_t v = 0; v < n; ++v){
+            T sum = 0;
+            for (std::size_t k = 0; k < K; ++k){
+                f.bones.push_back(bdist(gen));
+                f.weights.push_back(wdist(gen));
+                sum += f.weights.back();
+            }
+            for (std::size_t k = 0; k < K; ++k){
+                f.weights[v * K + k] /= sum;
+            }
+
+            f.x.push_back(dist(gen)); f.y.push_back(dist(gen)); f.z.push_back(dist(gen));
+            f.nx.push_back(dist(gen)); f.ny.push_back(dist(gen)); f.nz.push_back(dist(gen));
+        }
+        return f;
+    }
+
+    // Textbook DLB on raw components: sign-corrected weighted sum, normalisation, p' = R p + t
+    template<typename T, std::size_t K>
+    std::array<double, 6> reference(const skin_fixture<T>& f, std::size_t v){
+        const auto& pivot = f.palette[f.bones[v * K]].qr_;
+        std::array<double, 8> b{};
+
+        for (std::size_t k = 0; k < K; ++k){
+            const auto& dq = f.palette[f.bones[v * K + k]];
+            const double d = double(pivot.w()) * dq.qr_.w() + double(pivot.x()) * dq.qr_.x() + double(pivot.y()) * dq.qr_.y() + double(pivot.z()) * dq.qr_.z();
+            const double w = (d < 0 ? -1.0 : 1.0) * f.weights[v * K + k];
+
+            const double c[8] = {dq.qr_.w(), dq.qr_.x(), dq.qr_.y(), dq.qr_.z(), dq.qd_.w(), dq.qd_.x(), dq.qd_.y(), dq.qd_.z()};
+            for (std::size_t j = 0; j < 8; ++j){
+                b[j] += w * c[j];
+            }
+        }
+
+        const double n = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
+        for (auto& c : b){
+            c /= n;
+        }
+
+        const yadq::quaternionU<double> r(b[0], b[1], b[2], b[3]);
+        const yadq::dualquaternion<double> dq(r, yadq::quaternion<double>(b[4], b[5], b[6], b[7]));
+        const auto p = yadq::transform(dq, std::array<double, 3>{f.x[v], f.y[v], f.z[v]});
+        const auto nr = yadq::rotate(r, std::array<double, 3>{f.nx[v], f.ny[v], f.nz[v]});
+
+        return {p[0], p[1], p[2], nr[0], nr[1], nr[2]};
+    }
+
+    template<typename T, std::size_t K>
+    void check_against_reference(std::size_t n, const yadq::parallel_config& config){
+        auto f = make_fixture<T, K>(n, 12, 7);
+        std::vector<T> ox(n), oy(n), oz(n), onx(n), ony(n), onz(n);
+
+        yadq::skin(f.palette.data(), yadq::bone_influences<T, K>{f.bones.data(), f.weights.data()},
+                   {f.x.data(), f.y.data(), f.z.data()}, {f.nx.data(), f.ny.data(), f.nz.data()},
+                   {ox.data(), oy.data(), oz.data()}, {onx.data(), ony.data(), onz.data()}, n, config);
+
+        for (std::size_t v = 0; v < n; ++v){
+            const auto e = reference<T, K>(f, v);
+            EXPECT_NEAR(ox[v], e[0], TOLERANCE) << "vertex " << v;
+            EXPECT_NEAR(oy[v], e[1], TOLERANCE) << "vertex " << v;
+            EXPECT_NEAR(oz[v], e[2], TOLERANCE) << "vertex " << v;
+            EXPECT_NEAR(onx[v], e[3], TOLERANCE) << "vertex " << v;
+            EXPECT_NEAR(ony[v], e[4], TOLERANCE) << "vertex " << v;
+            EXPECT_NEAR(onz[v], e[5], TOLERANCE) << "vertex " << v;
+        }
+    }
+}
+
+TEST(Skinning, MatchesReference4) {
+    // 37 vertices: several full packs plus a scalar tail on every ISA
+    check_against_reference<float, 4>(37, {});
+    check_against_reference<double, 4>(37, {});
+}
+
+TEST(Skinning, MatchesReference8) {
+    check_against_reference<float, 8>(37, {});
+    check_against_reference<double, 8>(37, {});
+}
+
+TEST(Skinning, Threads) {
+    check_against_reference<double, 4>(1001, {4, 1});
+}
+
+TEST(Skinning, SingleBoneIsRigid) {
+    const yadq::quaternionU<double> r(0.3, -0.5, 0.2, 0.7);
+    const yadq::dualquaternion<double> dq(r, std::array<double, 3>{1.0, -2.0, 0.5});
+
+    // The second slot is padding: any valid bone with a zero weight
+    const std::vector<yadq::dualquaternion<double>> palette{dq, yadq::dualquaternion<double>()};
+    const std::size_t n = 19;
+    std::vector<std::uint32_t> bones(4 * n, 1);
+    std::vector<double> weights(4 * n, 0.0);
+    std::vector<double> x(n), y(n), z(n), ox(n), oy(n), oz(n);
+
+    for (std::size_t v = 0; v < n; ++v){
+        bones[4 * v] = 0;
+        weights[4 * v] = 1.0;
+        x[v] = 0.1 * v; y[v] = 1.0 - 0.2 * v; z[v] = 0.05 * v * v;
+    }
+
+    yadq::skin(palette.data(), yadq::bone_influences<double, 4>{bones.data(), weights.data()},
+               {x.data(), y.data(), z.data()}, {ox.data(), oy.data(), oz.data()}, n);
+
+    for (std::size_t v = 0; v < n; ++v){
+        const auto e = yadq::transform(dq, std::array<double, 3>{x[v], y[v], z[v]});
+        EXPECT_NEAR(ox[v], e[0], TOLERANCE);
+        EXPECT_NEAR(oy[v], e[1], TOLERANCE);
+        EXPECT_NEAR(oz[v], e[2], TOLERANCE);
+    }
+}
+
+TEST(Skinning, Antipodality) {
+    // dq and -dq are the same rigid transformation: blending them must not collapse the result
+    const yadq::quaternionU<double> r(0.9, 0.1, -0.3, 0.2);
+    const yadq::dualquaternion<double> dq(r, std::array<double, 3>{0.5, 0.25, -1.0});
+    const yadq::dualquaternion<double> neg(yadq::quaternionU<double>(-r.w(), -r.x(), -r.y(), -r.z()), -1.0 * dq.qd_);
+
+    const std::vector<yadq::dualquaternion<double>> palette{dq, neg};
+    const std::vector<std::uint32_t> bones{0, 1, 0, 1};
+    const std::vector<double> weights{0.25, 0.25, 0.25, 0.25};
+    double x = 0.3, y = -0.7, z = 1.1, ox, oy, oz;
+
+    yadq::skin(palette.data(), yadq::bone_influences<double, 4>{bones.data(), weights.data()},
+               {&x, &y, &z}, {&ox, &oy, &oz}, 1);
+
+    const auto e = yadq::transform(dq, std::array<double, 3>{x, y, z});
+    EXPECT_NEAR(ox, e[0], TOLERANCE);
+    EXPECT_NEAR(oy, e[1], TOLERANCE);
+    EXPECT_NEAR(oz, e[2], TOLERANCE);
+}
+
+TEST(Skinning, InPlace) {
+    const std::size_t n = 21;
+    auto f = make_fixture<float, 4>(n, 5, 3);
+    std::vector<float> ox(n), oy(n), oz(n);
+    const yadq::bone_influences<float, 4> inf{f.bones.data(), f.weights.data()};
+
+    yadq::skin(f.palette.data(), inf, {f.x.data(), f.y.data(), f.z.data()}, {ox.data(), oy.data(), oz.data()}, n);
+    yadq::skin(f.palette.data(), inf, {f.x.data(), f.y.data(), f.z.data()}, {f.x.data(), f.y.data(), f.z.data()}, n);
+
+    for (std::size_t v = 0; v < n; ++v){
+        EXPECT_EQ(f.x[v], ox[v]);
+        EXPECT_EQ(f.y[v], oy[v]);
+        EXPECT_EQ(f.z[v], oz[v]);
+    }
+}
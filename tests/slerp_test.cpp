@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/slerp.hpp>
+
+#define TOLERANCE (1e-5)
+
+namespace {
+
+    // Rotation angle between two quaternions, robust for nearly equal inputs. Slerp samples are not renormalised:
+    // the rotation is given by their direction only.
+    template<typename Q1, typename Q2>
+    double rotation_distance(const Q1& q1, const Q2& q2){
+        double diff = 0, sum = 0;
+        const double n1 = q1.norm(), n2 = q2.norm();
+        const double a[4] = {q1.w() / n1, q1.x() / n1, q1.y() / n1, q1.z() / n1};
+        const double b[4] = {q2.w() / n2, q2.x() / n2, q2.y() / n2, q2.z() / n2};
+        for (int i = 0; i < 4; ++i){
+            diff += (a[i] - b[i]) * (a[i] - b[i]);
+            sum += (a[i] + b[i]) * (a[i] + b[i]);
+        }
+        return 4 * std::atan2(std::sqrt(std::min(diff, sum)), std::sqrt(std::max(diff, sum)));
+    }
+}
+
+TEST(Slerp, InterpolationSLERP) {
+
+    const std::array<double, 3> axis = {0.2, -0.5, 0.8};
+    yadq::quaternionU<double> q1(axis, 0.3);
+    yadq::quaternionU<double> q2(axis, 2.1);
+
+    for (double t : {0.0, 0.25, 0.5, 0.9, 1.0}){
+        yadq::quaternionU<double> q_ref(axis, 0.3 + t * 1.8);
+        EXPECT_NEAR(rotation_distance(interpolation(q1, q2, t, yadq::InterpType::SLERP), q_ref), 0.0, TOLERANCE);
+    }
+
+    // Shortest path and identical end points
+    yadq::quaternionU<double> q2_neg(-q2.w(), -q2.x(), -q2.y(), -q2.z());
+    EXPECT_NEAR(rotation_distance(interpolation(q1, q2_neg, 0.5, yadq::InterpType::SLERP), yadq::quaternionU<double>(axis, 1.2)), 0.0, TOLERANCE);
+    EXPECT_NEAR(rotation_distance(interpolation(q1, q1, 0.5, yadq::InterpType::SLERP), q1), 0.0, TOLERANCE);
+}
+
+TEST(Slerp, PlanExact) {
+
+    const std::array<double, 3> axis = {0.2, -0.5, 0.8};
+    yadq::quaternionU<double> q1(axis, -1.0);
+    yadq::quaternionU<double> q2(axis, 2.0);
+
+    yadq::slerp_plan<double> plan(q1, q2);
+
+    EXPECT_NEAR(plan.angle(), 3.0 / 2, TOLERANCE);
+
+    for (double t = 0; t <= 1.0; t += 0.125){
+        yadq::quaternionU<double> q_ref(axis, -1.0 + t * 3.0);
+        EXPECT_NEAR(rotation_distance(plan(t), q_ref), 0.0, 1e-12);
+        EXPECT_NEAR(rotation_distance(plan(t), interpolation(q1, q2, t, yadq::InterpType::SLERP)), 0.0, 1e-12);
+    }
+}
+
+TEST(Slerp, PlanShortestPath) {
+
+    const std::array<double, 3> axis = {1, 0, 0};
+    yadq::quaternionU<double> q1(axis, 0.0);
+    yadq::quaternionU<double> q2(axis, 1.0);
+    yadq::quaternionU<double> q2_neg(-q2.w(), -q2.x(), -q2.y(), -q2.z());
+
+    yadq::slerp_plan<double> plan(q1, q2);
+    yadq::slerp_plan<double> plan_neg(q1, q2_neg);
+
+    EXPECT_NEAR(plan_neg.angle(), plan.angle(), 1e-12);
+    EXPECT_NEAR(rotation_distance(plan_neg(0.4), plan(0.4)), 0.0, 1e-12);
+}
+
+TEST(Slerp, PlanDegenerate) {
+
+    yadq::quaternionU<double> q1({0.3, 0.1, -0.2}, 0.7);
+    yadq::quaternionU<double> q2({0.3, 0.1, -0.2}, 0.7 + 1e-9);
+
+    for (auto mode : {yadq::slerp_mode::exact, yadq::slerp_mode::fast}){
+        yadq::slerp_plan<double> same(q1, q1, mode);
+        yadq::slerp_plan<double> close(q1, q2, mode);
+
+        for (double t : {0.0, 0.3, 1.0}){
+            auto q = same(t);
+            EXPECT_FALSE(std::isnan(q.w()));
+            EXPECT_NEAR(rotation_distance(q, q1), 0.0, 1e-12);
+            EXPECT_NEAR(rotation_distance(close(t), q1), t * 1e-9, 1e-12);
+        }
+    }
+}
+
+TEST(Slerp, PlanFastErrorBound) {
+
+    // Sweep over the whole range of angles, the rotation angle error must stay within the documented bound
+    const std::array<double, 3> axis = {-0.4, 0.7, 0.1};
+
+    double max_err = 0, max_norm_err = 0;
+    for (double angle = 0.01; angle < 2 * M_PI; angle += 0.05){
+        yadq::quaternionU<double> q1(axis, 0.2);
+        yadq::quaternionU<double> q2(axis, 0.2 + angle);
+
+        yadq::slerp_plan<double> exact(q1, q2);
+        yadq::slerp_plan<double> fast(q1, q2, yadq::slerp_mode::fast);
+
+        for (double t = 0; t <= 1.0; t += 1.0 / 64){
+            max_err = std::max(max_err, rotation_distance(fast(t), exact(t)));
+            max_norm_err = std::max({max_norm_err, std::fabs(fast(t).norm() - 1), std::fabs(exact(t).norm() - 1)});
+        }
+    }
+
+    // The documented bound is 1.6e-8, the sweep stays below 1e-8
+    EXPECT_LT(max_err, 1.3e-8);
+
+    // Samples are not renormalised: their norm is off by the weight error only, below 5.4e-9
+    EXPECT_LT(max_norm_err, 1e-8);
+}
+
+TEST(Slerp, PlanBatch) {
+
+    yadq::quaternionU<float> q1({0.3f, 0.1f, -0.2f}, 0.7f);
+    yadq::quaternionU<float> q2({-0.6f, 0.2f, 0.4f}, 2.0f);
+
+    std::vector<float> t;
+    for (int i = 0; i <= 100; ++i){
+        t.push_back(static_cast<float>(i) / 100);
+    }
+
+    for (auto mode : {yadq::slerp_mode::exact, yadq::slerp_mode::fast}){
+        yadq::slerp_plan<float> plan(q1, q2, mode);
+        const auto q_out = plan.evaluate(t);
+
+        ASSERT_EQ(q_out.size(), t.size());
+        for (std::size_t i = 0; i < t.size(); ++i){
+            const auto q = plan(t[i]);
+            EXPECT_NEAR(q_out[i].w(), q.w(), 1e-6);
+            EXPECT_NEAR(q_out[i].x(), q.x(), 1e-6);
+            EXPECT_NEAR(q_out[i].y(), q.y(), 1e-6);
+            EXPECT_NEAR(q_out[i].z(), q.z(), 1e-6);
+        }
+
+        EXPECT_NEAR(rotation_distance(q_out.front(), q1), 0.0, 1e-5);
+        EXPECT_NEAR(rotation_distance(q_out.back(), q2), 0.0, 1e-5);
+    }
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/trajectory_file.hpp>
+
+namespace {
+
+    std::string temp_path(const std::string& name){
+        return testing::TempDir() + "yadq_" + name + ".traj";
+    }
+
+    template<typename T>
+    std::vector<yadq::dualquaternion<T>> random_poses(std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<T> dist(-1, 1);
+
+        std::vector<yadq::dualquaternion<T>> v;
+        for (std::size_t i = 0; i < n; ++i){
+            yadq::quaternionU<T> r(dist(gen), dist(gen), dist(gen), dist(gen));
+            v.emplace_back(r, std::array<T, 3>{dist(gen), dist(gen), dist(gen)});
+        }
+        return v;
+    }
+
+    template<typename Q>
+    void expect_equal(const Q& a, const Q& b){
+        EXPECT_EQ(a.w(), b.w());
+        EXPECT_EQ(a.x(), b.x());
+        EXPECT_EQ(a.y(), b.y());
+        EXPECT_EQ(a.z(), b.z());
+    }
+}
+
+TEST(TrajectoryFile, RoundTripDualQuaternion) {
+    const std::string path = temp_path("dq");
+    const auto poses = random_poses<double>(10000, 1);
+
+    {
+        // A small buffer forces several block writes
+        yadq::trajectory_appender<yadq::dualquaternion<double>> out(path, yadq::open_mode::truncate, 333);
+        for (std::size_t i = 0; i < poses.size(); ++i){
+            out.append(0.01 * i, poses[i]);
+        }
+        EXPECT_EQ(out.size(), poses.size());
+    }
+
+    yadq::trajectory_reader<yadq::dualquaternion<double>> in(path, yadq::access_pattern::sequential);
+    ASSERT_EQ(in.size(), poses.size());
+    EXPECT_EQ(in.header().version, yadq::trajectory_header::current_version);
+    EXPECT_EQ(in.header().record_size, 72u);
+
+    // Records are used in place, aligned for their type
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(in.data()) % alignof(double), 0u);
+
+    std::size_t i = 0;
+    for (const auto& r : in){
+        EXPECT_EQ(r.timestamp, 0.01 * i);
+        expect_equal(r.value.qr_, poses[i].qr_);
+        expect_equal(r.value.qd_, poses[i].qd_);
+        ++i;
+    }
+    EXPECT_EQ(i, poses.size());
+
+    expect_equal(in[1234].value.qd_, poses[1234].qd_);
+    EXPECT_THROW(in.at(poses.size()), std::out_of_range);
+
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryFile, QuaternionFloat) {
+    const std::string path = temp_path("qf");
+    const auto poses = random_poses<float>(100, 2);
+
+    {
+        yadq::trajectory_appender<yadq::quaternionU<float>> out(path);
+        for (std::size_t i = 0; i < poses.size(); ++i){
+            out.append(double(i), poses[i].qr_);
+        }
+    }
+
+    // quaternion and quaternionU share the record layout
+    yadq::trajectory_reader<yadq::quaternion<float>> in(path);
+    ASSERT_EQ(in.size(), poses.size());
+    EXPECT_EQ(in.header().record_size, 24u);
+
+    for (std::size_t i = 0; i < poses.size(); ++i){
+        EXPECT_EQ(in[i].timestamp, double(i));
+        expect_equal(in[i].value, static_cast<const yadq::quaternion<float>&>(poses[i].qr_));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryFile, AppendAndFlush) {
+    const std::string path = temp_path("append");
+    const auto poses = random_poses<double>(50, 3);
+
+    {
+        yadq::trajectory_appender<yadq::dualquaternion<double>> out(path);
+        for (std::size_t i = 0; i < 20; ++i){
+            out.append(double(i), poses[i]);
+        }
+        out.flush();
+
+        // Readers see the records flushed before they open, and keep that view
+        yadq::trajectory_reader<yadq::dualquaternion<double>> before(path);
+        EXPECT_EQ(before.size(), 20u);
+
+        out.append(20.0, poses[20]);
+        out.flush();
+        EXPECT_EQ(before.size(), 20u);
+
+        yadq::trajectory_reader<yadq::dualquaternion<double>> after(path);
+        EXPECT_EQ(after.size(), 21u);
+    }
+
+    {
+        yadq::trajectory_appender<yadq::dualquaternion<double>> out(path, yadq::open_mode::append);
+        EXPECT_EQ(out.size(), 21u);
+        for (std::size_t i = 21; i < poses.size(); ++i){
+            out.append(double(i), poses[i]);
+        }
+    }
+
+    yadq::trajectory_reader<yadq::dualquaternion<double>> in(path);
+    ASSERT_EQ(in.size(), poses.size());
+    for (std::size_t i = 0; i < poses.size(); ++i){
+        EXPECT_EQ(in[i].timestamp, double(i));
+        expect_equal(in[i].value.qd_, poses[i].qd_);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryFile, AppendAfterUnflushedRecords) {
+    const std::string path = temp_path("unflushed");
+    const auto poses = random_poses<double>(12, 5);
+
+    {
+        yadq::trajectory_appender<yadq::dualquaternion<double>> out(path);
+        for (std::size_t i = 0; i < 10; ++i){
+            out.append(double(i), poses[i]);
+        }
+    }
+
+    // As if the writer stopped after writing 10 records but before recording more than 6
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        const std::uint64_t count = 6;
+        f.seekp(offsetof(yadq::trajectory_header, count));
+        f.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    const auto file_size = [&path](){
+        std::ifstream f(path, std::ios::binary | std::ios::ate);
+        return static_cast<std::size_t>(f.tellg());
+    };
+    const std::size_t size = file_size();
+
+    yadq::trajectory_reader<yadq::dualquaternion<double>> before(path);
+    EXPECT_EQ(before.size(), 6u);
+
+    {
+        // Reopening never shrinks the file under a mapping: the stale records are overwritten in place
+        yadq::trajectory_appender<yadq::dualquaternion<double>> out(path, yadq::open_mode::append);
+        EXPECT_EQ(out.size(), 6u);
+        EXPECT_EQ(file_size(), size);
+        out.append(6.5, poses[10]);
+        out.append(7.5, poses[11]);
+    }
+
+    EXPECT_EQ(before.size(), 6u);
+    expect_equal(before[5].value.qr_, poses[5].qr_);
+
+    yadq::trajectory_reader<yadq::dualquaternion<double>> after(path);
+    ASSERT_EQ(after.size(), 8u);
+    EXPECT_EQ(after[6].timestamp, 6.5);
+    expect_equal(after[7].value.qd_, poses[11].qd_);
+
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryFile, Empty) {
+    const std::string path = temp_path("empty");
+
+    { yadq::trajectory_appender<yadq::quaternion<double>> out(path); }
+
+    yadq::trajectory_reader<yadq::quaternion<double>> in(path);
+    EXPECT_TRUE(in.empty());
+    EXPECT_EQ(in.begin(), in.end());
+
+    std::remove(path.c_str());
+}
+
+TEST(TrajectoryFile, Validation) {
+    const std::string path = temp_path("invalid");
+
+    EXPECT_THROW((yadq::trajectory_reader<yadq::quaternion<double>>(temp_path("missing"))), std::system_error);
+
+    {
+        std::ofstream f(path, std::ios::binary);
+        f << "definitely not a trajectory file, but long enough to hold a whole header of 64 bytes";
+    }
+    EXPECT_THROW((yadq::trajectory_reader<yadq::quaternion<double>>(path)), std::runtime_error);
+    EXPECT_THROW((yadq::trajectory_appender<yadq::quaternion<double>>(path, yadq::open_mode::append)), std::runtime_error);
+
+    {
+        yadq::trajectory_appender<yadq::quaternion<double>> out(path);
+        out.append(0.0, yadq::quaternion<double>());
+    }
+
+    // Wrong record type
+    EXPECT_THROW((yadq::trajectory_reader<yadq::quaternion<float>>(path)), std::runtime_error);
+    EXPECT_THROW((yadq::trajectory_reader<yadq::dualquaternion<double>>(path)), std::runtime_error);
+
+    // A count larger than the data
+    {
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        const std::uint64_t count = 2;
+        f.seekp(offsetof(yadq::trajectory_header, count));
+        f.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    EXPECT_THROW((yadq::trajectory_reader<yadq::quaternion<double>>(path)), std::runtime_error);
+
+    std::remove(path.c_str());
+}
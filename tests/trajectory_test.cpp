@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <yadq/quaternion.hpp>
+#include <yadq/dual_quaternion.hpp>
+#include <yadq/trajectory.hpp>
+
+#define TOLERANCE (1e-9)
+
+namespace {
+
+    // Rotation angle between two unitary quaternions, robust for nearly equal inputs
+    template<typename Q1, typename Q2>
+    double rotation_distance(const Q1& q1, const Q2& q2){
+        double diff = 0, sum = 0;
+        const double a[4] = {q1.w(), q1.x(), q1.y(), q1.z()};
+        const double b[4] = {q2.w(), q2.x(), q2.y(), q2.z()};
+        for (int i = 0; i < 4; ++i){
+            diff += (a[i] - b[i]) * (a[i] - b[i]);
+            sum += (a[i] + b[i]) * (a[i] + b[i]);
+        }
+        return 4 * std::atan2(std::sqrt(std::min(diff, sum)), std::sqrt(std::max(diff, sum)));
+    }
+
+    void expect_motion_near(const yadq::dualquaternion<double>& a, const yadq::dualquaternion<double>& b, double tol = TOLERANCE){
+        EXPECT_NEAR(rotation_distance(a.qr_, b.qr_), 0.0, tol);
+        const auto pa = a.translation();
+        const auto pb = b.translation();
+        for (std::size_t c = 0; c < 3; ++c){
+            EXPECT_NEAR(pa[c], pb[c], tol);
+        }
+    }
+
+    // Unevenly spaced keyframes
+    std::vector<double> keyframe_times(std::size_t n){
+        std::vector<double> t(n);
+        for (std::size_t i = 0; i < n; ++i){
+            t[i] = 0.5 * static_cast<double>(i) + 0.1 * std::sin(static_cast<double>(i));
+        }
+        return t;
+    }
+
+    std::vector<yadq::quaternionU<double>> keyframe_rotations(std::size_t n){
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<double> dist(-1, 1);
+        std::vector<yadq::quaternionU<double>> q;
+        for (std::size_t i = 0; i < n; ++i){
+            q.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+        }
+        return q;
+    }
+
+    std::vector<yadq::dualquaternion<double>> keyframe_motions(std::size_t n){
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<double> dist(-1, 1);
+        std::vector<yadq::dualquaternion<double>> dq;
+        for (std::size_t i = 0; i < n; ++i){
+            yadq::quaternionU<double> r(dist(gen), dist(gen), dist(gen), dist(gen));
+            dq.emplace_back(r, std::array<double, 3>{3 * dist(gen), 3 * dist(gen), 3 * dist(gen)});
+        }
+        return dq;
+    }
+
+    std::vector<double> random_queries(double t0, double t1, std::size_t n, unsigned seed){
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> dist(t0 - 0.5, t1 + 0.5);
+        std::vector<double> t(n);
+        for (auto& ti : t){
+            ti = dist(gen);
+        }
+        return t;
+    }
+}
+
+TEST(Trajectory, Linear) {
+
+    const auto t = keyframe_times(20);
+    const auto q = keyframe_rotations(20);
+
+    yadq::trajectory<yadq::quaternionU<double>> tr(t, q);
+
+    ASSERT_EQ(tr.size(), 20u);
+    EXPECT_EQ(tr.mode(), yadq::trajectory_interp::linear);
+    EXPECT_EQ(tr.start_time(), t.front());
+    EXPECT_EQ(tr.end_time(), t.back());
+
+    for (std::size_t i = 0; i < t.size(); ++i){
+        EXPECT_NEAR(rotation_distance(tr(t[i]), q[i]), 0.0, TOLERANCE);
+    }
+
+    for (std::size_t i = 0; i + 1 < t.size(); ++i){
+        for (double u : {0.2, 0.5, 0.75}){
+            const auto ref = yadq::interpolation(q[i], q[i + 1], u, yadq::InterpType::SLERP);
+            EXPECT_NEAR(rotation_distance(tr(t[i] + u * (t[i + 1] - t[i])), ref), 0.0, 1e-8);
+        }
+    }
+
+    // Clamped outside the keyframes
+    EXPECT_NEAR(rotation_distance(tr(t.front() - 10), q.front()), 0.0, TOLERANCE);
+    EXPECT_NEAR(rotation_distance(tr(t.back() + 10), q.back()), 0.0, TOLERANCE);
+}
+
+TEST(Trajectory, LinearDual) {
+
+    const auto t = keyframe_times(12);
+    const auto dq = keyframe_motions(12);
+
+    yadq::trajectory<yadq::dualquaternion<double>> tr(t, dq);
+
+    for (std::size_t i = 0; i < t.size(); ++i){
+        expect_motion_near(tr(t[i]), dq[i]);
+    }
+
+    for (std::size_t i = 0; i + 1 < t.size(); ++i){
+        yadq::sclerp_plan<double> plan(dq[i], dq[i + 1]);
+        for (double u : {0.2, 0.5, 0.75}){
+            expect_motion_near(tr(t[i] + u * (t[i + 1] - t[i])), plan(u), 1e-8);
+        }
+    }
+}
+
+TEST(Trajectory, CursorAndBatch) {
+
+    const auto t = keyframe_times(500);
+    const auto q = keyframe_rotations(500);
+
+    for (auto mode : {yadq::trajectory_interp::linear, yadq::trajectory_interp::smooth}){
+        yadq::trajectory<yadq::quaternionU<double>> tr(t, q, mode);
+
+        // Random order: backward jumps and long forward jumps
+        const auto queries = random_queries(t.front(), t.back(), 2000, 3);
+        auto cursor = tr.make_cursor();
+
+        const auto batch = tr.evaluate(queries);
+        ASSERT_EQ(batch.size(), queries.size());
+
+        for (std::size_t i = 0; i < queries.size(); ++i){
+            const auto ref = tr(queries[i]);
+            EXPECT_NEAR(rotation_distance(cursor(queries[i]), ref), 0.0, TOLERANCE);
+            EXPECT_NEAR(rotation_distance(batch[i], ref), 0.0, TOLERANCE);
+        }
+
+        // Sorted, with several queries per segment and exact keyframe times
+        auto sorted = random_queries(t.front(), t.back(), 3000, 5);
+        sorted.insert(sorted.end(), t.begin(), t.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        const auto sorted_batch = tr.evaluate(sorted);
+        for (std::size_t i = 0; i < sorted.size(); ++i){
+            EXPECT_NEAR(rotation_distance(sorted_batch[i], tr(sorted[i])), 0.0, TOLERANCE);
+        }
+
+        // The cursor lands on the segment holding the time
+        auto c = tr.make_cursor();
+        c(t[42] + 1e-3);
+        EXPECT_EQ(c.segment(), 42u);
+        c(t[3]);
+        EXPECT_EQ(c.segment(), 3u);
+        c(t.back() + 1);
+        EXPECT_EQ(c.segment(), t.size() - 2);
+    }
+}
+
+TEST(Trajectory, ParallelResampling) {
+
+    const auto t = keyframe_times(300);
+    const auto dq = keyframe_motions(300);
+
+    for (auto mode : {yadq::trajectory_interp::linear, yadq::trajectory_interp::smooth}){
+        yadq::trajectory<yadq::dualquaternion<double>> tr(t, dq, mode);
+
+        // Dense sorted resampling, split across threads, and random queries
+        std::vector<double> dense(20000);
+        for (std::size_t i = 0; i < dense.size(); ++i){
+            dense[i] = t.front() + (t.back() - t.front()) * static_cast<double>(i) / static_cast<double>(dense.size() - 1);
+        }
+        const auto queries = random_queries(t.front(), t.back(), 5000, 9);
+
+        for (const std::vector<double>* times : std::array<const std::vector<double>*, 2>{&dense, &queries}){
+            const auto sequential = tr.evaluate(*times);
+            const auto parallel = tr.evaluate(*times, yadq::parallel_config{4, 256});
+            ASSERT_EQ(parallel.size(), times->size());
+            for (std::size_t i = 0; i < times->size(); i += 7){
+                expect_motion_near(parallel[i], sequential[i]);
+            }
+        }
+    }
+
+    yadq::trajectory<yadq::dualquaternion<double>> empty;
+    const double time = 0;
+    yadq::dualquaternion<double> out;
+    EXPECT_THROW(empty.evaluate(&time, &out, 1, yadq::parallel_config{2, 1}), std::out_of_range);
+}
+
+TEST(Trajectory, SmoothInterpolatesKeyframes) {
+
+    const auto t = keyframe_times(15);
+    const auto q = keyframe_rotations(15);
+    const auto dq = keyframe_motions(15);
+
+    yadq::trajectory<yadq::quaternionU<double>> tr(t, q, yadq::trajectory_interp::smooth);
+    yadq::trajectory<yadq::dualquaternion<double>> tr_dual(t, dq, yadq::trajectory_interp::smooth);
+
+    for (std::size_t i = 0; i < t.size(); ++i){
+        EXPECT_NEAR(rotation_distance(tr(t[i]), q[i]), 0.0, 1e-8);
+        expect_motion_near(tr_dual(t[i]), dq[i], 1e-8);
+    }
+}
+
+TEST(Trajectory, SmoothVelocityContinuity) {
+
+    // Evenly spaced keyframes: the angular velocity is continuous across keyframes with SQUAD, not with SLERP
+    std::vector<double> t;
+    std::vector<yadq::quaternionU<double>> q;
+    for (int i = 0; i < 6; ++i){
+        t.push_back(i);
+        q.emplace_back(std::array<double, 3>{std::cos(i), 1, std::sin(0.5 * i)}, 0.4 * i * i);
+    }
+
+    yadq::trajectory<yadq::quaternionU<double>> linear(t, q);
+    yadq::trajectory<yadq::quaternionU<double>> smooth(t, q, yadq::trajectory_interp::smooth);
+
+    // Angular speed on both sides of keyframe i, from finite differences over h
+    const auto jump = [](const auto& tr, double ti){
+        const double h = 1e-4;
+        const double before = rotation_distance(tr(ti - h), tr(ti)) / h;
+        const double after = rotation_distance(tr(ti), tr(ti + h)) / h;
+        return std::abs(after - before);
+    };
+
+    for (std::size_t i = 1; i + 1 < t.size(); ++i){
+        EXPECT_LT(jump(smooth, t[i]), 1e-2);
+        EXPECT_GT(jump(linear, t[i]), 1e-1);
+    }
+
+    // Constant angular velocity about a fixed axis is reproduced exactly
+    std::vector<yadq::quaternionU<double>> uniform;
+    for (int i = 0; i < 6; ++i){
+        uniform.emplace_back(std::array<double, 3>{0, 0.6, 0.8}, 0.5 * i);
+    }
+    yadq::trajectory<yadq::quaternionU<double>> spin(t, uniform, yadq::trajectory_interp::smooth);
+    for (double ti = 0; ti <= 5; ti += 0.125){
+        EXPECT_NEAR(rotation_distance(spin(ti), yadq::quaternionU<double>(std::array<double, 3>{0, 0.6, 0.8}, 0.5 * ti)), 0.0, 1e-8);
+    }
+}
+
+TEST(Trajectory, SmoothTranslation) {
+
+    // Uniform linear motion is reproduced by the Catmull-Rom spline, even with uneven keyframes
+    const auto t = keyframe_times(8);
+    const yadq::quaternionU<double> r(0.3, -0.2, 0.9, 0.4);
+
+    std::vector<yadq::dualquaternion<double>> dq;
+    for (double ti : t){
+        dq.emplace_back(r, std::array<double, 3>{1 + 2 * ti, -ti, 0.5 * ti});
+    }
+
+    yadq::trajectory<yadq::dualquaternion<double>> tr(t, dq, yadq::trajectory_interp::smooth);
+
+    for (double ti = t.front(); ti <= t.back(); ti += 0.05){
+        expect_motion_near(tr(ti), yadq::dualquaternion<double>(r, {1 + 2 * ti, -ti, 0.5 * ti}), 1e-8);
+    }
+}
+
+TEST(Trajectory, PushBack) {
+
+    const auto t = keyframe_times(30);
+    const auto dq = keyframe_motions(30);
+    const auto queries = random_queries(t.front(), t.back(), 500, 9);
+
+    for (auto mode : {yadq::trajectory_interp::linear, yadq::trajectory_interp::smooth}){
+        yadq::trajectory<yadq::dualquaternion<double>> whole(t, dq, mode);
+        yadq::trajectory<yadq::dualquaternion<double>> incremental(mode);
+
+        incremental.reserve(t.size());
+        auto cursor = incremental.make_cursor();
+        for (std::size_t i = 0; i < t.size(); ++i){
+            incremental.push_back(t[i], dq[i]);
+            expect_motion_near(cursor(t[i]), dq[i], 1e-8);
+        }
+
+        for (double ti : queries){
+            expect_motion_near(incremental(ti), whole(ti));
+        }
+    }
+}
+
+TEST(Trajectory, Degenerate) {
+
+    yadq::trajectory<yadq::quaternionU<double>> tr;
+
+    EXPECT_TRUE(tr.empty());
+    EXPECT_THROW(tr(0.0), std::out_of_range);
+    EXPECT_THROW(tr.make_cursor()(0.0), std::out_of_range);
+
+    const yadq::quaternionU<double> q(0.3, -0.2, 0.9, 0.4);
+    tr.push_back(1.0, q);
+
+    EXPECT_NEAR(rotation_distance(tr(0.0), q), 0.0, TOLERANCE);
+    EXPECT_NEAR(rotation_distance(tr(5.0), q), 0.0, TOLERANCE);
+
+    // Timestamps must increase strictly
+    EXPECT_THROW(tr.push_back(1.0, q), std::invalid_argument);
+    EXPECT_THROW(tr.push_back(0.5, q), std::invalid_argument);
+    EXPECT_THROW((yadq::trajectory<yadq::quaternionU<double>>({0.0, 2.0, 1.0}, {q, q, q})), std::invalid_argument);
+    EXPECT_THROW((yadq::trajectory<yadq::quaternionU<double>>({0.0, 1.0}, {q})), std::invalid_argument);
+}